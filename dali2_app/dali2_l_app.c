@@ -12,12 +12,14 @@
 #include <string.h>
 
 #include "dali2_l_app.h"
+#include "dali2_log.h"
+#include "dali2_metrics.h"
+#include "dali2_mon.h"
 
 #include "dali2_spec_cmd_list.h"
 #include "dali2_std_cmd_list.h"
 #include "dali2_led_cmd_list.h"
 
-
 typedef enum {
     DALI2_L_APP_STATE_IDLE,
     DALI2_L_APP_STATE_BUSY
@@ -27,8 +29,14 @@ typedef struct {
     DALI2_L_APP_STATE_T state;
     dali2_l_app_evt_data_t evt_data;
     dali2_l_app_evt_func_t evt_cb;
+    DALI2_L_SES_PRIORITY_T priority;
+
+    //! DT6 command waiting for ENABLE DEVICE TYPE 6 to be done
+    DALI2_L_SES_MSG_T dt6_msg;
+    unsigned int dt6_frame;
 
     unsigned char is_dtr:1;
+    unsigned char is_dt6:1;
     unsigned char is_init:1;
 } __app_handle_t;
 
@@ -37,6 +45,12 @@ static __app_handle_t __app_handle;
 void dali2_l_app_timer_cb_handler(void)
 {
     dali2_ret_t dali2_ret;
+
+    //! Late timer of resynchronized command
+    if (__app_handle.state != DALI2_L_APP_STATE_BUSY) {
+        return;
+    }
+
     //! Check DTR0 flag
     if (__app_handle.is_dtr) {
         __app_handle.state = DALI2_L_APP_STATE_IDLE;
@@ -44,6 +58,20 @@ void dali2_l_app_timer_cb_handler(void)
             (dali2_ret = dali2_l_app_cmd_execute(__app_handle.evt_data.cmd, &__app_handle.evt_data.cmd_data))) {
             __app_handle.evt_cb(DALI2_L_APP_EVT_FAULT, &__app_handle.evt_data);
         }
+
+        //! Command itself is in progress now, it is done by Session layer event
+        return;
+    }
+
+    //! ENABLE DEVICE TYPE 6 is done, DT6 command goes next
+    if (__app_handle.is_dt6) {
+        __app_handle.is_dt6 = 0;
+        if (DALI2_RET_SUCCESS != dali2_l_ses_exec(__app_handle.dt6_msg, __app_handle.priority,
+                                                  DALI2_L_PHY_FRAME_16BIT_FW, __app_handle.dt6_frame)) {
+            __app_handle.state = DALI2_L_APP_STATE_IDLE;
+            __app_handle.evt_cb(DALI2_L_APP_EVT_FAULT, &__app_handle.evt_data);
+        }
+        return;
     }
 
     switch (__app_handle.evt_data.cmd) {
@@ -66,6 +94,7 @@ static inline void __dali2_l_app_ses_done_query_evt_handler(dali2_l_ses_evt_para
 {
     switch (__app_handle.evt_data.cmd) {
         //! Standard commands
+        case DALI2_L_APP_CMD_QUERY_STATUS:
         case DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_PRESENT:
         case DALI2_L_APP_CMD_QUERY_LAMP_FAILURE:
         case DALI2_L_APP_CMD_QUERY_LAMP_POWER_ON:
@@ -138,7 +167,7 @@ static void __dali2_l_app_ses_evt_handler(DALI2_L_SES_EVT_T evt, dali2_l_ses_evt
         case DALI2_L_SES_EVT_DONE:
             switch (params->msg) {
                 case DALI2_L_SES_SEND:
-                    if (__app_handle.is_dtr) {
+                    if (__app_handle.is_dtr || __app_handle.is_dt6) {
                         dali2_l_bsp_app_timer_start_ms(DALI2_L_SES_SETTLING_TIME_FW_FW_MS_MAX);
                         break;
                     }
@@ -217,13 +246,24 @@ dali2_ret_t dali2_l_app_init(dali2_l_app_evt_func_t cb)
         goto __ret;
     }
 
+    //! Binary logging initialization
+    dali2_log_init();
+
+    //! Bus metrics initialization
+    dali2_metrics_init();
+
+    //! Bus monitor journal initialization
+    dali2_mon_init();
+
     //! Call into Session layer
     dali2_ret = dali2_l_ses_init(__dali2_l_app_ses_evt_handler);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
     __app_handle.state = DALI2_L_APP_STATE_IDLE;
     __app_handle.evt_cb = cb;
+    __app_handle.priority = DALI2_L_SES_PRIORITY_DEFAULT;
     __app_handle.is_dtr = 0;
+    __app_handle.is_dt6 = 0;
     __app_handle.is_init = 1;
 
 __ret:
@@ -251,6 +291,39 @@ __ret:
     return dali2_ret;
 }
 
+unsigned char dali2_l_app_resync(void)
+{
+    unsigned char busy;
+
+    //! Verify state
+    if (!__app_handle.is_init) {
+        return 0;
+    }
+
+    busy = dali2_l_ses_resync();
+    if (__app_handle.state != DALI2_L_APP_STATE_IDLE) {
+        busy |= DALI2_L_APP_RESYNC_APP;
+    }
+
+    //! The next command starts from DTR0 again
+    __app_handle.is_dtr = 0;
+    __app_handle.is_dt6 = 0;
+    __app_handle.state = DALI2_L_APP_STATE_IDLE;
+
+    return busy;
+}
+
+dali2_ret_t dali2_l_app_priority_set(DALI2_L_SES_PRIORITY_T priority)
+{
+    //! Verify parameters
+    if (!DALI2_L_SES_PRIORITY_IS_VALID(priority)) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    __app_handle.priority = priority;
+    return DALI2_RET_SUCCESS;
+}
+
 static inline dali2_ret_t __terminate_execute(unsigned long int *frame, dali2_l_app_cmd_data_t *cmd_data)
 {
     dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
@@ -258,7 +331,7 @@ static inline dali2_ret_t __terminate_execute(unsigned long int *frame, dali2_l_
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_TERMINATE, 0x00);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -270,7 +343,7 @@ static inline dali2_ret_t __dtr0_execute(unsigned long int *frame, dali2_l_app_c
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_DTR0, cmd_data->spec_cmd.dtr0);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -306,7 +379,7 @@ static inline dali2_ret_t __initialise_execute(unsigned long int *frame, dali2_l
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_INITIALISE, initialise_device);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND_TWICE, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND_TWICE, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -318,7 +391,7 @@ static inline dali2_ret_t __randomise_execute(unsigned long int *frame, dali2_l_
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_RANDOMISE, 0x00);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND_TWICE, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND_TWICE, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -330,7 +403,7 @@ static inline dali2_ret_t __compare_execute(unsigned long int *frame, dali2_l_ap
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_COMPARE, 0x00);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_QUERY, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_QUERY, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -342,7 +415,7 @@ static inline dali2_ret_t __withdraw_execute(unsigned long int *frame, dali2_l_a
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_WITHDRAW, 0x00);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -354,7 +427,7 @@ static inline dali2_ret_t __ping_execute(unsigned long int *frame, dali2_l_app_c
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_PING, 0x00);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -366,7 +439,7 @@ static inline dali2_ret_t __searchaddrh_execute(unsigned long int *frame, dali2_
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_SEARCHADDRH, cmd_data->spec_cmd.searchaddress_hml);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -378,7 +451,7 @@ static inline dali2_ret_t __searchaddrm_execute(unsigned long int *frame, dali2_
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_SEARCHADDRM, cmd_data->spec_cmd.searchaddress_hml);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -390,7 +463,7 @@ static inline dali2_ret_t __searchaddrl_execute(unsigned long int *frame, dali2_
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_SEARCHADDRL, cmd_data->spec_cmd.searchaddress_hml);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -404,7 +477,7 @@ static inline dali2_ret_t __program_short_address_execute(unsigned long int *fra
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_PROGRAM_SHORT_ADDRESS, address);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -418,7 +491,7 @@ static inline dali2_ret_t __verify_short_address_execute(unsigned long int *fram
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_VERIFY_SHORT_ADDRESS, address);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_QUERY, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_QUERY, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -430,7 +503,7 @@ static inline dali2_ret_t __query_short_address_execute(unsigned long int *frame
     dali2_ret = dali2_l_pres_16bit_encode(frame, DALI2_L_APP_SPEC_CMD_QUERY_SHORT_ADDRESS, 0x00);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_QUERY, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_QUERY, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -447,7 +520,7 @@ static inline dali2_ret_t __dapc_execute(unsigned long int *frame, dali2_l_app_c
     dali2_ret = dali2_l_pres_16bit_encode(frame, net_byte, cmd_data->std_cmd.data);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, *frame);
 __ret:
     return dali2_ret;
 }
@@ -456,7 +529,7 @@ static inline dali2_ret_t __query_enable_device_type_6_execute(unsigned long int
 {
     dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
 
-    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND_TWICE, DALI2_L_PHY_FRAME_16BIT_FW, DALI2_L_APP_LED_CMD_ENABLE_DEVICE_TYPE_6);
+    dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND_TWICE, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, DALI2_L_APP_LED_CMD_ENABLE_DEVICE_TYPE_6);
     return dali2_ret;
 }
 
@@ -484,6 +557,10 @@ dali2_ret_t dali2_l_app_cmd_execute(DALI2_L_APP_CMD_T cmd, dali2_l_app_cmd_data_
     //! Copy Inputs to internal structure
     __app_handle.evt_data.cmd = cmd;
     memcpy(&__app_handle.evt_data.cmd_data, cmd_data, sizeof(dali2_l_app_cmd_data_t));
+    __app_handle.is_dt6 = 0;
+
+    //! Session layer frames are counted for this command, DTR0 included
+    DALI2_METRICS_CMD_SET(cmd);
 
     switch (cmd) {
         //! ***** Special commands here *****
@@ -972,14 +1049,32 @@ dali2_ret_t dali2_l_app_cmd_execute(DALI2_L_APP_CMD_T cmd, dali2_l_app_cmd_data_
     dali2_ret = dali2_l_pres_16bit_encode(&frame, net_byte, std_cmd);
     if (dali2_ret != DALI2_RET_SUCCESS) goto __ret;
 
-    dali2_ret = dali2_l_ses_exec(session_method, DALI2_L_PHY_FRAME_16BIT_FW, frame);
+    //! Device type is enabled for the next command only, DT6 command goes after it is done
+    if (DALI2_L_APP_CMD_IS_DT6(cmd)) {
+        __app_handle.dt6_msg = session_method;
+        __app_handle.dt6_frame = (unsigned int) frame;
+        __app_handle.is_dt6 = 1;
+        dali2_ret = dali2_l_ses_exec(DALI2_L_SES_SEND, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW,
+                                     DALI2_L_APP_LED_CMD_ENABLE_DEVICE_TYPE_6);
+        if (dali2_ret != DALI2_RET_SUCCESS) {
+            __app_handle.is_dt6 = 0;
+        }
+        goto __ret;
+    }
+
+    dali2_ret = dali2_l_ses_exec(session_method, __app_handle.priority, DALI2_L_PHY_FRAME_16BIT_FW, frame);
 
 __ret:
 
     //! DTR0 trigger
-    if (__app_handle.is_dtr) {
+    if (__app_handle.is_dtr && dali2_ret == DALI2_RET_SUCCESS) {
         cmd_data_dtr0.spec_cmd.dtr0 = cmd_data->std_cmd.data;
         dali2_ret = __dtr0_execute(&frame, &cmd_data_dtr0);
+
+        //! Next attempt starts from DTR0 again
+        if (dali2_ret != DALI2_RET_SUCCESS) {
+            __app_handle.is_dtr = 0;
+        }
     }
 
     if (dali2_ret == DALI2_RET_SUCCESS) {
@@ -116,7 +116,7 @@ typedef enum {
 
     DALI2_L_APP_CMD_DAPC,
 
-    //! LED commands
+    //! LED commands, ENABLE DEVICE TYPE 6 is sent before each of them
     DALI2_L_APP_CMD_REFERENCE_SYSTEM_POWER,
     DALI2_L_APP_CMD_ENABLE_CURRENT_PROTECTOR,
     DALI2_L_APP_CMD_DISABLE_CURRENT_PROTECTOR,
@@ -148,6 +148,10 @@ typedef enum {
     DALI2_L_APP_CMD_UNKNOWN
 } DALI2_L_APP_CMD_T;
 
+//! IEC 62386-207 command, gear accepts it right after ENABLE DEVICE TYPE 6 only
+#define DALI2_L_APP_CMD_IS_DT6(CMD)     ((CMD) >= DALI2_L_APP_CMD_REFERENCE_SYSTEM_POWER && \
+                                         (CMD) < DALI2_L_APP_CMD_ENABLE_DEVICE_TYPE_6)
+
 //! Data for DALI2_L_APP_CMD_INITIALISE
 typedef enum {
     DALI2_APP_CMD_INITIALISE_ADDRESSING_SHORT_ADDRESS,
@@ -326,5 +330,23 @@ dali2_ret_t dali2_l_app_deinit(void);
 
 dali2_ret_t dali2_l_app_cmd_execute(DALI2_L_APP_CMD_T cmd, dali2_l_app_cmd_data_t *cmd_data);
 
+//! Application layer is found busy by resynchronization, @see DALI2_L_SES_RESYNC_SES
+#define DALI2_L_APP_RESYNC_APP                  0x04
+
+/**@brief Resynchronization after lost completion, e.g. missed timer interrupt
+ * @note  Command in progress is dropped without event, lower layers are resynchronized too
+ *
+ * @return DALI2_L_APP_RESYNC_APP and DALI2_L_SES_RESYNC_* flags of layers which were busy
+ */
+unsigned char dali2_l_app_resync(void);
+
+/**@brief Setting multi-master priority of the next commands
+ * @note  DALI2_L_SES_PRIORITY_DEFAULT is used after initialization
+ *
+ * @param[IN] priority - @see DALI2_L_SES_PRIORITY_T
+ * @return @see dali2_ret_t
+ */
+dali2_ret_t dali2_l_app_priority_set(DALI2_L_SES_PRIORITY_T priority);
+
 
 #endif /* DALI2_L_APP_H_ */
@@ -15,6 +15,7 @@
 #include "nrf_drv_timer.h"
 #include "app_timer.h"
 #include "app_error.h"
+#include "app_util_platform.h"
 
 #include "pwr_management.h"
 
@@ -40,6 +41,11 @@ NRF_LOG_MODULE_REGISTER();
 APP_TIMER_DEF(__dali2_l_ses_timer_id);
 APP_TIMER_DEF(__dali2_l_app_timer_id);
 const nrf_drv_timer_t __bsp_phy_timer_us = NRF_DRV_TIMER_INSTANCE(1);
+const nrf_drv_timer_t __bsp_time_us = NRF_DRV_TIMER_INSTANCE(2);
+
+static unsigned int __bsp_time_last_us;
+static unsigned int __bsp_time_acc_us;
+static unsigned int __bsp_time_ms;
 
 static void __dali2_l_bsp_phy_pin_int_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action)
 {
@@ -56,6 +62,17 @@ static void __dali2_l_bsp_phy_timer_int_handler(nrf_timer_event_t event_type, vo
     }
 }
 
+static void __dali2_l_bsp_time_int_handler(nrf_timer_event_t event_type, void *p_context)
+{
+    //! Free-running timer compare is absolute deadline of Physical timer
+    if (event_type == NRF_TIMER_EVENT_COMPARE1) {
+        nrf_drv_timer_compare_int_disable(&__bsp_time_us, NRF_TIMER_CC_CHANNEL1);
+
+        //! Call Physical timer callback
+        dali2_l_phy_timer_cb_handler();
+    }
+}
+
 static void __dali2_l_bsp_ses_timer_int_handler(void * p_context)
 {
     //! Call Session timer callback
@@ -86,6 +103,13 @@ void dali2_l_bsp_init(void)
         .interrupt_priority = NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY,
         .p_context          = NULL
     };
+    nrf_drv_timer_config_t time_cfg = {
+        .frequency          = NRF_TIMER_FREQ_1MHz,
+        .mode               = NRF_TIMER_MODE_TIMER,
+        .bit_width          = NRF_TIMER_BIT_WIDTH_32,
+        .interrupt_priority = NRFX_TIMER_DEFAULT_CONFIG_IRQ_PRIORITY,
+        .p_context          = NULL
+    };
 
     pwr_management_periph_switch(PWR_PERIPH_DALI_PS, PWR_SWITCH_ON);
 
@@ -102,6 +126,15 @@ void dali2_l_bsp_init(void)
     nrf_drv_timer_pause(&__bsp_phy_timer_us);
     nrf_drv_timer_enable(&__bsp_phy_timer_us);
 
+    //! Free-running timer for time measurement
+    err_code = nrf_drv_timer_init(&__bsp_time_us, &time_cfg, __dali2_l_bsp_time_int_handler);
+    APP_ERROR_CHECK(err_code);
+
+    nrf_drv_timer_enable(&__bsp_time_us);
+    __bsp_time_last_us = 0;
+    __bsp_time_acc_us = 0;
+    __bsp_time_ms = 0;
+
     //! Timer for Session layer
     err_code = app_timer_create(&__dali2_l_ses_timer_id,
                                 APP_TIMER_MODE_SINGLE_SHOT,
@@ -122,6 +155,7 @@ void dali2_l_bsp_deinit(void)
 {
     nrf_drv_gpiote_in_event_disable(DALI_L_BSP_RX_PIN);
     nrf_drv_timer_uninit(&__bsp_phy_timer_us);
+    nrf_drv_timer_uninit(&__bsp_time_us);
     return;
 }
 
@@ -150,6 +184,9 @@ void dali2_l_bsp_phy_timer_start_us(unsigned int us)
 {
     unsigned int time_ticks;
 
+    //! Cancel absolute deadline
+    nrf_drv_timer_compare_int_disable(&__bsp_time_us, NRF_TIMER_CC_CHANNEL1);
+
     nrf_drv_timer_pause(&__bsp_phy_timer_us);
     time_ticks = nrf_drv_timer_us_to_ticks(&__bsp_phy_timer_us, us);
     nrf_drv_timer_extended_compare(
@@ -158,6 +195,30 @@ void dali2_l_bsp_phy_timer_start_us(unsigned int us)
     nrfx_timer_resume(&__bsp_phy_timer_us);
 }
 
+/**@brief Timer One-shot start function with absolute deadline
+ *
+ * @param[IN] at_us - @ref dali2_l_bsp_time_us_get() value to fire at
+ * @attention Use dali2_l_phy_timer_handler() inside timer callback
+ */
+void dali2_l_bsp_phy_timer_start_at_us(unsigned int at_us)
+{
+    unsigned int now_us;
+
+    //! Cancel relative timer
+    nrf_drv_timer_pause(&__bsp_phy_timer_us);
+
+    CRITICAL_REGION_ENTER();
+
+    //! Deadline in the past or too close for compare fires at once
+    now_us = dali2_l_bsp_time_us_get();
+    if ((int) (at_us - now_us) < 2) {
+        at_us = now_us + 2;
+    }
+    nrf_drv_timer_compare(&__bsp_time_us, NRF_TIMER_CC_CHANNEL1, at_us, 1);
+
+    CRITICAL_REGION_EXIT();
+}
+
 /**@brief Timer One-shot start function
  *
  * @param[IN] ms - milliseconds for One-shot timer
@@ -169,6 +230,25 @@ void dali2_l_bsp_ses_timer_start_ms(unsigned int ms)
     app_timer_start(__dali2_l_ses_timer_id, APP_TIMER_TICKS(ms), NULL);
 }
 
+/**@brief Timer One-shot start function with microseconds resolution
+ *
+ * @param[IN] us - microseconds for One-shot timer
+ * @attention Use dali2_l_ses_timer_handler() inside timer callback
+ */
+void dali2_l_bsp_ses_timer_start_us(unsigned int us)
+{
+    uint32_t ticks = (uint32_t) ROUNDED_DIV((uint64_t) us * APP_TIMER_CLOCK_FREQ,
+                                            1000000 * (APP_TIMER_CONFIG_RTC_FREQUENCY + 1));
+
+    //! RTC based timer has minimal timeout
+    if (ticks < APP_TIMER_MIN_TIMEOUT_TICKS) {
+        ticks = APP_TIMER_MIN_TIMEOUT_TICKS;
+    }
+
+    app_timer_stop(__dali2_l_ses_timer_id);
+    app_timer_start(__dali2_l_ses_timer_id, ticks, NULL);
+}
+
 /**@brief Timer One-shot start function
  *
  * @param[IN] ms - milliseconds for One-shot timer
@@ -180,6 +260,33 @@ void dali2_l_bsp_app_timer_start_ms(unsigned int ms)
     app_timer_start(__dali2_l_app_timer_id, APP_TIMER_TICKS(ms), NULL);
 }
 
+//! @brief Free-running microseconds time
+unsigned int dali2_l_bsp_time_us_get(void)
+{
+    return nrf_drv_timer_capture(&__bsp_time_us, NRF_TIMER_CC_CHANNEL0);
+}
+
+//! @brief Free-running milliseconds time
+//! @note Must be called at least once per 32-bit microseconds timer period (~71 minutes)
+unsigned int dali2_l_bsp_time_ms_get(void)
+{
+    unsigned int now_us;
+
+    CRITICAL_REGION_ENTER();
+
+    now_us = dali2_l_bsp_time_us_get();
+    __bsp_time_acc_us += now_us - __bsp_time_last_us;
+    __bsp_time_last_us = now_us;
+
+    __bsp_time_ms += __bsp_time_acc_us / 1000;
+    __bsp_time_acc_us %= 1000;
+    now_us = __bsp_time_ms;
+
+    CRITICAL_REGION_EXIT();
+
+    return now_us;
+}
+
 /**@brief Print function
  */
 void dali2_l_bsp_print(const char * _format, ...)
@@ -12,8 +12,25 @@
 #ifndef DALI2_L_BSP_H_
 #define DALI2_L_BSP_H_
 
+//! Enables binary logging, @see dali2_log.h
+//! DALI2_L_BSP_LOG() formats text immediately, do not use it in callback context
 #define DALI2_LOG_EN
 
+//! Diagnostics below are disabled in production build, define them by compiler flags
+//! (-DDALI2_METRICS_EN) for development and host benches. RAM is of default sizes.
+
+//! Enables bus metrics, @see dali2_metrics.h
+//! ~3.3 KB RAM, counters are updated on every Session layer transaction
+//#define DALI2_METRICS_EN
+
+//! Enables Physical layer timing histograms, @see dali2_l_phy_timing_get()
+//! ~4.1 KB RAM of __phy_handle, histograms are updated on every RX edge in interrupt context
+//#define DALI2_L_PHY_TIMING_EN
+
+//! Enables bus monitor frame journal, @see dali2_mon.h
+//! ~1.3 KB RAM, record is stored on every frame in interrupt context
+//#define DALI2_MON_EN
+
 #ifdef DALI2_LOG_EN
 #define DALI2_L_BSP_LOG(...)            dali2_l_bsp_print(__VA_ARGS__)
 #else
@@ -38,6 +55,7 @@ typedef enum {
  * @include TX PIN initialization for @ref dali2_l_bsp_dpin_set()
  * @include RX PIN initialization for @ref dali2_l_bsp_rx_pin_get()
  * @include Enable interrupt on RX PIN
+ * @include Free-running time for @ref dali2_l_bsp_time_us_get()
  */
 void dali2_l_bsp_init(void);
 
@@ -63,6 +81,16 @@ DALI2_L_BSP_DPIN_STATE_T dali2_l_bsp_rx_pin_get(void);
  */
 void dali2_l_bsp_phy_timer_start_us(unsigned int us);
 
+/**@brief Timer One-shot start function with absolute deadline
+ * @note  Deadline is compared with running @ref dali2_l_bsp_time_us_get() counter,
+ *        so start latency is not added up. Deadline in the past fires at once.
+ *        Replaces timer started by @ref dali2_l_bsp_phy_timer_start_us() and vice versa.
+ *
+ * @param[IN] at_us - @ref dali2_l_bsp_time_us_get() value to fire at
+ * @attention Use dali2_l_phy_timer_handler() inside timer callback
+ */
+void dali2_l_bsp_phy_timer_start_at_us(unsigned int at_us);
+
 /**@brief Timer One-shot start function
  *
  * @param[IN] ms - milliseconds for One-shot timer
@@ -70,6 +98,15 @@ void dali2_l_bsp_phy_timer_start_us(unsigned int us);
  */
 void dali2_l_bsp_ses_timer_start_ms(unsigned int ms);
 
+/**@brief Timer One-shot start function with microseconds resolution
+ * @note  Shares the same timer with @ref dali2_l_bsp_ses_timer_start_ms(),
+ *        precision of a few tens of microseconds is enough for priority settling time
+ *
+ * @param[IN] us - microseconds for One-shot timer
+ * @attention Use dali2_l_ses_timer_handler() inside timer callback
+ */
+void dali2_l_bsp_ses_timer_start_us(unsigned int us);
+
 /**@brief Timer One-shot start function
  *
  * @param[IN] ms - milliseconds for One-shot timer
@@ -77,6 +114,19 @@ void dali2_l_bsp_ses_timer_start_ms(unsigned int ms);
  */
 void dali2_l_bsp_app_timer_start_ms(unsigned int ms);
 
+/**@brief Free-running microseconds time
+ *
+ * @return Microseconds counter, wraps around 2^32
+ * @note  Use only differences of two values
+ */
+unsigned int dali2_l_bsp_time_us_get(void);
+
+/**@brief Free-running milliseconds time
+ *
+ * @return Milliseconds since @ref dali2_l_bsp_init(), wraps around 2^32
+ */
+unsigned int dali2_l_bsp_time_ms_get(void);
+
 /**@brief Print function for logging
  */
 void dali2_l_bsp_print(const char * __restrict _format, ...);
@@ -0,0 +1,194 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_l_bsp_host.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host (Linux) BSP layer source file
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#include "dali2_l_phy.h"
+#include "dali2_l_ses.h"
+#include "dali2_l_app.h"
+#include "dali2_l_bsp.h"
+#include "dali2_l_bsp_host.h"
+
+typedef struct {
+    dali2_sim_bus_t *bus;
+
+    int phy_timer_evt;
+    int ses_timer_evt;
+    int app_timer_evt;
+
+    unsigned char print_en:1;
+} dali2_l_bsp_host_handle_t;
+
+static dali2_l_bsp_host_handle_t __bsp_handle = {
+    .phy_timer_evt = DALI2_SIM_SCHED_EVT_INVALID,
+    .ses_timer_evt = DALI2_SIM_SCHED_EVT_INVALID,
+    .app_timer_evt = DALI2_SIM_SCHED_EVT_INVALID,
+    .print_en = 1
+};
+
+static void __dali2_l_bsp_phy_pin_int_handler(void *ctx)
+{
+    //! Interrupt handler reads actual PIN state as hardware does
+    dali2_l_dpin_int_cb_handler(dali2_l_bsp_rx_pin_get());
+}
+
+static void __dali2_l_bsp_edge_handler(void *ctx, DALI2_L_BSP_DPIN_STATE_T level)
+{
+    //! Never call PHY from inside of dali2_l_bsp_tx_pin_set(), defer it as interrupt does
+    dali2_sim_sched_add_in(DALI2_L_BSP_HOST_ISR_LATENCY_US, __dali2_l_bsp_phy_pin_int_handler, NULL);
+}
+
+static void __dali2_l_bsp_phy_timer_int_handler(void *ctx)
+{
+    __bsp_handle.phy_timer_evt = DALI2_SIM_SCHED_EVT_INVALID;
+
+    //! Call Physical timer callback
+    dali2_l_phy_timer_cb_handler();
+}
+
+static void __dali2_l_bsp_ses_timer_int_handler(void *ctx)
+{
+    __bsp_handle.ses_timer_evt = DALI2_SIM_SCHED_EVT_INVALID;
+
+    //! Call Session timer callback
+    dali2_l_ses_timer_cb_handler();
+}
+
+static void __dali2_l_bsp_app_timer_int_handler(void *ctx)
+{
+    __bsp_handle.app_timer_evt = DALI2_SIM_SCHED_EVT_INVALID;
+
+    //! Call Application timer callback
+    dali2_l_app_timer_cb_handler();
+}
+
+void dali2_l_bsp_host_attach(dali2_sim_bus_t *bus)
+{
+    if (__bsp_handle.bus) {
+        dali2_sim_bus_edge_listener_set(__bsp_handle.bus, NULL, NULL);
+    }
+
+    __bsp_handle.bus = bus;
+
+    if (bus) {
+        dali2_sim_bus_edge_listener_set(bus, __dali2_l_bsp_edge_handler, NULL);
+    }
+}
+
+void dali2_l_bsp_host_print_enable(unsigned char enable)
+{
+    __bsp_handle.print_en = enable ? 1 : 0;
+}
+
+//! @brief BSP layer initialization
+void dali2_l_bsp_init(void)
+{
+    dali2_sim_sched_cancel(__bsp_handle.phy_timer_evt);
+    dali2_sim_sched_cancel(__bsp_handle.ses_timer_evt);
+    dali2_sim_sched_cancel(__bsp_handle.app_timer_evt);
+
+    __bsp_handle.phy_timer_evt = DALI2_SIM_SCHED_EVT_INVALID;
+    __bsp_handle.ses_timer_evt = DALI2_SIM_SCHED_EVT_INVALID;
+    __bsp_handle.app_timer_evt = DALI2_SIM_SCHED_EVT_INVALID;
+}
+
+//! @brief BSP layer deinitialization
+void dali2_l_bsp_deinit(void)
+{
+    dali2_sim_sched_cancel(__bsp_handle.phy_timer_evt);
+    __bsp_handle.phy_timer_evt = DALI2_SIM_SCHED_EVT_INVALID;
+
+    //! Release line
+    dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_1);
+}
+
+//! @brief Setting Data PIN state
+void dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_T data)
+{
+    if (__bsp_handle.bus) {
+        dali2_sim_bus_drive(__bsp_handle.bus, DALI2_SIM_BUS_CTRL_DRIVER, data);
+    }
+}
+
+//! @brief Getting Feedback PIN state
+DALI2_L_BSP_DPIN_STATE_T dali2_l_bsp_rx_pin_get(void)
+{
+    if (!__bsp_handle.bus) {
+        return DALI2_L_BSP_DPIN_STATE_1;
+    }
+
+    return dali2_sim_bus_level(__bsp_handle.bus);
+}
+
+void dali2_l_bsp_phy_timer_start_us(unsigned int us)
+{
+    dali2_sim_sched_cancel(__bsp_handle.phy_timer_evt);
+    __bsp_handle.phy_timer_evt = dali2_sim_sched_add_in(us + DALI2_L_BSP_HOST_TIMER_LATENCY_US,
+                                                        __dali2_l_bsp_phy_timer_int_handler, NULL);
+}
+
+void dali2_l_bsp_phy_timer_start_at_us(unsigned int at_us)
+{
+    int delay_us = (int) (at_us - dali2_l_bsp_time_us_get());
+
+    dali2_sim_sched_cancel(__bsp_handle.phy_timer_evt);
+    __bsp_handle.phy_timer_evt = dali2_sim_sched_add_in((delay_us > 0) ? (dali2_sim_time_t) delay_us : 0,
+                                                        __dali2_l_bsp_phy_timer_int_handler, NULL);
+}
+
+void dali2_l_bsp_ses_timer_start_ms(unsigned int ms)
+{
+    dali2_sim_sched_cancel(__bsp_handle.ses_timer_evt);
+    __bsp_handle.ses_timer_evt = dali2_sim_sched_add_in((dali2_sim_time_t) ms * 1000,
+                                                        __dali2_l_bsp_ses_timer_int_handler, NULL);
+}
+
+void dali2_l_bsp_ses_timer_start_us(unsigned int us)
+{
+    dali2_sim_sched_cancel(__bsp_handle.ses_timer_evt);
+    __bsp_handle.ses_timer_evt = dali2_sim_sched_add_in((dali2_sim_time_t) us,
+                                                        __dali2_l_bsp_ses_timer_int_handler, NULL);
+}
+
+void dali2_l_bsp_app_timer_start_ms(unsigned int ms)
+{
+    dali2_sim_sched_cancel(__bsp_handle.app_timer_evt);
+    __bsp_handle.app_timer_evt = dali2_sim_sched_add_in((dali2_sim_time_t) ms * 1000,
+                                                        __dali2_l_bsp_app_timer_int_handler, NULL);
+}
+
+unsigned int dali2_l_bsp_time_us_get(void)
+{
+    return (unsigned int) dali2_sim_sched_now();
+}
+
+unsigned int dali2_l_bsp_time_ms_get(void)
+{
+    return (unsigned int) (dali2_sim_sched_now() / 1000);
+}
+
+void dali2_l_bsp_print(const char * _format, ...)
+{
+    va_list args;
+
+    if (!__bsp_handle.print_en) {
+        return;
+    }
+
+    printf("[%10.3f ms] ", (double) dali2_sim_sched_now() / 1000.0);
+
+    va_start(args, _format);
+    vprintf(_format, args);
+    va_end(args);
+
+    printf("\n");
+}
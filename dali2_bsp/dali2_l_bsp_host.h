@@ -0,0 +1,46 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_l_bsp_host.h
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host (Linux) BSP layer header file
+ *
+ * @details Virtual time BSP for host builds. Build dali2_l_bsp_host.c
+ *          instead of dali2_l_bsp.c together with dali2_sim/ sources.
+ *          TX/RX pins are connected to simulated bus, @see dali2_sim_bus.h,
+ *          timers are events of dali2_sim_sched.h scheduler.
+ */
+#ifndef DALI2_L_BSP_HOST_H_
+#define DALI2_L_BSP_HOST_H_
+
+#include "dali2_l_bsp.h"
+#include "dali2_sim_bus.h"
+
+//! Delay between line edge and RX PIN interrupt handler
+#ifndef DALI2_L_BSP_HOST_ISR_LATENCY_US
+#define DALI2_L_BSP_HOST_ISR_LATENCY_US     0
+#endif
+
+//! Start latency of relative Physical timer, it is added up on every restart.
+//! Absolute deadline timer has no start latency.
+#ifndef DALI2_L_BSP_HOST_TIMER_LATENCY_US
+#define DALI2_L_BSP_HOST_TIMER_LATENCY_US   0
+#endif
+
+/**@brief Connecting BSP pins to the simulated bus
+ * @note  Call it before dali2_l_app_init()
+ *
+ * @param[IN] bus - simulated bus, NULL for disconnection
+ */
+void dali2_l_bsp_host_attach(dali2_sim_bus_t *bus);
+
+/**@brief Enabling print output
+ *
+ * @param[IN] enable - 0 suppresses dali2_l_bsp_print() output
+ */
+void dali2_l_bsp_host_print_enable(unsigned char enable);
+
+#endif /* DALI2_L_BSP_HOST_H_ */
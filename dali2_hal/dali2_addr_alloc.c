@@ -17,6 +17,29 @@ static DALI2_HAL_ADDR_ALLOC_METHOD_T __addr_alloc_method = DALI2_HAL_ADDR_ALLOC_
 static unsigned char __addr_list[DALI2_HAL_ADDR_LIST_SIZE];
 static unsigned int __addr_count;
 
+//! Random address search, IEC 62386-102 Annex A
+#define DALI2_HAL_ADDR_SEARCH_MAX               0xFFFFFFUL
+#define DALI2_HAL_ADDR_SEARCH_BYTES             3
+#define DALI2_HAL_ADDR_SEARCH_SHIFT(IDX)        (16 - 8 * (IDX))
+#define DALI2_HAL_ADDR_SEARCH_BYTE(ADDR, IDX)   ((unsigned char) ((ADDR) >> DALI2_HAL_ADDR_SEARCH_SHIFT(IDX)))
+#define DALI2_HAL_ADDR_SEARCH_BYTE_MASK(IDX)    (0xFFUL << DALI2_HAL_ADDR_SEARCH_SHIFT(IDX))
+#define DALI2_HAL_ADDR_RANDOMISE_MS             100
+
+typedef struct {
+    unsigned long int low;              //! The lowest random address is not lower
+    unsigned long int high;             //! The lowest random address is not higher
+    unsigned long int addr;             //! Compared search address
+    unsigned long int set_addr;         //! Search address of gear
+    unsigned char set_mask;             //! Bytes of search address set in gear
+    unsigned char is_any;               //! Some gear is not withdrawn yet
+} dali2_hal_addr_search_t;
+
+static const DALI2_L_APP_CMD_T __search_cmd[DALI2_HAL_ADDR_SEARCH_BYTES] = {
+    DALI2_L_APP_CMD_SEARCHADDRH, DALI2_L_APP_CMD_SEARCHADDRM, DALI2_L_APP_CMD_SEARCHADDRL
+};
+
+static dali2_hal_addr_search_t __search;
+
 static inline void __single_addr_alloc_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data)
 {
     dali2_l_app_cmd_data_t instr_data;
@@ -29,7 +52,7 @@ static inline void __single_addr_alloc_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_a
                 instr_data.std_cmd.net.addr_byte = __addr_list[__addr_count];
                 instr_data.std_cmd.data = DALI2_L_APP_DTR0_TO_SET_SHORT_ADDRESS(__addr_list[__addr_count]);
                 dali2_hal_queue_push(DALI2_L_APP_CMD_SET_SHORT_ADDRESS, &instr_data);
-            } else {
+            } else if (dali2_hal_retry(DALI2_HAL_RETRY_STEP_SEND, evt_data->cmd) == DALI2_HAL_RETRY_REPEAT) {
                 //! REPEAT: Reset
                 instr_data.std_cmd.net.method = DALI2_L_NET_METHOD_BROADCAST;
                 instr_data.std_cmd.net.addr_byte = __addr_list[__addr_count];
@@ -43,7 +66,7 @@ static inline void __single_addr_alloc_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_a
                 instr_data.std_cmd.net.method = DALI2_L_NET_METHOD_SHORT_ADDRESSING;
                 instr_data.std_cmd.net.addr_byte = __addr_list[__addr_count];
                 dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_CONTENT_DTR0, &instr_data);
-            } else {
+            } else if (dali2_hal_retry(DALI2_HAL_RETRY_STEP_SEND, evt_data->cmd) == DALI2_HAL_RETRY_REPEAT) {
                 //! REPEAT: Assign single address
                 instr_data.std_cmd.net.method = DALI2_L_NET_METHOD_BROADCAST;
                 instr_data.std_cmd.net.addr_byte = __addr_list[__addr_count];
@@ -61,32 +84,136 @@ static inline void __single_addr_alloc_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_a
                 //! Free mutex
                 dali2_hal_mtx_give();
             } else {
+                switch (dali2_hal_retry(DALI2_HAL_RETRY_STEP_READ(evt), evt_data->cmd)) {
+                    case DALI2_HAL_RETRY_REREAD:
+                        //! Re-read before re-write
+                        instr_data.std_cmd.net.method = DALI2_L_NET_METHOD_SHORT_ADDRESSING;
+                        instr_data.std_cmd.net.addr_byte = __addr_list[__addr_count];
+                        dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_CONTENT_DTR0, &instr_data);
+                        break;
+
+                    case DALI2_HAL_RETRY_REPEAT:
+                        //! REPEAT: Reset
+                        instr_data.std_cmd.net.method = DALI2_L_NET_METHOD_BROADCAST;
+                        instr_data.std_cmd.net.addr_byte = __addr_list[__addr_count];
+                        dali2_hal_queue_push(DALI2_L_APP_CMD_RESET, &instr_data);
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+            break;
+
+        default:
+            if (dali2_hal_retry(DALI2_HAL_RETRY_STEP_SEND, evt_data->cmd) == DALI2_HAL_RETRY_REPEAT) {
                 //! REPEAT: Reset
                 instr_data.std_cmd.net.method = DALI2_L_NET_METHOD_BROADCAST;
                 instr_data.std_cmd.net.addr_byte = __addr_list[__addr_count];
                 dali2_hal_queue_push(DALI2_L_APP_CMD_RESET, &instr_data);
             }
             break;
+    }
+}
 
-        default:
-            //! REPEAT: Reset
-            instr_data.std_cmd.net.method = DALI2_L_NET_METHOD_BROADCAST;
-            instr_data.std_cmd.net.addr_byte = __addr_list[__addr_count];
-            dali2_hal_queue_push(DALI2_L_APP_CMD_RESET, &instr_data);
+static inline void __random_addr_terminate(void)
+{
+    dali2_l_app_cmd_data_t instr_data;
+
+    //! Leave INITIALISE state of the rest gear [g]
+    dali2_hal_queue_push(DALI2_L_APP_CMD_TERMINATE, &instr_data);
+}
+
+static inline void __random_search_start(void)
+{
+    //! The lowest random address of gear still in INITIALISE state is searched from the last found one
+    __search.is_any = 0;
+    __search.high = DALI2_HAL_ADDR_SEARCH_MAX;
+}
+
+static void __random_search_push(void)
+{
+    dali2_l_app_cmd_data_t instr_data;
+    unsigned long int addr;
+    unsigned char i;
+
+    if (!__search.is_any) {
+        //! Is any gear left?
+        addr = DALI2_HAL_ADDR_SEARCH_MAX;
+    } else if (__search.low < __search.high) {
+        //! Binary search of the lowest random address
+        addr = __search.low + (__search.high - __search.low) / 2;
+    } else {
+        //! Found gear is the only one selected
+        addr = __search.low;
+    }
+    __search.addr = addr;
+
+    //! Gear keeps search address, changed bytes only are sent [c]
+    for (i = 0; i < DALI2_HAL_ADDR_SEARCH_BYTES; i++) {
+        if (!(__search.set_mask & (1 << i)) ||
+            DALI2_HAL_ADDR_SEARCH_BYTE(__search.set_addr, i) != DALI2_HAL_ADDR_SEARCH_BYTE(addr, i)) {
+            instr_data.spec_cmd.searchaddress_hml = DALI2_HAL_ADDR_SEARCH_BYTE(addr, i);
+            dali2_hal_queue_push(__search_cmd[i], &instr_data);
+            return;
+        }
+    }
+
+    if (__search.is_any && __search.low == __search.high) {
+        //! Program this short address [d]
+        instr_data.spec_cmd.program_short_address = __addr_list[__addr_count];
+        dali2_hal_queue_push(DALI2_L_APP_CMD_PROGRAM_SHORT_ADDRESS, &instr_data);
+    } else {
+        //! Is any random address lower or equal to search address?
+        dali2_hal_queue_push(DALI2_L_APP_CMD_COMPARE, &instr_data);
+    }
+}
+
+static inline void __random_search_set(DALI2_L_APP_CMD_T cmd, unsigned char addr_byte)
+{
+    unsigned char i;
+
+    for (i = 0; i < DALI2_HAL_ADDR_SEARCH_BYTES; i++) {
+        if (__search_cmd[i] == cmd) {
+            __search.set_addr &= ~DALI2_HAL_ADDR_SEARCH_BYTE_MASK(i);
+            __search.set_addr |= (unsigned long int) addr_byte << DALI2_HAL_ADDR_SEARCH_SHIFT(i);
+            __search.set_mask |= 1 << i;
             break;
+        }
+    }
+}
+
+static inline void __random_search_compared(unsigned char is_yes)
+{
+    if (!__search.is_any) {
+        if (!is_yes) {
+            //! Every gear is withdrawn
+            __random_addr_terminate();
+            return;
+        }
+        __search.is_any = 1;
+    } else if (is_yes) {
+        __search.high = __search.addr;
+    } else {
+        __search.low = __search.addr + 1;
     }
+
+    __random_search_push();
 }
 
 static inline void __random_addr_prepare_next(void)
 {
-    if (__addr_count < DALI2_L_NET_ADDR_SHORT_MAX) {
+    if (__addr_count < DALI2_L_NET_ADDR_SHORT_MAX - 1 &&
+        __addr_list[__addr_count] < DALI2_L_NET_ADDR_SHORT_MAX - 1) {
         __addr_count++;
         __addr_list[__addr_count] = __addr_list[__addr_count - 1] + 1;
-    } else {    //! Critical state. Terminate address allocation immediately.
-        __addr_alloc_method = DALI2_HAL_ADDR_ALLOC_METHOD_UNKNOWN;
 
-        //! Free mutex
-        dali2_hal_mtx_give();
+        //!  Search Next Low Address [c]
+        __random_search_start();
+        __random_search_push();
+    } else {    //! Critical state. Short addresses are over, terminate address allocation immediately.
+        __addr_count++;
+        __random_addr_terminate();
     }
 }
 
@@ -94,44 +221,56 @@ static inline void __random_addr_alloc_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_a
 {
     dali2_l_app_cmd_data_t instr_data;
 
-    if (evt != DALI2_L_APP_EVT_SUCCESS) {
-        if (evt_data->cmd == DALI2_L_APP_CMD_COMPARE) {
-            //! Prepare next address
-            __random_addr_prepare_next();
+    //! No answer is "no", violated backward frame is several "yes" answers
+    if (evt_data->cmd == DALI2_L_APP_CMD_COMPARE) {
+        __random_search_compared((evt != DALI2_L_APP_EVT_TIMEOUT) ? 1 : 0);
+        return;
+    }
 
-            //! Identification forced. Search Next Low Address [c]
-            instr_data.spec_cmd.searchaddress_hml = __addr_list[__addr_count];
-            dali2_hal_queue_push(DALI2_L_APP_CMD_SEARCHADDRL, &instr_data);
-        } else {
-            //! Initialization failed
-            //! Give mutex
-            dali2_hal_mtx_give();
-            return;
+    if (evt != DALI2_L_APP_EVT_SUCCESS) {
+        switch (dali2_hal_retry((evt_data->cmd == DALI2_L_APP_CMD_VERIFY_SHORT_ADDRESS) ?
+                                DALI2_HAL_RETRY_STEP_READ(evt) : DALI2_HAL_RETRY_STEP_SEND, evt_data->cmd)) {
+            case DALI2_HAL_RETRY_REPEAT:
+                if (evt_data->cmd == DALI2_L_APP_CMD_VERIFY_SHORT_ADDRESS) {
+                    //! REPEAT: Program short address
+                    instr_data.spec_cmd.program_short_address = __addr_list[__addr_count];
+                    dali2_hal_queue_push(DALI2_L_APP_CMD_PROGRAM_SHORT_ADDRESS, &instr_data);
+                } else {
+                    dali2_hal_queue_push(evt_data->cmd, &evt_data->cmd_data);
+                }
+                break;
+
+            case DALI2_HAL_RETRY_REREAD:
+                dali2_hal_queue_push(evt_data->cmd, &evt_data->cmd_data);
+                break;
+
+            default:
+                break;
         }
+        return;
     }
 
     switch (evt_data->cmd) {
         case DALI2_L_APP_CMD_INITIALISE:
             //! Initialization opened. RANDOMISE addresses [b]
-            __addr_list[__addr_count] = evt_data->cmd_data.spec_cmd.initialise.addr;
             dali2_hal_queue_push(DALI2_L_APP_CMD_RANDOMISE, &instr_data);
             break;
 
         case DALI2_L_APP_CMD_RANDOMISE:
-            //! RANDOMISE completed. Search Low Address [c]
-            instr_data.spec_cmd.searchaddress_hml = __addr_list[__addr_count];
-            dali2_hal_queue_push(DALI2_L_APP_CMD_SEARCHADDRL, &instr_data);
+            //! Gear generates random address in 100 ms. Search Low Address [c]
+            dali2_hal_queue_hold(DALI2_HAL_ADDR_RANDOMISE_MS);
+            __search.low = 0;
+            __search.set_mask = 0;
+            __random_search_start();
+            __random_search_push();
             break;
 
+        case DALI2_L_APP_CMD_SEARCHADDRH:
+        case DALI2_L_APP_CMD_SEARCHADDRM:
         case DALI2_L_APP_CMD_SEARCHADDRL:
-            //! Search address completed. COMPARE address [c]
-            dali2_hal_queue_push(DALI2_L_APP_CMD_COMPARE, &instr_data);
-            break;
-
-        case DALI2_L_APP_CMD_COMPARE:
-            //! COMPARE is found address. Program this short address [d]
-            instr_data.spec_cmd.program_short_address = __addr_list[__addr_count];
-            dali2_hal_queue_push(DALI2_L_APP_CMD_PROGRAM_SHORT_ADDRESS, &instr_data);
+            //! Search address byte is set, the next one or COMPARE [c]
+            __random_search_set(evt_data->cmd, evt_data->cmd_data.spec_cmd.searchaddress_hml);
+            __random_search_push();
             break;
 
         case DALI2_L_APP_CMD_PROGRAM_SHORT_ADDRESS:
@@ -155,10 +294,14 @@ static inline void __random_addr_alloc_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_a
         case DALI2_L_APP_CMD_WITHDRAW:
             //! Prepare next address
             __random_addr_prepare_next();
+            break;
 
-            //!  Search Next Low Address [c]
-            instr_data.spec_cmd.searchaddress_hml = __addr_list[__addr_count];
-            dali2_hal_queue_push(DALI2_L_APP_CMD_SEARCHADDRL, &instr_data);
+        case DALI2_L_APP_CMD_TERMINATE:
+            //! Random address allocation completed!
+            __addr_alloc_method = DALI2_HAL_ADDR_ALLOC_METHOD_UNKNOWN;
+
+            //! Free mutex
+            dali2_hal_mtx_give();
             break;
 
         default:
@@ -211,7 +354,6 @@ dali2_ret_t dali2_hal_addr_alloc(DALI2_HAL_ADDR_ALLOC_METHOD_T method, dali2_hal
             dali2_ret = dali2_hal_queue_push(DALI2_L_APP_CMD_RESET, &instr_data);
             break;
 
-            //! TODO: Random address allocation still not tested!
         case DALI2_HAL_ADDR_ALLOC_METHOD_RANDOM:
             //! Internal data initialization
             __addr_count = 0;
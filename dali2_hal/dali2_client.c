@@ -0,0 +1,388 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_client.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL bus sharing between clients source file
+ *
+ * @details Every client queues own jobs. Busy clients share the bus by start-time
+ *          fair queuing: job is tagged on submission by predicted bus time divided
+ *          by weight of the client, the job of the least finish tag goes first, so
+ *          client submitting more often waits for its own tags. Tags of queued jobs
+ *          are corrected by real bus time of finished job. Token bucket of the
+ *          client is charged by time of holding HAL by its jobs, client is skipped
+ *          while the bucket is empty and the debt of long job is paid by refill.
+ *          Client job is not preempted by job of another client, otherwise busy
+ *          interactive client would suspend background job of other client forever.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+#include "dali2_log.h"
+
+typedef struct {
+    dali2_hal_client_req_t req;
+    unsigned int start_tag;
+    unsigned int finish_tag;
+} dali2_hal_client_job_t;
+
+typedef struct {
+    dali2_hal_client_cfg_t cfg;
+    dali2_hal_client_job_t queue[DALI2_HAL_CLIENT_QUEUE];
+    unsigned char head;
+    unsigned char count;
+    unsigned int finish_tag;            //! Of the last queued job
+    int tokens_us;
+    unsigned int refill_ms;
+    unsigned char is_throttled;
+    unsigned char is_refused;           //! Dimmer is not ready, the client waits for the end of a job
+    dali2_hal_client_stats_t stats;
+} dali2_hal_client_t;
+
+//! Started job of client
+typedef struct {
+    unsigned char client;               //! DALI2_HAL_CLIENT_COUNT if none
+    unsigned int start_ms;
+    unsigned int tag_us;                //! Predicted bus time by weight
+    dali2_hal_done_t done;
+} dali2_hal_client_run_t;
+
+//! Internal handle type
+typedef struct {
+    dali2_hal_client_t client[DALI2_HAL_CLIENT_COUNT];
+    unsigned char count;
+    unsigned int vtime;                 //! Start tag of the last started job
+    dali2_hal_client_run_t run[DALI2_HAL_EVT_FREE];
+} dali2_hal_client_handle_t;
+
+static dali2_hal_client_handle_t __client_handle;
+
+static inline unsigned char __dali2_hal_client_is_before(unsigned int tag, unsigned int other_tag)
+{
+    return ((int) (tag - other_tag) < 0) ? 1 : 0;
+}
+
+//! Rate is bus time per second, so bus microseconds are granted per millisecond
+static void __dali2_hal_client_refill(dali2_hal_client_t *client, unsigned int now_ms)
+{
+    unsigned int elapsed_ms = now_ms - client->refill_ms;
+    int bucket_us = (int) (client->cfg.burst_ms * 1000);
+
+    client->refill_ms = now_ms;
+
+    if (!client->cfg.rate_ms || client->tokens_us >= bucket_us) {
+        return;
+    }
+
+    if (elapsed_ms >= (unsigned int) (bucket_us - client->tokens_us) / client->cfg.rate_ms) {
+        client->tokens_us = bucket_us;
+    } else {
+        client->tokens_us += (int) (elapsed_ms * client->cfg.rate_ms);
+    }
+}
+
+/**@brief Charging client by bus time of its finished job
+ *
+ * @param[IN] client - client
+ * @param[IN] elapsed_ms - time of holding HAL
+ * @param[IN] tag_us - predicted bus time of the job by weight
+ */
+static void __dali2_hal_client_charge(dali2_hal_client_t *client, unsigned int elapsed_ms, unsigned int tag_us)
+{
+    unsigned int delta;
+    unsigned int i;
+
+    client->stats.bus_ms += elapsed_ms;
+    if (client->cfg.rate_ms) {
+        client->tokens_us -= (int) (elapsed_ms * 1000);
+    }
+
+    //! Queued jobs of the client follow its real bus time, not the predicted one
+    delta = elapsed_ms * 1000 / client->cfg.weight - tag_us;
+    client->finish_tag += delta;
+    for (i = 0; i < client->count; i++) {
+        client->queue[(client->head + i) % DALI2_HAL_CLIENT_QUEUE].start_tag += delta;
+        client->queue[(client->head + i) % DALI2_HAL_CLIENT_QUEUE].finish_tag += delta;
+    }
+}
+
+//! Running or suspended job of any client
+static unsigned char __dali2_hal_client_is_running(void)
+{
+    unsigned int i;
+
+    for (i = 0; i < DALI2_HAL_EVT_FREE; i++) {
+        if (__client_handle.run[i].client < DALI2_HAL_CLIENT_COUNT) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void __dali2_hal_client_end(DALI2_HAL_EVT_T evt, dali2_ret_t ret)
+{
+    dali2_hal_client_run_t *run = &__client_handle.run[evt];
+    dali2_hal_client_t *client = &__client_handle.client[run->client];
+    unsigned int elapsed_ms = dali2_l_bsp_time_ms_get() - run->start_ms;
+    unsigned int i;
+
+    __dali2_hal_client_charge(client, elapsed_ms, run->tag_us);
+
+    if (ret != DALI2_RET_SUCCESS) {
+        client->stats.failed++;
+    }
+    run->client = DALI2_HAL_CLIENT_COUNT;
+
+    //! Suspended job is not charged by the job which has preempted it
+    for (i = 0; i < DALI2_HAL_EVT_FREE; i++) {
+        if (__client_handle.run[i].client < DALI2_HAL_CLIENT_COUNT && dali2_hal_mtx_suspended() == (DALI2_HAL_EVT_T) i) {
+            __client_handle.run[i].start_ms += elapsed_ms;
+        }
+    }
+}
+
+void dali2_hal_client_init(void)
+{
+    unsigned int i;
+
+    memset(&__client_handle, 0x00, sizeof(__client_handle));
+    for (i = 0; i < DALI2_HAL_EVT_FREE; i++) {
+        __client_handle.run[i].client = DALI2_HAL_CLIENT_COUNT;
+    }
+}
+
+dali2_ret_t dali2_hal_client_register(unsigned char *client, const dali2_hal_client_cfg_t *cfg)
+{
+    dali2_hal_client_t *new_client;
+
+    //! Verify parameters
+    if (!client || !cfg || !cfg->weight || (cfg->rate_ms && !cfg->burst_ms)) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    if (__client_handle.count >= DALI2_HAL_CLIENT_COUNT) {
+        return DALI2_RET_BUSY;
+    }
+
+    new_client = &__client_handle.client[__client_handle.count];
+    memset(new_client, 0x00, sizeof(dali2_hal_client_t));
+    memcpy(&new_client->cfg, cfg, sizeof(dali2_hal_client_cfg_t));
+
+    //! New client starts with full bucket
+    new_client->tokens_us = (int) (cfg->burst_ms * 1000);
+    new_client->refill_ms = dali2_l_bsp_time_ms_get();
+    new_client->finish_tag = __client_handle.vtime;
+
+    *client = __client_handle.count++;
+
+    return DALI2_RET_SUCCESS;
+}
+
+dali2_ret_t dali2_hal_client_submit(unsigned char client, dali2_hal_client_req_t *req)
+{
+    dali2_hal_client_t *queue_client;
+    dali2_hal_client_job_t *job;
+
+    //! Verify parameters
+    if (client >= __client_handle.count || !req || req->job >= DALI2_HAL_JOB_COUNT) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    queue_client = &__client_handle.client[client];
+    queue_client->stats.submitted++;
+
+    if (queue_client->count >= DALI2_HAL_CLIENT_QUEUE) {
+        DALI2_LOG2(HAL_CLIENT_FULL, client, req->job);
+        queue_client->stats.dropped++;
+        return DALI2_RET_BUSY;
+    }
+
+    job = &queue_client->queue[(queue_client->head + queue_client->count) % DALI2_HAL_CLIENT_QUEUE];
+    memcpy(&job->req, req, sizeof(dali2_hal_client_req_t));
+
+    //! Idle client does not save up its share, it starts from virtual time now
+    job->start_tag = __dali2_hal_client_is_before(queue_client->finish_tag, __client_handle.vtime) ?
+                     __client_handle.vtime : queue_client->finish_tag;
+    job->finish_tag = job->start_tag + dali2_hal_cost_job_us(req->job, &req->node) / queue_client->cfg.weight;
+    queue_client->finish_tag = job->finish_tag;
+    queue_client->count++;
+    dali2_hal_wake();
+
+    return DALI2_RET_SUCCESS;
+}
+
+void dali2_hal_client_poll(void)
+{
+    unsigned int now_ms = dali2_l_bsp_time_ms_get();
+    dali2_hal_client_t *client, *next;
+    dali2_hal_client_job_t *job;
+    unsigned int tried = 0;
+    unsigned int tag_us;
+    DALI2_HAL_EVT_T evt;
+    dali2_ret_t ret;
+    unsigned int i;
+
+    //! Job has ended without report, e.g. queue fault
+    for (i = 0; i < DALI2_HAL_EVT_FREE; i++) {
+        if (__client_handle.run[i].client < DALI2_HAL_CLIENT_COUNT &&
+            dali2_hal_mtx_check() != (DALI2_HAL_EVT_T) i && dali2_hal_mtx_suspended() != (DALI2_HAL_EVT_T) i) {
+            __dali2_hal_client_end((DALI2_HAL_EVT_T) i, DALI2_RET_INTERNAL_ERROR);
+            dali2_hal_done_call(&__client_handle.run[i].done, (DALI2_HAL_EVT_T) i, DALI2_RET_INTERNAL_ERROR);
+        }
+    }
+
+    for (i = 0; i < __client_handle.count; i++) {
+        client = &__client_handle.client[i];
+        __dali2_hal_client_refill(client, now_ms);
+
+        if (!client->count) {
+            client->is_throttled = 0;
+        } else if (client->cfg.rate_ms && client->tokens_us <= 0) {
+            if (!client->is_throttled) {
+                client->is_throttled = 1;
+                client->stats.throttled++;
+                DALI2_LOG2(HAL_CLIENT_THROTTLE, i, (unsigned int) (-client->tokens_us) / 1000);
+            }
+            tried |= 1 << i;
+        } else {
+            client->is_throttled = 0;
+        }
+    }
+
+    //! Clients share the bus job by job, the next job is started once the running one ends
+    if (__dali2_hal_client_is_running()) {
+        return;
+    }
+
+    //! Client which cannot start its job now gives way to the next one
+    for (;;) {
+        next = NULL;
+        for (i = 0; i < __client_handle.count; i++) {
+            client = &__client_handle.client[i];
+            if (!client->count || (tried & (1 << i))) {
+                continue;
+            }
+
+            if (!next || __dali2_hal_client_is_before(client->queue[client->head].finish_tag,
+                                                      next->queue[next->head].finish_tag)) {
+                next = client;
+            }
+        }
+
+        if (!next) {
+            return;
+        }
+        tried |= 1 << (next - __client_handle.client);
+
+        job = &next->queue[next->head];
+        evt = DALI2_HAL_JOB_EVT(job->req.job);
+        if (!dali2_hal_mtx_is_takeable(evt)) {
+            continue;
+        }
+
+        ret = dali2_hal_job_start(job->req.job, &job->req.node, &job->req.data);
+        if (ret == DALI2_RET_BUSY) {
+            //! Dimmer is not configured yet or HAL is busy, the job keeps its turn
+            next->is_refused = 1;
+            continue;
+        }
+
+        __client_handle.vtime = job->start_tag;
+        tag_us = job->finish_tag - job->start_tag;
+        next->stats.started++;
+        next->head = (next->head + 1) % DALI2_HAL_CLIENT_QUEUE;
+        next->count--;
+
+        if (ret == DALI2_RET_SUCCESS && dali2_hal_mtx_check() == evt) {
+            __client_handle.run[evt].client = (unsigned char) (next - __client_handle.client);
+            __client_handle.run[evt].start_ms = now_ms;
+            __client_handle.run[evt].tag_us = tag_us;
+            memcpy(&__client_handle.run[evt].done, &job->req.done, sizeof(dali2_hal_done_t));
+            dali2_hal_done_attach(evt, &job->req.done);
+            return;
+        }
+
+        //! Answered from cache, gear is quarantined or the job has not started, no bus time
+        if (ret != DALI2_RET_SUCCESS) {
+            next->stats.failed++;
+        }
+        __dali2_hal_client_charge(next, 0, tag_us);
+        dali2_hal_done_call(&job->req.done, evt, ret);
+        return;
+    }
+}
+
+void dali2_hal_client_job_end(DALI2_HAL_EVT_T evt, dali2_ret_t ret)
+{
+    unsigned int i;
+
+    //! Dimmer may be ready now
+    for (i = 0; i < __client_handle.count; i++) {
+        __client_handle.client[i].is_refused = 0;
+    }
+
+    if (evt < DALI2_HAL_EVT_FREE && __client_handle.run[evt].client < DALI2_HAL_CLIENT_COUNT) {
+        __dali2_hal_client_end(evt, ret);
+    }
+}
+
+unsigned int dali2_hal_client_idle_ms(void)
+{
+    unsigned int now_ms = dali2_l_bsp_time_ms_get();
+    unsigned int idle_ms = DALI2_HAL_IDLE_MAX_MS;
+    unsigned int refill_ms;
+    dali2_hal_client_t *client;
+    DALI2_HAL_EVT_T evt;
+    unsigned int i;
+
+    //! End of running client job is reported by the bus
+    if (__dali2_hal_client_is_running()) {
+        return idle_ms;
+    }
+
+    for (i = 0; i < __client_handle.count; i++) {
+        client = &__client_handle.client[i];
+        if (!client->count) {
+            continue;
+        }
+
+        //! Throttled client waits for the refill of its bucket
+        if (client->cfg.rate_ms && client->tokens_us <= 0) {
+            refill_ms = (unsigned int) -client->tokens_us / client->cfg.rate_ms + 1;
+            if (now_ms - client->refill_ms < refill_ms) {
+                refill_ms -= now_ms - client->refill_ms;
+                if (refill_ms < idle_ms) {
+                    idle_ms = refill_ms;
+                }
+                continue;
+            }
+        }
+
+        evt = DALI2_HAL_JOB_EVT(client->queue[client->head].req.job);
+        if (!client->is_refused && dali2_hal_mtx_is_takeable(evt)) {
+            return 0;
+        }
+    }
+
+    return idle_ms;
+}
+
+dali2_ret_t dali2_hal_client_stats_get(dali2_hal_client_stats_t *stats, unsigned char client)
+{
+    //! Verify parameters
+    if (!stats || client >= __client_handle.count) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    memcpy(stats, &__client_handle.client[client].stats, sizeof(dali2_hal_client_stats_t));
+    stats->tokens_ms = __client_handle.client[client].tokens_us / 1000;
+    stats->queued = __client_handle.client[client].count;
+
+    return DALI2_RET_SUCCESS;
+}
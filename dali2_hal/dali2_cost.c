@@ -0,0 +1,463 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_cost.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL bus time cost model source file
+ *
+ * @details Bus time of command is built from Physical and Session layer timing:
+ *          priority settling up to the frame, 16-bit forward frame, the second
+ *          frame of send-twice, DTR0 prefix, reply window and backward frame of
+ *          query, settling time of Application layer after configuration command and
+ *          level polling up to the end of fade known by dimmer shadow state.
+ *          Line idle time left by the previous command counts to settling.
+ *          Query is charged by learned share of no-replies: Yes/No query answered
+ *          "No" waits whole reply window. Job is the nominal command chain of its
+ *          dispatcher, fresh cached answers and quarantined gear take no bus time.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+
+//! Frame on the line: start bit, data bits and stop condition
+#define DALI2_HAL_COST_FRAME_US(BITS)       (((BITS) + 1) * DALI2_L_PHY_DOUBLE_HALF_BIT_TIME_US_TYP + \
+                                             DALI2_L_PHY_STOP_CONDITION_TIME_US)
+#define DALI2_HAL_COST_FW_US                DALI2_HAL_COST_FRAME_US(DALI2_L_PHY_FORWARD_16BIT_SIZE)
+#define DALI2_HAL_COST_BW_US                DALI2_HAL_COST_FRAME_US(DALI2_L_PHY_BACKWARD_8BIT_SIZE)
+
+//! Typical gear reply, practice overhead of reply window is not expected
+#define DALI2_HAL_COST_REPLY_US             ((DALI2_L_SES_SETTLING_TIME_FW_BW_MS_MIN + \
+                                              DALI2_L_SES_SETTLING_TIME_FW_BW_MS_MAX - \
+                                              DALI2_L_SES_SETTLING_TIME_FW_BW_OVERHEAD_MS) * 1000 / 2)
+#define DALI2_HAL_COST_NO_REPLY_US          (DALI2_L_SES_SETTLING_TIME_FW_BW_MS_MAX * 1000)
+
+//! Answers learned per query, counts are halved on the window, so gear changes are followed
+#define DALI2_HAL_COST_LEARN_WINDOW         32
+
+//! Typical point of priority settling window
+#define DALI2_HAL_COST_SETTLING_US(P)       ((DALI2_L_SES_PRIORITY_##P##_US_MIN + DALI2_L_SES_PRIORITY_##P##_US_MAX) / 2)
+
+static const unsigned short __cost_settling_us[] = {
+    [DALI2_L_SES_PRIORITY_1] = DALI2_HAL_COST_SETTLING_US(1),
+    [DALI2_L_SES_PRIORITY_2] = DALI2_HAL_COST_SETTLING_US(2),
+    [DALI2_L_SES_PRIORITY_3] = DALI2_HAL_COST_SETTLING_US(3),
+    [DALI2_L_SES_PRIORITY_4] = DALI2_HAL_COST_SETTLING_US(4),
+    [DALI2_L_SES_PRIORITY_5] = DALI2_HAL_COST_SETTLING_US(5),
+};
+
+//! Nominal command chains of jobs, LED gear with current protector and dimming curve
+static const DALI2_L_APP_CMD_T __cost_set_level[] = {
+    DALI2_L_APP_CMD_SET_POWER_ON_LEVEL_DTR0,
+    DALI2_L_APP_CMD_QUERY_POWER_ON_LEVEL,
+    DALI2_L_APP_CMD_SET_SYSTEM_FAILURE_LEVEL_DTR0,
+    DALI2_L_APP_CMD_QUERY_SYSTEM_FAILURE_LEVEL,
+    DALI2_L_APP_CMD_DAPC,
+    DALI2_L_APP_CMD_QUERY_STATUS,
+    DALI2_L_APP_CMD_QUERY_SHORT_CIRCUIT,
+    DALI2_L_APP_CMD_QUERY_OPEN_CIRCUIT,
+    DALI2_L_APP_CMD_QUERY_LOAD_DECREASE,
+    DALI2_L_APP_CMD_QUERY_LOAD_INCREASE,
+    DALI2_L_APP_CMD_QUERY_CURRENT_PROTECTOR_ACTIVE,
+    DALI2_L_APP_CMD_QUERY_THERMAL_SHUT_DOWN,
+    DALI2_L_APP_CMD_QUERY_THERMAL_OVERLOAD,
+    DALI2_L_APP_CMD_QUERY_REFERENCE_MEASUREMENT_FAILED,
+    DALI2_L_APP_CMD_QUERY_FAILURE_STATUS,
+    DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL,
+};
+
+static const DALI2_L_APP_CMD_T __cost_update_state[] = {
+    DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_PRESENT,
+    DALI2_L_APP_CMD_QUERY_LAMP_FAILURE,
+    DALI2_L_APP_CMD_QUERY_LAMP_POWER_ON,
+    DALI2_L_APP_CMD_QUERY_LIMIT_ERROR,
+    DALI2_L_APP_CMD_QUERY_RESET_STATE,
+    DALI2_L_APP_CMD_QUERY_MISSING_SHORT_ADDRESS,
+    DALI2_L_APP_CMD_QUERY_POWER_FAILURE,
+    DALI2_L_APP_CMD_QUERY_STATUS,
+    DALI2_L_APP_CMD_QUERY_SHORT_CIRCUIT,
+    DALI2_L_APP_CMD_QUERY_OPEN_CIRCUIT,
+    DALI2_L_APP_CMD_QUERY_LOAD_DECREASE,
+    DALI2_L_APP_CMD_QUERY_LOAD_INCREASE,
+    DALI2_L_APP_CMD_QUERY_CURRENT_PROTECTOR_ACTIVE,
+    DALI2_L_APP_CMD_QUERY_THERMAL_SHUT_DOWN,
+    DALI2_L_APP_CMD_QUERY_THERMAL_OVERLOAD,
+    DALI2_L_APP_CMD_QUERY_REFERENCE_MEASUREMENT_FAILED,
+    DALI2_L_APP_CMD_QUERY_FAILURE_STATUS,
+    DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL,
+};
+
+static const DALI2_L_APP_CMD_T __cost_dim_cfg[] = {
+    DALI2_L_APP_CMD_QUERY_DEVICE_TYPE,
+    DALI2_L_APP_CMD_QUERY_LIGHT_SOURCE_TYPE,
+    DALI2_L_APP_CMD_QUERY_OPERATING_MODE_LED,
+    DALI2_L_APP_CMD_QUERY_FEATURES,
+    DALI2_L_APP_CMD_QUERY_CURRENT_PROTECTOR_ENABLED,
+    DALI2_L_APP_CMD_QUERY_DIMMING_CURVE,
+    DALI2_L_APP_CMD_QUERY_PHYSICAL_MINIMUM,
+    DALI2_L_APP_CMD_SET_OPERATING_MODE_DTR0,
+    DALI2_L_APP_CMD_QUERY_OPERATING_MODE,
+    DALI2_L_APP_CMD_SET_MAX_LEVEL_DTR0,
+    DALI2_L_APP_CMD_QUERY_MAX_LEVEL,
+    DALI2_L_APP_CMD_SET_MIN_LEVEL_DTR0,
+    DALI2_L_APP_CMD_QUERY_MIN_LEVEL,
+    DALI2_L_APP_CMD_SET_FADE_TIME_DTR0,
+    DALI2_L_APP_CMD_QUERY_FADE_TIME_FADE_RATE,
+    DALI2_L_APP_CMD_SET_EXTENDED_FADE_TIME_DTR0,
+    DALI2_L_APP_CMD_QUERY_EXTENDED_FADE_TIME,
+};
+
+typedef struct {
+    const DALI2_L_APP_CMD_T *cmd;
+    unsigned char count;
+} dali2_hal_cost_chain_t;
+
+#define DALI2_HAL_COST_CHAIN(CHAIN)         {CHAIN, sizeof(CHAIN) / sizeof(CHAIN[0])}
+
+static const dali2_hal_cost_chain_t __cost_chain[DALI2_HAL_JOB_COUNT] = {
+    [DALI2_HAL_JOB_SET_LEVEL] = DALI2_HAL_COST_CHAIN(__cost_set_level),
+    [DALI2_HAL_JOB_UPDATE_STATE] = DALI2_HAL_COST_CHAIN(__cost_update_state),
+    [DALI2_HAL_JOB_DIM_CFG] = DALI2_HAL_COST_CHAIN(__cost_dim_cfg),
+};
+
+//! How command goes on the line
+typedef struct {
+    DALI2_L_SES_MSG_T msg;
+    unsigned char is_dtr;               //! DTR0 frame goes first
+    unsigned char is_dt6;               //! ENABLE DEVICE TYPE 6 frame goes right before the command
+    unsigned short settle_ms;           //! Application layer settling time after the command
+} dali2_hal_cost_shape_t;
+
+//! Learned answers of query
+typedef struct {
+    unsigned char answers;
+    unsigned char silences;
+} dali2_hal_cost_learn_t;
+
+//! Internal handle type
+typedef struct {
+    dali2_hal_cost_learn_t learn[DALI2_L_APP_CMD_UNKNOWN];
+} dali2_hal_cost_handle_t;
+
+static dali2_hal_cost_handle_t __cost_handle;
+
+static void __dali2_hal_cost_shape(DALI2_L_APP_CMD_T cmd, dali2_hal_cost_shape_t *shape)
+{
+    shape->msg = DALI2_L_SES_SEND;
+    shape->is_dtr = 0;
+    shape->is_dt6 = DALI2_L_APP_CMD_IS_DT6(cmd) ? 1 : 0;
+    shape->settle_ms = 0;
+
+    switch (cmd) {
+        case DALI2_L_APP_CMD_RESET:
+            shape->msg = DALI2_L_SES_SEND_TWICE;
+            shape->settle_ms = DALI2_L_APP_CMD_RESET_SETTLING_TIME_MS;
+            break;
+
+        case DALI2_L_APP_CMD_SET_OPERATING_MODE_DTR0:
+        case DALI2_L_APP_CMD_SET_MAX_LEVEL_DTR0:
+        case DALI2_L_APP_CMD_SET_MIN_LEVEL_DTR0:
+        case DALI2_L_APP_CMD_SET_FADE_TIME_DTR0:
+        case DALI2_L_APP_CMD_SET_EXTENDED_FADE_TIME_DTR0:
+            shape->settle_ms = DALI2_L_APP_CMD_DEFAULT_SETTLING_TIME_MS;
+            /* fall through */
+        case DALI2_L_APP_CMD_SET_SYSTEM_FAILURE_LEVEL_DTR0:
+        case DALI2_L_APP_CMD_SET_POWER_ON_LEVEL_DTR0:
+        case DALI2_L_APP_CMD_SET_FADE_RATE_DTR0:
+        case DALI2_L_APP_CMD_SET_SHORT_ADDRESS:
+        case DALI2_L_APP_CMD_SELECT_DIMMING_CURVE:
+        case DALI2_L_APP_CMD_STORE_DTR_AS_FAST_FADE_TIME:
+            shape->is_dtr = 1;
+            /* fall through */
+        case DALI2_L_APP_CMD_IDENTIFY_DEVICE:
+        case DALI2_L_APP_CMD_REFERENCE_SYSTEM_POWER:
+        case DALI2_L_APP_CMD_ENABLE_CURRENT_PROTECTOR:
+        case DALI2_L_APP_CMD_DISABLE_CURRENT_PROTECTOR:
+        case DALI2_L_APP_CMD_INITIALISE:
+        case DALI2_L_APP_CMD_RANDOMISE:
+        case DALI2_L_APP_CMD_ENABLE_DEVICE_TYPE_6:
+            shape->msg = DALI2_L_SES_SEND_TWICE;
+            break;
+
+        case DALI2_L_APP_CMD_COMPARE:
+        case DALI2_L_APP_CMD_VERIFY_SHORT_ADDRESS:
+        case DALI2_L_APP_CMD_QUERY_SHORT_ADDRESS:
+            shape->msg = DALI2_L_SES_QUERY;
+            break;
+
+        default:
+            if ((cmd >= DALI2_L_APP_CMD_QUERY_STATUS && cmd <= DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_FAILURE) ||
+                (cmd >= DALI2_L_APP_CMD_QUERY_GEAR_TYPE && cmd <= DALI2_L_APP_CMD_QUERY_EXTENDED_VERSION_NUMBER)) {
+                shape->msg = DALI2_L_SES_QUERY;
+            }
+            break;
+    }
+}
+
+//! Priority settling left after idle time of the line
+static inline unsigned int __dali2_hal_cost_gap_us(DALI2_L_SES_PRIORITY_T priority, unsigned int idle_us)
+{
+    unsigned int settling_us = __cost_settling_us[DALI2_L_SES_PRIORITY_IS_VALID(priority) ?
+                                                  priority : DALI2_L_SES_PRIORITY_DEFAULT];
+
+    return (settling_us > idle_us) ? settling_us - idle_us : 0;
+}
+
+/**@brief Bus time of command
+ *
+ * @param[IN] cmd - command
+ * @param[IN] priority - priority of the job
+ * @param[IN/OUT] idle_us - line idle time before the command, after the command on return
+ * @return bus time
+ */
+static unsigned int __dali2_hal_cost_step_us(DALI2_L_APP_CMD_T cmd, DALI2_L_SES_PRIORITY_T priority,
+                                             unsigned int *idle_us)
+{
+    const dali2_hal_cost_learn_t *learn;
+    dali2_hal_cost_shape_t shape;
+    unsigned int cost_us = 0;
+    unsigned int count;
+
+    __dali2_hal_cost_shape(cmd, &shape);
+
+    //! Stop condition is idle line already
+    if (shape.is_dtr) {
+        cost_us += __dali2_hal_cost_gap_us(priority, *idle_us) + DALI2_HAL_COST_FW_US;
+        *idle_us = DALI2_L_PHY_STOP_CONDITION_TIME_US;
+    }
+    if (shape.is_dt6) {
+        cost_us += __dali2_hal_cost_gap_us(priority, *idle_us) + DALI2_HAL_COST_FW_US;
+        *idle_us = DALI2_L_PHY_STOP_CONDITION_TIME_US;
+    }
+
+    cost_us += __dali2_hal_cost_gap_us(priority, *idle_us) + DALI2_HAL_COST_FW_US;
+    *idle_us = DALI2_L_PHY_STOP_CONDITION_TIME_US;
+
+    switch (shape.msg) {
+        case DALI2_L_SES_SEND_TWICE:
+            cost_us += DALI2_L_SES_SETTLING_TIME_FW_FW_MS_MAX * 1000 + DALI2_HAL_COST_FW_US;
+            break;
+
+        case DALI2_L_SES_QUERY:
+            //! No learned answers yet, the longer case is expected
+            learn = &__cost_handle.learn[cmd];
+            count = learn->answers + learn->silences;
+            if (!count) {
+                cost_us += DALI2_HAL_COST_NO_REPLY_US;
+                *idle_us = DALI2_HAL_COST_NO_REPLY_US;
+            } else {
+                cost_us += (learn->answers * (DALI2_HAL_COST_REPLY_US + DALI2_HAL_COST_BW_US) +
+                            learn->silences * DALI2_HAL_COST_NO_REPLY_US) / count;
+                *idle_us = (learn->answers * DALI2_L_PHY_STOP_CONDITION_TIME_US +
+                            learn->silences * DALI2_HAL_COST_NO_REPLY_US) / count;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    if (shape.settle_ms) {
+        cost_us += shape.settle_ms * 1000;
+        *idle_us += shape.settle_ms * 1000;
+    }
+
+    return cost_us;
+}
+
+//! Fade started by level command, gear of unknown fade time is expected to keep reset value
+static unsigned int __dali2_hal_cost_fade_us(dali2_l_app_network_t *net)
+{
+    unsigned int fade_ms;
+
+    if (!net || net->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING ||
+        dali2_hal_dim_shadow_fade_ms_get(&fade_ms, net->addr_byte) != DALI2_RET_SUCCESS) {
+        return 0;
+    }
+
+    return fade_ms * 1000;
+}
+
+/**@brief Bus time of level polling until fade ends, @see DALI2_HAL_RETRY_STEP_SETTLE
+ *
+ * @param[IN] cmd - polling query
+ * @param[IN] priority - priority of the job
+ * @param[IN] fade_us - fade time
+ * @param[IN] elapsed_us - time since fade start up to the first answer
+ * @return bus time of repetitions
+ */
+static unsigned int __dali2_hal_cost_settle_us(DALI2_L_APP_CMD_T cmd, DALI2_L_SES_PRIORITY_T priority,
+                                               unsigned int fade_us, unsigned int elapsed_us)
+{
+    unsigned int cost_us = 0;
+    unsigned int backoff_ms;
+    unsigned int attempt;
+    unsigned int idle_us;
+
+    for (attempt = 0; elapsed_us + cost_us < fade_us; attempt++) {
+        backoff_ms = dali2_hal_retry_backoff_ms(DALI2_HAL_RETRY_STEP_SETTLE, attempt);
+        if (!backoff_ms) {
+            break;
+        }
+
+        idle_us = backoff_ms * 1000;
+        cost_us += idle_us;
+        cost_us += __dali2_hal_cost_step_us(cmd, priority, &idle_us);
+    }
+
+    return cost_us;
+}
+
+/**@brief Bus time of command chain
+ *
+ * @param[IN] cmd - chain
+ * @param[IN] count - commands in chain
+ * @param[IN] net - DALI node, NULL if answers are not cached
+ * @param[IN] priority - priority of the job
+ * @return bus time
+ */
+static unsigned int __dali2_hal_cost_chain_us(const DALI2_L_APP_CMD_T *cmd, unsigned int count,
+                                              dali2_l_app_network_t *net, DALI2_L_SES_PRIORITY_T priority)
+{
+    dali2_hal_cost_shape_t shape;
+    unsigned int cost_us = 0;
+    unsigned int idle_us = 0;
+    unsigned int fade_us = 0;
+    unsigned int fade_at_us = 0;
+    unsigned char dropped = 0;
+    unsigned int i;
+
+    for (i = 0; i < count; i++) {
+        __dali2_hal_cost_shape(cmd[i], &shape);
+
+        //! Answer is fresh unless the job itself changes it before
+        if (shape.msg == DALI2_L_SES_QUERY && net &&
+            dali2_hal_cache_is_fresh(cmd[i], net, cost_us / 1000, dropped)) {
+            continue;
+        }
+
+        cost_us += __dali2_hal_cost_step_us(cmd[i], priority, &idle_us);
+        dropped |= dali2_hal_cache_drops(cmd[i]);
+
+        if (cmd[i] == DALI2_L_APP_CMD_DAPC) {
+            fade_us = __dali2_hal_cost_fade_us(net);
+            fade_at_us = cost_us;
+        } else if (cmd[i] == DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL && fade_us) {
+            cost_us += __dali2_hal_cost_settle_us(cmd[i], priority, fade_us, cost_us - fade_at_us);
+            idle_us = 0;
+        }
+    }
+
+    return cost_us;
+}
+
+void dali2_hal_cost_init(void)
+{
+    memset(&__cost_handle, 0x00, sizeof(__cost_handle));
+}
+
+void dali2_hal_cost_answer(DALI2_L_APP_CMD_T cmd, DALI2_L_APP_EVT_T evt)
+{
+    dali2_hal_cost_learn_t *learn;
+    dali2_hal_cost_shape_t shape;
+
+    if (cmd >= DALI2_L_APP_CMD_UNKNOWN || evt == DALI2_L_APP_EVT_FAULT) {
+        return;
+    }
+
+    __dali2_hal_cost_shape(cmd, &shape);
+    if (shape.msg != DALI2_L_SES_QUERY) {
+        return;
+    }
+
+    learn = &__cost_handle.learn[cmd];
+    if (learn->answers + learn->silences >= DALI2_HAL_COST_LEARN_WINDOW) {
+        learn->answers /= 2;
+        learn->silences /= 2;
+    }
+
+    if (evt == DALI2_L_APP_EVT_SUCCESS) {
+        learn->answers++;
+    } else {
+        learn->silences++;
+    }
+}
+
+unsigned int dali2_hal_cost_left_us(DALI2_HAL_EVT_T evt, DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net)
+{
+    const dali2_hal_cost_chain_t *chain;
+    unsigned int idle_us = 0;
+    unsigned int i;
+
+    switch (evt) {
+        case DALI2_HAL_EVT_DIM_CTRL:
+            //! Status chain of setting level is the tail of state update
+            chain = &__cost_chain[DALI2_HAL_JOB_SET_LEVEL];
+            for (i = 0; i < chain->count && chain->cmd[i] != cmd; i++);
+            if (i == chain->count) {
+                chain = &__cost_chain[DALI2_HAL_JOB_UPDATE_STATE];
+            }
+            break;
+
+        case DALI2_HAL_EVT_DIM_CFG:
+            chain = &__cost_chain[DALI2_HAL_JOB_DIM_CFG];
+            break;
+
+        case DALI2_HAL_EVT_ADDR_ALLOC:
+            //! Walk of the bus is not predictable, its deadline is the bound
+            return DALI2_HAL_WATCHDOG_ADDR_ALLOC_MS * 1000;
+
+        case DALI2_HAL_EVT_POLL:
+            //! Polling gives way between its queries
+            return (cmd < DALI2_L_APP_CMD_UNKNOWN) ?
+                   __dali2_hal_cost_step_us(cmd, dali2_hal_evt_priority_get(evt), &idle_us) : 0;
+
+        default:
+            return 0;
+    }
+
+    //! Unknown step, e.g. repetition of the previous one, the whole chain is left
+    for (i = 0; i < chain->count && chain->cmd[i] != cmd; i++);
+    if (i == chain->count) {
+        i = 0;
+    }
+
+    return __dali2_hal_cost_chain_us(&chain->cmd[i], chain->count - i, net, dali2_hal_evt_priority_get(evt));
+}
+
+unsigned int dali2_hal_cost_cmd_us(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *node,
+                                   DALI2_L_SES_PRIORITY_T priority)
+{
+    if (cmd >= DALI2_L_APP_CMD_UNKNOWN) {
+        return 0;
+    }
+
+    return __dali2_hal_cost_chain_us(&cmd, 1, node, priority);
+}
+
+unsigned int dali2_hal_cost_job_us(DALI2_HAL_JOB_T job, dali2_l_app_network_t *node)
+{
+    DALI2_L_SES_PRIORITY_T priority;
+
+    if (job >= DALI2_HAL_JOB_COUNT || !node) {
+        return 0;
+    }
+
+    //! Job addressing quarantined gear ends before transmission
+    if (node->method == DALI2_L_NET_METHOD_SHORT_ADDRESSING && dali2_hal_quarantine_is_set(node->addr_byte)) {
+        return 0;
+    }
+
+    //! Fresh status is returned without state update
+    if (job == DALI2_HAL_JOB_UPDATE_STATE && dali2_hal_cache_is_fresh(DALI2_L_APP_CMD_QUERY_STATUS, node, 0, 0)) {
+        return 0;
+    }
+
+    priority = dali2_hal_evt_priority_get(DALI2_HAL_JOB_EVT(job));
+
+    return __dali2_hal_cost_chain_us(__cost_chain[job].cmd, __cost_chain[job].count, node, priority);
+}
@@ -13,6 +13,7 @@
 
 #include "dali2_hal.h"
 #include "dali2_hal_internal.h"
+#include "dali2_log.h"
 
 static dali2_l_app_network_t __dim_node;
 static dali2_hal_dim_cfg_t __dim_cfg;
@@ -43,7 +44,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
             if (evt == DALI2_L_APP_EVT_SUCCESS) {
                 __dim_cfg_meta.device_type = evt_data->cmd_data.std_rsp.data;
 
-                DALI2_L_BSP_LOG("Device type %u", __dim_cfg_meta.device_type);
+                DALI2_LOG1(DIM_CFG_DEVICE_TYPE, __dim_cfg_meta.device_type);
 
                 //! Verify device is LED module
                 if (__dim_cfg_meta.device_type == DALI2_L_APP_CMD_DEVICE_LED) {
@@ -52,7 +53,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                     instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
                     dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_LIGHT_SOURCE_TYPE, &instr_data);
                 } else {
-                    DALI2_L_BSP_LOG("Device type is not supported. Terminated Configuration!");
+                    DALI2_LOG0(DIM_CFG_DEVICE_NOT_SUPPORTED);
 
                     //! Free mutex
                     dali2_hal_mtx_give();
@@ -64,15 +65,8 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
             if (evt == DALI2_L_APP_EVT_SUCCESS) {
                 __dim_cfg_meta.light_src_type = evt_data->cmd_data.std_rsp.data;
 
-                DALI2_L_BSP_LOG("Light source type %u", __dim_cfg_meta.light_src_type);
+                DALI2_LOG1(DIM_CFG_LIGHT_SRC_TYPE, __dim_cfg_meta.light_src_type);
 
-                //! Enable LED Module devices
-                dali2_hal_queue_push(DALI2_L_APP_CMD_ENABLE_DEVICE_TYPE_6, &instr_data);
-            }
-            break;
-
-        case DALI2_L_APP_CMD_ENABLE_DEVICE_TYPE_6:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
                 //! Query LED Operating Mode
                 instr_data.std_cmd.net.method = __dim_node.method;
                 instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
@@ -84,7 +78,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
             if (evt == DALI2_L_APP_EVT_SUCCESS) {
                 __dim_cfg_meta.led_operating_mode = evt_data->cmd_data.std_rsp.data;
 
-                DALI2_L_BSP_LOG("LED operating mode 0x%X", __dim_cfg_meta.led_operating_mode);
+                DALI2_LOG1(DIM_CFG_LED_OPERATING_MODE, __dim_cfg_meta.led_operating_mode);
 
                 //! Query LED featured
                 instr_data.std_cmd.net.method = __dim_node.method;
@@ -97,7 +91,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
             if (evt == DALI2_L_APP_EVT_SUCCESS) {
                 __dim_cfg_meta.led_features = evt_data->cmd_data.std_rsp.data;
 
-                DALI2_L_BSP_LOG("LED features byte 0x%X", __dim_cfg_meta.led_features);
+                DALI2_LOG1(DIM_CFG_LED_FEATURES, __dim_cfg_meta.led_features);
 
                 //! Verify Current Protector Support
                 if (__dim_cfg_meta.led_features & DALI2_L_APP_LED_FEATURE_CURRENT_PROTECTOR_SUPPORTED) {
@@ -106,7 +100,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                     instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
                     dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_CURRENT_PROTECTOR_ENABLED, &instr_data);
                 } else {
-                    DALI2_L_BSP_LOG("Current protector doesn't supported!");
+                    DALI2_LOG0(DIM_CFG_NO_CURR_PROTECTOR);
 
                     //! Verify does non-logarithmic curve supported
                     if (__dim_cfg_meta.led_operating_mode & DALI2_L_APP_LED_OPERATING_MODE_NON_LOGARITHMIC_ACTIVE) {
@@ -115,7 +109,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                         instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
                         dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_DIMMING_CURVE, &instr_data);
                     } else {
-                        DALI2_L_BSP_LOG("Non-logarithmic curve doesn't supported!");
+                        DALI2_LOG0(DIM_CFG_NO_NON_LOG_CURVE);
 
                         //! Query Physical minimum
                         instr_data.std_cmd.net.method = __dim_node.method;
@@ -157,7 +151,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                 instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
                 dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_DIMMING_CURVE, &instr_data);
             } else {
-                DALI2_L_BSP_LOG("Non-logarithmic curve doesn't supported!");
+                DALI2_LOG0(DIM_CFG_NO_NON_LOG_CURVE);
 
                 //! Query Physical minimum
                 instr_data.std_cmd.net.method = __dim_node.method;
@@ -178,7 +172,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
 
         case DALI2_L_APP_CMD_QUERY_DIMMING_CURVE:
             if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                DALI2_L_BSP_LOG("Dimming curve 0x%X", evt_data->cmd_data.std_rsp.data);
+                DALI2_LOG1(DIM_CFG_DIMMING_CURVE, evt_data->cmd_data.std_rsp.data);
 
                 if (evt_data->cmd_data.std_rsp.data == __dim_cfg.dim_curve) {
                     //! Query Physical minimum
@@ -210,7 +204,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                 evt_data->cmd_data.std_rsp.data != DALI2_DIM_CFG_WRONG_LEVEL) {
                 __dim_cfg_meta.phy_min = evt_data->cmd_data.std_rsp.data;
 
-                DALI2_L_BSP_LOG("Physical minimum: %u", __dim_cfg_meta.phy_min);
+                DALI2_LOG1(DIM_CFG_PHY_MIN, __dim_cfg_meta.phy_min);
 
                 //! Here is the point, where all dimmer configuration metadata retrieved
                 __dim_cfg_meta_retrieved = 1;
@@ -241,13 +235,27 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                 instr_data.std_cmd.data = __dim_cfg.level_max;
                 dali2_hal_queue_push(DALI2_L_APP_CMD_SET_MAX_LEVEL_DTR0, &instr_data);
             } else {
-                DALI2_L_BSP_LOG("Dimmer configuration Failed on set mode!");
+                DALI2_LOG0(DIM_CFG_FAIL_MODE);
 
-                //! REPEAT: Setting operating mode
-                instr_data.std_cmd.net.method = __dim_node.method;
-                instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
-                instr_data.std_cmd.data = __dim_cfg.mode;
-                dali2_hal_queue_push(DALI2_L_APP_CMD_SET_OPERATING_MODE_DTR0, &instr_data);
+                switch (dali2_hal_retry(DALI2_HAL_RETRY_STEP_READ(evt), evt_data->cmd)) {
+                    case DALI2_HAL_RETRY_REREAD:
+                        //! Re-read before re-write
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        dali2_hal_queue_push(evt_data->cmd, &instr_data);
+                        break;
+
+                    case DALI2_HAL_RETRY_REPEAT:
+                        //! REPEAT: Setting operating mode
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        instr_data.std_cmd.data = __dim_cfg.mode;
+                        dali2_hal_queue_push(DALI2_L_APP_CMD_SET_OPERATING_MODE_DTR0, &instr_data);
+                        break;
+
+                    default:
+                        break;
+                }
             }
             break;
 
@@ -269,11 +277,25 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                 instr_data.std_cmd.data = __dim_cfg.level_min;
                 dali2_hal_queue_push(DALI2_L_APP_CMD_SET_MIN_LEVEL_DTR0, &instr_data);
             } else {
-                //! REPEAT: Setting maximum level
-                instr_data.std_cmd.net.method = __dim_node.method;
-                instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
-                instr_data.std_cmd.data = __dim_cfg.level_max;
-                dali2_hal_queue_push(DALI2_L_APP_CMD_SET_MAX_LEVEL_DTR0, &instr_data);
+                switch (dali2_hal_retry(DALI2_HAL_RETRY_STEP_READ(evt), evt_data->cmd)) {
+                    case DALI2_HAL_RETRY_REREAD:
+                        //! Re-read before re-write
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        dali2_hal_queue_push(evt_data->cmd, &instr_data);
+                        break;
+
+                    case DALI2_HAL_RETRY_REPEAT:
+                        //! REPEAT: Setting maximum level
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        instr_data.std_cmd.data = __dim_cfg.level_max;
+                        dali2_hal_queue_push(DALI2_L_APP_CMD_SET_MAX_LEVEL_DTR0, &instr_data);
+                        break;
+
+                    default:
+                        break;
+                }
             }
             break;
 
@@ -295,11 +317,25 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                 instr_data.std_cmd.data = 0x00;
                 dali2_hal_queue_push(DALI2_L_APP_CMD_SET_FADE_TIME_DTR0, &instr_data);
             } else {
-                //! REPEAT: Setting minimum level
-                instr_data.std_cmd.net.method = __dim_node.method;
-                instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
-                instr_data.std_cmd.data = __dim_cfg.level_min;
-                dali2_hal_queue_push(DALI2_L_APP_CMD_SET_MIN_LEVEL_DTR0, &instr_data);
+                switch (dali2_hal_retry(DALI2_HAL_RETRY_STEP_READ(evt), evt_data->cmd)) {
+                    case DALI2_HAL_RETRY_REREAD:
+                        //! Re-read before re-write
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        dali2_hal_queue_push(evt_data->cmd, &instr_data);
+                        break;
+
+                    case DALI2_HAL_RETRY_REPEAT:
+                        //! REPEAT: Setting minimum level
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        instr_data.std_cmd.data = __dim_cfg.level_min;
+                        dali2_hal_queue_push(DALI2_L_APP_CMD_SET_MIN_LEVEL_DTR0, &instr_data);
+                        break;
+
+                    default:
+                        break;
+                }
             }
             break;
 
@@ -309,7 +345,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                 instr_data.std_cmd.net.method = __dim_node.method;
                 instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
                 dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_FADE_TIME_FADE_RATE, &instr_data);
-            } else {
+            } else if (dali2_hal_retry(DALI2_HAL_RETRY_STEP_SEND, evt_data->cmd) == DALI2_HAL_RETRY_REPEAT) {
                 //! REPEAT: Setting fade time
                 instr_data.std_cmd.net.method = __dim_node.method;
                 instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
@@ -327,13 +363,27 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                 instr_data.std_cmd.data = __dim_cfg_sec_to_ext_fade_time(__dim_cfg.fade_time_s);
                 dali2_hal_queue_push(DALI2_L_APP_CMD_SET_EXTENDED_FADE_TIME_DTR0, &instr_data);
             } else {
-                DALI2_L_BSP_LOG("Dimmer configuration Failed on query fade time rate!");
+                DALI2_LOG0(DIM_CFG_FAIL_FADE_RATE);
 
-                //! REPEAT: Setting fade time
-                instr_data.std_cmd.net.method = __dim_node.method;
-                instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
-                instr_data.std_cmd.data = 0x00;
-                dali2_hal_queue_push(DALI2_L_APP_CMD_SET_FADE_TIME_DTR0, &instr_data);
+                switch (dali2_hal_retry(DALI2_HAL_RETRY_STEP_READ(evt), evt_data->cmd)) {
+                    case DALI2_HAL_RETRY_REREAD:
+                        //! Re-read before re-write
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        dali2_hal_queue_push(evt_data->cmd, &instr_data);
+                        break;
+
+                    case DALI2_HAL_RETRY_REPEAT:
+                        //! REPEAT: Setting fade time
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        instr_data.std_cmd.data = 0x00;
+                        dali2_hal_queue_push(DALI2_L_APP_CMD_SET_FADE_TIME_DTR0, &instr_data);
+                        break;
+
+                    default:
+                        break;
+                }
             }
             break;
 
@@ -343,7 +393,7 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                 instr_data.std_cmd.net.method = __dim_node.method;
                 instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
                 dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_EXTENDED_FADE_TIME, &instr_data);
-            } else {
+            } else if (dali2_hal_retry(DALI2_HAL_RETRY_STEP_SEND, evt_data->cmd) == DALI2_HAL_RETRY_REPEAT) {
                 //! REPEAT: Setting Extended Fade Time
                 instr_data.std_cmd.net.method = __dim_node.method;
                 instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
@@ -360,21 +410,37 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
                 //! Free mutex
                 dali2_hal_mtx_give();
             } else {
-                DALI2_L_BSP_LOG("Dimmer configuration Failed on query extended fade time!");
+                DALI2_LOG0(DIM_CFG_FAIL_EXT_FADE_TIME);
 
-                //! REPEAT: Setting Extended Fade Time
-                instr_data.std_cmd.net.method = __dim_node.method;
-                instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
-                instr_data.std_cmd.data = __dim_cfg_sec_to_ext_fade_time(__dim_cfg.fade_time_s);
-                dali2_hal_queue_push(DALI2_L_APP_CMD_SET_EXTENDED_FADE_TIME_DTR0, &instr_data);
+                switch (dali2_hal_retry(DALI2_HAL_RETRY_STEP_READ(evt), evt_data->cmd)) {
+                    case DALI2_HAL_RETRY_REREAD:
+                        //! Re-read before re-write
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        dali2_hal_queue_push(evt_data->cmd, &instr_data);
+                        break;
+
+                    case DALI2_HAL_RETRY_REPEAT:
+                        //! REPEAT: Setting Extended Fade Time
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        instr_data.std_cmd.data = __dim_cfg_sec_to_ext_fade_time(__dim_cfg.fade_time_s);
+                        dali2_hal_queue_push(DALI2_L_APP_CMD_SET_EXTENDED_FADE_TIME_DTR0, &instr_data);
+                        break;
+
+                    default:
+                        break;
+                }
             }
             break;
 
         case DALI2_L_APP_CMD_UNKNOWN:
-            //! REPEAT: Query Device Type
-            instr_data.std_cmd.net.method = __dim_node.method;
-            instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
-            dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_DEVICE_TYPE, &instr_data);
+            if (dali2_hal_retry(DALI2_HAL_RETRY_STEP_SEND, evt_data->cmd) == DALI2_HAL_RETRY_REPEAT) {
+                //! REPEAT: Query Device Type
+                instr_data.std_cmd.net.method = __dim_node.method;
+                instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_DEVICE_TYPE, &instr_data);
+            }
             break;
 
         default:
@@ -13,14 +13,90 @@
 
 #include "dali2_hal.h"
 #include "dali2_hal_internal.h"
+#include "dali2_log.h"
 
 static dali2_l_app_network_t __dim_node;
 static unsigned char __dim_target_level;
+static unsigned char __dim_is_set_level;    //! Status chain waits for the target level
 static unsigned char __dim_actual_level;
 static unsigned char __dim_status;
 static unsigned char __dim_failure_status;
 static dali2_hal_dim_meta_t __dim_meta_cfg;
 
+//! Yes/No queries of status chain and the bits they answer
+typedef struct {
+    DALI2_L_APP_CMD_T cmd;
+    unsigned char bit;
+    unsigned char is_failure_status;    //! Bit of LED failure status, otherwise of status
+    unsigned char is_yes_clear;         //! "Yes" clears the bit
+} dali2_hal_dim_status_query_t;
+
+static const dali2_hal_dim_status_query_t __dim_status_query[] = {
+    {DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_PRESENT, DALI2_L_APP_CMD_STATUS_CONTROL_GEAR_FAILURE, 0, 1},
+    {DALI2_L_APP_CMD_QUERY_LAMP_FAILURE, DALI2_L_APP_CMD_STATUS_LAMP_FAILURE, 0, 0},
+    {DALI2_L_APP_CMD_QUERY_LAMP_POWER_ON, DALI2_L_APP_CMD_STATUS_LAMP_ON, 0, 0},
+    {DALI2_L_APP_CMD_QUERY_LIMIT_ERROR, DALI2_L_APP_CMD_STATUS_LIMIT_ERROR, 0, 0},
+    {DALI2_L_APP_CMD_QUERY_RESET_STATE, DALI2_L_APP_CMD_STATUS_RESET_STATE, 0, 0},
+    {DALI2_L_APP_CMD_QUERY_MISSING_SHORT_ADDRESS, DALI2_L_APP_CMD_STATUS_SHORT_ADDRESS, 0, 0},
+    {DALI2_L_APP_CMD_QUERY_POWER_FAILURE, DALI2_L_APP_CMD_STATUS_POWER_CYCLE_SEEN, 0, 0},
+
+    {DALI2_L_APP_CMD_QUERY_SHORT_CIRCUIT, DALI2_L_APP_LED_FAILURE_SHORT_CIRCUIT, 1, 0},
+    {DALI2_L_APP_CMD_QUERY_OPEN_CIRCUIT, DALI2_L_APP_LED_FAILURE_OPEN_CIRCUIT, 1, 0},
+    {DALI2_L_APP_CMD_QUERY_LOAD_DECREASE, DALI2_L_APP_LED_FAILURE_LOAD_DECREASE, 1, 0},
+    {DALI2_L_APP_CMD_QUERY_LOAD_INCREASE, DALI2_L_APP_LED_FAILURE_LOAD_INCREASE, 1, 0},
+    {DALI2_L_APP_CMD_QUERY_CURRENT_PROTECTOR_ACTIVE, DALI2_L_APP_LED_FAILURE_CURRENT_PROTECTOR_ACTIVE, 1, 0},
+    {DALI2_L_APP_CMD_QUERY_THERMAL_SHUT_DOWN, DALI2_L_APP_LED_FAILURE_THERMAL_SHUT_DOWN, 1, 0},
+    {DALI2_L_APP_CMD_QUERY_THERMAL_OVERLOAD, DALI2_L_APP_LED_FAILURE_THERMAL_OVERLOAD, 1, 0},
+    {DALI2_L_APP_CMD_QUERY_REFERENCE_MEASUREMENT_FAILED, DALI2_L_APP_LED_FAILURE_REFERENCE_FAILED, 1, 0}
+};
+
+#define DALI2_HAL_DIM_STATUS_QUERY_COUNT    (sizeof(__dim_status_query) / sizeof(__dim_status_query[0]))
+
+unsigned char dali2_hal_dim_status_decode(DALI2_L_APP_CMD_T cmd, DALI2_L_APP_EVT_T evt, unsigned char data,
+                                          unsigned char *status, unsigned char *failure_status)
+{
+    const dali2_hal_dim_status_query_t *query;
+    unsigned char *value;
+    unsigned int i;
+
+    if (evt == DALI2_L_APP_EVT_FAULT) {
+        return 0;
+    }
+
+    switch (cmd) {
+        case DALI2_L_APP_CMD_QUERY_STATUS:
+            //! Silent gear is failed gear
+            *status = (evt == DALI2_L_APP_EVT_SUCCESS) ? data :
+                      (*status | DALI2_L_APP_CMD_STATUS_CONTROL_GEAR_FAILURE);
+            return 1;
+
+        case DALI2_L_APP_CMD_QUERY_FAILURE_STATUS:
+            //! Gear without LED failure status has no failures
+            *failure_status = (evt == DALI2_L_APP_EVT_SUCCESS) ? data : 0;
+            return 1;
+
+        default:
+            break;
+    }
+
+    for (i = 0; i < DALI2_HAL_DIM_STATUS_QUERY_COUNT; i++) {
+        query = &__dim_status_query[i];
+        if (query->cmd != cmd) {
+            continue;
+        }
+
+        value = query->is_failure_status ? failure_status : status;
+        if ((evt == DALI2_L_APP_EVT_SUCCESS) != query->is_yes_clear) {
+            *value |= query->bit;
+        } else {
+            *value &= ~query->bit;
+        }
+        return 1;
+    }
+
+    return 0;
+}
+
 void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data)
 {
     dali2_l_app_cmd_data_t instr_data;
@@ -44,11 +120,25 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
                 instr_data.std_cmd.data = __dim_target_level;
                 dali2_hal_queue_push(DALI2_L_APP_CMD_SET_SYSTEM_FAILURE_LEVEL_DTR0, &instr_data);
             } else {
-                //! Setting Power On level
-                instr_data.std_cmd.net.method = __dim_node.method;
-                instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
-                instr_data.std_cmd.data = __dim_target_level;
-                dali2_hal_queue_push(DALI2_L_APP_CMD_SET_POWER_ON_LEVEL_DTR0, &instr_data);
+                switch (dali2_hal_retry(DALI2_HAL_RETRY_STEP_READ(evt), evt_data->cmd)) {
+                    case DALI2_HAL_RETRY_REREAD:
+                        //! Re-read before re-write
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        dali2_hal_queue_push(evt_data->cmd, &instr_data);
+                        break;
+
+                    case DALI2_HAL_RETRY_REPEAT:
+                        //! REPEAT: Setting Power On level
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        instr_data.std_cmd.data = __dim_target_level;
+                        dali2_hal_queue_push(DALI2_L_APP_CMD_SET_POWER_ON_LEVEL_DTR0, &instr_data);
+                        break;
+
+                    default:
+                        break;
+                }
             }
             break;
 
@@ -70,11 +160,25 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
                 instr_data.std_cmd.data = __dim_target_level;
                 dali2_hal_queue_push(DALI2_L_APP_CMD_DAPC, &instr_data);
             } else {
-                //! REPEAT: Setting System Failure level
-                instr_data.std_cmd.net.method = __dim_node.method;
-                instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
-                instr_data.std_cmd.data = __dim_target_level;
-                dali2_hal_queue_push(DALI2_L_APP_CMD_SET_SYSTEM_FAILURE_LEVEL_DTR0, &instr_data);
+                switch (dali2_hal_retry(DALI2_HAL_RETRY_STEP_READ(evt), evt_data->cmd)) {
+                    case DALI2_HAL_RETRY_REREAD:
+                        //! Re-read before re-write
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        dali2_hal_queue_push(evt_data->cmd, &instr_data);
+                        break;
+
+                    case DALI2_HAL_RETRY_REPEAT:
+                        //! REPEAT: Setting System Failure level
+                        instr_data.std_cmd.net.method = __dim_node.method;
+                        instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                        instr_data.std_cmd.data = __dim_target_level;
+                        dali2_hal_queue_push(DALI2_L_APP_CMD_SET_SYSTEM_FAILURE_LEVEL_DTR0, &instr_data);
+                        break;
+
+                    default:
+                        break;
+                }
             }
             break;
 
@@ -95,7 +199,7 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
                 break;
             }
 
-            DALI2_L_BSP_LOG("DALI Status 0x%X", __dim_status);
+            DALI2_LOG1(DIM_CTRL_STATUS, __dim_status);
 
             //! Query Short Circuit
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -107,6 +211,15 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             if (evt == DALI2_L_APP_EVT_SUCCESS) {
                 __dim_actual_level = evt_data->cmd_data.std_rsp.data;
 
+                //! Level thresholds control
+                if (!__dim_is_set_level) {
+                    //! State update completed!
+
+                    //! Free mutex
+                    dali2_hal_mtx_give();
+                    break;
+                }
+
                 //! Level thresholds control
                 if ((__dim_meta_cfg.phy_min && (__dim_target_level >= __dim_meta_cfg.phy_min)) ||
                     (!__dim_target_level)) {
@@ -115,20 +228,25 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
 
                         //! Free mutex
                         dali2_hal_mtx_give();
+                        break;
                     }
                 }
+
+                //! Fade is running
+                if (dali2_hal_retry(DALI2_HAL_RETRY_STEP_SETTLE, evt_data->cmd) == DALI2_HAL_RETRY_REPEAT) {
+                    instr_data.std_cmd.net.method = __dim_node.method;
+                    instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                    dali2_hal_queue_push(DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL, &instr_data);
+                }
             }
             break;
 
         case DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_PRESENT:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                //! Clear failure status
-                __dim_status &= ~DALI2_L_APP_CMD_STATUS_CONTROL_GEAR_FAILURE;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                DALI2_L_BSP_LOG("DALI Control Gear presence failed!");
-                //! Set failure status
-                __dim_status |= DALI2_L_APP_CMD_STATUS_CONTROL_GEAR_FAILURE;
+            if (evt == DALI2_L_APP_EVT_TIMEOUT) {
+                DALI2_LOG0(DIM_CTRL_GEAR_NOT_PRESENT);
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Lamp Failure status
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -138,13 +256,10 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
 
         case DALI2_L_APP_CMD_QUERY_LAMP_FAILURE:
             if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                DALI2_L_BSP_LOG("DALI Lamp Failure detected!");
-                //! Set lamp failure status
-                __dim_status |= DALI2_L_APP_CMD_STATUS_LAMP_FAILURE;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                //! Reset lamp failure status
-                __dim_status &= ~DALI2_L_APP_CMD_STATUS_LAMP_FAILURE;
+                DALI2_LOG0(DIM_CTRL_LAMP_FAILURE);
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Lamp Power On status
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -153,13 +268,8 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_LAMP_POWER_ON:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                //! Set lamp failure status
-                __dim_status |= DALI2_L_APP_CMD_STATUS_LAMP_ON;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                //! Reset lamp failure status
-                __dim_status &= ~DALI2_L_APP_CMD_STATUS_LAMP_ON;
-            }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Limit Error status
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -168,13 +278,8 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_LIMIT_ERROR:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                //! Set limit error status
-                __dim_status |= DALI2_L_APP_CMD_STATUS_LIMIT_ERROR;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                //! Reset limit error status
-                __dim_status &= ~DALI2_L_APP_CMD_STATUS_LIMIT_ERROR;
-            }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Reset State status
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -183,13 +288,8 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_RESET_STATE:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                //! Set limit error status
-                __dim_status |= DALI2_L_APP_CMD_STATUS_RESET_STATE;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                //! Reset limit error status
-                __dim_status &= ~DALI2_L_APP_CMD_STATUS_RESET_STATE;
-            }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Missing Short Address status
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -198,13 +298,8 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_MISSING_SHORT_ADDRESS:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                //! Set Short Address status
-                __dim_status |= DALI2_L_APP_CMD_STATUS_SHORT_ADDRESS;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                //! Reset Short Address status
-                __dim_status &= ~DALI2_L_APP_CMD_STATUS_SHORT_ADDRESS;
-            }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query status
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -213,13 +308,8 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_POWER_FAILURE:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                //! Set Power Failure status
-                __dim_status |= DALI2_L_APP_CMD_STATUS_POWER_CYCLE_SEEN;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                //! Reset Power Failure status
-                __dim_status &= ~DALI2_L_APP_CMD_STATUS_POWER_CYCLE_SEEN;
-            }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query status
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -229,13 +319,11 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
 
 
         case DALI2_L_APP_CMD_QUERY_SHORT_CIRCUIT:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                __dim_failure_status |= DALI2_L_APP_LED_FAILURE_SHORT_CIRCUIT;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                __dim_failure_status &= ~DALI2_L_APP_LED_FAILURE_SHORT_CIRCUIT;
-            } else {
+            if (evt == DALI2_L_APP_EVT_FAULT) {
                 break;
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Open Circuit
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -244,13 +332,11 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_OPEN_CIRCUIT:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                __dim_failure_status |= DALI2_L_APP_LED_FAILURE_OPEN_CIRCUIT;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                __dim_failure_status &= ~DALI2_L_APP_LED_FAILURE_OPEN_CIRCUIT;
-            } else {
+            if (evt == DALI2_L_APP_EVT_FAULT) {
                 break;
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Load Decrease
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -259,13 +345,11 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_LOAD_DECREASE:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                __dim_failure_status |= DALI2_L_APP_LED_FAILURE_LOAD_DECREASE;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                __dim_failure_status &= ~DALI2_L_APP_LED_FAILURE_LOAD_DECREASE;
-            } else {
+            if (evt == DALI2_L_APP_EVT_FAULT) {
                 break;
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Load Increase
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -274,13 +358,11 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_LOAD_INCREASE:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                __dim_failure_status |= DALI2_L_APP_LED_FAILURE_LOAD_INCREASE;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                __dim_failure_status &= ~DALI2_L_APP_LED_FAILURE_LOAD_INCREASE;
-            } else {
+            if (evt == DALI2_L_APP_EVT_FAULT) {
                 break;
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Current Protector Active
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -289,13 +371,11 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_CURRENT_PROTECTOR_ACTIVE:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                __dim_failure_status |= DALI2_L_APP_LED_FAILURE_CURRENT_PROTECTOR_ACTIVE;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                __dim_failure_status &= ~DALI2_L_APP_LED_FAILURE_CURRENT_PROTECTOR_ACTIVE;
-            } else {
+            if (evt == DALI2_L_APP_EVT_FAULT) {
                 break;
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Thermal Shut Down
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -304,13 +384,11 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_THERMAL_SHUT_DOWN:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                __dim_failure_status |= DALI2_L_APP_LED_FAILURE_THERMAL_SHUT_DOWN;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                __dim_failure_status &= ~DALI2_L_APP_LED_FAILURE_THERMAL_SHUT_DOWN;
-            } else {
+            if (evt == DALI2_L_APP_EVT_FAULT) {
                 break;
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Thermal Overload
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -319,13 +397,11 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_THERMAL_OVERLOAD:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                __dim_failure_status |= DALI2_L_APP_LED_FAILURE_THERMAL_OVERLOAD;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                __dim_failure_status &= ~DALI2_L_APP_LED_FAILURE_THERMAL_OVERLOAD;
-            } else {
+            if (evt == DALI2_L_APP_EVT_FAULT) {
                 break;
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Thermal Overload
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -334,13 +410,11 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_QUERY_REFERENCE_MEASUREMENT_FAILED:
-            if (evt == DALI2_L_APP_EVT_SUCCESS) {
-                __dim_failure_status |= DALI2_L_APP_LED_FAILURE_REFERENCE_FAILED;
-            } else if (evt == DALI2_L_APP_EVT_TIMEOUT) {
-                __dim_failure_status &= ~DALI2_L_APP_LED_FAILURE_REFERENCE_FAILED;
-            } else {
+            if (evt == DALI2_L_APP_EVT_FAULT) {
                 break;
             }
+            dali2_hal_dim_status_decode(evt_data->cmd, evt, evt_data->cmd_data.std_rsp.data,
+                                        &__dim_status, &__dim_failure_status);
 
             //! Query Failure Status
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -356,7 +430,7 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
                 break;
             }
 
-            DALI2_L_BSP_LOG("DALI Failure Status 0x%X", __dim_failure_status);
+            DALI2_LOG1(DIM_CTRL_FAILURE_STATUS, __dim_failure_status);
 
             //! Query actual level
             instr_data.std_cmd.net.method = __dim_node.method;
@@ -365,11 +439,13 @@ void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *
             break;
 
         case DALI2_L_APP_CMD_UNKNOWN:
-            //! Setting Power On level
-            instr_data.std_cmd.net.method = __dim_node.method;
-            instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
-            instr_data.std_cmd.data = __dim_target_level;
-            dali2_hal_queue_push(DALI2_L_APP_CMD_SET_POWER_ON_LEVEL_DTR0, &instr_data);
+            if (dali2_hal_retry(DALI2_HAL_RETRY_STEP_SEND, evt_data->cmd) == DALI2_HAL_RETRY_REPEAT) {
+                //! REPEAT: Setting Power On level
+                instr_data.std_cmd.net.method = __dim_node.method;
+                instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
+                instr_data.std_cmd.data = __dim_target_level;
+                dali2_hal_queue_push(DALI2_L_APP_CMD_SET_POWER_ON_LEVEL_DTR0, &instr_data);
+            }
             break;
 
         default:
@@ -409,6 +485,7 @@ dali2_ret_t dali2_hal_dim_set_level(unsigned char level, dali2_l_app_network_t *
     }
 
     memcpy(&__dim_node, node, sizeof(dali2_l_app_network_t));
+    __dim_is_set_level = 1;
 
     //! Setting Power On level
     instr_data.std_cmd.net.method = __dim_node.method;
@@ -424,14 +501,28 @@ static void __dali2_hal_update_dim_state(dali2_l_app_network_t *node)
 {
     dali2_l_app_cmd_data_t instr_data;
 
-    //! Copy metadata
-    memcpy(&__dim_node, node, sizeof(dali2_l_app_network_t));
+    //! Running query chain of the same node answers this request too
+    if (dali2_hal_mtx_check() == DALI2_HAL_EVT_DIM_CTRL &&
+        __dim_node.method == node->method && __dim_node.addr_byte == node->addr_byte) {
+        dali2_hal_cache_join();
+        return;
+    }
 
-    if (dali2_hal_mtx_check() == DALI2_HAL_EVT_FREE) {
+    //! Quarantined gear keeps the last known state
+    if (node->method == DALI2_L_NET_METHOD_SHORT_ADDRESSING && dali2_hal_quarantine_is_set(node->addr_byte)) {
+        return;
+    }
+
+    //! Background polling gives way
+    if (dali2_hal_mtx_check() == DALI2_HAL_EVT_FREE || dali2_hal_mtx_check() == DALI2_HAL_EVT_POLL) {
         if (dali2_hal_mtx_take(DALI2_HAL_EVT_DIM_CTRL) != DALI2_HAL_EVT_DIM_CTRL) {
             return;
         }
 
+        //! Copy metadata
+        memcpy(&__dim_node, node, sizeof(dali2_l_app_network_t));
+        __dim_is_set_level = 0;
+
         //! Query driver presence
         instr_data.std_cmd.net.method = __dim_node.method;
         instr_data.std_cmd.net.addr_byte = __dim_node.addr_byte;
@@ -439,9 +530,36 @@ static void __dali2_hal_update_dim_state(dali2_l_app_network_t *node)
     }
 }
 
+static dali2_ret_t __dali2_hal_dim_cached(DALI2_L_APP_CMD_T cmd, unsigned char *data, dali2_l_app_network_t *node)
+{
+    DALI2_L_APP_EVT_T evt;
+
+    if (dali2_hal_cache_get(cmd, node, &evt, data) != DALI2_RET_SUCCESS ||
+        evt != DALI2_L_APP_EVT_SUCCESS) {
+        return DALI2_RET_TIMEOUT;
+    }
+
+    return DALI2_RET_SUCCESS;
+}
+
 dali2_ret_t dali2_hal_dim_get_level(unsigned char *level, dali2_l_app_network_t *node)
 {
-    *level = (__dim_actual_level) ? __dim_actual_level - DALI2_DIM_CFG_MIN_LEVEL : __dim_actual_level;
+    unsigned char shadow_level;
+
+    //! Trusted shadow level costs no bus time
+    if (node->method == DALI2_L_NET_METHOD_SHORT_ADDRESSING &&
+        dali2_hal_dim_shadow_level_get(&shadow_level, node->addr_byte) == DALI2_RET_SUCCESS) {
+        *level = DALI2_HAL_DIM_LEVEL_FROM_ARC(shadow_level);
+        return DALI2_RET_SUCCESS;
+    }
+
+    //! So does fresh answer
+    if (__dali2_hal_dim_cached(DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL, &shadow_level, node) == DALI2_RET_SUCCESS) {
+        *level = DALI2_HAL_DIM_LEVEL_FROM_ARC(shadow_level);
+        return DALI2_RET_SUCCESS;
+    }
+
+    *level = DALI2_HAL_DIM_LEVEL_FROM_ARC(__dim_actual_level);
 
     __dali2_hal_update_dim_state(node);
 
@@ -450,6 +568,10 @@ dali2_ret_t dali2_hal_dim_get_level(unsigned char *level, dali2_l_app_network_t
 
 dali2_ret_t dali2_hal_dim_get_status(unsigned char *status, dali2_l_app_network_t *node)
 {
+    if (__dali2_hal_dim_cached(DALI2_L_APP_CMD_QUERY_STATUS, status, node) == DALI2_RET_SUCCESS) {
+        return DALI2_RET_SUCCESS;
+    }
+
     *status = __dim_status;
 
     __dali2_hal_update_dim_state(node);
@@ -459,6 +581,10 @@ dali2_ret_t dali2_hal_dim_get_status(unsigned char *status, dali2_l_app_network_
 
 dali2_ret_t dali2_hal_dim_get_led_failure_status(unsigned char *failure_status, dali2_l_app_network_t *node)
 {
+    if (__dali2_hal_dim_cached(DALI2_L_APP_CMD_QUERY_FAILURE_STATUS, failure_status, node) == DALI2_RET_SUCCESS) {
+        return DALI2_RET_SUCCESS;
+    }
+
     *failure_status = __dim_failure_status;
 
     __dali2_hal_update_dim_state(node);
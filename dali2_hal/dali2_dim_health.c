@@ -0,0 +1,214 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_dim_health.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL Dimmer health poller source file
+ *
+ * @details Gear known to be present is polled round robin with QUERY STATUS by
+ *          background poll job, QUERY FAILURE STATUS follows when lamp failure is
+ *          reported. Every node has own poll interval: failing node and node with
+ *          changed status are polled every DALI2_HAL_HEALTH_FAST_MS, interval of
+ *          stable node is doubled up to DALI2_HAL_HEALTH_SLOW_MS.
+ *          Answers of any HAL job are used, so user queries count as health polls.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+
+#define DALI2_HAL_HEALTH_NODE_COUNT         DALI2_L_NET_ADDR_SHORT_MAX
+
+//! Status bits of failing gear
+#define DALI2_HAL_HEALTH_STATUS_FAILURE     (DALI2_L_APP_CMD_STATUS_CONTROL_GEAR_FAILURE | \
+                                             DALI2_L_APP_CMD_STATUS_LAMP_FAILURE)
+
+//! Status bits changed by level commands are not health changes
+#define DALI2_HAL_HEALTH_STATUS_LEVEL       (DALI2_L_APP_CMD_STATUS_LAMP_ON | \
+                                             DALI2_L_APP_CMD_STATUS_FADE_RUNNING)
+
+typedef struct {
+    unsigned char status;
+    unsigned char failure_status;
+    unsigned char is_valid;
+    unsigned char is_failure_due;       //! LED failure query is the next one
+    unsigned int interval_ms;
+    unsigned int due_ms;
+} dali2_hal_health_node_t;
+
+//! Internal handle type
+typedef struct {
+    dali2_hal_health_node_t node[DALI2_HAL_HEALTH_NODE_COUNT];
+    dali2_hal_health_stats_t stats;
+    unsigned char is_running;
+    unsigned char next_addr;            //! Round robin position
+} dali2_hal_health_handle_t;
+
+static dali2_hal_health_handle_t __health_handle;
+
+static inline unsigned char __dali2_hal_health_is_failing(dali2_hal_health_node_t *node)
+{
+    return ((node->status & DALI2_HAL_HEALTH_STATUS_FAILURE) || node->failure_status) ? 1 : 0;
+}
+
+static void __dali2_hal_health_schedule(dali2_hal_health_node_t *node, unsigned char is_changed)
+{
+    if (is_changed || __dali2_hal_health_is_failing(node)) {
+        node->interval_ms = DALI2_HAL_HEALTH_FAST_MS;
+    } else if (node->interval_ms < DALI2_HAL_HEALTH_SLOW_MS / 2) {
+        node->interval_ms = node->interval_ms ? (node->interval_ms * 2) : DALI2_HAL_HEALTH_FAST_MS;
+    } else {
+        node->interval_ms = DALI2_HAL_HEALTH_SLOW_MS;
+    }
+
+    node->due_ms = dali2_l_bsp_time_ms_get() + node->interval_ms;
+}
+
+void dali2_hal_health_init(void)
+{
+    memset(&__health_handle, 0x00, sizeof(__health_handle));
+}
+
+unsigned char dali2_hal_health_is_running(void)
+{
+    return __health_handle.is_running;
+}
+
+void dali2_hal_health_answer(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                             DALI2_L_APP_EVT_T evt, unsigned char data)
+{
+    dali2_hal_health_node_t *node;
+    unsigned char status, failure_status, is_changed;
+
+    if (net->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING || net->addr_byte >= DALI2_HAL_HEALTH_NODE_COUNT) {
+        return;
+    }
+
+    node = &__health_handle.node[net->addr_byte];
+    status = node->status;
+    failure_status = node->failure_status;
+
+    if (!dali2_hal_dim_status_decode(cmd, evt, data, &status, &failure_status)) {
+        return;
+    }
+
+    //! POWER CYCLE SEEN is sticky, its rising edge is a change
+    is_changed = (node->is_valid &&
+                  (((status ^ node->status) & ~DALI2_HAL_HEALTH_STATUS_LEVEL) ||
+                   failure_status != node->failure_status)) ? 1 : 0;
+
+    if (is_changed) {
+        __health_handle.stats.changes++;
+    }
+
+    node->status = status;
+    node->failure_status = failure_status;
+
+    if (cmd == DALI2_L_APP_CMD_QUERY_STATUS) {
+        node->is_valid = 1;
+        node->is_failure_due = (status & DALI2_L_APP_CMD_STATUS_LAMP_FAILURE) ? 1 : 0;
+        __dali2_hal_health_schedule(node, is_changed);
+    } else if (cmd == DALI2_L_APP_CMD_QUERY_FAILURE_STATUS) {
+        node->is_failure_due = 0;
+        if (is_changed) {
+            __dali2_hal_health_schedule(node, is_changed);
+        }
+    } else if (is_changed) {
+        //! Status chain of another job has seen the change, look closer soon
+        __dali2_hal_health_schedule(node, is_changed);
+    }
+}
+
+unsigned char dali2_hal_health_next(unsigned char *short_addr, DALI2_L_APP_CMD_T *cmd)
+{
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    dali2_hal_health_node_t *node;
+    unsigned int addr, i;
+
+    if (!__health_handle.is_running) {
+        return 0;
+    }
+
+    for (i = 0; i < DALI2_HAL_HEALTH_NODE_COUNT; i++) {
+        addr = (__health_handle.next_addr + i) % DALI2_HAL_HEALTH_NODE_COUNT;
+        node = &__health_handle.node[addr];
+
+        if (!dali2_hal_watch_is_present((unsigned char) addr) || dali2_hal_quarantine_is_set((unsigned char) addr)) {
+            continue;
+        }
+
+        if (node->is_failure_due) {
+            *cmd = DALI2_L_APP_CMD_QUERY_FAILURE_STATUS;
+        } else if (!node->is_valid || (int) (now - node->due_ms) >= 0) {
+            *cmd = DALI2_L_APP_CMD_QUERY_STATUS;
+        } else {
+            continue;
+        }
+
+        *short_addr = (unsigned char) addr;
+        __health_handle.next_addr = (unsigned char) ((addr + 1) % DALI2_HAL_HEALTH_NODE_COUNT);
+        __health_handle.stats.queries++;
+        return 1;
+    }
+
+    return 0;
+}
+
+void dali2_hal_health_start(void)
+{
+    __health_handle.is_running = 1;
+}
+
+void dali2_hal_health_stop(void)
+{
+    __health_handle.is_running = 0;
+}
+
+dali2_ret_t dali2_hal_health_get(dali2_hal_health_t *health, dali2_l_app_network_t *node)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+    dali2_hal_health_node_t *health_node;
+
+    //! Verify parameters
+    if (!health || !node || node->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING ||
+        node->addr_byte >= DALI2_HAL_HEALTH_NODE_COUNT) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    health_node = &__health_handle.node[node->addr_byte];
+    if (!health_node->is_valid) {
+        dali2_ret = DALI2_RET_NOT_SUPPORTED;
+        goto __ret;
+    }
+
+    health->status = health_node->status;
+    health->failure_status = health_node->failure_status;
+    health->is_failing = __dali2_hal_health_is_failing(health_node);
+    health->interval_ms = health_node->interval_ms;
+
+__ret:
+    return dali2_ret;
+}
+
+void dali2_hal_health_stats_get(dali2_hal_health_stats_t *stats)
+{
+    unsigned int i;
+
+    if (!stats) {
+        return;
+    }
+
+    memcpy(stats, &__health_handle.stats, sizeof(dali2_hal_health_stats_t));
+
+    stats->failing = 0;
+    for (i = 0; i < DALI2_HAL_HEALTH_NODE_COUNT; i++) {
+        if (__health_handle.node[i].is_valid && __dali2_hal_health_is_failing(&__health_handle.node[i])) {
+            stats->failing++;
+        }
+    }
+}
@@ -0,0 +1,611 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_dim_shadow.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL Dimmer shadow state source file
+ *
+ * @details Actual level of every short address is predicted from forward frames
+ *          delivered on the line, own frames and frames of other masters, and is
+ *          confirmed by answers of own queries. Group membership, scene levels,
+ *          limits, fade time and DTR0 are learned the same way.
+ *
+ *          Value of gear with unknown group membership is dropped by group command,
+ *          level during fade is interpolated only when both ends are known.
+ *          Level is trusted for DALI2_HAL_SHADOW_OBSERVED_TTL_MS after answer and for
+ *          DALI2_HAL_SHADOW_PREDICTED_TTL_MS after prediction has settled.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+
+#include "dali2_spec_cmd_list.h"
+#include "dali2_std_cmd_list.h"
+
+#define DALI2_HAL_SHADOW_NODE_COUNT         DALI2_L_NET_ADDR_SHORT_MAX
+#define DALI2_HAL_SHADOW_GROUP_COUNT        16
+#define DALI2_HAL_SHADOW_FADE_MAX           15
+
+#define DALI2_HAL_SHADOW_LEVEL_MAX          0xFE
+#define DALI2_HAL_SHADOW_MASK               0xFF
+
+//! Known values of node
+#define DALI2_HAL_SHADOW_LEVEL              0x01
+#define DALI2_HAL_SHADOW_FROM_LEVEL         0x02    //! Level at fade start
+#define DALI2_HAL_SHADOW_MAX_LEVEL          0x04
+#define DALI2_HAL_SHADOW_MIN_LEVEL          0x08
+#define DALI2_HAL_SHADOW_FADE               0x10
+#define DALI2_HAL_SHADOW_EXT_FADE           0x20
+#define DALI2_HAL_SHADOW_PREDICTED          0x40    //! Level is predicted, not answered
+
+//! Fade time 1 - 15, IEC 62386-102 Table 5
+static const unsigned int __shadow_fade_ms[] = {
+    0, 707, 1000, 1414, 2000, 2828, 4000, 5657, 8000, 11314, 16000, 22627, 32000, 45255, 64000, 90510
+};
+
+//! Extended fade time multiplier
+static const unsigned int __shadow_ext_fade_mul_ms[] = { 0, 100, 1000, 10000, 60000 };
+
+//! Node shadow state
+typedef struct {
+    unsigned char known;
+    unsigned char level;                //! Target level of the last command
+    unsigned char from_level;
+    unsigned char max_level;
+    unsigned char min_level;
+    unsigned char fade;                 //! Fade time code
+    unsigned short groups;
+    unsigned short groups_known;        //! Bit per group
+    unsigned short scenes_known;        //! Bit per scene
+    unsigned char scene[DALI2_L_APP_CMD_SCENE_COUNT];
+    unsigned int ext_fade_ms;
+    unsigned int update_ms;             //! Level update, fade start
+    unsigned int fade_ms;
+    unsigned int expire_ms;
+} dali2_hal_shadow_node_t;
+
+//! Internal handle type
+typedef struct {
+    dali2_hal_shadow_node_t node[DALI2_HAL_SHADOW_NODE_COUNT];
+    unsigned char dtr0;
+    unsigned char is_dtr0;
+} dali2_hal_shadow_handle_t;
+
+static dali2_hal_shadow_handle_t __shadow_handle;
+
+static inline unsigned char __dali2_hal_shadow_is_before(unsigned int now_ms, unsigned int at_ms)
+{
+    return ((int) (at_ms - now_ms) > 0) ? 1 : 0;
+}
+
+static void __dali2_hal_shadow_level_drop(dali2_hal_shadow_node_t *node)
+{
+    node->known &= ~(DALI2_HAL_SHADOW_LEVEL | DALI2_HAL_SHADOW_FROM_LEVEL | DALI2_HAL_SHADOW_PREDICTED);
+}
+
+//! Level answered by gear
+static void __dali2_hal_shadow_level_observed(dali2_hal_shadow_node_t *node, unsigned char level)
+{
+    if (level == DALI2_HAL_SHADOW_MASK) {
+        __dali2_hal_shadow_level_drop(node);
+        return;
+    }
+
+    node->level = level;
+    node->known |= DALI2_HAL_SHADOW_LEVEL;
+    node->known &= ~(DALI2_HAL_SHADOW_FROM_LEVEL | DALI2_HAL_SHADOW_PREDICTED);
+    node->update_ms = dali2_l_bsp_time_ms_get();
+    node->fade_ms = 0;
+    node->expire_ms = node->update_ms + DALI2_HAL_SHADOW_OBSERVED_TTL_MS;
+}
+
+static unsigned int __dali2_hal_shadow_fade_ms(dali2_hal_shadow_node_t *node, unsigned char *is_known)
+{
+    *is_known = 0;
+
+    if (!(node->known & DALI2_HAL_SHADOW_FADE)) {
+        return __shadow_fade_ms[DALI2_HAL_SHADOW_FADE_MAX];
+    }
+
+    //! Fade time 0 is extended fade time
+    if (node->fade) {
+        *is_known = 1;
+        return __shadow_fade_ms[node->fade];
+    }
+
+    if (!(node->known & DALI2_HAL_SHADOW_EXT_FADE)) {
+        return __shadow_fade_ms[DALI2_HAL_SHADOW_FADE_MAX];
+    }
+
+    *is_known = 1;
+    return node->ext_fade_ms;
+}
+
+//! Level predicted from forward frame, fade is not used by OFF and RECALL commands
+static void __dali2_hal_shadow_level_predicted(dali2_hal_shadow_node_t *node, unsigned char level, unsigned char is_fade)
+{
+    unsigned char is_fade_known = 1;
+    unsigned int fade_ms = 0;
+
+    //! Gear keeps level within limits
+    if (level) {
+        if ((node->known & DALI2_HAL_SHADOW_MAX_LEVEL) && level > node->max_level) {
+            level = node->max_level;
+        }
+        if ((node->known & DALI2_HAL_SHADOW_MIN_LEVEL) && level < node->min_level) {
+            level = node->min_level;
+        }
+    }
+
+    if (is_fade) {
+        fade_ms = __dali2_hal_shadow_fade_ms(node, &is_fade_known);
+    }
+
+    //! Fade starts from the current level
+    if ((node->known & DALI2_HAL_SHADOW_LEVEL) && is_fade_known && fade_ms &&
+        dali2_hal_dim_shadow_level_get(&node->from_level, (unsigned char) (node - __shadow_handle.node)) == DALI2_RET_SUCCESS) {
+        node->known |= DALI2_HAL_SHADOW_FROM_LEVEL;
+    } else {
+        node->known &= ~DALI2_HAL_SHADOW_FROM_LEVEL;
+    }
+
+    node->level = level;
+    node->known |= DALI2_HAL_SHADOW_LEVEL | DALI2_HAL_SHADOW_PREDICTED;
+    node->update_ms = dali2_l_bsp_time_ms_get();
+    node->fade_ms = fade_ms;
+    node->expire_ms = node->update_ms + fade_ms + DALI2_HAL_SHADOW_PREDICTED_TTL_MS;
+}
+
+static void __dali2_hal_shadow_scene(dali2_hal_shadow_node_t *node, unsigned char scene)
+{
+    if (!(node->scenes_known & (1 << scene))) {
+        __dali2_hal_shadow_level_drop(node);
+        return;
+    }
+
+    //! Gear out of scene keeps its level
+    if (node->scene[scene] != DALI2_HAL_SHADOW_MASK) {
+        __dali2_hal_shadow_level_predicted(node, node->scene[scene], 1);
+    }
+}
+
+static void __dali2_hal_shadow_reset(dali2_hal_shadow_node_t *node)
+{
+    node->known = DALI2_HAL_SHADOW_MAX_LEVEL | DALI2_HAL_SHADOW_FADE | DALI2_HAL_SHADOW_EXT_FADE;
+    node->max_level = DALI2_HAL_SHADOW_LEVEL_MAX;
+    node->fade = 0;
+    node->ext_fade_ms = 0;
+    node->groups = 0;
+    node->groups_known = 0xFFFF;
+    node->scenes_known = 0xFFFF;
+    memset(node->scene, DALI2_HAL_SHADOW_MASK, sizeof(node->scene));
+    __dali2_hal_shadow_level_predicted(node, DALI2_HAL_SHADOW_LEVEL_MAX, 0);
+}
+
+//! Standard command of node. Node is not sure to be addressed by group of unknown membership,
+//! so every value the command changes is dropped then.
+static void __dali2_hal_shadow_std_cmd(dali2_hal_shadow_node_t *node, unsigned char opcode, unsigned char is_sure)
+{
+    unsigned char dtr0 = __shadow_handle.dtr0;
+    unsigned char is_dtr0 = __shadow_handle.is_dtr0 && is_sure;
+    unsigned char index = opcode & 0x0F;
+
+    switch (opcode & 0xF0) {
+        case DALI2_L_APP_STD_CMD_GO_TO_SCENE:
+            if (is_sure) {
+                __dali2_hal_shadow_scene(node, index);
+            } else {
+                __dali2_hal_shadow_level_drop(node);
+            }
+            return;
+
+        case DALI2_L_APP_STD_CMD_SET_SCENE_DTR0:
+            if (is_dtr0) {
+                node->scene[index] = dtr0;
+                node->scenes_known |= 1 << index;
+            } else {
+                node->scenes_known &= ~(1 << index);
+            }
+            return;
+
+        case DALI2_L_APP_STD_CMD_REMOVE_FROM_SCENE:
+            if (is_sure) {
+                node->scene[index] = DALI2_HAL_SHADOW_MASK;
+                node->scenes_known |= 1 << index;
+            } else {
+                node->scenes_known &= ~(1 << index);
+            }
+            return;
+
+        case DALI2_L_APP_STD_CMD_ADD_TO_GROUP:
+        case DALI2_L_APP_STD_CMD_REMOVE_FROM_GROUP:
+            if (is_sure) {
+                node->groups_known |= 1 << index;
+                if ((opcode & 0xF0) == DALI2_L_APP_STD_CMD_ADD_TO_GROUP) {
+                    node->groups |= 1 << index;
+                } else {
+                    node->groups &= ~(1 << index);
+                }
+            } else {
+                node->groups_known &= ~(1 << index);
+            }
+            return;
+
+        default:
+            break;
+    }
+
+    switch (opcode) {
+        case DALI2_L_APP_STD_CMD_OFF:
+            if (is_sure) {
+                __dali2_hal_shadow_level_predicted(node, 0, 0);
+            } else {
+                __dali2_hal_shadow_level_drop(node);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_RECALL_MAX_LEVEL:
+            if (is_sure && (node->known & DALI2_HAL_SHADOW_MAX_LEVEL)) {
+                __dali2_hal_shadow_level_predicted(node, node->max_level, 0);
+            } else {
+                __dali2_hal_shadow_level_drop(node);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_RECALL_MIN_LEVEL:
+            if (is_sure && (node->known & DALI2_HAL_SHADOW_MIN_LEVEL)) {
+                __dali2_hal_shadow_level_predicted(node, node->min_level, 0);
+            } else {
+                __dali2_hal_shadow_level_drop(node);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_UP:
+        case DALI2_L_APP_STD_CMD_DOWN:
+        case DALI2_L_APP_STD_CMD_STEP_UP:
+        case DALI2_L_APP_STD_CMD_STEP_DOWN:
+        case DALI2_L_APP_STD_CMD_STEP_DOWN_AND_OFF:
+        case DALI2_L_APP_STD_CMD_ON_AND_STEP_UP:
+        case DALI2_L_APP_STD_CMD_GO_TO_LAST_ACTIVE_LEVEL:
+            //! Level depends on gear history
+            __dali2_hal_shadow_level_drop(node);
+            break;
+
+        case DALI2_L_APP_STD_CMD_RESET:
+            if (is_sure) {
+                __dali2_hal_shadow_reset(node);
+            } else {
+                memset(node, 0x00, sizeof(dali2_hal_shadow_node_t));
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_STORE_ACTUAL_LEVEL_IN_DTR0:
+            //! DTR0 of gear differs from now
+            __shadow_handle.is_dtr0 = 0;
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_MAX_LEVEL_DTR0:
+        case DALI2_L_APP_STD_CMD_SET_MIN_LEVEL_DTR0:
+            //! Gear corrects limits and level by physical minimum, values are queried again
+            node->known &= ~((opcode == DALI2_L_APP_STD_CMD_SET_MAX_LEVEL_DTR0) ?
+                             DALI2_HAL_SHADOW_MAX_LEVEL : DALI2_HAL_SHADOW_MIN_LEVEL);
+            __dali2_hal_shadow_level_drop(node);
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_FADE_TIME_DTR0:
+            if (is_dtr0) {
+                node->fade = (dtr0 < DALI2_HAL_SHADOW_FADE_MAX) ? dtr0 : DALI2_HAL_SHADOW_FADE_MAX;
+                node->known |= DALI2_HAL_SHADOW_FADE;
+            } else {
+                node->known &= ~DALI2_HAL_SHADOW_FADE;
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_EXTENDED_FADE_TIME_DTR0:
+            if (is_dtr0) {
+                //! Base 1 - 16 in lower nibble, invalid multiplier disables extended fade time
+                node->ext_fade_ms = ((dtr0 >> 4) < sizeof(__shadow_ext_fade_mul_ms) / sizeof(__shadow_ext_fade_mul_ms[0])) ?
+                                    ((dtr0 & 0x0F) + 1) * __shadow_ext_fade_mul_ms[dtr0 >> 4] : 0;
+                node->known |= DALI2_HAL_SHADOW_EXT_FADE;
+            } else {
+                node->known &= ~DALI2_HAL_SHADOW_EXT_FADE;
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_SHORT_ADDRESS_DTR0:
+            //! Another gear may answer on this address from now
+            memset(node, 0x00, sizeof(dali2_hal_shadow_node_t));
+            break;
+
+        default:
+            break;
+    }
+}
+
+//! Answer of own query to short address
+static void __dali2_hal_shadow_answer(dali2_hal_shadow_node_t *node, unsigned char opcode,
+                                      unsigned char is_answer, unsigned char answer)
+{
+    //! Scene level
+    if ((opcode & 0xF0) == DALI2_L_APP_STD_CMD_QUERY_SCENE_LEVEL) {
+        if (is_answer) {
+            node->scene[opcode & 0x0F] = answer;
+            node->scenes_known |= 1 << (opcode & 0x0F);
+        }
+        return;
+    }
+
+    switch (opcode) {
+        case DALI2_L_APP_STD_CMD_QUERY_ACTUAL_LEVEL:
+            if (is_answer) {
+                __dali2_hal_shadow_level_observed(node, answer);
+            } else {
+                //! No gear on the address
+                __dali2_hal_shadow_level_drop(node);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_MAX_LEVEL:
+            if (is_answer) {
+                node->max_level = answer;
+                node->known |= DALI2_HAL_SHADOW_MAX_LEVEL;
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_MIN_LEVEL:
+            if (is_answer) {
+                node->min_level = answer;
+                node->known |= DALI2_HAL_SHADOW_MIN_LEVEL;
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_FADE_TIME_FADE_RATE:
+            if (is_answer) {
+                node->fade = answer >> 4;
+                node->known |= DALI2_HAL_SHADOW_FADE;
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_GROUPS_0_7:
+            if (is_answer) {
+                node->groups = (node->groups & 0xFF00) | answer;
+                node->groups_known |= 0x00FF;
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_GROUPS_8_15:
+            if (is_answer) {
+                node->groups = (node->groups & 0x00FF) | (answer << 8);
+                node->groups_known |= 0xFF00;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void __dali2_hal_shadow_special(unsigned char opcode, unsigned char data)
+{
+    switch (opcode) {
+        case DALI2_L_APP_SPEC_CMD_DTR0:
+            __shadow_handle.dtr0 = data;
+            __shadow_handle.is_dtr0 = 1;
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_PROGRAM_SHORT_ADDRESS:
+            //! Another gear may answer on this address from now
+            if (data != DALI2_HAL_SHADOW_MASK) {
+                memset(&__shadow_handle.node[(data >> 1) & 0x3F], 0x00, sizeof(dali2_hal_shadow_node_t));
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void dali2_hal_dim_shadow_tap(const dali2_l_ses_tap_t *tap)
+{
+    unsigned char addr = (unsigned char) (tap->forward >> 8);
+    unsigned char opcode = (unsigned char) tap->forward;
+    unsigned char group;
+    unsigned int i;
+    dali2_hal_shadow_node_t *node;
+
+    //! Control gear frames only, 24 bit frames are for control devices
+    if (tap->bits != DALI2_L_PHY_FORWARD_16BIT_SIZE) {
+        return;
+    }
+
+    //! Special command: 101X XXX1 and 110X XXX1
+    if (addr >= 0xA0 && addr <= 0xCB) {
+        __dali2_hal_shadow_special(addr, opcode);
+        return;
+    }
+
+    //! Short address: 0AAA AAAS
+    if (!(addr & 0x80)) {
+        node = &__shadow_handle.node[addr >> 1];
+
+        if (!(addr & 0x01)) {
+            //! DAPC, MASK stops fading on unknown level
+            if (opcode == DALI2_HAL_SHADOW_MASK) {
+                __dali2_hal_shadow_level_drop(node);
+            } else {
+                __dali2_hal_shadow_level_predicted(node, opcode, 1);
+            }
+        } else if (tap->is_query) {
+            __dali2_hal_shadow_answer(node, opcode, tap->is_answer, tap->backward);
+        } else {
+            __dali2_hal_shadow_std_cmd(node, opcode, 1);
+        }
+        return;
+    }
+
+    //! Queries to group and broadcast are not assigned to node
+    if (tap->is_query) {
+        return;
+    }
+
+    if ((addr & 0xE0) == 0x80) {
+        //! Group address: 100G GGGS
+        group = (addr >> 1) & 0x0F;
+    } else if ((addr & 0xFE) == 0xFE) {
+        //! Broadcast
+        group = DALI2_HAL_SHADOW_GROUP_COUNT;
+    } else {
+        //! Broadcast unaddressed and reserved
+        return;
+    }
+
+    for (i = 0; i < DALI2_HAL_SHADOW_NODE_COUNT; i++) {
+        node = &__shadow_handle.node[i];
+
+        if (group < DALI2_HAL_SHADOW_GROUP_COUNT) {
+            //! Node is out of the group
+            if ((node->groups_known & (1 << group)) && !(node->groups & (1 << group))) {
+                continue;
+            }
+
+            //! Membership is not known, command may be applied or not
+            if (!(node->groups_known & (1 << group))) {
+                if (!(addr & 0x01)) {
+                    __dali2_hal_shadow_level_drop(node);
+                } else {
+                    __dali2_hal_shadow_std_cmd(node, opcode, 0);
+                }
+                continue;
+            }
+        }
+
+        if (!(addr & 0x01)) {
+            if (opcode == DALI2_HAL_SHADOW_MASK) {
+                __dali2_hal_shadow_level_drop(node);
+            } else {
+                __dali2_hal_shadow_level_predicted(node, opcode, 1);
+            }
+        } else {
+            __dali2_hal_shadow_std_cmd(node, opcode, 1);
+        }
+    }
+}
+
+void dali2_hal_dim_shadow_init(void)
+{
+    memset(&__shadow_handle, 0x00, sizeof(__shadow_handle));
+}
+
+void dali2_hal_dim_shadow_flush(void)
+{
+    //! Levels, groups, scenes and fade are learned again from the next frames and answers
+    memset(&__shadow_handle, 0x00, sizeof(__shadow_handle));
+}
+
+dali2_ret_t dali2_hal_dim_shadow_level_get(unsigned char *level, unsigned char short_addr)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+    dali2_hal_shadow_node_t *node;
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    unsigned int elapsed;
+
+    //! Verify parameters
+    if (!level || short_addr >= DALI2_HAL_SHADOW_NODE_COUNT) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    node = &__shadow_handle.node[short_addr];
+
+    //! Level is not known or confidence has expired
+    if (!(node->known & DALI2_HAL_SHADOW_LEVEL) || !__dali2_hal_shadow_is_before(now, node->expire_ms)) {
+        dali2_ret = DALI2_RET_TIMEOUT;
+        goto __ret;
+    }
+
+    elapsed = now - node->update_ms;
+    if (elapsed >= node->fade_ms) {
+        *level = node->level;
+        goto __ret;
+    }
+
+    //! Fade is linear on arc power level, switching off and on is not
+    if (!(node->known & DALI2_HAL_SHADOW_FROM_LEVEL) || !node->from_level || !node->level) {
+        dali2_ret = DALI2_RET_BUSY;
+        goto __ret;
+    }
+
+    *level = (unsigned char) ((int) node->from_level +
+                              ((int) node->level - (int) node->from_level) * (int) elapsed / (int) node->fade_ms);
+
+__ret:
+    return dali2_ret;
+}
+
+unsigned char dali2_hal_dim_shadow_is_member(unsigned char short_addr, unsigned char group)
+{
+    dali2_hal_shadow_node_t *node;
+
+    if (short_addr >= DALI2_HAL_SHADOW_NODE_COUNT || group >= DALI2_HAL_SHADOW_GROUP_COUNT) {
+        return 0;
+    }
+
+    node = &__shadow_handle.node[short_addr];
+
+    return (!(node->groups_known & (1 << group)) || (node->groups & (1 << group))) ? 1 : 0;
+}
+
+dali2_ret_t dali2_hal_dim_shadow_fade_ms_get(unsigned int *fade_ms, unsigned char short_addr)
+{
+    unsigned char is_known;
+
+    //! Verify parameters
+    if (!fade_ms || short_addr >= DALI2_HAL_SHADOW_NODE_COUNT) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    *fade_ms = __dali2_hal_shadow_fade_ms(&__shadow_handle.node[short_addr], &is_known);
+
+    return is_known ? DALI2_RET_SUCCESS : DALI2_RET_TIMEOUT;
+}
+
+dali2_ret_t dali2_hal_dim_shadow_get(dali2_hal_dim_shadow_t *shadow, dali2_l_app_network_t *node)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+    dali2_hal_shadow_node_t *shadow_node;
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    unsigned char level;
+
+    //! Verify parameters
+    if (!shadow || !node || node->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING ||
+        node->addr_byte >= DALI2_HAL_SHADOW_NODE_COUNT) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    shadow_node = &__shadow_handle.node[node->addr_byte];
+    memset(shadow, 0x00, sizeof(dali2_hal_dim_shadow_t));
+
+    dali2_ret = dali2_hal_dim_shadow_level_get(&level, node->addr_byte);
+    if (dali2_ret == DALI2_RET_SUCCESS) {
+        shadow->level = DALI2_HAL_DIM_LEVEL_FROM_ARC(level);
+        shadow->confidence_ms = shadow_node->expire_ms - now;
+    } else if (!(shadow_node->known & DALI2_HAL_SHADOW_LEVEL)) {
+        dali2_ret = DALI2_RET_NOT_SUPPORTED;
+        goto __ret;
+    }
+
+    //! Expired and fading values are reported with their age
+    shadow->is_predicted = (shadow_node->known & DALI2_HAL_SHADOW_PREDICTED) ? 1 : 0;
+    shadow->age_ms = now - shadow_node->update_ms;
+    shadow->groups = shadow_node->groups;
+    shadow->groups_known = shadow_node->groups_known;
+
+__ret:
+    return dali2_ret;
+}
@@ -0,0 +1,471 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_dim_watch.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL Dimmer attribute subscription source file
+ *
+ * @details Every (short address, attribute) pair keeps the last answer and its time.
+ *          Answers of any HAL job refresh it, trusted shadow level refreshes level
+ *          without bus time. Background poll job queries only pairs covered by
+ *          subscriptions, the most overdue pair first, when its age exceeds the
+ *          smallest maximum age of covering subscriptions. So overlapping
+ *          subscriptions share one query.
+ *
+ *          Group and broadcast subscriptions cover gear known to be present,
+ *          group membership comes from shadow state, unknown membership is covered.
+ *          While such subscription exists, absent addresses are probed slowly.
+ *
+ *          Health poller queries are sent by the same job when no subscribed
+ *          attribute is due. Every poll job query is followed by quiet time, so
+ *          background polling takes DALI2_HAL_POLL_SHARE_PCT of bus time at most.
+ *          Quarantined gear is not polled, it gets rechecks only.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+
+#define DALI2_HAL_WATCH_NODE_COUNT          DALI2_L_NET_ADDR_SHORT_MAX
+#define DALI2_HAL_WATCH_ATTR_COUNT          3
+#define DALI2_HAL_WATCH_GROUP_COUNT         16
+
+//! Slot is not covered by any subscription
+#define DALI2_HAL_WATCH_AGE_NONE            0
+
+//! Poll job query which is not attribute one
+#define DALI2_HAL_WATCH_JOB_PROBE           DALI2_HAL_WATCH_ATTR_COUNT
+#define DALI2_HAL_WATCH_JOB_HEALTH          (DALI2_HAL_WATCH_ATTR_COUNT + 1)
+#define DALI2_HAL_WATCH_JOB_RECHECK         (DALI2_HAL_WATCH_ATTR_COUNT + 2)
+
+//! Query of attribute, the same order as attribute bits
+static const DALI2_L_APP_CMD_T __watch_attr_cmd[DALI2_HAL_WATCH_ATTR_COUNT] = {
+    DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL,
+    DALI2_L_APP_CMD_QUERY_STATUS,
+    DALI2_L_APP_CMD_QUERY_FAILURE_STATUS
+};
+
+//! The last answer of attribute
+typedef struct {
+    unsigned char value;
+    unsigned char is_answered;
+    unsigned char is_valid;
+    unsigned char is_changed;           //! Subscribers are not notified yet
+    unsigned int stamp_ms;              //! The last answer
+    unsigned int hold_ms;               //! Not polled before, set by transmission fault
+} dali2_hal_watch_slot_t;
+
+typedef struct {
+    dali2_hal_watch_slot_t slot[DALI2_HAL_WATCH_ATTR_COUNT];
+    unsigned char is_present;
+    unsigned char is_probed;
+    unsigned int probe_ms;
+} dali2_hal_watch_node_t;
+
+typedef struct {
+    dali2_l_app_network_t target;
+    dali2_hal_watch_func_t func;
+    unsigned int max_age_ms;
+    unsigned char attrs;
+    unsigned char is_used;
+} dali2_hal_watch_sub_t;
+
+//! Internal handle type
+typedef struct {
+    dali2_hal_watch_sub_t sub[DALI2_HAL_WATCH_COUNT];
+    dali2_hal_watch_node_t node[DALI2_HAL_WATCH_NODE_COUNT];
+    dali2_hal_watch_stats_t stats;
+
+    //! Query of running poll job
+    unsigned char poll_addr;
+    unsigned char poll_attr;            //! Attribute or DALI2_HAL_WATCH_JOB_*
+    unsigned int poll_us;               //! Query push time
+
+    //! Poll job waits till then to keep its bus share
+    unsigned int quiet_ms;
+
+    unsigned char probe_addr;
+    unsigned int probe_ms;
+} dali2_hal_watch_handle_t;
+
+static dali2_hal_watch_handle_t __watch_handle;
+
+static inline unsigned char __dali2_hal_watch_is_before(unsigned int now_ms, unsigned int at_ms)
+{
+    return ((int) (at_ms - now_ms) > 0) ? 1 : 0;
+}
+
+static unsigned char __dali2_hal_watch_covers(dali2_hal_watch_sub_t *sub, unsigned char addr)
+{
+    switch (sub->target.method) {
+        case DALI2_L_NET_METHOD_SHORT_ADDRESSING:
+            return (sub->target.addr_byte == addr) ? 1 : 0;
+
+        case DALI2_L_NET_METHOD_GROUP_ADDRESSING:
+            return (__watch_handle.node[addr].is_present &&
+                    dali2_hal_dim_shadow_is_member(addr, sub->target.addr_byte)) ? 1 : 0;
+
+        case DALI2_L_NET_METHOD_BROADCAST:
+            return __watch_handle.node[addr].is_present;
+
+        default:
+            return 0;
+    }
+}
+
+//! The smallest maximum age of subscriptions covering node attribute
+static unsigned int __dali2_hal_watch_age_ms(unsigned char addr, unsigned char attr)
+{
+    unsigned int age_ms = DALI2_HAL_WATCH_AGE_NONE;
+    dali2_hal_watch_sub_t *sub;
+    unsigned int i;
+
+    for (i = 0; i < DALI2_HAL_WATCH_COUNT; i++) {
+        sub = &__watch_handle.sub[i];
+
+        if (!sub->is_used || !(sub->attrs & (1 << attr)) || !__dali2_hal_watch_covers(sub, addr)) {
+            continue;
+        }
+
+        if (age_ms == DALI2_HAL_WATCH_AGE_NONE || sub->max_age_ms < age_ms) {
+            age_ms = sub->max_age_ms;
+        }
+    }
+
+    return age_ms;
+}
+
+static void __dali2_hal_watch_store(unsigned char addr, unsigned char attr, unsigned char is_answered,
+                                    unsigned char value)
+{
+    dali2_hal_watch_slot_t *slot = &__watch_handle.node[addr].slot[attr];
+
+    if (!slot->is_valid || slot->is_answered != is_answered || (is_answered && slot->value != value)) {
+        slot->is_changed = 1;
+    }
+
+    slot->value = value;
+    slot->is_answered = is_answered;
+    slot->is_valid = 1;
+    slot->stamp_ms = dali2_l_bsp_time_ms_get();
+}
+
+static void __dali2_hal_watch_notify(void)
+{
+    dali2_hal_watch_evt_t evt;
+    dali2_hal_watch_slot_t *slot;
+    dali2_hal_watch_sub_t *sub;
+    unsigned int addr, attr, i;
+
+    for (addr = 0; addr < DALI2_HAL_WATCH_NODE_COUNT; addr++) {
+        for (attr = 0; attr < DALI2_HAL_WATCH_ATTR_COUNT; attr++) {
+            slot = &__watch_handle.node[addr].slot[attr];
+            if (!slot->is_changed) {
+                continue;
+            }
+            slot->is_changed = 0;
+
+            evt.short_addr = (unsigned char) addr;
+            evt.attr = (DALI2_HAL_ATTR_T) (1 << attr);
+            evt.is_answered = slot->is_answered;
+            evt.value = slot->value;
+
+            for (i = 0; i < DALI2_HAL_WATCH_COUNT; i++) {
+                sub = &__watch_handle.sub[i];
+
+                if (sub->is_used && (sub->attrs & evt.attr) && __dali2_hal_watch_covers(sub, (unsigned char) addr)) {
+                    __watch_handle.stats.notified++;
+                    sub->func(&evt);
+                }
+            }
+        }
+    }
+}
+
+static unsigned char __dali2_hal_watch_is_discovery(void)
+{
+    unsigned int i;
+
+    if (dali2_hal_health_is_running()) {
+        return 1;
+    }
+
+    for (i = 0; i < DALI2_HAL_WATCH_COUNT; i++) {
+        if (__watch_handle.sub[i].is_used &&
+            __watch_handle.sub[i].target.method != DALI2_L_NET_METHOD_SHORT_ADDRESSING) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+static void __dali2_hal_watch_push(unsigned char addr, unsigned char attr, DALI2_L_APP_CMD_T cmd)
+{
+    dali2_l_app_cmd_data_t instr_data;
+
+    if (dali2_hal_mtx_take(DALI2_HAL_EVT_POLL) != DALI2_HAL_EVT_POLL) {
+        return;
+    }
+
+    __watch_handle.poll_addr = addr;
+    __watch_handle.poll_attr = attr;
+    __watch_handle.poll_us = dali2_l_bsp_time_us_get();
+
+    memset(&instr_data, 0x00, sizeof(instr_data));
+    instr_data.std_cmd.net.method = DALI2_L_NET_METHOD_SHORT_ADDRESSING;
+    instr_data.std_cmd.net.addr_byte = addr;
+    dali2_hal_queue_push(cmd, &instr_data);
+}
+
+void dali2_hal_watch_init(void)
+{
+    memset(&__watch_handle, 0x00, sizeof(__watch_handle));
+}
+
+void dali2_hal_watch_answer(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                            DALI2_L_APP_EVT_T evt, unsigned char data)
+{
+    unsigned int attr;
+
+    if (net->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING || net->addr_byte >= DALI2_HAL_WATCH_NODE_COUNT ||
+        evt == DALI2_L_APP_EVT_FAULT) {
+        return;
+    }
+
+    //! Any answer tells gear is here
+    if (evt == DALI2_L_APP_EVT_SUCCESS) {
+        __watch_handle.node[net->addr_byte].is_present = 1;
+    }
+
+    for (attr = 0; attr < DALI2_HAL_WATCH_ATTR_COUNT; attr++) {
+        if (__watch_attr_cmd[attr] == cmd) {
+            __dali2_hal_watch_store(net->addr_byte, (unsigned char) attr,
+                                    (evt == DALI2_L_APP_EVT_SUCCESS) ? 1 : 0, data);
+            break;
+        }
+    }
+}
+
+void dali2_hal_watch_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data)
+{
+    dali2_hal_watch_node_t *node = &__watch_handle.node[__watch_handle.poll_addr];
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    unsigned int busy_ms;
+
+    if (__watch_handle.poll_attr < DALI2_HAL_WATCH_ATTR_COUNT) {
+        //! Faulty line is not queried again at once
+        if (evt == DALI2_L_APP_EVT_FAULT) {
+            node->slot[__watch_handle.poll_attr].hold_ms = now + DALI2_HAL_WATCH_RETRY_MS;
+        }
+    } else if (__watch_handle.poll_attr == DALI2_HAL_WATCH_JOB_PROBE && evt != DALI2_L_APP_EVT_FAULT) {
+        node->is_probed = 1;
+        node->probe_ms = now;
+    }
+
+    //! Bus share of background polling is limited
+    busy_ms = (dali2_l_bsp_time_us_get() - __watch_handle.poll_us) / 1000;
+    __watch_handle.quiet_ms = now + busy_ms * (100 - DALI2_HAL_POLL_SHARE_PCT) / DALI2_HAL_POLL_SHARE_PCT;
+
+    //! Single query per job, free mutex
+    dali2_hal_mtx_give();
+}
+
+void dali2_hal_watch_poll(void)
+{
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    unsigned int age_ms, overdue_ms, best_overdue_ms = 0;
+    unsigned char best_addr = 0, best_attr = DALI2_HAL_WATCH_ATTR_COUNT;
+    unsigned char level;
+    DALI2_L_APP_CMD_T cmd;
+    dali2_hal_watch_slot_t *slot;
+    dali2_hal_watch_node_t *node;
+    unsigned int addr, attr, i;
+
+    __dali2_hal_watch_notify();
+
+    for (addr = 0; addr < DALI2_HAL_WATCH_NODE_COUNT; addr++) {
+        for (attr = 0; attr < DALI2_HAL_WATCH_ATTR_COUNT; attr++) {
+            slot = &__watch_handle.node[addr].slot[attr];
+
+            age_ms = __dali2_hal_watch_age_ms((unsigned char) addr, (unsigned char) attr);
+            if (age_ms == DALI2_HAL_WATCH_AGE_NONE || dali2_hal_quarantine_is_set((unsigned char) addr) ||
+                (slot->is_valid && (now - slot->stamp_ms) < age_ms) ||
+                __dali2_hal_watch_is_before(now, slot->hold_ms)) {
+                continue;
+            }
+
+            //! Trusted shadow level costs no bus time
+            if (__watch_attr_cmd[attr] == DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL &&
+                dali2_hal_dim_shadow_level_get(&level, (unsigned char) addr) == DALI2_RET_SUCCESS) {
+                __watch_handle.stats.shadow++;
+                __dali2_hal_watch_store((unsigned char) addr, (unsigned char) attr, 1, level);
+                continue;
+            }
+
+            //! Never answered slot is the most overdue
+            overdue_ms = slot->is_valid ? (now - slot->stamp_ms) - age_ms + 1 : 0xFFFFFFFF;
+            if (overdue_ms > best_overdue_ms) {
+                best_overdue_ms = overdue_ms;
+                best_addr = (unsigned char) addr;
+                best_attr = (unsigned char) attr;
+            }
+        }
+    }
+
+    //! Shadow refresh may have changed values
+    __dali2_hal_watch_notify();
+
+    if (__dali2_hal_watch_is_before(now, __watch_handle.quiet_ms)) {
+        return;
+    }
+
+    //! Single cheap recheck of quarantined gear goes first
+    if (dali2_hal_quarantine_next(&best_addr)) {
+        __dali2_hal_watch_push(best_addr, DALI2_HAL_WATCH_JOB_RECHECK, DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_PRESENT);
+        return;
+    }
+
+    if (best_attr < DALI2_HAL_WATCH_ATTR_COUNT) {
+        __watch_handle.stats.queries++;
+        __dali2_hal_watch_push(best_addr, best_attr, __watch_attr_cmd[best_attr]);
+        return;
+    }
+
+    if (dali2_hal_health_next(&best_addr, &cmd)) {
+        __dali2_hal_watch_push(best_addr, DALI2_HAL_WATCH_JOB_HEALTH, cmd);
+        return;
+    }
+
+    //! Presence probe of the next absent address
+    if (!__dali2_hal_watch_is_discovery() ||
+        (now - __watch_handle.probe_ms) < DALI2_HAL_WATCH_PROBE_MS) {
+        return;
+    }
+
+    for (i = 0; i < DALI2_HAL_WATCH_NODE_COUNT; i++) {
+        addr = (__watch_handle.probe_addr + i) % DALI2_HAL_WATCH_NODE_COUNT;
+        node = &__watch_handle.node[addr];
+
+        if (!node->is_present && (!node->is_probed || (now - node->probe_ms) >= DALI2_HAL_WATCH_REPROBE_MS)) {
+            __watch_handle.probe_addr = (unsigned char) ((addr + 1) % DALI2_HAL_WATCH_NODE_COUNT);
+            __watch_handle.probe_ms = now;
+            __watch_handle.stats.probes++;
+            __dali2_hal_watch_push((unsigned char) addr, DALI2_HAL_WATCH_JOB_PROBE,
+                                   DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_PRESENT);
+            return;
+        }
+    }
+}
+
+unsigned int dali2_hal_watch_idle_ms(void)
+{
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    unsigned int idle_ms = dali2_hal_quarantine_idle_ms();
+    unsigned int i;
+
+    //! Subscribed attributes and health get due one by one, they are rechecked periodically
+    for (i = 0; i < DALI2_HAL_WATCH_COUNT; i++) {
+        if (__watch_handle.sub[i].is_used) {
+            break;
+        }
+    }
+    if ((i < DALI2_HAL_WATCH_COUNT || __dali2_hal_watch_is_discovery()) && idle_ms > DALI2_HAL_IDLE_POLL_MS) {
+        idle_ms = DALI2_HAL_IDLE_POLL_MS;
+    }
+
+    //! Bus share of background polling
+    if (idle_ms < DALI2_HAL_IDLE_MAX_MS && __dali2_hal_watch_is_before(now, __watch_handle.quiet_ms) &&
+        __watch_handle.quiet_ms - now > idle_ms) {
+        idle_ms = __watch_handle.quiet_ms - now;
+    }
+
+    return idle_ms;
+}
+
+unsigned char dali2_hal_watch_is_present(unsigned char short_addr)
+{
+    return (short_addr < DALI2_HAL_WATCH_NODE_COUNT) ? __watch_handle.node[short_addr].is_present : 0;
+}
+
+dali2_ret_t dali2_hal_watch_subscribe(unsigned char *watch_id, dali2_l_app_network_t *target,
+                                      unsigned char attrs, unsigned int max_age_ms,
+                                      dali2_hal_watch_func_t func)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+    dali2_hal_watch_sub_t *sub;
+    unsigned int i;
+
+    //! Verify parameters
+    if (!watch_id || !target || !func || !attrs || (attrs & ~DALI2_HAL_ATTR_ALL) ||
+        max_age_ms < DALI2_HAL_WATCH_AGE_MIN_MS) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    switch (target->method) {
+        case DALI2_L_NET_METHOD_SHORT_ADDRESSING:
+            if (target->addr_byte >= DALI2_HAL_WATCH_NODE_COUNT) {
+                dali2_ret = DALI2_RET_INVALID_PARAMS;
+                goto __ret;
+            }
+            break;
+
+        case DALI2_L_NET_METHOD_GROUP_ADDRESSING:
+            if (target->addr_byte >= DALI2_HAL_WATCH_GROUP_COUNT) {
+                dali2_ret = DALI2_RET_INVALID_PARAMS;
+                goto __ret;
+            }
+            break;
+
+        case DALI2_L_NET_METHOD_BROADCAST:
+            break;
+
+        default:
+            dali2_ret = DALI2_RET_NOT_SUPPORTED;
+            goto __ret;
+    }
+
+    for (i = 0; i < DALI2_HAL_WATCH_COUNT; i++) {
+        sub = &__watch_handle.sub[i];
+        if (sub->is_used) {
+            continue;
+        }
+
+        memcpy(&sub->target, target, sizeof(dali2_l_app_network_t));
+        sub->func = func;
+        sub->max_age_ms = max_age_ms;
+        sub->attrs = attrs;
+        sub->is_used = 1;
+
+        *watch_id = (unsigned char) i;
+        goto __ret;
+    }
+
+    dali2_ret = DALI2_RET_BUSY;
+
+__ret:
+    return dali2_ret;
+}
+
+dali2_ret_t dali2_hal_watch_unsubscribe(unsigned char watch_id)
+{
+    if (watch_id >= DALI2_HAL_WATCH_COUNT || !__watch_handle.sub[watch_id].is_used) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    __watch_handle.sub[watch_id].is_used = 0;
+
+    return DALI2_RET_SUCCESS;
+}
+
+void dali2_hal_watch_stats_get(dali2_hal_watch_stats_t *stats)
+{
+    if (stats) {
+        memcpy(stats, &__watch_handle.stats, sizeof(dali2_hal_watch_stats_t));
+    }
+}
@@ -0,0 +1,125 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_done.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL job completion source file
+ *
+ * @details Completion of submitted request is attached to its job once the job holds
+ *          the mutex, it follows the job through preemption and is moved aside when
+ *          the mutex is freed. Both completion of the job and common callback are called
+ *          when dali2_hal_process() reports it, so they run in the context of the caller
+ *          of dali2_hal_process(). Schedulers call completion themselves for jobs which
+ *          have not gone to the bus. Wake callback only tells there is work.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+
+//! Internal handle type
+typedef struct {
+    dali2_hal_done_t job[DALI2_HAL_EVT_FREE];
+    dali2_hal_done_t freed;             //! Of the job to be reported
+    dali2_hal_done_t common;
+    dali2_hal_wake_func_t wake;
+} dali2_hal_done_handle_t;
+
+static dali2_hal_done_handle_t __done_handle;
+
+static void __dali2_hal_done_wait_set(DALI2_HAL_EVT_T evt, dali2_ret_t ret, void *ctx)
+{
+    dali2_hal_done_wait_t *wait = (dali2_hal_done_wait_t *) ctx;
+
+    wait->evt = evt;
+    wait->ret = ret;
+
+    //! Event and result are seen by the thread waiting for the handle
+    __atomic_store_n(&wait->is_done, 1, __ATOMIC_RELEASE);
+}
+
+void dali2_hal_done_init(void)
+{
+    memset(&__done_handle, 0x00, sizeof(__done_handle));
+}
+
+void dali2_hal_done_job_start(DALI2_HAL_EVT_T evt)
+{
+    if (evt < DALI2_HAL_EVT_FREE) {
+        __done_handle.job[evt].func = NULL;
+    }
+}
+
+void dali2_hal_done_attach(DALI2_HAL_EVT_T evt, const dali2_hal_done_t *done)
+{
+    if (evt < DALI2_HAL_EVT_FREE) {
+        memcpy(&__done_handle.job[evt], done, sizeof(dali2_hal_done_t));
+    }
+}
+
+void dali2_hal_done_job_end(DALI2_HAL_EVT_T evt)
+{
+    if (evt < DALI2_HAL_EVT_FREE) {
+        memcpy(&__done_handle.freed, &__done_handle.job[evt], sizeof(dali2_hal_done_t));
+        __done_handle.job[evt].func = NULL;
+    }
+}
+
+void dali2_hal_done_report(DALI2_HAL_EVT_T evt, dali2_ret_t ret)
+{
+    dali2_hal_done_t freed;
+
+    //! Completion may submit the next request
+    memcpy(&freed, &__done_handle.freed, sizeof(dali2_hal_done_t));
+    __done_handle.freed.func = NULL;
+
+    dali2_hal_done_call(&freed, evt, ret);
+    dali2_hal_done_call(&__done_handle.common, evt, ret);
+}
+
+void dali2_hal_done_call(const dali2_hal_done_t *done, DALI2_HAL_EVT_T evt, dali2_ret_t ret)
+{
+    if (done->func) {
+        done->func(evt, ret, done->ctx);
+    }
+}
+
+void dali2_hal_done_func_set(dali2_hal_done_func_t func, void *ctx)
+{
+    __done_handle.common.func = func;
+    __done_handle.common.ctx = ctx;
+}
+
+void dali2_hal_done_wait_bind(dali2_hal_done_t *done, dali2_hal_done_wait_t *wait)
+{
+    if (!done || !wait) {
+        return;
+    }
+
+    wait->is_done = 0;
+    wait->evt = DALI2_HAL_EVT_FREE;
+    wait->ret = DALI2_RET_BUSY;
+    done->func = __dali2_hal_done_wait_set;
+    done->ctx = wait;
+}
+
+unsigned char dali2_hal_done_wait_is_done(const dali2_hal_done_wait_t *wait)
+{
+    return __atomic_load_n(&wait->is_done, __ATOMIC_ACQUIRE);
+}
+
+void dali2_hal_wake_func_set(dali2_hal_wake_func_t func)
+{
+    __done_handle.wake = func;
+}
+
+void dali2_hal_wake(void)
+{
+    if (__done_handle.wake) {
+        __done_handle.wake();
+    }
+}
@@ -0,0 +1,307 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_edf.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL deadline scheduler source file
+ *
+ * @details Request is admitted when predicted bus time of it and of all admitted
+ *          requests of earlier deadline, together with the rest of running jobs it
+ *          cannot preempt, fits its deadline and deadlines of admitted requests
+ *          still fit too. Admitted requests are started earliest deadline first,
+ *          the job is started once it takes the mutex, @see dali2_hal_mtx_take().
+ *          Request which cannot finish in time anymore is reported as failed job.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+#include "dali2_log.h"
+
+typedef enum {
+    DALI2_HAL_EDF_STATE_FREE,
+    DALI2_HAL_EDF_STATE_PENDING,        //! Admitted, waits for the mutex
+    DALI2_HAL_EDF_STATE_RUNNING
+} DALI2_HAL_EDF_STATE_T;
+
+typedef struct {
+    dali2_hal_edf_req_t req;
+    DALI2_HAL_EDF_STATE_T state;
+    unsigned int deadline_ms;           //! Absolute
+    unsigned int cost_us;               //! Predicted bus time
+    unsigned char is_refused;           //! Dimmer is not ready, request waits for the end of a job
+} dali2_hal_edf_entry_t;
+
+//! Internal handle type
+typedef struct {
+    dali2_hal_edf_entry_t entry[DALI2_HAL_EDF_COUNT];
+    dali2_hal_edf_stats_t stats;
+} dali2_hal_edf_handle_t;
+
+static dali2_hal_edf_handle_t __edf_handle;
+
+//! Time over deadline, negative if deadline is met
+static inline int __dali2_hal_edf_late_ms(unsigned int now_ms, unsigned int bus_us, unsigned int deadline_ms)
+{
+    return (int) (now_ms + (bus_us + 999) / 1000 - deadline_ms);
+}
+
+/**@brief Checking deadlines of admitted requests with the new one
+ *
+ * @param[IN] now_ms - time now
+ * @param[OUT] late_ms - the worst time over deadline, 0 if all deadlines are met
+ * @return 1 if all deadlines are met
+ */
+static unsigned char __dali2_hal_edf_is_feasible(unsigned int now_ms, int *late_ms)
+{
+    dali2_hal_edf_entry_t *entry, *other;
+    DALI2_HAL_EVT_T evt, other_evt;
+    unsigned int bus_us;
+    unsigned int i, j;
+    int late;
+
+    *late_ms = 0;
+
+    for (i = 0; i < DALI2_HAL_EDF_COUNT; i++) {
+        entry = &__edf_handle.entry[i];
+        if (entry->state == DALI2_HAL_EDF_STATE_FREE) {
+            continue;
+        }
+        evt = DALI2_HAL_JOB_EVT(entry->req.job);
+
+        //! Pending request waits for running jobs, running one for the rest of itself
+        bus_us = (entry->state == DALI2_HAL_EDF_STATE_PENDING) ? dali2_hal_mtx_wait_us(evt) :
+                                                                 dali2_hal_job_left_us(evt);
+
+        //! Pending requests of earlier deadline go first, running job is passed by preempting ones only
+        for (j = 0; j < DALI2_HAL_EDF_COUNT; j++) {
+            other = &__edf_handle.entry[j];
+            if (other->state != DALI2_HAL_EDF_STATE_PENDING) {
+                continue;
+            }
+            other_evt = DALI2_HAL_JOB_EVT(other->req.job);
+
+            if (entry->state == DALI2_HAL_EDF_STATE_PENDING) {
+                if (j != i && (int) (other->deadline_ms - entry->deadline_ms) > 0) {
+                    continue;
+                }
+            } else if ((int) (other->deadline_ms - entry->deadline_ms) >= 0 ||
+                       !dali2_hal_mtx_is_preemptive(other_evt, evt)) {
+                continue;
+            }
+
+            bus_us += other->cost_us;
+        }
+
+        late = __dali2_hal_edf_late_ms(now_ms, bus_us, entry->deadline_ms);
+        if (late > *late_ms) {
+            *late_ms = late;
+        }
+    }
+
+    return (*late_ms == 0) ? 1 : 0;
+}
+
+static void __dali2_hal_edf_end(dali2_hal_edf_entry_t *entry)
+{
+    int late_ms = (int) (dali2_l_bsp_time_ms_get() - entry->deadline_ms);
+
+    if (late_ms > 0) {
+        DALI2_LOG2(HAL_EDF_MISS, entry->req.job, late_ms);
+        __edf_handle.stats.missed++;
+    } else {
+        __edf_handle.stats.met++;
+    }
+
+    entry->state = DALI2_HAL_EDF_STATE_FREE;
+}
+
+void dali2_hal_edf_init(void)
+{
+    memset(&__edf_handle, 0x00, sizeof(__edf_handle));
+}
+
+dali2_ret_t dali2_hal_edf_submit(dali2_hal_edf_req_t *req)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+    dali2_hal_edf_entry_t *entry = NULL;
+    unsigned int now_ms = dali2_l_bsp_time_ms_get();
+    unsigned int i;
+    int late_ms;
+
+    //! Verify parameters
+    if (!req || req->job >= DALI2_HAL_JOB_COUNT || !req->deadline_ms) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    //! Predictions follow cache and learned answers
+    for (i = 0; i < DALI2_HAL_EDF_COUNT; i++) {
+        if (__edf_handle.entry[i].state == DALI2_HAL_EDF_STATE_PENDING) {
+            __edf_handle.entry[i].cost_us = dali2_hal_cost_job_us(__edf_handle.entry[i].req.job,
+                                                                  &__edf_handle.entry[i].req.node);
+        } else if (__edf_handle.entry[i].state == DALI2_HAL_EDF_STATE_FREE && !entry) {
+            entry = &__edf_handle.entry[i];
+        }
+    }
+
+    if (!entry) {
+        dali2_ret = DALI2_RET_BUSY;
+        goto __ret;
+    }
+
+    memcpy(&entry->req, req, sizeof(dali2_hal_edf_req_t));
+    entry->deadline_ms = now_ms + req->deadline_ms;
+    entry->cost_us = dali2_hal_cost_job_us(req->job, &req->node);
+    entry->is_refused = 0;
+    entry->state = DALI2_HAL_EDF_STATE_PENDING;
+
+    if (!__dali2_hal_edf_is_feasible(now_ms, &late_ms)) {
+        entry->state = DALI2_HAL_EDF_STATE_FREE;
+        DALI2_LOG2(HAL_EDF_REJECT, req->job, late_ms);
+        __edf_handle.stats.rejected++;
+        dali2_ret = DALI2_RET_TIMEOUT;
+        goto __ret;
+    }
+
+    __edf_handle.stats.admitted++;
+    dali2_hal_wake();
+
+__ret:
+    return dali2_ret;
+}
+
+void dali2_hal_edf_poll(void)
+{
+    dali2_hal_edf_entry_t *entry, *next = NULL;
+    unsigned int now_ms = dali2_l_bsp_time_ms_get();
+    DALI2_HAL_EVT_T evt;
+    dali2_ret_t ret;
+    unsigned int i;
+
+    for (i = 0; i < DALI2_HAL_EDF_COUNT; i++) {
+        entry = &__edf_handle.entry[i];
+
+        //! Job has ended without report, e.g. queue fault
+        if (entry->state == DALI2_HAL_EDF_STATE_RUNNING) {
+            evt = DALI2_HAL_JOB_EVT(entry->req.job);
+            if (dali2_hal_mtx_check() != evt && dali2_hal_mtx_suspended() != evt) {
+                __dali2_hal_edf_end(entry);
+                dali2_hal_done_call(&entry->req.done, evt, DALI2_RET_INTERNAL_ERROR);
+            }
+        } else if (entry->state == DALI2_HAL_EDF_STATE_PENDING &&
+                   (!next || (int) (entry->deadline_ms - next->deadline_ms) < 0)) {
+            next = entry;
+        }
+    }
+
+    if (!next) {
+        return;
+    }
+    evt = DALI2_HAL_JOB_EVT(next->req.job);
+
+    //! Request cannot finish in time anymore, it is reported as failed job by free HAL
+    if (__dali2_hal_edf_late_ms(now_ms, next->cost_us, next->deadline_ms) > 0) {
+        if (dali2_hal_mtx_check() != DALI2_HAL_EVT_FREE || dali2_hal_mtx_suspended() != DALI2_HAL_EVT_FREE) {
+            return;
+        }
+
+        next->state = DALI2_HAL_EDF_STATE_FREE;
+        DALI2_LOG1(HAL_EDF_EXPIRE, next->req.job);
+        __edf_handle.stats.expired++;
+        if (dali2_hal_mtx_take(evt) == evt) {
+            dali2_hal_done_attach(evt, &next->req.done);
+            dali2_hal_mtx_fail(DALI2_RET_TIMEOUT);
+        }
+        return;
+    }
+
+    if (!dali2_hal_mtx_is_takeable(evt)) {
+        return;
+    }
+
+    ret = dali2_hal_job_start(next->req.job, &next->req.node, &next->req.data);
+    switch (ret) {
+        case DALI2_RET_SUCCESS:
+            if (dali2_hal_mtx_check() == evt) {
+                next->state = DALI2_HAL_EDF_STATE_RUNNING;
+                dali2_hal_done_attach(evt, &next->req.done);
+            } else {
+                //! Answered from cache or gear is quarantined, no bus time
+                __dali2_hal_edf_end(next);
+                dali2_hal_done_call(&next->req.done, evt, DALI2_RET_SUCCESS);
+            }
+            break;
+
+        case DALI2_RET_BUSY:
+            //! Dimmer is not configured yet, request waits for it up to its deadline
+            next->is_refused = 1;
+            break;
+
+        default:
+            next->state = DALI2_HAL_EDF_STATE_FREE;
+            DALI2_LOG1(HAL_EDF_EXPIRE, next->req.job);
+            __edf_handle.stats.expired++;
+            dali2_hal_done_call(&next->req.done, evt, ret);
+            break;
+    }
+}
+
+unsigned int dali2_hal_edf_idle_ms(void)
+{
+    dali2_hal_edf_entry_t *entry, *next = NULL;
+    unsigned int i;
+    int late_ms;
+
+    for (i = 0; i < DALI2_HAL_EDF_COUNT; i++) {
+        entry = &__edf_handle.entry[i];
+        if (entry->state == DALI2_HAL_EDF_STATE_PENDING &&
+            (!next || (int) (entry->deadline_ms - next->deadline_ms) < 0)) {
+            next = entry;
+        }
+    }
+
+    if (!next) {
+        return DALI2_HAL_IDLE_MAX_MS;
+    }
+
+    //! Expired request waits for free HAL, the end of running job is reported anyway
+    late_ms = __dali2_hal_edf_late_ms(dali2_l_bsp_time_ms_get(), next->cost_us, next->deadline_ms);
+    if (late_ms > 0) {
+        return (dali2_hal_mtx_check() == DALI2_HAL_EVT_FREE &&
+                dali2_hal_mtx_suspended() == DALI2_HAL_EVT_FREE) ? 0 : DALI2_HAL_IDLE_MAX_MS;
+    }
+
+    if (dali2_hal_mtx_is_takeable(DALI2_HAL_JOB_EVT(next->req.job)) && !next->is_refused) {
+        return 0;
+    }
+
+    return ((unsigned int) -late_ms + 1 < DALI2_HAL_IDLE_MAX_MS) ? (unsigned int) -late_ms + 1 : DALI2_HAL_IDLE_MAX_MS;
+}
+
+void dali2_hal_edf_job_end(DALI2_HAL_EVT_T evt)
+{
+    dali2_hal_edf_entry_t *entry;
+    unsigned int i;
+
+    for (i = 0; i < DALI2_HAL_EDF_COUNT; i++) {
+        entry = &__edf_handle.entry[i];
+
+        //! Dimmer may be ready now
+        entry->is_refused = 0;
+        if (entry->state == DALI2_HAL_EDF_STATE_RUNNING && DALI2_HAL_JOB_EVT(entry->req.job) == evt) {
+            __dali2_hal_edf_end(entry);
+        }
+    }
+}
+
+void dali2_hal_edf_stats_get(dali2_hal_edf_stats_t *stats)
+{
+    if (stats) {
+        memcpy(stats, &__edf_handle.stats, sizeof(dali2_hal_edf_stats_t));
+    }
+}
@@ -16,41 +16,511 @@
 
 #include "dali2_hal.h"
 #include "dali2_hal_internal.h"
+#include "dali2_log.h"
+#include "dali2_metrics.h"
+#include "dali2_ring.h"
 
 #define DALI2_HAL_IS_VALID_EVT(EVT)     (EVT < DALI2_HAL_EVT_FREE)
+#define DALI2_HAL_IS_STD_CMD(CMD)       ((CMD) < DALI2_L_APP_CMD_TERMINATE || \
+                                         ((CMD) >= DALI2_L_APP_CMD_DAPC && (CMD) < DALI2_L_APP_CMD_ENABLE_DEVICE_TYPE_6))
 
 static DALI2_HAL_EVT_T __hal_queue_evt = DALI2_HAL_EVT_FREE;
 static DALI2_HAL_EVT_T __hal_freed_by_evt = DALI2_HAL_EVT_FREE;
+static dali2_ret_t __hal_freed_ret;
 static DALI2_L_APP_CMD_T __hal_queue_app_cmd;
 static dali2_l_app_cmd_data_t __hal_queue_app_cmd_data;
 
+//! Pushed command is looked up in query cache once, repetition goes to the bus
+static unsigned char __hal_queue_is_new;
+static unsigned char __hal_queue_is_reread;
+static unsigned char __hal_queue_is_cached;
+
+//! Queued command is accepted by Application layer, its completion is awaited
+static unsigned char __hal_queue_is_exec;
+
+//! Queued command is refused by busy lower layers, they get ready without event
+static unsigned char __hal_queue_is_refused;
+
+//! Repetition of failed step waits for retry backoff
+static unsigned char __hal_queue_is_held;
+static unsigned int __hal_queue_hold_ms;
+
+//! The last command not relying on gear context, job restarts from it when context is lost
+static DALI2_L_APP_CMD_T __hal_queue_ckpt_cmd = DALI2_L_APP_CMD_UNKNOWN;
+static dali2_l_app_cmd_data_t __hal_queue_ckpt_cmd_data;
+static unsigned char __hal_queue_is_ctx_lost;
+
+//! Preemption rank per job, job of lower rank suspends running one between its commands
+static const unsigned char __hal_evt_rank[DALI2_HAL_EVT_FREE] = {
+    [DALI2_HAL_EVT_ADDR_ALLOC] = 1,
+    [DALI2_HAL_EVT_DIM_CFG] = 1,
+    [DALI2_HAL_EVT_DIM_CTRL] = 0,
+    [DALI2_HAL_EVT_POLL] = 2,
+};
+
+//! Job suspended by preemption
+typedef struct {
+    DALI2_HAL_EVT_T evt;                //! DALI2_HAL_EVT_FREE if none
+    DALI2_L_APP_CMD_T cmd;
+    dali2_l_app_cmd_data_t cmd_data;
+    DALI2_L_APP_CMD_T ckpt_cmd;
+    dali2_l_app_cmd_data_t ckpt_cmd_data;
+    unsigned char is_exec;              //! Command is on the bus, its completion is kept
+    unsigned char is_done;
+    unsigned char is_reread;
+    unsigned char is_held;
+    unsigned int hold_ms;
+    DALI2_L_APP_EVT_T done_evt;
+    dali2_l_app_evt_data_t done_evt_data;
+} dali2_hal_preempt_t;
+
+static dali2_hal_preempt_t __hal_preempt = {.evt = DALI2_HAL_EVT_FREE};
+static dali2_hal_preempt_stats_t __hal_preempt_stats;
+
+//! Multi-master priority per job, user control wins over configuration
+static const DALI2_L_SES_PRIORITY_T __hal_evt_priority[DALI2_HAL_EVT_FREE] = {
+    [DALI2_HAL_EVT_ADDR_ALLOC] = DALI2_L_SES_PRIORITY_3,
+    [DALI2_HAL_EVT_DIM_CFG] = DALI2_L_SES_PRIORITY_3,
+    [DALI2_HAL_EVT_DIM_CTRL] = DALI2_L_SES_PRIORITY_2,
+    [DALI2_HAL_EVT_POLL] = DALI2_L_SES_PRIORITY_5,
+};
+
+//! Queue wait starts on push or command done, bus time starts on command execution
+static unsigned int __hal_wait_us;
+static unsigned int __hal_exec_us;
+
+//! Bus event latched in interrupt context: frame of Session layer tap or Application layer event
+typedef struct {
+    volatile unsigned int stamp;        //! Publication marker
+    unsigned char is_tap;
+    unsigned int time_us;
+    union {
+        dali2_l_ses_tap_t tap;
+        struct {
+            DALI2_L_APP_EVT_T evt;
+            dali2_l_app_evt_data_t evt_data;
+        } app;
+    } data;
+} dali2_hal_bus_evt_t;
+
+//! Bus events in order of their delivery, interrupts of any priority produce, dali2_hal_process() consumes
+typedef struct {
+    dali2_ring_t ring;
+    volatile unsigned char is_lost;     //! Event is dropped since the last drain
+    dali2_hal_bus_evt_t slot[DALI2_HAL_BUS_EVT_RING_SIZE];
+} dali2_hal_bus_evt_ring_t;
+
+static dali2_hal_bus_evt_ring_t __hal_bus_evt_ring;
+
+static void __dali2_hal_app_evt_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data, unsigned int time_us);
+
+/**@brief Reserving bus event slot
+ *
+ * @return slot or NULL if ring is full
+ */
+static dali2_hal_bus_evt_t *__dali2_hal_bus_evt_reserve(unsigned int *head)
+{
+    if (!dali2_ring_reserve(&__hal_bus_evt_ring.ring, DALI2_HAL_BUS_EVT_RING_SIZE, head)) {
+        __atomic_store_n(&__hal_bus_evt_ring.is_lost, 1, __ATOMIC_RELEASE);
+        return NULL;
+    }
+
+    return &__hal_bus_evt_ring.slot[DALI2_RING_IDX(*head, DALI2_HAL_BUS_EVT_RING_SIZE)];
+}
+
+static void __dali2_hal_bus_evt_publish(dali2_hal_bus_evt_t *slot, unsigned int head)
+{
+    dali2_ring_publish(&slot->stamp, head);
+
+    //! Event from the bus has work for dali2_hal_process()
+    dali2_hal_wake();
+}
+
+static dali2_hal_bus_evt_t *__dali2_hal_bus_evt_published(unsigned int *tail)
+{
+    dali2_hal_bus_evt_t *slot;
+
+    *tail = dali2_ring_tail_get(&__hal_bus_evt_ring.ring);
+    slot = &__hal_bus_evt_ring.slot[DALI2_RING_IDX(*tail, DALI2_HAL_BUS_EVT_RING_SIZE)];
+
+    return dali2_ring_is_published(&slot->stamp, *tail) ? slot : NULL;
+}
+
+//! Dropped bus event: lost frame may have changed cached answers and shadow state,
+//! lost answer leaves the running command without completion
+static void __dali2_hal_bus_evt_lost(void)
+{
+    dali2_hal_cache_flush();
+    dali2_hal_dim_shadow_flush();
+
+    //! Running command is ended by the watchdog at once, it resyncs lower layers and repeats the step
+    if (DALI2_HAL_IS_VALID_EVT(__hal_queue_evt) && __hal_queue_is_exec) {
+        dali2_hal_watchdog_expire();
+    }
+}
+
+//! Handling latched bus events in the thread of dali2_hal_process(), HAL state has single owner
+static void __dali2_hal_bus_evt_drain(void)
+{
+    dali2_hal_bus_evt_t *slot;
+    unsigned int tail;
+    unsigned int i;
+
+    for (i = 0; i < DALI2_HAL_BUS_EVT_RING_SIZE; i++) {
+        slot = __dali2_hal_bus_evt_published(&tail);
+        if (!slot) {
+            break;
+        }
+
+        //! Slot is handled in place, producers take the next ones
+        if (slot->is_tap) {
+            dali2_hal_dim_shadow_tap(&slot->data.tap);
+            dali2_hal_cache_tap(&slot->data.tap);
+        } else {
+            __dali2_hal_app_evt_dispatch(slot->data.app.evt, &slot->data.app.evt_data, slot->time_us);
+        }
+
+        dali2_ring_release(&__hal_bus_evt_ring.ring, tail);
+    }
+
+    //! Dropped event is newer than the handled ones
+    if (__atomic_exchange_n(&__hal_bus_evt_ring.is_lost, 0, __ATOMIC_ACQ_REL)) {
+        __dali2_hal_bus_evt_lost();
+    }
+}
+
+static void __dali2_hal_ses_tap(const dali2_l_ses_tap_t *tap)
+{
+    dali2_hal_bus_evt_t *slot;
+    unsigned int head;
+
+    //! Lost frame is recovered by the next dali2_hal_process()
+    slot = __dali2_hal_bus_evt_reserve(&head);
+    if (!slot) {
+        return;
+    }
+
+    slot->is_tap = 1;
+    slot->time_us = dali2_l_bsp_time_us_get();
+    memcpy(&slot->data.tap, tap, sizeof(dali2_l_ses_tap_t));
+    __dali2_hal_bus_evt_publish(slot, head);
+}
+
+void dali2_hal_init(void)
+{
+    dali2_hal_dim_shadow_init();
+    dali2_hal_cache_init();
+    dali2_hal_watch_init();
+    dali2_hal_health_init();
+    dali2_hal_quarantine_init();
+    dali2_hal_retry_init();
+    dali2_hal_watchdog_init();
+    dali2_hal_cost_init();
+    dali2_hal_edf_init();
+    dali2_hal_client_init();
+    dali2_hal_done_init();
+    dali2_hal_post_init();
+    memset(&__hal_bus_evt_ring, 0x00, sizeof(__hal_bus_evt_ring));
+    dali2_l_ses_tap_set(__dali2_hal_ses_tap);
+}
+
+//! Command relies on gear context set by the previous command of the job,
+//! device type 6 commands are not: Application layer enables device type right before them
+static unsigned char __dali2_hal_cmd_is_ctx_user(DALI2_L_APP_CMD_T cmd)
+{
+    switch (cmd) {
+        case DALI2_L_APP_CMD_QUERY_CONTENT_DTR0:
+        case DALI2_L_APP_CMD_QUERY_CONTENT_DTR1:
+        case DALI2_L_APP_CMD_QUERY_CONTENT_DTR2:
+        case DALI2_L_APP_CMD_QUERY_NEXT_DEVICE_TYPE:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+static inline unsigned char __dali2_hal_is_answer_of(dali2_l_app_evt_data_t *evt_data, DALI2_L_APP_CMD_T cmd,
+                                                     dali2_l_app_cmd_data_t *cmd_data)
+{
+    if (evt_data->cmd != cmd) {
+        return 0;
+    }
+
+    //! The same command to another node
+    if (DALI2_HAL_IS_STD_CMD(cmd) &&
+        (evt_data->cmd_data.std_rsp.net.method != cmd_data->std_cmd.net.method ||
+         evt_data->cmd_data.std_rsp.net.addr_byte != cmd_data->std_cmd.net.addr_byte)) {
+        return 0;
+    }
+
+    return 1;
+}
+
+//! Queued command becomes checkpoint or is replaced by it when gear context is lost
+static void __dali2_hal_queue_ckpt(void)
+{
+    if (!__dali2_hal_cmd_is_ctx_user(__hal_queue_app_cmd)) {
+        __hal_queue_ckpt_cmd = __hal_queue_app_cmd;
+        memcpy(&__hal_queue_ckpt_cmd_data, &__hal_queue_app_cmd_data, sizeof(dali2_l_app_cmd_data_t));
+        __hal_queue_is_ctx_lost = 0;
+    } else if (__hal_queue_is_ctx_lost && __hal_queue_ckpt_cmd != DALI2_L_APP_CMD_UNKNOWN) {
+        __hal_queue_app_cmd = __hal_queue_ckpt_cmd;
+        memcpy(&__hal_queue_app_cmd_data, &__hal_queue_ckpt_cmd_data, sizeof(dali2_l_app_cmd_data_t));
+        __hal_queue_is_ctx_lost = 0;
+        __hal_preempt_stats.restarts++;
+    }
+}
+
+static void __dali2_hal_suspend(void)
+{
+    dali2_hal_preempt_t *preempt = &__hal_preempt;
+
+    preempt->evt = __hal_queue_evt;
+    preempt->cmd = __hal_queue_app_cmd;
+    memcpy(&preempt->cmd_data, &__hal_queue_app_cmd_data, sizeof(dali2_l_app_cmd_data_t));
+    preempt->ckpt_cmd = __hal_queue_ckpt_cmd;
+    memcpy(&preempt->ckpt_cmd_data, &__hal_queue_ckpt_cmd_data, sizeof(dali2_l_app_cmd_data_t));
+    preempt->is_exec = __hal_queue_is_exec;
+    preempt->is_done = 0;
+    preempt->is_reread = __hal_queue_is_reread;
+    preempt->is_held = __hal_queue_is_held;
+    preempt->hold_ms = __hal_queue_hold_ms;
+
+    __hal_preempt_stats.preemptions++;
+    DALI2_LOG2(HAL_PREEMPT, preempt->evt, preempt->cmd);
+}
+
+static void __dali2_hal_resume(void)
+{
+    dali2_hal_preempt_t *preempt = &__hal_preempt;
+
+    __hal_queue_evt = preempt->evt;
+    __hal_queue_app_cmd = preempt->cmd;
+    memcpy(&__hal_queue_app_cmd_data, &preempt->cmd_data, sizeof(dali2_l_app_cmd_data_t));
+    __hal_queue_ckpt_cmd = preempt->ckpt_cmd;
+    memcpy(&__hal_queue_ckpt_cmd_data, &preempt->ckpt_cmd_data, sizeof(dali2_l_app_cmd_data_t));
+    __hal_queue_is_held = preempt->is_held;
+    __hal_queue_hold_ms = preempt->hold_ms;
+    __hal_queue_is_exec = 0;
+    __hal_queue_is_refused = 0;
+    __hal_queue_is_new = 1;
+    __hal_queue_is_reread = preempt->is_reread;
+    __hal_queue_is_ctx_lost = 1;
+    preempt->evt = DALI2_HAL_EVT_FREE;
+    __hal_preempt_stats.resumes++;
+
+    //! Time of preempting job is not charged to suspended one
+    dali2_hal_retry_reset();
+    dali2_hal_watchdog_job_start();
+    __hal_wait_us = dali2_l_bsp_time_us_get();
+
+    if (preempt->is_done) {
+        //! Answer has come before gear context is lost, the next command is checked on push
+        preempt->is_done = 0;
+        __hal_exec_us = __hal_wait_us;
+        __hal_queue_is_cached = 1;
+        __dali2_hal_app_evt_dispatch(preempt->done_evt, &preempt->done_evt_data, __hal_wait_us);
+        __hal_queue_is_cached = 0;
+    } else {
+        __dali2_hal_queue_ckpt();
+    }
+}
+
+static unsigned char __dali2_hal_cache_answer(void)
+{
+    dali2_l_app_evt_data_t evt_data;
+    DALI2_L_APP_EVT_T evt;
+    unsigned char data;
+
+    if (dali2_hal_cache_get(__hal_queue_app_cmd, &__hal_queue_app_cmd_data.std_cmd.net,
+                            &evt, &data) != DALI2_RET_SUCCESS) {
+        return 0;
+    }
+
+    evt_data.cmd = __hal_queue_app_cmd;
+    memcpy(&evt_data.cmd_data.std_rsp.net, &__hal_queue_app_cmd_data.std_cmd.net, sizeof(dali2_l_app_network_t));
+    evt_data.cmd_data.std_rsp.data = data;
+
+    //! Answer is dispatched as it came from the bus, the next command may be pushed
+    __hal_exec_us = dali2_l_bsp_time_us_get();
+    __hal_queue_is_cached = 1;
+    __dali2_hal_app_evt_dispatch(evt, &evt_data, __hal_exec_us);
+    __hal_queue_is_cached = 0;
+
+    return 1;
+}
+
 DALI2_HAL_EVT_T dali2_hal_mtx_check(void)
 {
     return __hal_queue_evt;
 }
 
-DALI2_HAL_EVT_T dali2_hal_mtx_take(DALI2_HAL_EVT_T evt_mtx)
+unsigned char dali2_hal_mtx_is_preemptive(DALI2_HAL_EVT_T evt_mtx, DALI2_HAL_EVT_T evt)
+{
+    if (!DALI2_HAL_IS_VALID_EVT(evt_mtx) || !DALI2_HAL_IS_VALID_EVT(evt)) {
+        return 0;
+    }
+
+    return (evt == DALI2_HAL_EVT_POLL || __hal_evt_rank[evt_mtx] < __hal_evt_rank[evt]) ? 1 : 0;
+}
+
+unsigned char dali2_hal_mtx_is_takeable(DALI2_HAL_EVT_T evt_mtx)
+{
+    if (!DALI2_HAL_IS_VALID_EVT(evt_mtx)) {
+        return 0;
+    }
+
+    //! Suspended job goes on before jobs of its rank
+    if (DALI2_HAL_IS_VALID_EVT(__hal_preempt.evt) && __hal_evt_rank[evt_mtx] >= __hal_evt_rank[__hal_preempt.evt]) {
+        return 0;
+    }
+
+    //! Job of the same or higher rank keeps the mutex, one job is suspended at most
+    if (DALI2_HAL_IS_VALID_EVT(__hal_queue_evt) && __hal_queue_evt != DALI2_HAL_EVT_POLL) {
+        return (dali2_hal_mtx_is_preemptive(evt_mtx, __hal_queue_evt) && !DALI2_HAL_IS_VALID_EVT(__hal_preempt.evt));
+    }
+
+    return 1;
+}
+
+DALI2_HAL_EVT_T dali2_hal_mtx_suspended(void)
+{
+    return __hal_preempt.evt;
+}
+
+static inline dali2_l_app_network_t *__dali2_hal_cmd_net(DALI2_L_APP_CMD_T cmd, dali2_l_app_cmd_data_t *cmd_data)
+{
+    return DALI2_HAL_IS_STD_CMD(cmd) ? &cmd_data->std_cmd.net : NULL;
+}
+
+unsigned int dali2_hal_job_left_us(DALI2_HAL_EVT_T evt)
 {
-    if (evt_mtx < __hal_queue_evt) {
-        if (DALI2_HAL_IS_VALID_EVT(evt_mtx)) {
-            __hal_queue_evt = evt_mtx;
+    if (!DALI2_HAL_IS_VALID_EVT(evt)) {
+        return 0;
+    }
+
+    if (evt == __hal_queue_evt) {
+        return dali2_hal_cost_left_us(evt, __hal_queue_app_cmd,
+                                      __dali2_hal_cmd_net(__hal_queue_app_cmd, &__hal_queue_app_cmd_data));
+    }
+
+    if (evt == __hal_preempt.evt) {
+        return dali2_hal_cost_left_us(evt, __hal_preempt.cmd,
+                                      __dali2_hal_cmd_net(__hal_preempt.cmd, &__hal_preempt.cmd_data));
+    }
+
+    return 0;
+}
+
+unsigned int dali2_hal_mtx_wait_us(DALI2_HAL_EVT_T evt_mtx)
+{
+    unsigned int wait_us = 0;
+
+    if (DALI2_HAL_IS_VALID_EVT(__hal_queue_evt)) {
+        //! Preempted job gives way after its running command
+        if (dali2_hal_mtx_is_preemptive(evt_mtx, __hal_queue_evt) &&
+            (__hal_queue_evt == DALI2_HAL_EVT_POLL || !DALI2_HAL_IS_VALID_EVT(__hal_preempt.evt))) {
+            wait_us += dali2_hal_cost_cmd_us(__hal_queue_app_cmd,
+                                             __dali2_hal_cmd_net(__hal_queue_app_cmd, &__hal_queue_app_cmd_data),
+                                             __hal_evt_priority[__hal_queue_evt]);
+        } else {
+            wait_us += dali2_hal_job_left_us(__hal_queue_evt);
         }
     }
 
+    if (DALI2_HAL_IS_VALID_EVT(__hal_preempt.evt) && !dali2_hal_mtx_is_preemptive(evt_mtx, __hal_preempt.evt)) {
+        wait_us += dali2_hal_job_left_us(__hal_preempt.evt);
+    }
+
+    return wait_us;
+}
+
+DALI2_L_SES_PRIORITY_T dali2_hal_evt_priority_get(DALI2_HAL_EVT_T evt)
+{
+    return DALI2_HAL_IS_VALID_EVT(evt) ? __hal_evt_priority[evt] : DALI2_L_SES_PRIORITY_DEFAULT;
+}
+
+dali2_ret_t dali2_hal_job_start(DALI2_HAL_JOB_T job, dali2_l_app_network_t *node, dali2_hal_job_data_t *data)
+{
+    unsigned char status;
+
+    switch (job) {
+        case DALI2_HAL_JOB_SET_LEVEL:
+            return dali2_hal_dim_set_level(data->level, node);
+
+        case DALI2_HAL_JOB_UPDATE_STATE:
+            if (DALI2_HAL_IS_VALID_EVT(__hal_queue_evt) && __hal_queue_evt != DALI2_HAL_EVT_POLL) {
+                return DALI2_RET_BUSY;
+            }
+            return dali2_hal_dim_get_status(&status, node);
+
+        case DALI2_HAL_JOB_DIM_CFG:
+            return dali2_hal_dim_cfg(&data->dim_cfg, node);
+
+        default:
+            return DALI2_RET_INVALID_PARAMS;
+    }
+}
+
+DALI2_HAL_EVT_T dali2_hal_mtx_take(DALI2_HAL_EVT_T evt_mtx)
+{
+    if (!dali2_hal_mtx_is_takeable(evt_mtx)) {
+        return __hal_queue_evt;
+    }
+
+    if (DALI2_HAL_IS_VALID_EVT(__hal_queue_evt) && __hal_queue_evt != DALI2_HAL_EVT_POLL) {
+        __dali2_hal_suspend();
+    }
+
+    __hal_queue_evt = evt_mtx;
+
+    //! New job counts own attempts and has own deadlines
+    __hal_queue_is_held = 0;
+    __hal_queue_app_cmd = DALI2_L_APP_CMD_UNKNOWN;
+    __hal_queue_ckpt_cmd = DALI2_L_APP_CMD_UNKNOWN;
+    __hal_queue_is_ctx_lost = 0;
+    dali2_hal_retry_reset();
+    dali2_hal_watchdog_job_start();
+    dali2_hal_done_job_start(evt_mtx);
+
     return __hal_queue_evt;
 }
 
 void dali2_hal_mtx_give(void)
 {
-    __hal_freed_by_evt = __hal_queue_evt;
+    dali2_hal_mtx_fail(DALI2_RET_SUCCESS);
+}
+
+void dali2_hal_mtx_fail(dali2_ret_t ret)
+{
+    //! Background polling is not reported
+    if (__hal_queue_evt != DALI2_HAL_EVT_POLL) {
+        __hal_freed_by_evt = __hal_queue_evt;
+        __hal_freed_ret = ret;
+        if (DALI2_HAL_IS_VALID_EVT(__hal_queue_evt)) {
+            dali2_hal_done_job_end(__hal_queue_evt);
+            dali2_hal_retry_job_end(__hal_queue_evt, ret);
+            dali2_hal_edf_job_end(__hal_queue_evt);
+            dali2_hal_client_job_end(__hal_queue_evt, ret);
+        }
+    } else {
+        __hal_freed_by_evt = DALI2_HAL_EVT_FREE;
+    }
     __hal_queue_evt = DALI2_HAL_EVT_FREE;
 }
 
+void dali2_hal_queue_hold(unsigned int delay_ms)
+{
+    __hal_queue_hold_ms = dali2_l_bsp_time_ms_get() + delay_ms;
+    __hal_queue_is_held = 1;
+}
+
 dali2_ret_t dali2_hal_queue_push(DALI2_L_APP_CMD_T cmd, dali2_l_app_cmd_data_t *cmd_data)
 {
     //! Parameter verification
     if (!cmd_data || !DALI2_HAL_IS_VALID_EVT(__hal_queue_evt)) {
-        DALI2_L_BSP_LOG("DALI2 HAL Internal fail on queue!");
+        DALI2_LOG0(HAL_QUEUE_FAIL);
 
         //! Free mutex
         __hal_queue_evt = DALI2_HAL_EVT_FREE;
@@ -58,9 +528,20 @@ dali2_ret_t dali2_hal_queue_push(DALI2_L_APP_CMD_T cmd, dali2_l_app_cmd_data_t *
         return DALI2_RET_INVALID_PARAMS;
     }
 
+    //! Repetition of the job command re-reads the bus, cached answer is the one just dispatched
+    __hal_queue_is_reread = (cmd == __hal_queue_app_cmd && DALI2_HAL_IS_STD_CMD(cmd) &&
+                             cmd_data->std_cmd.net.method == __hal_queue_app_cmd_data.std_cmd.net.method &&
+                             cmd_data->std_cmd.net.addr_byte == __hal_queue_app_cmd_data.std_cmd.net.addr_byte) ? 1 : 0;
+
     //! Copy content
     __hal_queue_app_cmd = cmd;
     memcpy(&__hal_queue_app_cmd_data, cmd_data, sizeof(dali2_l_app_cmd_data_t));
+    __hal_queue_is_new = 1;
+    __hal_queue_is_exec = 0;
+    __hal_queue_is_refused = 0;
+    __dali2_hal_queue_ckpt();
+    __hal_wait_us = dali2_l_bsp_time_us_get();
+    dali2_hal_watchdog_kick();
     return DALI2_RET_SUCCESS;
 }
 
@@ -68,26 +549,88 @@ dali2_ret_t dali2_hal_process(DALI2_HAL_EVT_T *evt)
 {
     dali2_ret_t dali2_ret = DALI2_RET_BUSY;
 
+    __dali2_hal_bus_evt_drain();
+    dali2_hal_quarantine_notify();
+    dali2_hal_post_drain();
+
+    //! Suspended job resumes once preempting one is reported
+    if (!DALI2_HAL_IS_VALID_EVT(__hal_queue_evt) && !DALI2_HAL_IS_VALID_EVT(__hal_freed_by_evt) &&
+        DALI2_HAL_IS_VALID_EVT(__hal_preempt.evt)) {
+        __dali2_hal_resume();
+    }
+
+    //! Schedulers may preempt running job, freed job is reported before; deadlines go first
+    if (!DALI2_HAL_IS_VALID_EVT(__hal_freed_by_evt)) {
+        dali2_hal_edf_poll();
+        dali2_hal_client_poll();
+    }
+
+    //! Background polling uses free HAL only
+    if (!DALI2_HAL_IS_VALID_EVT(__hal_queue_evt) && !DALI2_HAL_IS_VALID_EVT(__hal_freed_by_evt)) {
+        dali2_hal_watch_poll();
+    }
+
     if (DALI2_HAL_IS_VALID_EVT(__hal_queue_evt)) {
 
         //! Set event as active
         *evt = __hal_queue_evt;
 
+        //! Quarantined gear is not asked, job ends, polling and addressing check it themselves
+        if (__hal_queue_evt != DALI2_HAL_EVT_POLL && __hal_queue_evt != DALI2_HAL_EVT_ADDR_ALLOC &&
+            DALI2_HAL_IS_STD_CMD(__hal_queue_app_cmd) &&
+            dali2_hal_quarantine_skip(&__hal_queue_app_cmd_data.std_cmd.net)) {
+            dali2_hal_mtx_fail(DALI2_RET_TIMEOUT);
+            return dali2_ret;
+        }
+
+        //! Retry backoff
+        if (__hal_queue_is_held) {
+            if ((int) (dali2_l_bsp_time_ms_get() - __hal_queue_hold_ms) < 0) {
+                return dali2_ret;
+            }
+            __hal_queue_is_held = 0;
+            dali2_hal_watchdog_kick();
+        }
+
+        //! Lost completion or endless job
+        if (dali2_hal_watchdog_check(__hal_queue_evt, __hal_queue_app_cmd, __hal_queue_is_exec)) {
+            __hal_queue_is_exec = 0;
+            return dali2_ret;
+        }
+
+        //! Fresh answer costs no bus time, polling has own freshness
+        if (__hal_queue_is_new && !__hal_queue_is_reread && DALI2_L_APP_CMD_UNKNOWN != __hal_queue_app_cmd &&
+            __hal_queue_evt != DALI2_HAL_EVT_POLL) {
+            __hal_queue_is_new = 0;
+            if (__dali2_hal_cache_answer()) {
+                return dali2_ret;
+            }
+        }
+
         //! Execute command if mutex is active
         if (DALI2_L_APP_CMD_UNKNOWN != __hal_queue_app_cmd) {
+            DALI2_METRICS_JOB_SET(__hal_queue_evt);
+            dali2_l_app_priority_set(__hal_evt_priority[__hal_queue_evt]);
             dali2_ret = dali2_l_app_cmd_execute(__hal_queue_app_cmd, &__hal_queue_app_cmd_data);
+            DALI2_METRICS_JOB_SET(DALI2_METRICS_JOB_APP);
+
             switch (dali2_ret) {
                 case DALI2_RET_SUCCESS:
+                    __hal_queue_is_exec = 1;
+                    __hal_queue_is_refused = 0;
+                    __hal_exec_us = dali2_l_bsp_time_us_get();
+                    DALI2_METRICS_JOB_ADD(__hal_queue_evt, queue_wait, __hal_exec_us - __hal_wait_us);
                     dali2_ret = DALI2_RET_BUSY;
                     break;
 
                 case DALI2_RET_BUSY:
+                    __hal_queue_is_refused = 1;
                     break;
 
                 default:
                     //! Here is error occur!
                     //! Free mutex
-                    dali2_hal_mtx_give();
+                    dali2_hal_mtx_fail(dali2_ret);
                     break;
             }
         }
@@ -95,19 +638,104 @@ dali2_ret_t dali2_hal_process(DALI2_HAL_EVT_T *evt)
         //! Set event has freed
         *evt = __hal_freed_by_evt;
         __hal_freed_by_evt = DALI2_HAL_EVT_FREE;
-        dali2_ret = DALI2_RET_SUCCESS;
+        dali2_ret = __hal_freed_ret;
+        dali2_hal_done_report(*evt, dali2_ret);
     }
 
     return dali2_ret;
 }
 
-void dali2_hal_app_evt_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data)
+unsigned int dali2_hal_idle_ms(void)
 {
-    //! Skip interrupted command response
-    if (evt_data->cmd != __hal_queue_app_cmd) {
+    unsigned int idle_ms = DALI2_HAL_IDLE_MAX_MS;
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    unsigned int wait_ms;
+    unsigned int tail;
+
+    //! Bus event or posted request is to be handled, freed job is to be reported, suspended job is to be resumed
+    if (__dali2_hal_bus_evt_published(&tail) || __atomic_load_n(&__hal_bus_evt_ring.is_lost, __ATOMIC_ACQUIRE) ||
+        dali2_hal_post_is_pending() ||
+        DALI2_HAL_IS_VALID_EVT(__hal_freed_by_evt) ||
+        (!DALI2_HAL_IS_VALID_EVT(__hal_queue_evt) && DALI2_HAL_IS_VALID_EVT(__hal_preempt.evt))) {
+        return 0;
+    }
+
+    if (DALI2_HAL_IS_VALID_EVT(__hal_queue_evt)) {
+        if (__hal_queue_is_held) {
+            //! Watchdog waits for the end of retry backoff
+            if ((int) (now - __hal_queue_hold_ms) >= 0) {
+                return 0;
+            }
+            wait_ms = __hal_queue_hold_ms - now;
+        } else if (!__hal_queue_is_exec) {
+            //! Command is to be executed or answered from cache
+            return __hal_queue_is_refused ? DALI2_HAL_IDLE_BUSY_MS : 0;
+        } else {
+            //! Completion of executed command wakes, its loss is caught by watchdog
+            wait_ms = dali2_hal_watchdog_left_ms(__hal_queue_evt);
+        }
+    } else {
+        wait_ms = dali2_hal_watch_idle_ms();
+    }
+    if (wait_ms < idle_ms) {
+        idle_ms = wait_ms;
+    }
+
+    //! Schedulers may preempt running job
+    wait_ms = dali2_hal_edf_idle_ms();
+    if (wait_ms < idle_ms) {
+        idle_ms = wait_ms;
+    }
+    wait_ms = dali2_hal_client_idle_ms();
+    if (wait_ms < idle_ms) {
+        idle_ms = wait_ms;
+    }
+
+    return idle_ms;
+}
+
+static void __dali2_hal_app_evt_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data, unsigned int time_us)
+{
+    DALI2_HAL_EVT_T job_evt;
+
+    //! Every answer from the bus is stored, whoever has asked
+    if (!__hal_queue_is_cached && DALI2_HAL_IS_STD_CMD(evt_data->cmd)) {
+        dali2_hal_cache_put(evt_data->cmd, &evt_data->cmd_data.std_rsp.net, evt, evt_data->cmd_data.std_rsp.data);
+        dali2_hal_watch_answer(evt_data->cmd, &evt_data->cmd_data.std_rsp.net, evt, evt_data->cmd_data.std_rsp.data);
+        dali2_hal_health_answer(evt_data->cmd, &evt_data->cmd_data.std_rsp.net, evt, evt_data->cmd_data.std_rsp.data);
+        dali2_hal_quarantine_answer(evt_data->cmd, &evt_data->cmd_data.std_rsp.net, evt);
+    }
+
+    //! Bus time of queries follows their no-replies
+    if (!__hal_queue_is_cached) {
+        dali2_hal_cost_answer(evt_data->cmd, evt);
+    }
+
+    //! Completion of suspended job is kept until it resumes
+    if (__hal_preempt.is_exec && __dali2_hal_is_answer_of(evt_data, __hal_preempt.cmd, &__hal_preempt.cmd_data)) {
+        __hal_preempt.is_exec = 0;
+        __hal_preempt.is_done = 1;
+        __hal_preempt.done_evt = evt;
+        memcpy(&__hal_preempt.done_evt_data, evt_data, sizeof(dali2_l_app_evt_data_t));
         return;
     }
 
+    //! Skip interrupted command response or response of the same command to another node
+    if (!__dali2_hal_is_answer_of(evt_data, __hal_queue_app_cmd, &__hal_queue_app_cmd_data)) {
+        return;
+    }
+
+    //! Command done, the next one (or repetition) waits from now
+    __hal_queue_is_exec = 0;
+    __hal_wait_us = time_us;
+    dali2_hal_watchdog_kick();
+    if (DALI2_HAL_IS_VALID_EVT(__hal_queue_evt)) {
+        DALI2_METRICS_JOB_ADD(__hal_queue_evt, bus, __hal_wait_us - __hal_exec_us);
+    }
+
+    job_evt = __hal_queue_evt;
+    __hal_queue_is_new = 0;
+
     switch (__hal_queue_evt) {
         case DALI2_HAL_EVT_ADDR_ALLOC:
             dali2_hal_addr_alloc_dispatch(evt, evt_data);
@@ -121,9 +749,54 @@ void dali2_hal_app_evt_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
             dali2_hal_dim_ctrl_dispatch(evt, evt_data);
             break;
 
+        case DALI2_HAL_EVT_POLL:
+            dali2_hal_watch_dispatch(evt, evt_data);
+            break;
+
         case DALI2_HAL_EVT_FREE:
         default:
             break;
     }
+
+    //! Dispatcher keeping the job without the next command repeats the step
+    if (DALI2_HAL_IS_VALID_EVT(job_evt) && __hal_queue_evt == job_evt && !__hal_queue_is_new) {
+        dali2_hal_retry((evt == DALI2_L_APP_EVT_FAULT) ? DALI2_HAL_RETRY_STEP_SEND :
+                        (evt == DALI2_L_APP_EVT_TIMEOUT) ? DALI2_HAL_RETRY_STEP_QUERY :
+                        DALI2_HAL_RETRY_STEP_VERIFY, evt_data->cmd);
+    }
+}
+
+void dali2_hal_app_evt_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data)
+{
+    dali2_hal_bus_evt_t *slot;
+    unsigned int head;
+
+    //! Verify pointer, reserved slot is always published
+    if (!evt_data) {
+        return;
+    }
+
+    //! Lost completion is recovered by the next dali2_hal_process()
+    slot = __dali2_hal_bus_evt_reserve(&head);
+    if (!slot) {
+        return;
+    }
+
+    slot->is_tap = 0;
+    slot->time_us = dali2_l_bsp_time_us_get();
+    slot->data.app.evt = evt;
+    memcpy(&slot->data.app.evt_data, evt_data, sizeof(dali2_l_app_evt_data_t));
+    __dali2_hal_bus_evt_publish(slot, head);
+}
+
+unsigned int dali2_hal_bus_evt_dropped_get(void)
+{
+    return dali2_ring_dropped_get(&__hal_bus_evt_ring.ring);
 }
 
+void dali2_hal_preempt_stats_get(dali2_hal_preempt_stats_t *stats)
+{
+    if (stats) {
+        memcpy(stats, &__hal_preempt_stats, sizeof(dali2_hal_preempt_stats_t));
+    }
+}
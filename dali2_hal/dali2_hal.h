@@ -24,36 +24,330 @@
 #define DALI2_DIM_CFG_MAX_LEVEL           0xFE
 #define DALI2_DIM_CFG_MIN_LEVEL           0x9A
 
+//! Arc power level to Dimmer level
+#define DALI2_HAL_DIM_LEVEL_FROM_ARC(arc) ((arc) ? (arc) - DALI2_DIM_CFG_MIN_LEVEL : (arc))
+
+//! Shadow level confidence after gear answer and after settled prediction from forward frame
+#ifndef DALI2_HAL_SHADOW_OBSERVED_TTL_MS
+#define DALI2_HAL_SHADOW_OBSERVED_TTL_MS  60000
+#endif
+#ifndef DALI2_HAL_SHADOW_PREDICTED_TTL_MS
+#define DALI2_HAL_SHADOW_PREDICTED_TTL_MS 30000
+#endif
+
+//! Query answer lifetime in cache per answer class
+#ifndef DALI2_HAL_CACHE_STATE_TTL_MS
+#define DALI2_HAL_CACHE_STATE_TTL_MS      2000        //! Level, lamp and status bits
+#endif
+#ifndef DALI2_HAL_CACHE_FAILURE_TTL_MS
+#define DALI2_HAL_CACHE_FAILURE_TTL_MS    10000       //! Gear presence, lamp and LED failures
+#endif
+#ifndef DALI2_HAL_CACHE_CONFIG_TTL_MS
+#define DALI2_HAL_CACHE_CONFIG_TTL_MS     600000      //! Limits, fade, operating modes
+#endif
+#ifndef DALI2_HAL_CACHE_IDENT_TTL_MS
+#define DALI2_HAL_CACHE_IDENT_TTL_MS      3600000     //! Versions, device types, features
+#endif
+
+//! Attribute subscriptions count, maximum age low limit and retry time after transmission fault
+#ifndef DALI2_HAL_WATCH_COUNT
+#define DALI2_HAL_WATCH_COUNT             16
+#endif
+#define DALI2_HAL_WATCH_AGE_MIN_MS        100
+#define DALI2_HAL_WATCH_RETRY_MS          1000
+
+//! Presence probe period of absent addresses for group and broadcast subscriptions
+#ifndef DALI2_HAL_WATCH_PROBE_MS
+#define DALI2_HAL_WATCH_PROBE_MS          1000
+#endif
+#ifndef DALI2_HAL_WATCH_REPROBE_MS
+#define DALI2_HAL_WATCH_REPROBE_MS        600000
+#endif
+
+//! Health poller interval of failing or changed gear and the longest one of stable gear
+#ifndef DALI2_HAL_HEALTH_FAST_MS
+#define DALI2_HAL_HEALTH_FAST_MS          2000
+#endif
+#ifndef DALI2_HAL_HEALTH_SLOW_MS
+#define DALI2_HAL_HEALTH_SLOW_MS          256000
+#endif
+
+//! Bus time share of background polling, percent 1..100
+#ifndef DALI2_HAL_POLL_SHARE_PCT
+#define DALI2_HAL_POLL_SHARE_PCT          20
+#endif
+
+//! Consecutive no-replies of short address to quarantine it, first and the longest recheck period
+#ifndef DALI2_HAL_QUARANTINE_MISSES
+#define DALI2_HAL_QUARANTINE_MISSES       3
+#endif
+#ifndef DALI2_HAL_QUARANTINE_RECHECK_MS
+#define DALI2_HAL_QUARANTINE_RECHECK_MS   2000
+#endif
+#ifndef DALI2_HAL_QUARANTINE_RECHECK_MAX_MS
+#define DALI2_HAL_QUARANTINE_RECHECK_MAX_MS 600000
+#endif
+
+//! Repetitions of failed steps per job, steps have own limits too
+#ifndef DALI2_HAL_RETRY_JOB_MAX
+#define DALI2_HAL_RETRY_JOB_MAX           16
+#endif
+
+//! Time from the last progress of job to resynchronization and restart of its command
+#ifndef DALI2_HAL_WATCHDOG_CMD_MS
+#define DALI2_HAL_WATCHDOG_CMD_MS         1000
+#endif
+
+//! Time from the start of job to its abort
+#ifndef DALI2_HAL_WATCHDOG_JOB_MS
+#define DALI2_HAL_WATCHDOG_JOB_MS         60000
+#endif
+
+//! Address allocation walks whole bus
+#ifndef DALI2_HAL_WATCHDOG_ADDR_ALLOC_MS
+#define DALI2_HAL_WATCHDOG_ADDR_ALLOC_MS  300000
+#endif
+
+//! Requests held by deadline scheduler
+#ifndef DALI2_HAL_EDF_COUNT
+#define DALI2_HAL_EDF_COUNT               8
+#endif
+
+//! The longest sleep of idle HAL, sleep while background polling runs and retry of refused command
+#ifndef DALI2_HAL_IDLE_MAX_MS
+#define DALI2_HAL_IDLE_MAX_MS             1000
+#endif
+#ifndef DALI2_HAL_IDLE_POLL_MS
+#define DALI2_HAL_IDLE_POLL_MS            100
+#endif
+#define DALI2_HAL_IDLE_BUSY_MS            1
+
+//! Clients sharing the bus and requests queued per client
+#ifndef DALI2_HAL_CLIENT_COUNT
+#define DALI2_HAL_CLIENT_COUNT            4
+#endif
+#ifndef DALI2_HAL_CLIENT_QUEUE
+#define DALI2_HAL_CLIENT_QUEUE            4
+#endif
+
+//! Bus events latched in interrupt context up to the next dali2_hal_process(), must be power of 2
+#ifndef DALI2_HAL_BUS_EVT_RING_SIZE
+#define DALI2_HAL_BUS_EVT_RING_SIZE       8
+#endif
+#if (DALI2_HAL_BUS_EVT_RING_SIZE < 2) || (DALI2_HAL_BUS_EVT_RING_SIZE & (DALI2_HAL_BUS_EVT_RING_SIZE - 1))
+#error "DALI2_HAL_BUS_EVT_RING_SIZE must be power of 2"
+#endif
+
+//! Requests posted by other threads up to the next dali2_hal_process(), must be power of 2
+#ifndef DALI2_HAL_POST_RING_SIZE
+#define DALI2_HAL_POST_RING_SIZE          16
+#endif
+#if (DALI2_HAL_POST_RING_SIZE < 2) || (DALI2_HAL_POST_RING_SIZE & (DALI2_HAL_POST_RING_SIZE - 1))
+#error "DALI2_HAL_POST_RING_SIZE must be power of 2"
+#endif
+
 typedef enum {
     DALI2_HAL_EVT_ADDR_ALLOC,
     DALI2_HAL_EVT_DIM_CFG,
     DALI2_HAL_EVT_DIM_CTRL,
+    DALI2_HAL_EVT_POLL,                 //! Background polling, it is not reported as freed
 
     DALI2_HAL_EVT_FREE
 } DALI2_HAL_EVT_T;
 
+/**@brief HAL initialization, dimmer shadow state and query cache are reset and
+ *        attached to Session layer frames, @see dali2_l_ses_tap_set()
+ * @note  Call after dali2_l_app_init(). Without it every query goes to the bus.
+ */
+void dali2_hal_init(void);
+
 /**@brief Dispatch this function inside dali2_l_app_evt_func_t()
+ * @note  Event is latched, maybe in interrupt context, and handled by the next
+ *        dali2_hal_process(), @see DALI2_HAL_BUS_EVT_RING_SIZE
  *
  * @param[IN] evt - @see dali2_l_app_evt_func_t()
  * @param[IN] evt_data - @see dali2_l_app_evt_func_t()
  */
 void dali2_hal_app_evt_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data);
 
+/**@brief Getting count of bus events dropped on full ring
+ * @note  Next dali2_hal_process() after the drop flushes query cache and shadow state
+ *        and repeats running command
+ *
+ * @return dropped events since dali2_hal_init()
+ */
+unsigned int dali2_hal_bus_evt_dropped_get(void);
+
 /**@brief HAL process
- * @note  Call this function periodically according your priority.
+ * @note  Call this function periodically according your priority, or sleep between calls
+ *        up to dali2_hal_idle_ms() or to wake callback, @see dali2_hal_wake_func_set().
+ *        Failed steps of jobs are repeated by retry policy of step class, job
+ *        which is out of attempts fails, @see dali2_hal_job_result_get().
  *
  * @param[OUT] evt - event for return code
  * @return DALI2_RET_SUCCESS - HAL process successfully done
  *         DALI2_RET_BUSY - HAL process in progress or idle state
+ *         DALI2_RET_TIMEOUT - job has failed, gear has not answered or is quarantined,
+ *                             @see dali2_hal_quarantine_func_set(), or job is over
+ *                             its deadline, @see dali2_hal_watchdog_report_get()
+ *         DALI2_RET_NOT_SUPPORTED - job has failed, gear has not accepted value
+ *         DALI2_RET_INTERNAL_ERROR - job has failed, command is not transmitted
  *         [OTHERWISE] - execution error
  */
 dali2_ret_t dali2_hal_process(DALI2_HAL_EVT_T *evt);
 
+//! Result of the last finished job
+typedef struct {
+    DALI2_HAL_EVT_T evt;                //! Job, DALI2_HAL_EVT_FREE if none has finished
+    dali2_ret_t ret;                    //! Result reported by dali2_hal_process()
+    DALI2_L_APP_CMD_T cmd;              //! Failed step, DALI2_L_APP_CMD_UNKNOWN on success
+    unsigned char retries;              //! Repetitions of failed steps
+} dali2_hal_job_result_t;
+
+/**@brief Getting result of the last finished job
+ *
+ * @param[OUT] result - result output
+ */
+void dali2_hal_job_result_get(dali2_hal_job_result_t *result);
+
+/**@brief Job completion callback, called inside dali2_hal_process()
+ *
+ * @param[IN] evt - finished job
+ * @param[IN] ret - result of the job, @see dali2_hal_process()
+ * @param[IN] ctx - context given with the callback
+ */
+typedef void (* dali2_hal_done_func_t) (DALI2_HAL_EVT_T evt, dali2_ret_t ret, void *ctx);
+
+//! Completion of submitted job
+typedef struct {
+    dali2_hal_done_func_t func;         //! NULL if not needed
+    void *ctx;
+} dali2_hal_done_t;
+
+/**@brief Setting callback of every job reported by dali2_hal_process()
+ * @note  Callback is called with the same event and result as dali2_hal_process() returns,
+ *        after the callback of submitted job, @see dali2_hal_edf_submit(), dali2_hal_client_submit().
+ *        Background polling is not reported.
+ *
+ * @param[IN] func - callback, NULL to disable
+ * @param[IN] ctx - callback context
+ */
+void dali2_hal_done_func_set(dali2_hal_done_func_t func, void *ctx);
+
+//! Waitable completion of submitted job
+typedef struct {
+    volatile unsigned char is_done;
+    DALI2_HAL_EVT_T evt;
+    dali2_ret_t ret;
+} dali2_hal_done_wait_t;
+
+/**@brief Binding completion of submitted job to waitable handle
+ * @note  Handle is set done inside dali2_hal_process(), it has to live until then.
+ *        Main loop sleeping on wake callback checks it after dali2_hal_process().
+ *
+ * @param[OUT] done - completion of request to be submitted
+ * @param[OUT] wait - waitable handle, it is reset
+ */
+void dali2_hal_done_wait_bind(dali2_hal_done_t *done, dali2_hal_done_wait_t *wait);
+
+/**@brief Checking waitable handle
+ * @note  May be called by any thread, event and result are valid once it returns 1
+ *
+ * @param[IN] wait - waitable handle
+ * @return 1 if the job is finished
+ */
+unsigned char dali2_hal_done_wait_is_done(const dali2_hal_done_wait_t *wait);
+
+/**@brief Work pending callback
+ * @note  Called from dali2_hal_app_evt_dispatch() and by posting threads, so maybe from
+ *        interrupt context: only signal the thread calling dali2_hal_process(), RTOS event
+ *        or eventfd.
+ */
+typedef void (* dali2_hal_wake_func_t) (void);
+
+/**@brief Setting work pending callback
+ * @note  Callback is called on every answer or fault from the bus and on every submitted
+ *        or posted request. Timed work (retry backoff, watchdog, deadlines, bus time refill and
+ *        background polling) is not signalled, @see dali2_hal_idle_ms().
+ *
+ * @param[IN] func - callback, NULL to disable
+ */
+void dali2_hal_wake_func_set(dali2_hal_wake_func_t func);
+
+/**@brief Time dali2_hal_process() is not needed without wake callback
+ * @note  Call after dali2_hal_process() and after direct calls of HAL job functions, then
+ *        sleep up to the time or up to the wake callback, @see dali2_hal_wake_func_set().
+ *        Background polling is rechecked every DALI2_HAL_IDLE_POLL_MS.
+ *
+ * @return milliseconds, 0 if dali2_hal_process() has work now, DALI2_HAL_IDLE_MAX_MS at most
+ */
+unsigned int dali2_hal_idle_ms(void);
+
+//! Retry policy statistics
+typedef struct {
+    unsigned int retries;               //! Repeated steps
+    unsigned int rereads;               //! Repetitions re-reading the value only
+    unsigned int failures;              //! Jobs failed out of attempts
+} dali2_hal_retry_stats_t;
+
+/**@brief Getting retry policy statistics
+ *
+ * @param[OUT] stats - statistics output
+ */
+void dali2_hal_retry_stats_get(dali2_hal_retry_stats_t *stats);
+
+//! Where the job has stalled
+typedef enum {
+    DALI2_HAL_WATCHDOG_STAGE_QUEUE,     //! Command is not accepted by Application layer
+    DALI2_HAL_WATCHDOG_STAGE_BUS,       //! Command is accepted, its completion is lost
+    DALI2_HAL_WATCHDOG_STAGE_JOB        //! Job is over its deadline
+} DALI2_HAL_WATCHDOG_STAGE_T;
+
+//! The last watchdog intervention
+typedef struct {
+    DALI2_HAL_EVT_T evt;                //! Job, DALI2_HAL_EVT_FREE if none has stalled
+    DALI2_L_APP_CMD_T cmd;              //! Command of the job
+    DALI2_HAL_WATCHDOG_STAGE_T stage;
+    unsigned char layers;               //! Layers found busy, @see dali2_l_app_resync()
+    unsigned int stalled_ms;            //! Time without progress, time of job for DALI2_HAL_WATCHDOG_STAGE_JOB
+} dali2_hal_watchdog_report_t;
+
+/**@brief Getting the last watchdog intervention
+ *
+ * @param[OUT] report - report output
+ */
+void dali2_hal_watchdog_report_get(dali2_hal_watchdog_report_t *report);
+
+//! Watchdog statistics
+typedef struct {
+    unsigned int restarts;              //! Stalled commands restarted
+    unsigned int aborts;                //! Jobs aborted over deadline
+} dali2_hal_watchdog_stats_t;
+
+/**@brief Getting watchdog statistics
+ *
+ * @param[OUT] stats - statistics output
+ */
+void dali2_hal_watchdog_stats_get(dali2_hal_watchdog_stats_t *stats);
+
+//! Preemption statistics
+typedef struct {
+    unsigned int preemptions;           //! Jobs suspended by interactive ones
+    unsigned int resumes;
+    unsigned int restarts;              //! Commands restarted from checkpoint, gear context was lost
+} dali2_hal_preempt_stats_t;
+
+/**@brief Getting preemption statistics
+ *
+ * @param[OUT] stats - statistics output
+ */
+void dali2_hal_preempt_stats_get(dali2_hal_preempt_stats_t *stats);
+
 /********** Address allocation functions **********/
 /*** See IEC 62386-102-2014 document @paragraph "Annex A" for addresses allocation ***/
 typedef enum {
     DALI2_HAL_ADDR_ALLOC_METHOD_SINGLE,     //! Allocate single address
-    DALI2_HAL_ADDR_ALLOC_METHOD_RANDOM,     //! Allocate random addresses
+    DALI2_HAL_ADDR_ALLOC_METHOD_RANDOM,     //! Allocate random addresses, found by binary search from the lowest
     DALI2_HAL_ADDR_ALLOC_METHOD_UNKNOWN
 } DALI2_HAL_ADDR_ALLOC_METHOD_T;
 
@@ -144,7 +438,10 @@ dali2_ret_t dali2_hal_dim_meta_get(dali2_hal_dim_meta_t *dim_meta, dali2_l_app_n
 dali2_ret_t dali2_hal_dim_set_level(unsigned char level, dali2_l_app_network_t *node);
 
 /**@brief Getting Dimmer level
- * @note This is Blocking function
+ * @note Level of short address is taken from shadow state without bus traffic
+ *       while it is trusted, @see dali2_hal_dim_shadow_get().
+ *       Otherwise cached level is returned, or the last queried level is returned and
+ *       dimmer state is queried again.
  *
  * @param[OUT] level - pointer for dimmer level reception. Answer in
  *                       from Physical minimum up to DALI2_DIM_LEVEL_MAX
@@ -154,6 +451,9 @@ dali2_ret_t dali2_hal_dim_set_level(unsigned char level, dali2_l_app_network_t *
 dali2_ret_t dali2_hal_dim_get_level(unsigned char *level, dali2_l_app_network_t *node);
 
 /**@brief Obtaining Dimmer status
+ * @note Cached status of short address is returned without bus traffic,
+ *       otherwise the last queried status is returned and dimmer state is queried again.
+ *       Request for node with running query chain is attached to it.
  *
  * @param[OUT] status - pointer for obtaining dimmer status.
  *  @note Decode status byte according @ref DALI2_L_APP_CMD_STATUS_T
@@ -163,6 +463,7 @@ dali2_ret_t dali2_hal_dim_get_level(unsigned char *level, dali2_l_app_network_t
 dali2_ret_t dali2_hal_dim_get_status(unsigned char *status, dali2_l_app_network_t *node);
 
 /**@brief Obtaining LED Failure status
+ * @note Cached like dali2_hal_dim_get_status()
  *
  * @param[OUT] status - pointer for obtaining LED failure status.
  *  @note Decode status byte according @ref DALI2_L_APP_LED_FAILURE_T
@@ -171,4 +472,370 @@ dali2_ret_t dali2_hal_dim_get_status(unsigned char *status, dali2_l_app_network_
  */
 dali2_ret_t dali2_hal_dim_get_led_failure_status(unsigned char *failure_status, dali2_l_app_network_t *node);
 
+//! Dimmer shadow state
+typedef struct {
+    unsigned char level;                //! From physical minimum up to DALI2_DIM_LEVEL_MAX
+    unsigned char is_predicted;         //! Level is predicted from forward frames, not answered by gear
+    unsigned int age_ms;                //! Time since the last level update or fade start
+    unsigned int confidence_ms;         //! Time left before level is queried again
+    unsigned short groups;              //! Group membership bits...
+    unsigned short groups_known;        //! ...valid where this mask is set
+} dali2_hal_dim_shadow_t;
+
+/**@brief Getting Dimmer shadow state, it is updated from every forward frame on the line,
+ *        own frames and frames of other masters, and from answers of own queries.
+ *
+ * @param[OUT] shadow - shadow state
+ * @param[IN] node - DALI node, short addressing only
+ * @return DALI2_RET_SUCCESS - level is trusted
+ *         DALI2_RET_TIMEOUT - level confidence has expired, level is not valid
+ *         DALI2_RET_BUSY - level is fading from unknown level, level is not valid
+ *         DALI2_RET_NOT_SUPPORTED - level is not known
+ *         DALI2_RET_INVALID_PARAMS - not short address
+ */
+dali2_ret_t dali2_hal_dim_shadow_get(dali2_hal_dim_shadow_t *shadow, dali2_l_app_network_t *node);
+
+/********** Attribute subscription functions **********/
+typedef enum {
+    DALI2_HAL_ATTR_LEVEL = 0x01,        //! Actual arc power level, DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL
+    DALI2_HAL_ATTR_STATUS = 0x02,       //! @ref DALI2_L_APP_CMD_STATUS_T, DALI2_L_APP_CMD_QUERY_STATUS
+    DALI2_HAL_ATTR_LED_FAILURE = 0x04,  //! @ref DALI2_L_APP_LED_FAILURE_T, DALI2_L_APP_CMD_QUERY_FAILURE_STATUS
+
+    DALI2_HAL_ATTR_ALL = 0x07
+} DALI2_HAL_ATTR_T;
+
+//! Attribute change
+typedef struct {
+    unsigned char short_addr;
+    DALI2_HAL_ATTR_T attr;
+    unsigned char is_answered;          //! Gear has answered, otherwise value is not valid
+    unsigned char value;                //! Answer of the query
+} dali2_hal_watch_evt_t;
+
+/**@brief Attribute change callback, called inside dali2_hal_process()
+ *
+ * @param[IN] evt - changed attribute
+ */
+typedef void (* dali2_hal_watch_func_t) (const dali2_hal_watch_evt_t *evt);
+
+/**@brief Subscribing to attributes of node, group or all gear
+ * @note  Attributes are queried by background poll job of dali2_hal_process() only while
+ *        HAL is free and only when the last answer is older than the smallest maximum age
+ *        of subscriptions covering it. Answers of other HAL jobs and trusted shadow level
+ *        count as fresh values.
+ *        Callback is called when answer differs from the last known one, the first
+ *        answer is a change too.
+ *        Group and broadcast subscriptions cover gear which has answered any query,
+ *        absent addresses are probed every DALI2_HAL_WATCH_PROBE_MS.
+ *
+ * @param[OUT] watch_id - subscription identifier
+ * @param[IN] target - short address, group or broadcast
+ * @param[IN] attrs - attribute bits, @ref DALI2_HAL_ATTR_T
+ * @param[IN] max_age_ms - maximum age of attribute value, DALI2_HAL_WATCH_AGE_MIN_MS at least
+ * @param[IN] func - change callback
+ * @return DALI2_RET_SUCCESS - subscribed
+ *         DALI2_RET_BUSY - no free subscription, @see DALI2_HAL_WATCH_COUNT
+ *         DALI2_RET_NOT_SUPPORTED - addressing method is not supported
+ *         DALI2_RET_INVALID_PARAMS - wrong parameters
+ */
+dali2_ret_t dali2_hal_watch_subscribe(unsigned char *watch_id, dali2_l_app_network_t *target,
+                                      unsigned char attrs, unsigned int max_age_ms,
+                                      dali2_hal_watch_func_t func);
+
+/**@brief Unsubscribing
+ *
+ * @param[IN] watch_id - subscription identifier
+ * @return DALI2_RET_SUCCESS - unsubscribed
+ *         DALI2_RET_INVALID_PARAMS - subscription is not used
+ */
+dali2_ret_t dali2_hal_watch_unsubscribe(unsigned char watch_id);
+
+//! Attribute subscription statistics
+typedef struct {
+    unsigned int queries;               //! Attribute queries of poll job
+    unsigned int probes;                //! Presence probes of poll job
+    unsigned int shadow;                //! Level refreshes from shadow state
+    unsigned int notified;              //! Callback calls
+} dali2_hal_watch_stats_t;
+
+/**@brief Getting attribute subscription statistics
+ *
+ * @param[OUT] stats - statistics output
+ */
+void dali2_hal_watch_stats_get(dali2_hal_watch_stats_t *stats);
+
+/********** Health poller functions **********/
+//! Health of node
+typedef struct {
+    unsigned char status;               //! @ref DALI2_L_APP_CMD_STATUS_T
+    unsigned char failure_status;       //! @ref DALI2_L_APP_LED_FAILURE_T
+    unsigned char is_failing;           //! Gear, lamp or LED failure
+    unsigned int interval_ms;           //! Current poll interval
+} dali2_hal_health_t;
+
+/**@brief Starting health poller
+ * @note  Present gear is polled round robin by background poll job while HAL is free.
+ *        Failing gear and gear with changed status (POWER CYCLE SEEN included) is polled
+ *        every DALI2_HAL_HEALTH_FAST_MS, poll interval of stable gear is doubled after
+ *        every poll up to DALI2_HAL_HEALTH_SLOW_MS. Absent addresses are probed every
+ *        DALI2_HAL_WATCH_PROBE_MS. Background polling takes DALI2_HAL_POLL_SHARE_PCT
+ *        of bus time at most. Subscribe to status with dali2_hal_watch_subscribe()
+ *        to get changes.
+ */
+void dali2_hal_health_start(void);
+
+/**@brief Stopping health poller, known health is kept
+ */
+void dali2_hal_health_stop(void);
+
+/**@brief Getting health of node
+ *
+ * @param[OUT] health - health output
+ * @param[IN] node - DALI node, short addressing only
+ * @return DALI2_RET_SUCCESS - health is known
+ *         DALI2_RET_NOT_SUPPORTED - status has not been queried yet
+ *         DALI2_RET_INVALID_PARAMS - wrong parameters
+ */
+dali2_ret_t dali2_hal_health_get(dali2_hal_health_t *health, dali2_l_app_network_t *node);
+
+//! Health poller statistics
+typedef struct {
+    unsigned int queries;               //! Health queries of poll job
+    unsigned int changes;               //! Status or LED failure changes
+    unsigned int failing;               //! Gear failing now
+} dali2_hal_health_stats_t;
+
+/**@brief Getting health poller statistics
+ *
+ * @param[OUT] stats - statistics output
+ */
+void dali2_hal_health_stats_get(dali2_hal_health_stats_t *stats);
+
+/********** Unresponsive gear quarantine functions **********/
+/**@brief Quarantine change callback, called inside dali2_hal_process()
+ *
+ * @param[IN] short_addr - short address
+ * @param[IN] is_quarantined - 1 if gear has been quarantined, 0 if gear has answered again
+ */
+typedef void (* dali2_hal_quarantine_func_t) (unsigned char short_addr, unsigned char is_quarantined);
+
+/**@brief Setting quarantine change callback
+ * @note  Short address is quarantined after DALI2_HAL_QUARANTINE_MISSES consecutive
+ *        no-replies on queries which present gear always answers, QUERY CONTROL GEAR
+ *        PRESENT, QUERY STATUS, level queries and so on. HAL jobs addressing quarantined
+ *        gear end at once and pollers skip it. Gear is rechecked by single QUERY CONTROL
+ *        GEAR PRESENT after DALI2_HAL_QUARANTINE_RECHECK_MS, the period is doubled after
+ *        every silent recheck up to DALI2_HAL_QUARANTINE_RECHECK_MAX_MS.
+ *
+ * @param[IN] func - callback, NULL to disable
+ */
+void dali2_hal_quarantine_func_set(dali2_hal_quarantine_func_t func);
+
+/**@brief Releasing gear from quarantine, for example after replacement
+ *
+ * @param[IN] node - DALI node, short addressing only
+ * @return DALI2_RET_SUCCESS - gear is not quarantined
+ *         DALI2_RET_INVALID_PARAMS - wrong parameters
+ */
+dali2_ret_t dali2_hal_quarantine_release(dali2_l_app_network_t *node);
+
+//! Quarantine statistics
+typedef struct {
+    unsigned int quarantined;           //! Gear quarantined
+    unsigned int released;              //! Gear answered again or released
+    unsigned int rechecks;              //! Recheck probes of poll job
+    unsigned int skipped;               //! Job commands not sent to quarantined gear
+    unsigned int count;                 //! Gear quarantined now
+} dali2_hal_quarantine_stats_t;
+
+/**@brief Getting quarantine statistics
+ *
+ * @param[OUT] stats - statistics output
+ */
+void dali2_hal_quarantine_stats_get(dali2_hal_quarantine_stats_t *stats);
+
+//! Query cache statistics
+typedef struct {
+    unsigned int hit;                   //! Query answered from cache without bus time
+    unsigned int miss;                  //! Answer is not cached or has expired
+    unsigned int joined;                //! Request attached to running query chain of the same node
+    unsigned int invalidated;           //! Answers dropped by forward frames
+} dali2_hal_cache_stats_t;
+
+/**@brief Getting query cache statistics
+ *
+ * @param[OUT] stats - statistics output
+ */
+void dali2_hal_cache_stats_get(dali2_hal_cache_stats_t *stats);
+
+/**@brief Dropping all cached answers, the next queries go to the bus
+ * @note  Use it after gear were changed by other means than DALI line
+ */
+void dali2_hal_cache_flush(void);
+
+/********** Bus time cost model and deadline scheduler functions **********/
+typedef enum {
+    DALI2_HAL_JOB_SET_LEVEL,            //! @see dali2_hal_dim_set_level()
+    DALI2_HAL_JOB_UPDATE_STATE,         //! @see dali2_hal_dim_get_status()
+    DALI2_HAL_JOB_DIM_CFG,              //! @see dali2_hal_dim_cfg()
+
+    DALI2_HAL_JOB_COUNT
+} DALI2_HAL_JOB_T;
+
+typedef union {
+    unsigned char level;                //! Used for DALI2_HAL_JOB_SET_LEVEL
+    dali2_hal_dim_cfg_t dim_cfg;        //! Used for DALI2_HAL_JOB_DIM_CFG
+} dali2_hal_job_data_t;
+
+/**@brief Predicting bus time of command
+ * @note  Query is charged by learned share of its no-replies
+ *
+ * @param[IN] cmd - command
+ * @param[IN] node - DALI node, fresh cached answer takes no bus time; NULL if not known
+ * @param[IN] priority - transaction priority
+ * @return bus time in microseconds
+ */
+unsigned int dali2_hal_cost_cmd_us(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *node,
+                                   DALI2_L_SES_PRIORITY_T priority);
+
+/**@brief Predicting bus time of job started now
+ * @note  Nominal command chain of the job without retries, LED gear is expected;
+ *        setting level polls the level up to the end of fade known by shadow state
+ *
+ * @param[IN] job - job
+ * @param[IN] node - DALI node
+ * @return bus time in microseconds, 0 if the job is not going to the bus
+ */
+unsigned int dali2_hal_cost_job_us(DALI2_HAL_JOB_T job, dali2_l_app_network_t *node);
+
+typedef struct {
+    DALI2_HAL_JOB_T job;
+    dali2_l_app_network_t node;
+    dali2_hal_job_data_t data;
+    unsigned int deadline_ms;           //! From submission up to the end of the job
+    dali2_hal_done_t done;              //! Called when the job is finished
+} dali2_hal_edf_req_t;
+
+/**@brief Submitting job to deadline scheduler
+ * @note  Admitted jobs are started by dali2_hal_process() earliest deadline first and are
+ *        reported as usual. Job which cannot finish in time anymore is not started, it is
+ *        reported with DALI2_RET_TIMEOUT. Completion of admitted request is called once,
+ *        for job answered from cache without report too, rejected request is not called.
+ *
+ * @param[IN] req - request, it is copied
+ * @return DALI2_RET_SUCCESS - request is admitted, predicted bus time of it and of all
+ *                             admitted requests fits their deadlines
+ *         DALI2_RET_TIMEOUT - request is rejected, its deadline or deadline of admitted
+ *                             request would be missed
+ *         DALI2_RET_BUSY - all requests are held, @see DALI2_HAL_EDF_COUNT
+ *         DALI2_RET_INVALID_PARAMS - wrong request
+ */
+dali2_ret_t dali2_hal_edf_submit(dali2_hal_edf_req_t *req);
+
+//! Deadline scheduler statistics
+typedef struct {
+    unsigned int admitted;
+    unsigned int rejected;              //! Deadline would be missed
+    unsigned int expired;               //! Admitted, not started in time
+    unsigned int met;                   //! Finished before deadline
+    unsigned int missed;                //! Finished after deadline, prediction was short
+} dali2_hal_edf_stats_t;
+
+/**@brief Getting deadline scheduler statistics
+ *
+ * @param[OUT] stats - statistics output
+ */
+void dali2_hal_edf_stats_get(dali2_hal_edf_stats_t *stats);
+
+/********** Bus sharing between clients functions **********/
+typedef struct {
+    const char *name;                   //! Kept by pointer
+    unsigned char weight;               //! Share of bus time against other busy clients
+    unsigned int rate_ms;               //! Bus time granted per second, 0 - not limited
+    unsigned int burst_ms;              //! Bus time saved up by idle client
+} dali2_hal_client_cfg_t;
+
+/**@brief Registering HAL client
+ *
+ * @param[OUT] client - client identifier
+ * @param[IN] cfg - client configuration, it is copied
+ * @return DALI2_RET_SUCCESS - client is registered
+ *         DALI2_RET_BUSY - all clients are registered, @see DALI2_HAL_CLIENT_COUNT
+ *         DALI2_RET_INVALID_PARAMS - wrong configuration
+ */
+dali2_ret_t dali2_hal_client_register(unsigned char *client, const dali2_hal_client_cfg_t *cfg);
+
+typedef struct {
+    DALI2_HAL_JOB_T job;
+    dali2_l_app_network_t node;
+    dali2_hal_job_data_t data;
+    dali2_hal_done_t done;              //! Called when the job is finished
+} dali2_hal_client_req_t;
+
+/**@brief Queueing job of client
+ * @note  Jobs of busy clients are started by dali2_hal_process() by weighted fair queuing,
+ *        client out of bus time waits for the refill of its bucket. Jobs of one client are
+ *        started in order and are reported as usual. Completion of queued request is
+ *        called once, for job answered from cache or failed to start too.
+ *
+ * @param[IN] client - client identifier
+ * @param[IN] req - request, it is copied
+ * @return DALI2_RET_SUCCESS - request is queued
+ *         DALI2_RET_BUSY - queue of the client is full, @see DALI2_HAL_CLIENT_QUEUE
+ *         DALI2_RET_INVALID_PARAMS - wrong client or request
+ */
+dali2_ret_t dali2_hal_client_submit(unsigned char client, dali2_hal_client_req_t *req);
+
+//! Client statistics
+typedef struct {
+    unsigned int submitted;
+    unsigned int dropped;               //! Queue was full
+    unsigned int started;
+    unsigned int failed;                //! Job is started or finished with error
+    unsigned int throttled;             //! Client has run out of bus time with queued jobs
+    unsigned int bus_ms;                //! Time of holding HAL by its jobs
+    int tokens_ms;                      //! Bus time left in bucket, negative if owed
+    unsigned char queued;
+} dali2_hal_client_stats_t;
+
+/**@brief Getting client statistics
+ *
+ * @param[OUT] stats - statistics output
+ * @param[IN] client - client identifier
+ * @return DALI2_RET_SUCCESS - statistics are got
+ *         DALI2_RET_INVALID_PARAMS - wrong client
+ */
+dali2_ret_t dali2_hal_client_stats_get(dali2_hal_client_stats_t *stats, unsigned char client);
+
+/********** Submission from other threads functions **********/
+/**@brief Posting job to deadline scheduler from any thread
+ * @note  Lock-free, may be called from interrupt context and from several producers at the
+ *        same time. Request is handed to dali2_hal_edf_submit() by the next dali2_hal_process(),
+ *        deadline counts from then. Result of submission other than DALI2_RET_SUCCESS is
+ *        reported by completion of the request, so the completion is called exactly once.
+ *        Every other HAL function is called by the thread of dali2_hal_process() only.
+ *
+ * @param[IN] req - request, it is copied
+ * @return DALI2_RET_SUCCESS - request is posted
+ *         DALI2_RET_BUSY - ring is full, @see DALI2_HAL_POST_RING_SIZE
+ *         DALI2_RET_INVALID_PARAMS - wrong request
+ */
+dali2_ret_t dali2_hal_edf_post(const dali2_hal_edf_req_t *req);
+
+/**@brief Posting job of client from any thread
+ * @note  Same as dali2_hal_edf_post(), request is handed to dali2_hal_client_submit().
+ *        Client is registered before producers start.
+ *
+ * @param[IN] client - client identifier
+ * @param[IN] req - request, it is copied
+ * @return @see dali2_hal_edf_post()
+ */
+dali2_ret_t dali2_hal_client_post(unsigned char client, const dali2_hal_client_req_t *req);
+
+/**@brief Getting count of requests dropped on full ring
+ *
+ * @return dropped requests since dali2_hal_init()
+ */
+unsigned int dali2_hal_post_dropped_get(void);
+
 #endif /* DALI2_HAL_H_ */
@@ -24,6 +24,8 @@
 DALI2_HAL_EVT_T dali2_hal_mtx_check(void);
 
 /**@brief Take mutex
+ * @note  Interactive job suspends running background job between its commands, suspended
+ *        job resumes once interactive one is reported. Background polling is dropped.
  *
  * @param[IN] evt_mtx Event for capturing mutex
  * @return If (@retval == evt_mtx) - mutex has taken by @param evt_mtx
@@ -35,10 +37,286 @@ DALI2_HAL_EVT_T dali2_hal_mtx_take(DALI2_HAL_EVT_T evt_mtx);
  */
 void dali2_hal_mtx_give(void);
 
+/**@brief Give mutex of failed job, dali2_hal_process() reports the job with @param ret
+ *
+ * @param[IN] ret - result of the job
+ */
+void dali2_hal_mtx_fail(dali2_ret_t ret);
+
+/**@brief Checking job would take mutex now, @see dali2_hal_mtx_take()
+ *
+ * @param[IN] evt_mtx - event for capturing mutex
+ * @return 1 if mutex is free or running job is preempted
+ */
+unsigned char dali2_hal_mtx_is_takeable(DALI2_HAL_EVT_T evt_mtx);
+
+/**@brief Checking job suspends another one between its commands
+ *
+ * @param[IN] evt_mtx - event for capturing mutex
+ * @param[IN] evt - running job
+ * @return 1 if @param evt is suspended or dropped
+ */
+unsigned char dali2_hal_mtx_is_preemptive(DALI2_HAL_EVT_T evt_mtx, DALI2_HAL_EVT_T evt);
+
+/**@brief Getting job suspended by preemption
+ *
+ * @return DALI2_HAL_EVT_FREE if none
+ */
+DALI2_HAL_EVT_T dali2_hal_mtx_suspended(void);
+
+/**@brief Predicting bus time up to capture of mutex: running command of preempted
+ *        job, the rest of running and suspended jobs otherwise
+ *
+ * @param[IN] evt_mtx - event for capturing mutex
+ * @return bus time in microseconds
+ */
+unsigned int dali2_hal_mtx_wait_us(DALI2_HAL_EVT_T evt_mtx);
+
+/**@brief Predicting bus time left to running or suspended job
+ *
+ * @param[IN] evt - job
+ * @return bus time in microseconds, 0 if the job is not running
+ */
+unsigned int dali2_hal_job_left_us(DALI2_HAL_EVT_T evt);
+
+/**@brief Getting multi-master priority of job
+ *
+ * @param[IN] evt - job
+ * @return priority
+ */
+DALI2_L_SES_PRIORITY_T dali2_hal_evt_priority_get(DALI2_HAL_EVT_T evt);
+
 /**@brief Push single command to queue
  */
 dali2_ret_t dali2_hal_queue_push(DALI2_L_APP_CMD_T cmd, dali2_l_app_cmd_data_t *cmd_data);
 
+/**@brief Delaying execution of queued command
+ *
+ * @param[IN] delay_ms - delay from now
+ */
+void dali2_hal_queue_hold(unsigned int delay_ms);
+
+//! Class of failed job step, @see dali2_retry.c for policies
+typedef enum {
+    DALI2_HAL_RETRY_STEP_SEND,          //! Command is not transmitted
+    DALI2_HAL_RETRY_STEP_QUERY,         //! Query has no answer
+    DALI2_HAL_RETRY_STEP_VERIFY,        //! Read back value differs from written one
+    DALI2_HAL_RETRY_STEP_SETTLE,        //! Gear has not reached target yet, fade is running
+    DALI2_HAL_RETRY_STEP_STALL,         //! Completion of command is lost, @see dali2_watchdog.c
+
+    DALI2_HAL_RETRY_STEP_COUNT
+} DALI2_HAL_RETRY_STEP_T;
+
+//! Class of failed read back: no answer or wrong value
+#define DALI2_HAL_RETRY_STEP_READ(evt)  (((evt) == DALI2_L_APP_EVT_SUCCESS) ? DALI2_HAL_RETRY_STEP_VERIFY : \
+                                                                           DALI2_HAL_RETRY_STEP_QUERY)
+
+typedef enum {
+    DALI2_HAL_RETRY_REPEAT,             //! Repeat the step from its write
+    DALI2_HAL_RETRY_REREAD,             //! Repeat the read only
+    DALI2_HAL_RETRY_FAIL                //! Job has failed and its mutex is given, push nothing
+} DALI2_HAL_RETRY_T;
+
+/**@brief Retry policy initialization, statistics are dropped
+ */
+void dali2_hal_retry_init(void);
+
+/**@brief Starting attempts count of a new job
+ */
+void dali2_hal_retry_reset(void);
+
+/**@brief Applying retry policy to failed job step
+ * @note  Execution of the next command is held for policy backoff
+ *
+ * @param[IN] step - step class
+ * @param[IN] cmd - command of the step which has failed
+ * @return action of dispatcher
+ */
+DALI2_HAL_RETRY_T dali2_hal_retry(DALI2_HAL_RETRY_STEP_T step, DALI2_L_APP_CMD_T cmd);
+
+/**@brief Getting policy backoff before repetition of the step
+ *
+ * @param[IN] step - step class
+ * @param[IN] attempt - repetitions done already
+ * @return backoff, 0 if the step is out of attempts
+ */
+unsigned int dali2_hal_retry_backoff_ms(DALI2_HAL_RETRY_STEP_T step, unsigned int attempt);
+
+/**@brief Storing result of the job
+ *
+ * @param[IN] evt - job
+ * @param[IN] ret - result
+ */
+void dali2_hal_retry_job_end(DALI2_HAL_EVT_T evt, dali2_ret_t ret);
+
+/**@brief Watchdog initialization, report and statistics are dropped
+ */
+void dali2_hal_watchdog_init(void);
+
+/**@brief Starting deadlines of a new job
+ */
+void dali2_hal_watchdog_job_start(void);
+
+/**@brief Progress of the job, command deadline starts again
+ */
+void dali2_hal_watchdog_kick(void);
+
+/**@brief Checking deadlines of the running job
+ * @note  Stalled command is restarted by retry policy, stalled job fails
+ *
+ * @param[IN] evt - job
+ * @param[IN] cmd - queued command
+ * @param[IN] is_exec - command is accepted by Application layer
+ * @return 1 when the job is restarted or aborted, 0 otherwise
+ */
+unsigned char dali2_hal_watchdog_check(DALI2_HAL_EVT_T evt, DALI2_L_APP_CMD_T cmd, unsigned char is_exec);
+
+/**@brief Time up to the nearer deadline of running job
+ *
+ * @param[IN] evt - running job
+ * @return milliseconds, 0 if a deadline is over
+ */
+unsigned int dali2_hal_watchdog_left_ms(DALI2_HAL_EVT_T evt);
+
+/**@brief Command deadline is over now, the next check restarts the command
+ */
+void dali2_hal_watchdog_expire(void);
+
+//! Job of cost model and schedulers
+#define DALI2_HAL_JOB_EVT(JOB)          (((JOB) == DALI2_HAL_JOB_DIM_CFG) ? DALI2_HAL_EVT_DIM_CFG : \
+                                                                         DALI2_HAL_EVT_DIM_CTRL)
+
+/**@brief Starting job requested by scheduler
+ * @note  State update does not preempt, it takes free mutex only
+ *
+ * @param[IN] job - job
+ * @param[IN] node - DALI node
+ * @param[IN] data - data of the job
+ * @return @see dali2_hal_dim_set_level(), dali2_hal_dim_get_status(), dali2_hal_dim_cfg()
+ */
+dali2_ret_t dali2_hal_job_start(DALI2_HAL_JOB_T job, dali2_l_app_network_t *node, dali2_hal_job_data_t *data);
+
+/**@brief Cost model initialization, learned answers are dropped
+ */
+void dali2_hal_cost_init(void);
+
+/**@brief Learning answer or no-reply of query
+ *
+ * @param[IN] cmd - command
+ * @param[IN] evt - Application layer event of the command
+ */
+void dali2_hal_cost_answer(DALI2_L_APP_CMD_T cmd, DALI2_L_APP_EVT_T evt);
+
+/**@brief Predicting bus time left to job from its queued command
+ *
+ * @param[IN] evt - job
+ * @param[IN] cmd - queued command
+ * @param[IN] net - DALI node of the command, NULL for special command
+ * @return bus time in microseconds
+ */
+unsigned int dali2_hal_cost_left_us(DALI2_HAL_EVT_T evt, DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net);
+
+/**@brief Deadline scheduler initialization, requests are dropped
+ */
+void dali2_hal_edf_init(void);
+
+/**@brief Starting admitted request of the earliest deadline, dropping expired one
+ * @note  Called by dali2_hal_process() when no job is to be reported
+ */
+void dali2_hal_edf_poll(void);
+
+/**@brief Finishing request of the job
+ *
+ * @param[IN] evt - job
+ */
+void dali2_hal_edf_job_end(DALI2_HAL_EVT_T evt);
+
+/**@brief Bus sharing initialization, clients are dropped
+ */
+void dali2_hal_client_init(void);
+
+/**@brief Starting queued job of the client next by fair share
+ * @note  Called by dali2_hal_process() when no job is to be reported
+ */
+void dali2_hal_client_poll(void);
+
+/**@brief Finishing job of client, its bus time is charged
+ *
+ * @param[IN] evt - job
+ * @param[IN] ret - result of the job
+ */
+void dali2_hal_client_job_end(DALI2_HAL_EVT_T evt, dali2_ret_t ret);
+
+/**@brief Time up to expiry of admitted request or until it may start
+ *
+ * @return milliseconds, DALI2_HAL_IDLE_MAX_MS if none is pending
+ */
+unsigned int dali2_hal_edf_idle_ms(void);
+
+/**@brief Time up to the start of queued job of client or refill of throttled client
+ *
+ * @return milliseconds, DALI2_HAL_IDLE_MAX_MS if none is queued
+ */
+unsigned int dali2_hal_client_idle_ms(void);
+
+/**@brief Submission ring initialization, posted requests are dropped
+ */
+void dali2_hal_post_init(void);
+
+/**@brief Submitting requests posted by other threads
+ * @note  Called by dali2_hal_process()
+ */
+void dali2_hal_post_drain(void);
+
+/**@brief Checking posted requests
+ *
+ * @return 1 if published request waits for the drain
+ */
+unsigned char dali2_hal_post_is_pending(void);
+
+/**@brief Job completion initialization, callbacks are dropped
+ */
+void dali2_hal_done_init(void);
+
+/**@brief Dropping completion of the previous job of the event, the job takes the mutex
+ *
+ * @param[IN] evt - job
+ */
+void dali2_hal_done_job_start(DALI2_HAL_EVT_T evt);
+
+/**@brief Attaching completion of submitted request to its job holding the mutex
+ *
+ * @param[IN] evt - job
+ * @param[IN] done - completion, it is copied
+ */
+void dali2_hal_done_attach(DALI2_HAL_EVT_T evt, const dali2_hal_done_t *done);
+
+/**@brief Keeping completion of the job freeing the mutex up to its report
+ *
+ * @param[IN] evt - job
+ */
+void dali2_hal_done_job_end(DALI2_HAL_EVT_T evt);
+
+/**@brief Calling completion of reported job and common callback
+ * @note  Called by dali2_hal_process()
+ *
+ * @param[IN] evt - job
+ * @param[IN] ret - result of the job
+ */
+void dali2_hal_done_report(DALI2_HAL_EVT_T evt, dali2_ret_t ret);
+
+/**@brief Calling completion of job which has not gone to the bus
+ *
+ * @param[IN] done - completion
+ * @param[IN] evt - job
+ * @param[IN] ret - result of the job
+ */
+void dali2_hal_done_call(const dali2_hal_done_t *done, DALI2_HAL_EVT_T evt, dali2_ret_t ret);
+
+/**@brief Calling work pending callback
+ */
+void dali2_hal_wake(void);
+
 /**@brief Dispatch this function inside dali2_l_app_evt_func_t()
  *
  * @param[IN] evt - @see dali2_l_app_evt_func_t()
@@ -60,4 +338,218 @@ void dali2_hal_dim_cfg_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *e
  */
 void dali2_hal_dim_ctrl_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data);
 
+/**@brief Applying answer of status or LED failure query to status bytes
+ * @note  QUERY STATUS and QUERY FAILURE STATUS replace the byte, Yes/No queries
+ *        set or clear their bit, transmission fault changes nothing
+ *
+ * @param[IN] cmd - query
+ * @param[IN] evt - Application layer event of the query
+ * @param[IN] data - answer
+ * @param[IN/OUT] status - @ref DALI2_L_APP_CMD_STATUS_T bits
+ * @param[IN/OUT] failure_status - @ref DALI2_L_APP_LED_FAILURE_T bits
+ * @return 1 if answer has been applied
+ */
+unsigned char dali2_hal_dim_status_decode(DALI2_L_APP_CMD_T cmd, DALI2_L_APP_EVT_T evt, unsigned char data,
+                                          unsigned char *status, unsigned char *failure_status);
+
+/**@brief Dimmer shadow state initialization
+ */
+void dali2_hal_dim_shadow_init(void);
+
+/**@brief Forgetting shadow state, frame which may have changed it is lost
+ */
+void dali2_hal_dim_shadow_flush(void);
+
+/**@brief Updating shadow state from forward frame, @see dali2_l_ses_tap_func_t
+ */
+void dali2_hal_dim_shadow_tap(const dali2_l_ses_tap_t *tap);
+
+/**@brief Getting trusted shadow level
+ *
+ * @param[OUT] level - arc power level
+ * @param[IN] short_addr - short address
+ * @return DALI2_RET_SUCCESS - level is trusted, otherwise bus has to be queried
+ */
+dali2_ret_t dali2_hal_dim_shadow_level_get(unsigned char *level, unsigned char short_addr);
+
+/**@brief Checking group membership by shadow state
+ *
+ * @param[IN] short_addr - short address
+ * @param[IN] group - group number
+ * @return 1 if gear is member of the group or membership is not known
+ */
+unsigned char dali2_hal_dim_shadow_is_member(unsigned char short_addr, unsigned char group);
+
+/**@brief Getting shadow fade time
+ *
+ * @param[OUT] fade_ms - fade time, the longest one if it is not known
+ * @param[IN] short_addr - short address
+ * @return DALI2_RET_SUCCESS - fade time is known, DALI2_RET_TIMEOUT - it is not
+ */
+dali2_ret_t dali2_hal_dim_shadow_fade_ms_get(unsigned int *fade_ms, unsigned char short_addr);
+
+/**@brief Query cache initialization, all answers are dropped
+ */
+void dali2_hal_cache_init(void);
+
+/**@brief Getting cached answer of query
+ *
+ * @param[IN] cmd - query
+ * @param[IN] net - DALI node
+ * @param[OUT] evt - DALI2_L_APP_EVT_SUCCESS with answer or DALI2_L_APP_EVT_TIMEOUT without answer
+ * @param[OUT] data - answer
+ * @return DALI2_RET_SUCCESS - answer is fresh
+ *         DALI2_RET_TIMEOUT - answer is not cached or has expired
+ *         DALI2_RET_NOT_SUPPORTED - query or addressing is not cached
+ */
+dali2_ret_t dali2_hal_cache_get(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                                DALI2_L_APP_EVT_T *evt, unsigned char *data);
+
+/**@brief Storing answer of query, transmission fault is not stored
+ *
+ * @param[IN] cmd - query
+ * @param[IN] net - DALI node
+ * @param[IN] evt - Application layer event of the query
+ * @param[IN] data - answer
+ */
+void dali2_hal_cache_put(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                         DALI2_L_APP_EVT_T evt, unsigned char data);
+
+/**@brief Getting answer classes dropped by forward command of the job
+ *
+ * @param[IN] cmd - command
+ * @return class mask for dali2_hal_cache_is_fresh()
+ */
+unsigned char dali2_hal_cache_drops(DALI2_L_APP_CMD_T cmd);
+
+/**@brief Predicting query of the job is answered from cache, statistics are not counted
+ *
+ * @param[IN] cmd - query
+ * @param[IN] net - DALI node
+ * @param[IN] ahead_ms - time from now up to the query
+ * @param[IN] dropped - classes dropped by the previous commands of the job, @see dali2_hal_cache_drops()
+ * @return 1 if answer is fresh then
+ */
+unsigned char dali2_hal_cache_is_fresh(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                                       unsigned int ahead_ms, unsigned char dropped);
+
+/**@brief Counting request attached to running query chain of the same node
+ */
+void dali2_hal_cache_join(void);
+
+/**@brief Dropping answers changed by forward frame, @see dali2_l_ses_tap_func_t
+ */
+void dali2_hal_cache_tap(const dali2_l_ses_tap_t *tap);
+
+/**@brief Attribute subscriptions initialization, all subscriptions are dropped
+ */
+void dali2_hal_watch_init(void);
+
+/**@brief Storing answer of query to node attribute
+ *
+ * @param[IN] cmd - query
+ * @param[IN] net - DALI node
+ * @param[IN] evt - Application layer event of the query
+ * @param[IN] data - answer
+ */
+void dali2_hal_watch_answer(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                            DALI2_L_APP_EVT_T evt, unsigned char data);
+
+/**@brief Scheduling the next query of background poll job and calling change callbacks
+ * @note  Called by dali2_hal_process() on free HAL
+ */
+void dali2_hal_watch_poll(void);
+
+/**@brief Time up to the next check of background polling on free HAL
+ *
+ * @return milliseconds, DALI2_HAL_IDLE_MAX_MS if there is nothing to poll
+ */
+unsigned int dali2_hal_watch_idle_ms(void);
+
+/**@brief Dispatch this function inside dali2_l_app_evt_func_t()
+ *
+ * @param[IN] evt - @see dali2_l_app_evt_func_t()
+ * @param[IN] evt_data - @see dali2_l_app_evt_func_t()
+ */
+void dali2_hal_watch_dispatch(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data);
+
+/**@brief Checking gear presence learnt from answers and probes
+ *
+ * @param[IN] short_addr - short address
+ * @return 1 if gear has answered any query
+ */
+unsigned char dali2_hal_watch_is_present(unsigned char short_addr);
+
+/**@brief Health poller initialization, poller is stopped
+ */
+void dali2_hal_health_init(void);
+
+/**@brief Checking health poller is running
+ *
+ * @return 1 if running, so presence of gear has to be discovered
+ */
+unsigned char dali2_hal_health_is_running(void);
+
+/**@brief Storing answer of status or LED failure query
+ *
+ * @param[IN] cmd - query
+ * @param[IN] net - DALI node
+ * @param[IN] evt - Application layer event of the query
+ * @param[IN] data - answer
+ */
+void dali2_hal_health_answer(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                             DALI2_L_APP_EVT_T evt, unsigned char data);
+
+/**@brief Choosing the next health query, round robin over present gear
+ *
+ * @param[OUT] short_addr - short address
+ * @param[OUT] cmd - DALI2_L_APP_CMD_QUERY_STATUS or DALI2_L_APP_CMD_QUERY_FAILURE_STATUS
+ * @return 1 if query is due
+ */
+unsigned char dali2_hal_health_next(unsigned char *short_addr, DALI2_L_APP_CMD_T *cmd);
+
+/**@brief Quarantine initialization, all gear is released
+ */
+void dali2_hal_quarantine_init(void);
+
+/**@brief Counting no-replies of gear
+ *
+ * @param[IN] cmd - query
+ * @param[IN] net - DALI node
+ * @param[IN] evt - Application layer event of the query
+ */
+void dali2_hal_quarantine_answer(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net, DALI2_L_APP_EVT_T evt);
+
+/**@brief Checking gear is quarantined
+ *
+ * @param[IN] short_addr - short address
+ * @return 1 if quarantined
+ */
+unsigned char dali2_hal_quarantine_is_set(unsigned char short_addr);
+
+/**@brief Checking command of HAL job is addressed to quarantined gear, skip is counted
+ *
+ * @param[IN] net - DALI node
+ * @return 1 if command has to be skipped
+ */
+unsigned char dali2_hal_quarantine_skip(dali2_l_app_network_t *net);
+
+/**@brief Choosing quarantined gear to recheck
+ *
+ * @param[OUT] short_addr - short address
+ * @return 1 if recheck is due
+ */
+unsigned char dali2_hal_quarantine_next(unsigned char *short_addr);
+
+/**@brief Time up to the next recheck of quarantined gear
+ *
+ * @return milliseconds, DALI2_HAL_IDLE_MAX_MS if no gear is quarantined
+ */
+unsigned int dali2_hal_quarantine_idle_ms(void);
+
+/**@brief Calling quarantine change callback
+ * @note  Called by dali2_hal_process()
+ */
+void dali2_hal_quarantine_notify(void);
+
 #endif /* DALI2_HAL_INTERNAL_H_ */
@@ -0,0 +1,167 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_post.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL request submission ring source file
+ *
+ * @details Producers of any thread reserve slot by compare and swap of the head, copy
+ *          request into it and publish it by slot stamp. The only consumer is the thread
+ *          of dali2_hal_process(), it hands published requests to schedulers in order,
+ *          so schedulers, mutex and job state stay single threaded. Completion of the
+ *          request is called by the consumer, waitable handle carries it to producer.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+#include "dali2_ring.h"
+
+//! Ring slot, stamp is publication marker of the request
+typedef struct {
+    volatile unsigned int stamp;
+    unsigned char client;               //! DALI2_HAL_CLIENT_COUNT for deadline request
+    union {
+        dali2_hal_edf_req_t edf;
+        dali2_hal_client_req_t client;
+    } req;
+} dali2_hal_post_slot_t;
+
+//! Internal handle type
+typedef struct {
+    dali2_ring_t ring;
+    dali2_hal_post_slot_t slot[DALI2_HAL_POST_RING_SIZE];
+} dali2_hal_post_handle_t;
+
+static dali2_hal_post_handle_t __post_handle;
+
+/**@brief Reserving slot
+ *
+ * @return slot or NULL if ring is full
+ */
+static dali2_hal_post_slot_t *__dali2_hal_post_reserve(unsigned int *head)
+{
+    if (!dali2_ring_reserve(&__post_handle.ring, DALI2_HAL_POST_RING_SIZE, head)) {
+        return NULL;
+    }
+
+    return &__post_handle.slot[DALI2_RING_IDX(*head, DALI2_HAL_POST_RING_SIZE)];
+}
+
+static void __dali2_hal_post_publish(dali2_hal_post_slot_t *slot, unsigned int head)
+{
+    dali2_ring_publish(&slot->stamp, head);
+
+    //! Consumer may sleep
+    dali2_hal_wake();
+}
+
+void dali2_hal_post_init(void)
+{
+    memset(&__post_handle, 0x00, sizeof(__post_handle));
+}
+
+dali2_ret_t dali2_hal_edf_post(const dali2_hal_edf_req_t *req)
+{
+    dali2_hal_post_slot_t *slot;
+    unsigned int head;
+
+    //! Verify parameters
+    if (!req || req->job >= DALI2_HAL_JOB_COUNT || !req->deadline_ms) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    slot = __dali2_hal_post_reserve(&head);
+    if (!slot) {
+        return DALI2_RET_BUSY;
+    }
+
+    slot->client = DALI2_HAL_CLIENT_COUNT;
+    memcpy(&slot->req.edf, req, sizeof(dali2_hal_edf_req_t));
+    __dali2_hal_post_publish(slot, head);
+
+    return DALI2_RET_SUCCESS;
+}
+
+dali2_ret_t dali2_hal_client_post(unsigned char client, const dali2_hal_client_req_t *req)
+{
+    dali2_hal_post_slot_t *slot;
+    unsigned int head;
+
+    //! Verify parameters, registration is checked by consumer
+    if (client >= DALI2_HAL_CLIENT_COUNT || !req || req->job >= DALI2_HAL_JOB_COUNT) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    slot = __dali2_hal_post_reserve(&head);
+    if (!slot) {
+        return DALI2_RET_BUSY;
+    }
+
+    slot->client = client;
+    memcpy(&slot->req.client, req, sizeof(dali2_hal_client_req_t));
+    __dali2_hal_post_publish(slot, head);
+
+    return DALI2_RET_SUCCESS;
+}
+
+void dali2_hal_post_drain(void)
+{
+    dali2_hal_post_slot_t *slot;
+    dali2_hal_edf_req_t edf_req;
+    dali2_hal_client_req_t client_req;
+    unsigned char client;
+    unsigned int tail;
+    dali2_ret_t ret;
+    unsigned int i;
+
+    //! Producers posting all the time do not starve the bus
+    for (i = 0; i < DALI2_HAL_POST_RING_SIZE; i++) {
+        tail = dali2_ring_tail_get(&__post_handle.ring);
+        slot = &__post_handle.slot[DALI2_RING_IDX(tail, DALI2_HAL_POST_RING_SIZE)];
+
+        //! Reserved slot is not published yet, the producer wakes again
+        if (!dali2_ring_is_published(&slot->stamp, tail)) {
+            return;
+        }
+
+        client = slot->client;
+        if (client == DALI2_HAL_CLIENT_COUNT) {
+            memcpy(&edf_req, &slot->req.edf, sizeof(dali2_hal_edf_req_t));
+        } else {
+            memcpy(&client_req, &slot->req.client, sizeof(dali2_hal_client_req_t));
+        }
+
+        //! Free slot for producers before completion may post again
+        dali2_ring_release(&__post_handle.ring, tail);
+
+        if (client == DALI2_HAL_CLIENT_COUNT) {
+            ret = dali2_hal_edf_submit(&edf_req);
+            if (ret != DALI2_RET_SUCCESS) {
+                dali2_hal_done_call(&edf_req.done, DALI2_HAL_JOB_EVT(edf_req.job), ret);
+            }
+        } else {
+            ret = dali2_hal_client_submit(client, &client_req);
+            if (ret != DALI2_RET_SUCCESS) {
+                dali2_hal_done_call(&client_req.done, DALI2_HAL_JOB_EVT(client_req.job), ret);
+            }
+        }
+    }
+}
+
+unsigned char dali2_hal_post_is_pending(void)
+{
+    unsigned int tail = dali2_ring_tail_get(&__post_handle.ring);
+
+    //! Reserved slot is not pending before it is published, publication wakes the consumer
+    return dali2_ring_is_published(&__post_handle.slot[DALI2_RING_IDX(tail, DALI2_HAL_POST_RING_SIZE)].stamp, tail);
+}
+
+unsigned int dali2_hal_post_dropped_get(void)
+{
+    return dali2_ring_dropped_get(&__post_handle.ring);
+}
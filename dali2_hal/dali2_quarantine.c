@@ -0,0 +1,261 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_quarantine.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL unresponsive gear quarantine source file
+ *
+ * @details Every short address counts consecutive no-replies on queries which
+ *          present gear always answers. After DALI2_HAL_QUARANTINE_MISSES of them
+ *          gear is quarantined: HAL jobs addressing it end with DALI2_RET_TIMEOUT
+ *          before transmission and pollers skip it. Quarantined gear is rechecked
+ *          with single QUERY CONTROL GEAR PRESENT by background poll job, recheck
+ *          period is doubled after every silent recheck. Any answer releases gear.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+
+#define DALI2_HAL_QUARANTINE_NODE_COUNT     DALI2_L_NET_ADDR_SHORT_MAX
+
+typedef struct {
+    unsigned char misses;               //! Consecutive no-replies
+    unsigned char is_quarantined;
+    unsigned char is_changed;           //! Callback is not called yet
+    unsigned int backoff_ms;
+    unsigned int recheck_ms;
+} dali2_hal_quarantine_node_t;
+
+//! Internal handle type
+typedef struct {
+    dali2_hal_quarantine_node_t node[DALI2_HAL_QUARANTINE_NODE_COUNT];
+    dali2_hal_quarantine_stats_t stats;
+    dali2_hal_quarantine_func_t func;
+    unsigned char is_changed;
+} dali2_hal_quarantine_handle_t;
+
+static dali2_hal_quarantine_handle_t __quarantine_handle;
+
+//! Queries answered by any present gear whatever its state and type is
+static unsigned char __dali2_hal_quarantine_is_must_answer(DALI2_L_APP_CMD_T cmd)
+{
+    switch (cmd) {
+        case DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_PRESENT:
+        case DALI2_L_APP_CMD_QUERY_STATUS:
+        case DALI2_L_APP_CMD_QUERY_VERSION_NUMBER:
+        case DALI2_L_APP_CMD_QUERY_CONTENT_DTR0:
+        case DALI2_L_APP_CMD_QUERY_CONTENT_DTR1:
+        case DALI2_L_APP_CMD_QUERY_CONTENT_DTR2:
+        case DALI2_L_APP_CMD_QUERY_DEVICE_TYPE:
+        case DALI2_L_APP_CMD_QUERY_PHYSICAL_MINIMUM:
+        case DALI2_L_APP_CMD_QUERY_OPERATING_MODE:
+        case DALI2_L_APP_CMD_QUERY_LIGHT_SOURCE_TYPE:
+        case DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL:
+        case DALI2_L_APP_CMD_QUERY_MAX_LEVEL:
+        case DALI2_L_APP_CMD_QUERY_MIN_LEVEL:
+        case DALI2_L_APP_CMD_QUERY_POWER_ON_LEVEL:
+        case DALI2_L_APP_CMD_QUERY_SYSTEM_FAILURE_LEVEL:
+        case DALI2_L_APP_CMD_QUERY_FADE_TIME_FADE_RATE:
+        case DALI2_L_APP_CMD_QUERY_EXTENDED_FADE_TIME:
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+static void __dali2_hal_quarantine_change(dali2_hal_quarantine_node_t *node, unsigned char is_quarantined)
+{
+    node->is_quarantined = is_quarantined;
+    node->is_changed = 1;
+    __quarantine_handle.is_changed = 1;
+}
+
+void dali2_hal_quarantine_init(void)
+{
+    memset(&__quarantine_handle, 0x00, sizeof(__quarantine_handle));
+}
+
+void dali2_hal_quarantine_answer(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net, DALI2_L_APP_EVT_T evt)
+{
+    dali2_hal_quarantine_node_t *node;
+
+    if (net->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING || net->addr_byte >= DALI2_HAL_QUARANTINE_NODE_COUNT) {
+        return;
+    }
+
+    node = &__quarantine_handle.node[net->addr_byte];
+
+    //! Any answer tells gear is alive
+    if (evt == DALI2_L_APP_EVT_SUCCESS) {
+        node->misses = 0;
+        if (node->is_quarantined) {
+            __quarantine_handle.stats.released++;
+            __dali2_hal_quarantine_change(node, 0);
+        }
+        return;
+    }
+
+    if (evt != DALI2_L_APP_EVT_TIMEOUT || !__dali2_hal_quarantine_is_must_answer(cmd)) {
+        return;
+    }
+
+    //! Discovery probe of empty address is not a no-reply of gear
+    if (!node->is_quarantined && dali2_hal_mtx_check() == DALI2_HAL_EVT_POLL &&
+        !dali2_hal_watch_is_present(net->addr_byte)) {
+        return;
+    }
+
+    if (node->is_quarantined) {
+        //! Silent recheck
+        if (node->backoff_ms < DALI2_HAL_QUARANTINE_RECHECK_MAX_MS / 2) {
+            node->backoff_ms *= 2;
+        } else {
+            node->backoff_ms = DALI2_HAL_QUARANTINE_RECHECK_MAX_MS;
+        }
+    } else {
+        if (node->misses < 0xFF) {
+            node->misses++;
+        }
+        if (node->misses < DALI2_HAL_QUARANTINE_MISSES) {
+            return;
+        }
+
+        __quarantine_handle.stats.quarantined++;
+        __dali2_hal_quarantine_change(node, 1);
+        node->backoff_ms = DALI2_HAL_QUARANTINE_RECHECK_MS;
+    }
+
+    node->recheck_ms = dali2_l_bsp_time_ms_get() + node->backoff_ms;
+}
+
+unsigned char dali2_hal_quarantine_is_set(unsigned char short_addr)
+{
+    return (short_addr < DALI2_HAL_QUARANTINE_NODE_COUNT) ? __quarantine_handle.node[short_addr].is_quarantined : 0;
+}
+
+unsigned char dali2_hal_quarantine_skip(dali2_l_app_network_t *net)
+{
+    if (net->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING || !dali2_hal_quarantine_is_set(net->addr_byte)) {
+        return 0;
+    }
+
+    __quarantine_handle.stats.skipped++;
+    return 1;
+}
+
+unsigned char dali2_hal_quarantine_next(unsigned char *short_addr)
+{
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    dali2_hal_quarantine_node_t *node;
+    unsigned int i;
+
+    for (i = 0; i < DALI2_HAL_QUARANTINE_NODE_COUNT; i++) {
+        node = &__quarantine_handle.node[i];
+
+        if (node->is_quarantined && (int) (now - node->recheck_ms) >= 0) {
+            //! The next recheck waits for the answer or silence
+            node->recheck_ms = now + node->backoff_ms;
+            __quarantine_handle.stats.rechecks++;
+            *short_addr = (unsigned char) i;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+unsigned int dali2_hal_quarantine_idle_ms(void)
+{
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    unsigned int idle_ms = DALI2_HAL_IDLE_MAX_MS;
+    dali2_hal_quarantine_node_t *node;
+    unsigned int i;
+
+    for (i = 0; i < DALI2_HAL_QUARANTINE_NODE_COUNT; i++) {
+        node = &__quarantine_handle.node[i];
+        if (!node->is_quarantined) {
+            continue;
+        }
+
+        if ((int) (now - node->recheck_ms) >= 0) {
+            return 0;
+        }
+        if (node->recheck_ms - now < idle_ms) {
+            idle_ms = node->recheck_ms - now;
+        }
+    }
+
+    return idle_ms;
+}
+
+void dali2_hal_quarantine_notify(void)
+{
+    dali2_hal_quarantine_node_t *node;
+    unsigned int i;
+
+    if (!__quarantine_handle.is_changed) {
+        return;
+    }
+    __quarantine_handle.is_changed = 0;
+
+    for (i = 0; i < DALI2_HAL_QUARANTINE_NODE_COUNT; i++) {
+        node = &__quarantine_handle.node[i];
+        if (!node->is_changed) {
+            continue;
+        }
+        node->is_changed = 0;
+
+        if (__quarantine_handle.func) {
+            __quarantine_handle.func((unsigned char) i, node->is_quarantined);
+        }
+    }
+}
+
+void dali2_hal_quarantine_func_set(dali2_hal_quarantine_func_t func)
+{
+    __quarantine_handle.func = func;
+}
+
+dali2_ret_t dali2_hal_quarantine_release(dali2_l_app_network_t *node)
+{
+    dali2_hal_quarantine_node_t *quarantine_node;
+
+    //! Verify parameters
+    if (!node || node->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING ||
+        node->addr_byte >= DALI2_HAL_QUARANTINE_NODE_COUNT) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    quarantine_node = &__quarantine_handle.node[node->addr_byte];
+    quarantine_node->misses = 0;
+    if (quarantine_node->is_quarantined) {
+        __quarantine_handle.stats.released++;
+        __dali2_hal_quarantine_change(quarantine_node, 0);
+    }
+
+    return DALI2_RET_SUCCESS;
+}
+
+void dali2_hal_quarantine_stats_get(dali2_hal_quarantine_stats_t *stats)
+{
+    unsigned int i;
+
+    if (!stats) {
+        return;
+    }
+
+    memcpy(stats, &__quarantine_handle.stats, sizeof(dali2_hal_quarantine_stats_t));
+
+    stats->count = 0;
+    for (i = 0; i < DALI2_HAL_QUARANTINE_NODE_COUNT; i++) {
+        if (__quarantine_handle.node[i].is_quarantined) {
+            stats->count++;
+        }
+    }
+}
@@ -0,0 +1,387 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_query_cache.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL query result cache source file
+ *
+ * @details Answers of queries to short addresses are kept per (address, command)
+ *          together with "no answer", which is a valid answer of YES/NO queries only.
+ *          Lost answer of value query is not cached, it drops the cached value instead.
+ *          Command queued by HAL is answered from the cache without bus time
+ *          while its class TTL has not expired.
+ *
+ *          Every forward frame on the line, own and of other masters, drops
+ *          answers it may change: level commands drop state class, configuration
+ *          commands drop configuration class, addressing drops everything.
+ *          Group and broadcast frames drop answers of all addresses.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+
+#include "dali2_spec_cmd_list.h"
+#include "dali2_std_cmd_list.h"
+#include "dali2_led_cmd_list.h"
+
+#ifndef DALI2_HAL_CACHE_SIZE
+#define DALI2_HAL_CACHE_SIZE                64
+#endif
+
+//! Answer classes, class is TTL and invalidation group of the query
+#define DALI2_HAL_CACHE_STATE               0x01    //! Follows actual level
+#define DALI2_HAL_CACHE_FAILURE             0x02    //! Changes on its own
+#define DALI2_HAL_CACHE_CONFIG              0x04    //! Changes by configuration commands
+#define DALI2_HAL_CACHE_IDENT               0x08    //! Changes by addressing only
+#define DALI2_HAL_CACHE_ALL                 0x0F
+
+//! YES/NO query, no answer means NO
+#define DALI2_HAL_CACHE_YES_NO              0x80
+#define DALI2_HAL_CACHE_CLASS(CMD)          (__cache_class[CMD] & DALI2_HAL_CACHE_ALL)
+
+#define DALI2_HAL_CACHE_ADDR_ALL            0xFF
+
+//! Class of cached queries, not cached when zero
+static const unsigned char __cache_class[DALI2_L_APP_CMD_UNKNOWN] = {
+    [DALI2_L_APP_CMD_QUERY_STATUS] = DALI2_HAL_CACHE_STATE,
+    [DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_PRESENT] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_LAMP_FAILURE] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_LAMP_POWER_ON] = DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_LIMIT_ERROR] = DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_RESET_STATE] = DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_MISSING_SHORT_ADDRESS] = DALI2_HAL_CACHE_CONFIG | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_VERSION_NUMBER] = DALI2_HAL_CACHE_IDENT,
+    [DALI2_L_APP_CMD_QUERY_DEVICE_TYPE] = DALI2_HAL_CACHE_IDENT,
+    [DALI2_L_APP_CMD_QUERY_PHYSICAL_MINIMUM] = DALI2_HAL_CACHE_IDENT,
+    [DALI2_L_APP_CMD_QUERY_POWER_FAILURE] = DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_OPERATING_MODE] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_LIGHT_SOURCE_TYPE] = DALI2_HAL_CACHE_IDENT,
+    [DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL] = DALI2_HAL_CACHE_STATE,
+    [DALI2_L_APP_CMD_QUERY_MAX_LEVEL] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_MIN_LEVEL] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_POWER_ON_LEVEL] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_SYSTEM_FAILURE_LEVEL] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_FADE_TIME_FADE_RATE] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_MANUFACTURER_SPECIFIC_MODE] = DALI2_HAL_CACHE_CONFIG | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_EXTENDED_FADE_TIME] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_CONTROL_GEAR_FAILURE] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+
+    [DALI2_L_APP_CMD_QUERY_GEAR_TYPE] = DALI2_HAL_CACHE_IDENT,
+    [DALI2_L_APP_CMD_QUERY_DIMMING_CURVE] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_POSSIBLE_OPERATING_MODES] = DALI2_HAL_CACHE_IDENT,
+    [DALI2_L_APP_CMD_QUERY_FEATURES] = DALI2_HAL_CACHE_IDENT,
+    [DALI2_L_APP_CMD_QUERY_FAILURE_STATUS] = DALI2_HAL_CACHE_FAILURE,
+    [DALI2_L_APP_CMD_QUERY_SHORT_CIRCUIT] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_OPEN_CIRCUIT] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_LOAD_DECREASE] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_LOAD_INCREASE] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_CURRENT_PROTECTOR_ACTIVE] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_THERMAL_SHUT_DOWN] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_THERMAL_OVERLOAD] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_REFERENCE_RUNNING] = DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_REFERENCE_MEASUREMENT_FAILED] = DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_CURRENT_PROTECTOR_ENABLED] = DALI2_HAL_CACHE_CONFIG | DALI2_HAL_CACHE_YES_NO,
+    [DALI2_L_APP_CMD_QUERY_OPERATING_MODE_LED] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_FAST_FADE_TIME] = DALI2_HAL_CACHE_CONFIG,
+    [DALI2_L_APP_CMD_QUERY_MIN_FAST_FADE_TIME] = DALI2_HAL_CACHE_IDENT,
+    [DALI2_L_APP_CMD_QUERY_EXTENDED_VERSION_NUMBER] = DALI2_HAL_CACHE_IDENT,
+};
+
+//! Cached answer
+typedef struct {
+    unsigned char cmd;                  //! @ref DALI2_L_APP_CMD_T
+    unsigned char addr;                 //! Short address
+    unsigned char evt;                  //! DALI2_L_APP_EVT_SUCCESS or DALI2_L_APP_EVT_TIMEOUT
+    unsigned char data;
+    unsigned char is_valid;
+    unsigned int stamp_ms;
+} dali2_hal_cache_entry_t;
+
+//! Internal handle type
+typedef struct {
+    dali2_hal_cache_entry_t entry[DALI2_HAL_CACHE_SIZE];
+    dali2_hal_cache_stats_t stats;
+    unsigned char is_enabled;
+} dali2_hal_cache_handle_t;
+
+static dali2_hal_cache_handle_t __cache_handle;
+
+static unsigned int __dali2_hal_cache_ttl_ms(unsigned char cache_class)
+{
+    switch (cache_class) {
+        case DALI2_HAL_CACHE_STATE:
+            return DALI2_HAL_CACHE_STATE_TTL_MS;
+
+        case DALI2_HAL_CACHE_FAILURE:
+            return DALI2_HAL_CACHE_FAILURE_TTL_MS;
+
+        case DALI2_HAL_CACHE_CONFIG:
+            return DALI2_HAL_CACHE_CONFIG_TTL_MS;
+
+        default:
+            return DALI2_HAL_CACHE_IDENT_TTL_MS;
+    }
+}
+
+static dali2_hal_cache_entry_t *__dali2_hal_cache_find(DALI2_L_APP_CMD_T cmd, unsigned char addr)
+{
+    unsigned int i;
+
+    for (i = 0; i < DALI2_HAL_CACHE_SIZE; i++) {
+        if (__cache_handle.entry[i].is_valid &&
+            __cache_handle.entry[i].cmd == cmd &&
+            __cache_handle.entry[i].addr == addr) {
+            return &__cache_handle.entry[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void __dali2_hal_cache_drop(unsigned char addr, unsigned char class_mask)
+{
+    unsigned int i;
+    dali2_hal_cache_entry_t *entry;
+
+    for (i = 0; i < DALI2_HAL_CACHE_SIZE; i++) {
+        entry = &__cache_handle.entry[i];
+
+        if (entry->is_valid &&
+            (addr == DALI2_HAL_CACHE_ADDR_ALL || entry->addr == addr) &&
+            (__cache_class[entry->cmd] & class_mask)) {
+            entry->is_valid = 0;
+            __cache_handle.stats.invalidated++;
+        }
+    }
+}
+
+//! Answer classes changed by standard command
+static unsigned char __dali2_hal_cache_cmd_class(unsigned char opcode)
+{
+    //! Level commands and scenes
+    if (opcode < DALI2_L_APP_STD_CMD_RESET) {
+        return DALI2_HAL_CACHE_STATE;
+    }
+
+    switch (opcode) {
+        case DALI2_L_APP_STD_CMD_RESET:
+            return DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_CONFIG;
+
+        case DALI2_L_APP_STD_CMD_SET_OPERATING_MODE:
+        case DALI2_L_APP_STD_CMD_SET_MAX_LEVEL_DTR0:
+        case DALI2_L_APP_STD_CMD_SET_MIN_LEVEL_DTR0:
+        case DALI2_L_APP_STD_CMD_SET_SYSTEM_FAILURE_LEVEL_DTR0:
+        case DALI2_L_APP_STD_CMD_SET_POWER_ON_LEVEL_DTR0:
+        case DALI2_L_APP_STD_CMD_SET_FADE_TIME_DTR0:
+        case DALI2_L_APP_STD_CMD_SET_FADE_RATE_DTR0:
+        case DALI2_L_APP_STD_CMD_SET_EXTENDED_FADE_TIME_DTR0:
+            //! Limits clamp actual level too
+            return DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_CONFIG;
+
+        case DALI2_L_APP_STD_CMD_IDENTIFY_DEVICE:
+            return DALI2_HAL_CACHE_STATE;
+
+        case DALI2_L_APP_STD_CMD_SET_SHORT_ADDRESS_DTR0:
+            return DALI2_HAL_CACHE_ALL;
+
+        default:
+            break;
+    }
+
+    //! LED commands, queries are above them
+    if (opcode >= DALI2_L_APP_LED_CMD_REFERENCE_SYSTEM_POWER &&
+        opcode <= DALI2_L_APP_LED_CMD_STORE_DTR_AS_FAST_FADE_TIME) {
+        return DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_CONFIG;
+    }
+
+    //! Scenes, groups, memory and queries do not change cached answers
+    return 0;
+}
+
+void dali2_hal_cache_init(void)
+{
+    memset(&__cache_handle, 0x00, sizeof(__cache_handle));
+    __cache_handle.is_enabled = 1;
+}
+
+dali2_ret_t dali2_hal_cache_get(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                                DALI2_L_APP_EVT_T *evt, unsigned char *data)
+{
+    dali2_hal_cache_entry_t *entry;
+
+    //! Answers of short addresses only, group answers are mixed
+    if (!__cache_handle.is_enabled || cmd >= DALI2_L_APP_CMD_UNKNOWN || !__cache_class[cmd] ||
+        net->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING) {
+        return DALI2_RET_NOT_SUPPORTED;
+    }
+
+    entry = __dali2_hal_cache_find(cmd, net->addr_byte);
+    if (!entry) {
+        __cache_handle.stats.miss++;
+        return DALI2_RET_TIMEOUT;
+    }
+
+    if ((dali2_l_bsp_time_ms_get() - entry->stamp_ms) >= __dali2_hal_cache_ttl_ms(DALI2_HAL_CACHE_CLASS(cmd))) {
+        entry->is_valid = 0;
+        __cache_handle.stats.miss++;
+        return DALI2_RET_TIMEOUT;
+    }
+
+    *evt = (DALI2_L_APP_EVT_T) entry->evt;
+    *data = entry->data;
+    __cache_handle.stats.hit++;
+    return DALI2_RET_SUCCESS;
+}
+
+void dali2_hal_cache_put(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                         DALI2_L_APP_EVT_T evt, unsigned char data)
+{
+    dali2_hal_cache_entry_t *entry;
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    unsigned int i;
+
+    if (!__cache_handle.is_enabled || cmd >= DALI2_L_APP_CMD_UNKNOWN || !__cache_class[cmd] ||
+        net->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING) {
+        return;
+    }
+
+    //! Transmission fault is not an answer
+    if (evt == DALI2_L_APP_EVT_FAULT) {
+        return;
+    }
+
+    entry = __dali2_hal_cache_find(cmd, net->addr_byte);
+
+    //! Value query is answered by present gear, backward frame was lost
+    if (evt == DALI2_L_APP_EVT_TIMEOUT && !(__cache_class[cmd] & DALI2_HAL_CACHE_YES_NO)) {
+        if (entry) {
+            entry->is_valid = 0;
+            __cache_handle.stats.invalidated++;
+        }
+        return;
+    }
+
+    //! Free entry or the oldest one
+    if (!entry) {
+        entry = &__cache_handle.entry[0];
+        for (i = 0; i < DALI2_HAL_CACHE_SIZE; i++) {
+            if (!__cache_handle.entry[i].is_valid) {
+                entry = &__cache_handle.entry[i];
+                break;
+            }
+            if ((now - __cache_handle.entry[i].stamp_ms) > (now - entry->stamp_ms)) {
+                entry = &__cache_handle.entry[i];
+            }
+        }
+    }
+
+    entry->cmd = (unsigned char) cmd;
+    entry->addr = net->addr_byte;
+    entry->evt = (unsigned char) evt;
+    entry->data = data;
+    entry->stamp_ms = now;
+    entry->is_valid = 1;
+}
+
+unsigned char dali2_hal_cache_drops(DALI2_L_APP_CMD_T cmd)
+{
+    if (cmd < DALI2_L_APP_CMD_RESET || cmd == DALI2_L_APP_CMD_DAPC || cmd == DALI2_L_APP_CMD_IDENTIFY_DEVICE) {
+        return DALI2_HAL_CACHE_STATE;
+    }
+
+    if (cmd == DALI2_L_APP_CMD_SET_SHORT_ADDRESS || cmd == DALI2_L_APP_CMD_PROGRAM_SHORT_ADDRESS) {
+        return DALI2_HAL_CACHE_ALL;
+    }
+
+    if (cmd == DALI2_L_APP_CMD_RESET ||
+        (cmd >= DALI2_L_APP_CMD_REFERENCE_SYSTEM_POWER && cmd <= DALI2_L_APP_CMD_STORE_DTR_AS_FAST_FADE_TIME)) {
+        return DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_FAILURE | DALI2_HAL_CACHE_CONFIG;
+    }
+
+    if (cmd >= DALI2_L_APP_CMD_SET_OPERATING_MODE_DTR0 && cmd <= DALI2_L_APP_CMD_SET_EXTENDED_FADE_TIME_DTR0) {
+        return DALI2_HAL_CACHE_STATE | DALI2_HAL_CACHE_CONFIG;
+    }
+
+    return 0;
+}
+
+unsigned char dali2_hal_cache_is_fresh(DALI2_L_APP_CMD_T cmd, dali2_l_app_network_t *net,
+                                       unsigned int ahead_ms, unsigned char dropped)
+{
+    dali2_hal_cache_entry_t *entry;
+
+    if (!__cache_handle.is_enabled || cmd >= DALI2_L_APP_CMD_UNKNOWN || !__cache_class[cmd] ||
+        (__cache_class[cmd] & dropped) || net->method != DALI2_L_NET_METHOD_SHORT_ADDRESSING) {
+        return 0;
+    }
+
+    entry = __dali2_hal_cache_find(cmd, net->addr_byte);
+
+    return (entry && (dali2_l_bsp_time_ms_get() - entry->stamp_ms) + ahead_ms <
+                     __dali2_hal_cache_ttl_ms(DALI2_HAL_CACHE_CLASS(cmd))) ? 1 : 0;
+}
+
+void dali2_hal_cache_join(void)
+{
+    __cache_handle.stats.joined++;
+}
+
+void dali2_hal_cache_tap(const dali2_l_ses_tap_t *tap)
+{
+    unsigned char addr = (unsigned char) (tap->forward >> 8);
+    unsigned char opcode = (unsigned char) tap->forward;
+    unsigned char class_mask;
+
+    if (!__cache_handle.is_enabled || tap->is_query || tap->bits != DALI2_L_PHY_FORWARD_16BIT_SIZE) {
+        return;
+    }
+
+    //! Special command: addressing moves answers between addresses
+    if (addr >= DALI2_L_APP_SPEC_CMD_TERMINATE && addr <= DALI2_L_APP_SPEC_CMD_WRITE_MEMORY_LOCATION_NO_REPLY_DTR1_DTR0) {
+        if (addr == DALI2_L_APP_SPEC_CMD_PROGRAM_SHORT_ADDRESS) {
+            __dali2_hal_cache_drop(DALI2_HAL_CACHE_ADDR_ALL, DALI2_HAL_CACHE_ALL);
+        }
+        return;
+    }
+
+    //! DAPC: YAAA AAA0
+    if (!(addr & 0x01)) {
+        class_mask = DALI2_HAL_CACHE_STATE;
+    } else {
+        class_mask = __dali2_hal_cache_cmd_class(opcode);
+    }
+
+    if (!class_mask) {
+        return;
+    }
+
+    if (!(addr & 0x80)) {
+        //! Short address
+        if (class_mask == DALI2_HAL_CACHE_ALL) {
+            //! New address of the gear has its answers
+            __dali2_hal_cache_drop(DALI2_HAL_CACHE_ADDR_ALL, class_mask);
+        } else {
+            __dali2_hal_cache_drop(addr >> 1, class_mask);
+        }
+    } else if ((addr & 0xE0) == 0x80 || (addr & 0xFE) == 0xFE) {
+        //! Group and broadcast, membership is not known here
+        __dali2_hal_cache_drop(DALI2_HAL_CACHE_ADDR_ALL, class_mask);
+    }
+}
+
+void dali2_hal_cache_flush(void)
+{
+    __dali2_hal_cache_drop(DALI2_HAL_CACHE_ADDR_ALL, DALI2_HAL_CACHE_ALL);
+}
+
+void dali2_hal_cache_stats_get(dali2_hal_cache_stats_t *stats)
+{
+    if (stats) {
+        memcpy(stats, &__cache_handle.stats, sizeof(dali2_hal_cache_stats_t));
+    }
+}
@@ -0,0 +1,132 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_retry.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL job step retry policy source file
+ *
+ * @details Every failed job step is classified and repeated according the policy
+ *          of its class: attempts, backoff before repetition, re-read before re-write
+ *          and the result of failed job. Attempts are counted per step, a new step
+ *          starts counting again, the whole job has DALI2_HAL_RETRY_JOB_MAX
+ *          repetitions at most, so steps failing in turn do not livelock HAL.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+#include "dali2_log.h"
+
+typedef struct {
+    unsigned char attempts;             //! Repetitions of the step
+    unsigned char rereads;              //! The first repetitions re-read the value only
+    unsigned short backoff_ms;          //! The first delay, doubled by repetition
+    unsigned short backoff_max_ms;
+    dali2_ret_t ret;                    //! Result of failed job
+} dali2_hal_retry_policy_t;
+
+static const dali2_hal_retry_policy_t __retry_policy[DALI2_HAL_RETRY_STEP_COUNT] = {
+    [DALI2_HAL_RETRY_STEP_SEND] = {3, 0, 50, 200, DALI2_RET_INTERNAL_ERROR},
+    [DALI2_HAL_RETRY_STEP_QUERY] = {3, 0, 100, 400, DALI2_RET_TIMEOUT},
+    [DALI2_HAL_RETRY_STEP_VERIFY] = {4, 1, 100, 400, DALI2_RET_NOT_SUPPORTED},
+    [DALI2_HAL_RETRY_STEP_SETTLE] = {30, 0, 100, 1000, DALI2_RET_TIMEOUT},
+    [DALI2_HAL_RETRY_STEP_STALL] = {2, 0, 100, 100, DALI2_RET_TIMEOUT},
+};
+
+//! Internal handle type
+typedef struct {
+    DALI2_L_APP_CMD_T cmd;              //! Step being repeated
+    unsigned char attempts;
+    unsigned char job_attempts;
+    dali2_hal_job_result_t result;
+    dali2_hal_retry_stats_t stats;
+} dali2_hal_retry_handle_t;
+
+static dali2_hal_retry_handle_t __retry_handle;
+
+void dali2_hal_retry_init(void)
+{
+    memset(&__retry_handle, 0x00, sizeof(__retry_handle));
+    __retry_handle.result.evt = DALI2_HAL_EVT_FREE;
+}
+
+void dali2_hal_retry_reset(void)
+{
+    __retry_handle.cmd = DALI2_L_APP_CMD_UNKNOWN;
+    __retry_handle.attempts = 0;
+    __retry_handle.job_attempts = 0;
+}
+
+DALI2_HAL_RETRY_T dali2_hal_retry(DALI2_HAL_RETRY_STEP_T step, DALI2_L_APP_CMD_T cmd)
+{
+    const dali2_hal_retry_policy_t *policy = &__retry_policy[step];
+
+    if (cmd != __retry_handle.cmd) {
+        __retry_handle.cmd = cmd;
+        __retry_handle.attempts = 0;
+    }
+
+    //! Step or job is out of attempts
+    if (__retry_handle.attempts >= policy->attempts || __retry_handle.job_attempts >= DALI2_HAL_RETRY_JOB_MAX) {
+        DALI2_LOG2(HAL_RETRY_FAIL, cmd, __retry_handle.attempts);
+        __retry_handle.stats.failures++;
+        dali2_hal_mtx_fail(policy->ret);
+        return DALI2_HAL_RETRY_FAIL;
+    }
+
+    dali2_hal_queue_hold(dali2_hal_retry_backoff_ms(step, __retry_handle.attempts));
+
+    __retry_handle.attempts++;
+    __retry_handle.job_attempts++;
+    __retry_handle.stats.retries++;
+
+    if (__retry_handle.attempts <= policy->rereads) {
+        __retry_handle.stats.rereads++;
+        return DALI2_HAL_RETRY_REREAD;
+    }
+
+    return DALI2_HAL_RETRY_REPEAT;
+}
+
+unsigned int dali2_hal_retry_backoff_ms(DALI2_HAL_RETRY_STEP_T step, unsigned int attempt)
+{
+    const dali2_hal_retry_policy_t *policy = &__retry_policy[step];
+    unsigned int backoff_ms = policy->backoff_ms;
+
+    if (attempt >= policy->attempts) {
+        return 0;
+    }
+
+    //! Doubling stops on the limit, long policies do not overflow
+    while (attempt-- && backoff_ms < policy->backoff_max_ms) {
+        backoff_ms *= 2;
+    }
+
+    return (backoff_ms > policy->backoff_max_ms) ? policy->backoff_max_ms : backoff_ms;
+}
+
+void dali2_hal_retry_job_end(DALI2_HAL_EVT_T evt, dali2_ret_t ret)
+{
+    __retry_handle.result.evt = evt;
+    __retry_handle.result.ret = ret;
+    __retry_handle.result.cmd = (ret == DALI2_RET_SUCCESS) ? DALI2_L_APP_CMD_UNKNOWN : __retry_handle.cmd;
+    __retry_handle.result.retries = __retry_handle.job_attempts;
+}
+
+void dali2_hal_job_result_get(dali2_hal_job_result_t *result)
+{
+    if (result) {
+        memcpy(result, &__retry_handle.result, sizeof(dali2_hal_job_result_t));
+    }
+}
+
+void dali2_hal_retry_stats_get(dali2_hal_retry_stats_t *stats)
+{
+    if (stats) {
+        memcpy(stats, &__retry_handle.stats, sizeof(dali2_hal_retry_stats_t));
+    }
+}
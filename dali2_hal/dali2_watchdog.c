@@ -0,0 +1,136 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_watchdog.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          HAL job watchdog source file
+ *
+ * @details Both deadlines of the running job are checked against one millisecond
+ *          clock by dali2_hal_process(). Command has DALI2_HAL_WATCHDOG_CMD_MS from
+ *          the last progress of the job (push of command or its completion): stalled
+ *          command resynchronizes the Application and lower layers and is restarted
+ *          by retry policy. Job has its own deadline from the start: stalled job is
+ *          aborted with DALI2_RET_TIMEOUT. Both cases are reported.
+ */
+
+#include "string.h"
+
+#include "dali2_hal.h"
+#include "dali2_hal_internal.h"
+#include "dali2_log.h"
+
+static const unsigned int __watchdog_job_ms[DALI2_HAL_EVT_FREE] = {
+    [DALI2_HAL_EVT_ADDR_ALLOC] = DALI2_HAL_WATCHDOG_ADDR_ALLOC_MS,
+    [DALI2_HAL_EVT_DIM_CFG] = DALI2_HAL_WATCHDOG_JOB_MS,
+    [DALI2_HAL_EVT_DIM_CTRL] = DALI2_HAL_WATCHDOG_JOB_MS,
+    [DALI2_HAL_EVT_POLL] = DALI2_HAL_WATCHDOG_JOB_MS,
+};
+
+//! Internal handle type
+typedef struct {
+    unsigned int job_ms;                //! Start of the job
+    unsigned int cmd_ms;                //! The last progress of the job
+    dali2_hal_watchdog_report_t report;
+    dali2_hal_watchdog_stats_t stats;
+} dali2_hal_watchdog_handle_t;
+
+static dali2_hal_watchdog_handle_t __watchdog_handle;
+
+void dali2_hal_watchdog_init(void)
+{
+    memset(&__watchdog_handle, 0x00, sizeof(__watchdog_handle));
+    __watchdog_handle.report.evt = DALI2_HAL_EVT_FREE;
+}
+
+void dali2_hal_watchdog_job_start(void)
+{
+    __watchdog_handle.job_ms = dali2_l_bsp_time_ms_get();
+    __watchdog_handle.cmd_ms = __watchdog_handle.job_ms;
+}
+
+void dali2_hal_watchdog_kick(void)
+{
+    __watchdog_handle.cmd_ms = dali2_l_bsp_time_ms_get();
+}
+
+void dali2_hal_watchdog_expire(void)
+{
+    __watchdog_handle.cmd_ms = dali2_l_bsp_time_ms_get() - DALI2_HAL_WATCHDOG_CMD_MS;
+}
+
+unsigned char dali2_hal_watchdog_check(DALI2_HAL_EVT_T evt, DALI2_L_APP_CMD_T cmd, unsigned char is_exec)
+{
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    dali2_hal_watchdog_report_t *report = &__watchdog_handle.report;
+
+    if (evt >= DALI2_HAL_EVT_FREE) {
+        return 0;
+    }
+
+    if (now - __watchdog_handle.job_ms >= __watchdog_job_ms[evt]) {
+        report->stage = DALI2_HAL_WATCHDOG_STAGE_JOB;
+        report->stalled_ms = now - __watchdog_handle.job_ms;
+    } else if (now - __watchdog_handle.cmd_ms >= DALI2_HAL_WATCHDOG_CMD_MS) {
+        report->stage = is_exec ? DALI2_HAL_WATCHDOG_STAGE_BUS : DALI2_HAL_WATCHDOG_STAGE_QUEUE;
+        report->stalled_ms = now - __watchdog_handle.cmd_ms;
+    } else {
+        return 0;
+    }
+
+    report->evt = evt;
+    report->cmd = cmd;
+
+    //! Lower layers may wait for lost interrupt, the next command needs them ready
+    report->layers = dali2_l_app_resync();
+
+    if (report->stage == DALI2_HAL_WATCHDOG_STAGE_JOB) {
+        DALI2_LOG2(HAL_WDT_ABORT, evt, report->stalled_ms);
+        __watchdog_handle.stats.aborts++;
+        dali2_hal_mtx_fail(DALI2_RET_TIMEOUT);
+    } else {
+        DALI2_LOG2(HAL_WDT_STALL, cmd, report->layers);
+        __watchdog_handle.stats.restarts++;
+        __watchdog_handle.cmd_ms = now;
+        dali2_hal_retry(DALI2_HAL_RETRY_STEP_STALL, cmd);
+    }
+
+    return 1;
+}
+
+unsigned int dali2_hal_watchdog_left_ms(DALI2_HAL_EVT_T evt)
+{
+    unsigned int now = dali2_l_bsp_time_ms_get();
+    unsigned int job_ms, cmd_ms;
+
+    if (evt >= DALI2_HAL_EVT_FREE) {
+        return DALI2_HAL_WATCHDOG_CMD_MS;
+    }
+
+    job_ms = now - __watchdog_handle.job_ms;
+    cmd_ms = now - __watchdog_handle.cmd_ms;
+    if (job_ms >= __watchdog_job_ms[evt] || cmd_ms >= DALI2_HAL_WATCHDOG_CMD_MS) {
+        return 0;
+    }
+
+    job_ms = __watchdog_job_ms[evt] - job_ms;
+    cmd_ms = DALI2_HAL_WATCHDOG_CMD_MS - cmd_ms;
+
+    return (job_ms < cmd_ms) ? job_ms : cmd_ms;
+}
+
+void dali2_hal_watchdog_report_get(dali2_hal_watchdog_report_t *report)
+{
+    if (report) {
+        memcpy(report, &__watchdog_handle.report, sizeof(dali2_hal_watchdog_report_t));
+    }
+}
+
+void dali2_hal_watchdog_stats_get(dali2_hal_watchdog_stats_t *stats)
+{
+    if (stats) {
+        memcpy(stats, &__watchdog_handle.stats, sizeof(dali2_hal_watchdog_stats_t));
+    }
+}
@@ -0,0 +1,133 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_log.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Binary deferred logging source file
+ */
+
+#include <string.h>
+
+#include "dali2_log.h"
+
+dali2_log_handle_t __dali2_log_handle;
+
+#ifdef DALI2_LOG_TEXT_EN
+#define DALI2_LOG_MSG(ID, MODULE, LEVEL, TEXT)  TEXT,
+static const char * const __dali2_log_text[DALI2_LOG_ID_COUNT] = {
+#include "dali2_log_msg_list.h"
+};
+#undef DALI2_LOG_MSG
+#endif
+
+void dali2_log_init(void)
+{
+    memset(&__dali2_log_handle, 0x00, sizeof(__dali2_log_handle));
+    memset(__dali2_log_handle.module_level, DALI2_LOG_LEVEL_DEFAULT, sizeof(__dali2_log_handle.module_level));
+}
+
+dali2_ret_t dali2_log_level_set(DALI2_LOG_MODULE_T module, unsigned char level)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+
+    //! Verify parameters
+    if (module >= DALI2_LOG_MODULE_COUNT || level > DALI2_LOG_LEVEL_DEBUG) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    __dali2_log_handle.module_level[module] = level;
+
+__ret:
+    return dali2_ret;
+}
+
+dali2_ret_t dali2_log_read(dali2_log_record_t *record)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+    unsigned int tail;
+    dali2_log_slot_t *slot;
+
+    //! Verify pointer
+    if (!record) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    tail = dali2_ring_tail_get(&__dali2_log_handle.ring);
+    slot = &__dali2_log_handle.slot[DALI2_RING_IDX(tail, DALI2_LOG_RING_SIZE)];
+
+    //! Verify record is published
+    if (!dali2_ring_is_published(&slot->stamp, tail)) {
+        dali2_ret = DALI2_RET_BUSY;
+        goto __ret;
+    }
+
+    memcpy(record, &slot->record, sizeof(dali2_log_record_t));
+
+    //! Free slot for producers
+    dali2_ring_release(&__dali2_log_handle.ring, tail);
+
+__ret:
+    return dali2_ret;
+}
+
+unsigned int dali2_log_dropped_get(void)
+{
+    return dali2_ring_dropped_get(&__dali2_log_handle.ring);
+}
+
+static inline void __dali2_log_put_le(unsigned char *buf, unsigned int value, unsigned int size)
+{
+    unsigned int i;
+
+    for (i = 0; i < size; i++) {
+        buf[i] = (unsigned char) (value >> (i * 8));
+    }
+}
+
+unsigned int dali2_log_export(dali2_log_export_func_t write_func)
+{
+    unsigned int count = 0;
+    dali2_log_record_t record;
+    unsigned char buf[DALI2_LOG_RECORD_EXPORT_SIZE];
+
+    if (!write_func) {
+        return 0;
+    }
+
+    while (dali2_log_read(&record) == DALI2_RET_SUCCESS) {
+        __dali2_log_put_le(&buf[0], record.id, 2);
+        buf[2] = record.arg_count;
+        buf[3] = record.seq;
+        __dali2_log_put_le(&buf[4], record.args[0], 4);
+        __dali2_log_put_le(&buf[8], record.args[1], 4);
+
+        write_func(buf, sizeof(buf));
+        count++;
+    }
+
+    return count;
+}
+
+unsigned int dali2_log_process(void)
+{
+    unsigned int count = 0;
+    dali2_log_record_t record;
+
+    while (dali2_log_read(&record) == DALI2_RET_SUCCESS) {
+#ifdef DALI2_LOG_TEXT_EN
+        if (record.id < DALI2_LOG_ID_COUNT) {
+            dali2_l_bsp_print(__dali2_log_text[record.id], record.args[0], record.args[1]);
+        }
+#else
+        dali2_l_bsp_print("DALI2 LOG #%u: %u 0x%X 0x%X", record.seq, record.id, record.args[0], record.args[1]);
+#endif
+        count++;
+    }
+
+    return count;
+}
@@ -0,0 +1,211 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_log.h
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Binary deferred logging header file
+ *
+ * @details Log call stores message ID and raw integer arguments into
+ *          lock-free ring buffer. Text formatting is deferred to
+ *          @ref dali2_log_process() or done on host side by dali2_log_decode tool
+ *          from the same @ref dali2_log_msg_list.h table.
+ *
+ * @note    DALI2_LOG_EN (see dali2_l_bsp.h) enables logging at all.
+ *          DALI2_LOG_LEVEL_STRIP strips messages above level at compile time.
+ *          DALI2_LOG_TEXT_EN keeps message texts in firmware for @ref dali2_log_process().
+ */
+#ifndef DALI2_LOG_H_
+#define DALI2_LOG_H_
+
+#include "dali2_l_bsp.h"
+#include "dali2_error.h"
+#include "dali2_ring.h"
+
+//! Ring buffer size in records, must be power of 2
+#ifndef DALI2_LOG_RING_SIZE
+#define DALI2_LOG_RING_SIZE             64
+#endif
+
+//! Maximum integer arguments per message
+#define DALI2_LOG_ARGS_MAX              2
+
+//! Binary record size on export stream, @see dali2_log_export()
+#define DALI2_LOG_RECORD_EXPORT_SIZE    12
+
+//! Log levels
+#define DALI2_LOG_LEVEL_NONE            0
+#define DALI2_LOG_LEVEL_ERROR           1
+#define DALI2_LOG_LEVEL_WARNING         2
+#define DALI2_LOG_LEVEL_INFO            3
+#define DALI2_LOG_LEVEL_DEBUG           4
+
+//! Messages above this level are stripped at compile time
+#ifndef DALI2_LOG_LEVEL_STRIP
+#define DALI2_LOG_LEVEL_STRIP           DALI2_LOG_LEVEL_INFO
+#endif
+
+//! Default runtime level of each module
+#ifndef DALI2_LOG_LEVEL_DEFAULT
+#define DALI2_LOG_LEVEL_DEFAULT         DALI2_LOG_LEVEL_INFO
+#endif
+
+//! Log modules
+typedef enum {
+    DALI2_LOG_MODULE_PHY,
+    DALI2_LOG_MODULE_SES,
+    DALI2_LOG_MODULE_APP,
+    DALI2_LOG_MODULE_HAL,
+    DALI2_LOG_MODULE_ADDR_ALLOC,
+    DALI2_LOG_MODULE_DIM_CFG,
+    DALI2_LOG_MODULE_DIM_CTRL,
+
+    DALI2_LOG_MODULE_COUNT
+} DALI2_LOG_MODULE_T;
+
+//! Message identifiers, DALI2_LOG_ID_<ID>
+#define DALI2_LOG_MSG(ID, MODULE, LEVEL, TEXT)  DALI2_LOG_ID_##ID,
+typedef enum {
+#include "dali2_log_msg_list.h"
+    DALI2_LOG_ID_COUNT
+} DALI2_LOG_ID_T;
+#undef DALI2_LOG_MSG
+
+//! Compile-time module and level of every message, DALI2_LOG_MOD_<ID> and DALI2_LOG_LVL_<ID>
+#define DALI2_LOG_MSG(ID, MODULE, LEVEL, TEXT)  \
+    DALI2_LOG_MOD_##ID = DALI2_LOG_MODULE_##MODULE, DALI2_LOG_LVL_##ID = DALI2_LOG_LEVEL_##LEVEL,
+enum {
+#include "dali2_log_msg_list.h"
+    DALI2_LOG_MSG_ATTR_COUNT
+};
+#undef DALI2_LOG_MSG
+
+//! Log record
+typedef struct {
+    unsigned short id;                          //! @ref DALI2_LOG_ID_T
+    unsigned char arg_count;
+    unsigned char seq;                          //! Lower byte of record number, shows lost records
+    unsigned int args[DALI2_LOG_ARGS_MAX];
+} dali2_log_record_t;
+
+//! Ring slot, stamp is publication marker of the record
+typedef struct {
+    volatile unsigned int stamp;
+    dali2_log_record_t record;
+} dali2_log_slot_t;
+
+//! Ring buffer handle. Do not use directly
+typedef struct {
+    dali2_ring_t ring;
+    unsigned char module_level[DALI2_LOG_MODULE_COUNT];
+    dali2_log_slot_t slot[DALI2_LOG_RING_SIZE];
+} dali2_log_handle_t;
+
+extern dali2_log_handle_t __dali2_log_handle;
+
+/**@brief Store message into ring buffer. Use DALI2_LOGx() macro instead.
+ *
+ * @note  Lock-free, may be called from interrupt context
+ *        and from several producers at the same time.
+ *        Record is dropped when ring buffer is full.
+ */
+static inline void dali2_log_write(unsigned short id, unsigned char module, unsigned char level,
+                                   unsigned char arg_count, unsigned int arg0, unsigned int arg1)
+{
+    unsigned int head;
+    dali2_log_slot_t *slot;
+
+    //! Runtime module level
+    if (level > __dali2_log_handle.module_level[module]) {
+        return;
+    }
+
+    //! Reserve slot
+    if (!dali2_ring_reserve(&__dali2_log_handle.ring, DALI2_LOG_RING_SIZE, &head)) {
+        return;
+    }
+
+    //! Fill record
+    slot = &__dali2_log_handle.slot[DALI2_RING_IDX(head, DALI2_LOG_RING_SIZE)];
+    slot->record.id = id;
+    slot->record.arg_count = arg_count;
+    slot->record.seq = (unsigned char) head;
+    slot->record.args[0] = arg0;
+    slot->record.args[1] = arg1;
+
+    //! Publish record
+    dali2_ring_publish(&slot->stamp, head);
+}
+
+#ifdef DALI2_LOG_EN
+#define DALI2_LOG_PUT(ID, COUNT, A0, A1)                                                            \
+    do {                                                                                            \
+        if (DALI2_LOG_LVL_##ID <= DALI2_LOG_LEVEL_STRIP) {                                          \
+            dali2_log_write(DALI2_LOG_ID_##ID, DALI2_LOG_MOD_##ID, DALI2_LOG_LVL_##ID,              \
+                            (COUNT), (unsigned int) (A0), (unsigned int) (A1));                     \
+        }                                                                                           \
+    } while (0)
+#else
+#define DALI2_LOG_PUT(ID, COUNT, A0, A1)    do { } while (0)
+#endif
+
+//! Log message without arguments
+#define DALI2_LOG0(ID)              DALI2_LOG_PUT(ID, 0, 0, 0)
+//! Log message with one integer argument
+#define DALI2_LOG1(ID, A0)          DALI2_LOG_PUT(ID, 1, A0, 0)
+//! Log message with two integer arguments
+#define DALI2_LOG2(ID, A0, A1)      DALI2_LOG_PUT(ID, 2, A0, A1)
+
+/**@brief Binary log initialization
+ * @note  All modules get DALI2_LOG_LEVEL_DEFAULT level
+ */
+void dali2_log_init(void);
+
+/**@brief Setting runtime level of module
+ *
+ * @param[IN] module - log module, @see DALI2_LOG_MODULE_T
+ * @param[IN] level - DALI2_LOG_LEVEL_x
+ * @return @see dali2_ret_t
+ */
+dali2_ret_t dali2_log_level_set(DALI2_LOG_MODULE_T module, unsigned char level);
+
+/**@brief Reading single record from ring buffer
+ * @note  Single consumer only
+ *
+ * @param[OUT] record - record output
+ * @return DALI2_RET_SUCCESS - record read
+ *         DALI2_RET_BUSY - ring buffer is empty or next record is not published yet
+ */
+dali2_ret_t dali2_log_read(dali2_log_record_t *record);
+
+/**@brief Getting count of dropped records since initialization
+ */
+unsigned int dali2_log_dropped_get(void);
+
+/**@brief Binary export writer function type
+ *
+ * @param[IN] data - bytes to write
+ * @param[IN] size - bytes count
+ */
+typedef void (* dali2_log_export_func_t) (const unsigned char *data, unsigned int size);
+
+/**@brief Exporting all pending records as binary stream for dali2_log_decode tool
+ * @note  Record layout is DALI2_LOG_RECORD_EXPORT_SIZE bytes, little endian:
+ *        [id:16] [arg_count:8] [seq:8] [arg0:32] [arg1:32]
+ *
+ * @param[IN] write_func - stream writer
+ * @return Count of exported records
+ */
+unsigned int dali2_log_export(dali2_log_export_func_t write_func);
+
+/**@brief Formatting all pending records through dali2_l_bsp_print()
+ * @note  Call it from idle context. Needs DALI2_LOG_TEXT_EN,
+ *        otherwise records are printed as raw ID and arguments.
+ *
+ * @return Count of printed records
+ */
+unsigned int dali2_log_process(void);
+
+#endif /* DALI2_LOG_H_ */
@@ -0,0 +1,58 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_log_msg_list.h
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Binary log message list
+ *
+ * @details X-macro table, include it only after defining
+ *          DALI2_LOG_MSG(ID, MODULE, LEVEL, TEXT).
+ *          Message ID is the position in this list, so append new messages
+ *          at the end to keep already captured logs decodable.
+ *          TEXT arguments must be integers only (%u, %d, %X).
+ */
+
+//! HAL messages
+DALI2_LOG_MSG(HAL_QUEUE_FAIL,               HAL,        ERROR,      "DALI2 HAL Internal fail on queue!")
+
+//! HAL Dimmer configuration messages
+DALI2_LOG_MSG(DIM_CFG_DEVICE_TYPE,          DIM_CFG,    INFO,       "Device type %u")
+DALI2_LOG_MSG(DIM_CFG_DEVICE_NOT_SUPPORTED, DIM_CFG,    WARNING,    "Device type is not supported. Terminated Configuration!")
+DALI2_LOG_MSG(DIM_CFG_LIGHT_SRC_TYPE,       DIM_CFG,    INFO,       "Light source type %u")
+DALI2_LOG_MSG(DIM_CFG_LED_OPERATING_MODE,   DIM_CFG,    INFO,       "LED operating mode 0x%X")
+DALI2_LOG_MSG(DIM_CFG_LED_FEATURES,         DIM_CFG,    INFO,       "LED features byte 0x%X")
+DALI2_LOG_MSG(DIM_CFG_NO_CURR_PROTECTOR,    DIM_CFG,    INFO,       "Current protector doesn't supported!")
+DALI2_LOG_MSG(DIM_CFG_NO_NON_LOG_CURVE,     DIM_CFG,    INFO,       "Non-logarithmic curve doesn't supported!")
+DALI2_LOG_MSG(DIM_CFG_DIMMING_CURVE,        DIM_CFG,    INFO,       "Dimming curve 0x%X")
+DALI2_LOG_MSG(DIM_CFG_PHY_MIN,              DIM_CFG,    INFO,       "Physical minimum: %u")
+DALI2_LOG_MSG(DIM_CFG_FAIL_MODE,            DIM_CFG,    WARNING,    "Dimmer configuration Failed on set mode!")
+DALI2_LOG_MSG(DIM_CFG_FAIL_FADE_RATE,       DIM_CFG,    WARNING,    "Dimmer configuration Failed on query fade time rate!")
+DALI2_LOG_MSG(DIM_CFG_FAIL_EXT_FADE_TIME,   DIM_CFG,    WARNING,    "Dimmer configuration Failed on query extended fade time!")
+
+//! HAL Dimmer control messages
+DALI2_LOG_MSG(DIM_CTRL_STATUS,              DIM_CTRL,   DEBUG,      "DALI Status 0x%X")
+DALI2_LOG_MSG(DIM_CTRL_GEAR_NOT_PRESENT,    DIM_CTRL,   WARNING,    "DALI Control Gear presence failed!")
+DALI2_LOG_MSG(DIM_CTRL_LAMP_FAILURE,        DIM_CTRL,   WARNING,    "DALI Lamp Failure detected!")
+DALI2_LOG_MSG(DIM_CTRL_FAILURE_STATUS,      DIM_CTRL,   DEBUG,      "DALI Failure Status 0x%X")
+
+//! HAL retry messages
+DALI2_LOG_MSG(HAL_RETRY_FAIL,               HAL,        WARNING,    "HAL job failed on command %u after %u repetitions")
+
+//! HAL watchdog messages
+DALI2_LOG_MSG(HAL_WDT_STALL,                HAL,        WARNING,    "HAL job stalled on command %u, busy layers 0x%X")
+DALI2_LOG_MSG(HAL_WDT_ABORT,                HAL,        ERROR,      "HAL job %u aborted by watchdog after %u ms")
+
+//! HAL preemption messages
+DALI2_LOG_MSG(HAL_PREEMPT,                  HAL,        DEBUG,      "HAL job %u suspended on command %u")
+
+//! HAL deadline scheduler messages
+DALI2_LOG_MSG(HAL_EDF_REJECT,               HAL,        WARNING,    "HAL request of job %u rejected, %u ms over deadline")
+DALI2_LOG_MSG(HAL_EDF_EXPIRE,               HAL,        WARNING,    "HAL request of job %u expired before start")
+DALI2_LOG_MSG(HAL_EDF_MISS,                 HAL,        WARNING,    "HAL request of job %u finished %u ms after deadline")
+
+//! HAL bus sharing messages
+DALI2_LOG_MSG(HAL_CLIENT_FULL,              HAL,        WARNING,    "HAL client %u queue is full, job %u dropped")
+DALI2_LOG_MSG(HAL_CLIENT_THROTTLE,          HAL,        DEBUG,      "HAL client %u throttled, %u ms of bus time owed")
@@ -0,0 +1,77 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_metrics.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Bus metrics source file
+ */
+
+#include <string.h>
+
+#include "dali2_metrics.h"
+
+#ifdef DALI2_METRICS_EN
+dali2_metrics_handle_t __dali2_metrics_handle;
+
+void dali2_metrics_init(void)
+{
+    memset(&__dali2_metrics_handle, 0x00, sizeof(__dali2_metrics_handle));
+    __dali2_metrics_handle.next_job = DALI2_METRICS_JOB_APP;
+    __dali2_metrics_handle.job = DALI2_METRICS_JOB_APP;
+    __dali2_metrics_handle.reset_us = dali2_l_bsp_time_us_get();
+}
+
+void dali2_metrics_reset(void)
+{
+    unsigned int *val = (unsigned int *) &__dali2_metrics_handle.val;
+    unsigned int i;
+
+    //! Values may be updated at the same time, clear them one by one
+    for (i = 0; i < (sizeof(dali2_metrics_snapshot_t) / sizeof(unsigned int)); i++) {
+        __atomic_store_n(&val[i], 0, __ATOMIC_RELAXED);
+    }
+
+    __dali2_metrics_handle.reset_us = dali2_l_bsp_time_us_get();
+}
+
+dali2_ret_t dali2_metrics_get(dali2_metrics_snapshot_t *snapshot)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+    unsigned int *src = (unsigned int *) &__dali2_metrics_handle.val;
+    unsigned int *dst;
+    unsigned int i;
+
+    //! Verify pointer
+    if (!snapshot) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    dst = (unsigned int *) snapshot;
+    for (i = 0; i < (sizeof(dali2_metrics_snapshot_t) / sizeof(unsigned int)); i++) {
+        dst[i] = __atomic_load_n(&src[i], __ATOMIC_RELAXED);
+    }
+
+    snapshot->time_us = dali2_l_bsp_time_us_get() - __dali2_metrics_handle.reset_us;
+
+__ret:
+    return dali2_ret;
+}
+#else
+//! Counters take no RAM while metrics are disabled
+void dali2_metrics_init(void)
+{
+}
+
+void dali2_metrics_reset(void)
+{
+}
+
+dali2_ret_t dali2_metrics_get(dali2_metrics_snapshot_t *snapshot)
+{
+    return snapshot ? DALI2_RET_NOT_SUPPORTED : DALI2_RET_INVALID_PARAMS;
+}
+#endif
@@ -0,0 +1,217 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_metrics.h
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Bus metrics header file
+ *
+ * @details Fixed-size counters and histograms of bus usage:
+ *          - frames, answers, timeouts, collisions and unexpected frames
+ *            per Application layer command, @see DALI2_L_APP_CMD_T;
+ *          - bus busy time, i.e. time when Session layer is not ready;
+ *          - queue wait, bus time and settling time histograms per HAL job.
+ *
+ *          Every value is updated by single atomic add, so updates are lock-free
+ *          and may be done from interrupt context. @ref dali2_metrics_get() copies
+ *          values one by one, so snapshot is not atomic as a whole.
+ *          Time values are 32 bit microseconds and wrap after ~71 minutes,
+ *          take differences of two snapshots or reset metrics more often.
+ *
+ * @note    DALI2_METRICS_EN (see dali2_l_bsp.h) enables metrics at all.
+ */
+#ifndef DALI2_METRICS_H_
+#define DALI2_METRICS_H_
+
+#include "dali2_l_bsp.h"
+#include "dali2_error.h"
+
+//! Count of tracked command identifiers, must cover DALI2_L_APP_CMD_UNKNOWN
+#ifndef DALI2_METRICS_CMD_COUNT
+#define DALI2_METRICS_CMD_COUNT         96
+#endif
+
+//! Histogram buckets, bucket i keeps values below (DALI2_METRICS_HIST_BASE_US << i),
+//! the last bucket keeps the rest
+#ifndef DALI2_METRICS_HIST_SIZE
+#define DALI2_METRICS_HIST_SIZE         16
+#endif
+#define DALI2_METRICS_HIST_BASE_US      250
+
+//! Job types, the same order as DALI2_HAL_EVT_T
+typedef enum {
+    DALI2_METRICS_JOB_ADDR_ALLOC,
+    DALI2_METRICS_JOB_DIM_CFG,
+    DALI2_METRICS_JOB_DIM_CTRL,
+    DALI2_METRICS_JOB_POLL,
+    DALI2_METRICS_JOB_APP,                      //! Application layer used directly
+
+    DALI2_METRICS_JOB_COUNT
+} DALI2_METRICS_JOB_T;
+
+//! Per command counters
+typedef struct {
+    unsigned int fw_frames;                     //! Sent forward frames, DTR0 and repetition included
+    unsigned int bw_frames;                     //! Received backward frames
+    unsigned int timeout;                       //! NO answer
+    unsigned int collision;
+    unsigned int unexpected;                    //! Broken or not expected backward frames
+    unsigned int bus_us;                        //! Bus busy time, settling included
+} dali2_metrics_cmd_t;
+
+//! Log2 histogram
+typedef struct {
+    unsigned int bucket[DALI2_METRICS_HIST_SIZE];
+    unsigned int sum_us;
+} dali2_metrics_hist_t;
+
+//! Per job histograms
+typedef struct {
+    dali2_metrics_hist_t queue_wait;            //! From queue push up to command start
+    dali2_metrics_hist_t bus;                   //! From command start up to command done
+    dali2_metrics_hist_t settling;              //! From command done up to Session layer ready
+} dali2_metrics_job_t;
+
+//! Metrics snapshot, the same layout is used by internal handle
+typedef struct {
+    unsigned int time_us;                       //! Time since reset
+    unsigned int busy_us;                       //! Bus busy time since reset
+    dali2_metrics_cmd_t cmd[DALI2_METRICS_CMD_COUNT];
+    dali2_metrics_job_t job[DALI2_METRICS_JOB_COUNT];
+} dali2_metrics_snapshot_t;
+
+//! Metrics handle. Do not use directly
+typedef struct {
+    unsigned int reset_us;
+    dali2_metrics_snapshot_t val;
+
+    //! Command and job of the next Session layer transaction
+    volatile unsigned char next_cmd;
+    volatile unsigned char next_job;
+
+    //! Session layer transaction in progress
+    volatile unsigned char cmd;
+    volatile unsigned char job;
+    volatile unsigned int start_us;
+    volatile unsigned int done_us;
+} dali2_metrics_handle_t;
+
+extern dali2_metrics_handle_t __dali2_metrics_handle;
+
+static inline void __dali2_metrics_add(unsigned int *val, unsigned int add)
+{
+    __atomic_fetch_add(val, add, __ATOMIC_RELAXED);
+}
+
+/**@brief Adding value into histogram
+ *
+ * @param[IN] hist - histogram
+ * @param[IN] us - value in microseconds
+ */
+static inline void dali2_metrics_hist_add(dali2_metrics_hist_t *hist, unsigned int us)
+{
+    unsigned int i;
+
+    for (i = 0; i < (DALI2_METRICS_HIST_SIZE - 1); i++) {
+        if (us < ((unsigned int) DALI2_METRICS_HIST_BASE_US << i)) {
+            break;
+        }
+    }
+
+    __dali2_metrics_add(&hist->bucket[i], 1);
+    __dali2_metrics_add(&hist->sum_us, us);
+}
+
+/**@brief Tagging the next Session layer transaction. Use DALI2_METRICS_CMD_SET()
+ *        and DALI2_METRICS_JOB_SET() macro instead.
+ *
+ * @param[IN] cmd - command identifier, @see DALI2_L_APP_CMD_T
+ */
+static inline void dali2_metrics_cmd_set(unsigned int cmd)
+{
+    __dali2_metrics_handle.next_cmd =
+        (unsigned char) ((cmd < DALI2_METRICS_CMD_COUNT) ? cmd : (DALI2_METRICS_CMD_COUNT - 1));
+}
+
+/**@brief Setting job type of the next Session layer transactions
+ *
+ * @param[IN] job - @see DALI2_METRICS_JOB_T
+ */
+static inline void dali2_metrics_job_set(unsigned int job)
+{
+    __dali2_metrics_handle.next_job = (unsigned char) ((job < DALI2_METRICS_JOB_COUNT) ? job : DALI2_METRICS_JOB_APP);
+}
+
+/**@brief Session layer transaction is started. Use DALI2_METRICS_BUS_START() macro instead.
+ */
+static inline void dali2_metrics_bus_start(void)
+{
+    __dali2_metrics_handle.cmd = __dali2_metrics_handle.next_cmd;
+    __dali2_metrics_handle.job = __dali2_metrics_handle.next_job;
+    __dali2_metrics_handle.start_us = dali2_l_bsp_time_us_get();
+    __dali2_metrics_handle.done_us = __dali2_metrics_handle.start_us;
+}
+
+/**@brief Session layer transaction is done, settling time starts.
+ *        Use DALI2_METRICS_BUS_DONE() macro instead.
+ */
+static inline void dali2_metrics_bus_done(void)
+{
+    __dali2_metrics_handle.done_us = dali2_l_bsp_time_us_get();
+}
+
+/**@brief Session layer is ready again. Use DALI2_METRICS_BUS_READY() macro instead.
+ */
+static inline void dali2_metrics_bus_ready(void)
+{
+    unsigned int now = dali2_l_bsp_time_us_get();
+    unsigned int busy = now - __dali2_metrics_handle.start_us;
+
+    __dali2_metrics_add(&__dali2_metrics_handle.val.busy_us, busy);
+    __dali2_metrics_add(&__dali2_metrics_handle.val.cmd[__dali2_metrics_handle.cmd].bus_us, busy);
+    dali2_metrics_hist_add(&__dali2_metrics_handle.val.job[__dali2_metrics_handle.job].settling,
+                           now - __dali2_metrics_handle.done_us);
+}
+
+//! Counter of Session layer transaction in progress
+#define DALI2_METRICS_CMD_FIELD(FIELD)  (&__dali2_metrics_handle.val.cmd[__dali2_metrics_handle.cmd].FIELD)
+
+#ifdef DALI2_METRICS_EN
+#define DALI2_METRICS_CMD_SET(CMD)          dali2_metrics_cmd_set((unsigned int) (CMD))
+#define DALI2_METRICS_JOB_SET(JOB)          dali2_metrics_job_set((unsigned int) (JOB))
+#define DALI2_METRICS_BUS_START()           dali2_metrics_bus_start()
+#define DALI2_METRICS_BUS_DONE()            dali2_metrics_bus_done()
+#define DALI2_METRICS_BUS_READY()           dali2_metrics_bus_ready()
+#define DALI2_METRICS_CMD_INC(FIELD)        __dali2_metrics_add(DALI2_METRICS_CMD_FIELD(FIELD), 1)
+#define DALI2_METRICS_JOB_ADD(JOB, HIST, US)                                                        \
+    dali2_metrics_hist_add(&__dali2_metrics_handle.val.job[((unsigned int) (JOB) < DALI2_METRICS_JOB_COUNT) ? \
+                           (unsigned int) (JOB) : DALI2_METRICS_JOB_APP].HIST, (US))
+#else
+#define DALI2_METRICS_CMD_SET(CMD)          do { } while (0)
+#define DALI2_METRICS_JOB_SET(JOB)          do { } while (0)
+#define DALI2_METRICS_BUS_START()           do { } while (0)
+#define DALI2_METRICS_BUS_DONE()            do { } while (0)
+#define DALI2_METRICS_BUS_READY()           do { } while (0)
+#define DALI2_METRICS_CMD_INC(FIELD)        do { } while (0)
+#define DALI2_METRICS_JOB_ADD(JOB, HIST, US) do { } while (0)
+#endif
+
+/**@brief Metrics initialization, all values are reset
+ */
+void dali2_metrics_init(void);
+
+/**@brief Resetting all values, time since reset starts from now
+ */
+void dali2_metrics_reset(void);
+
+/**@brief Getting metrics snapshot
+ * @note  May be called from any context, values are read one by one
+ *
+ * @param[OUT] snapshot - snapshot output
+ * @return DALI2_RET_SUCCESS or DALI2_RET_NOT_SUPPORTED when metrics are disabled
+ */
+dali2_ret_t dali2_metrics_get(dali2_metrics_snapshot_t *snapshot);
+
+#endif /* DALI2_METRICS_H_ */
@@ -0,0 +1,277 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_mon.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Bus monitor frame journal source file
+ */
+
+#include <string.h>
+
+#include "dali2_mon.h"
+#include "dali2_ring.h"
+
+//! pcap global header, microsecond timestamps
+#define DALI2_MON_PCAP_MAGIC            0xA1B2C3D4
+#define DALI2_MON_PCAP_VERSION_MAJOR    2
+#define DALI2_MON_PCAP_VERSION_MINOR    4
+#define DALI2_MON_PCAP_SNAPLEN          65535
+#define DALI2_MON_PCAP_HEADER_SIZE      24
+#define DALI2_MON_PCAP_RECORD_SIZE      16
+
+//! Ring slot, stamp is publication marker of the record
+typedef struct {
+    volatile unsigned int stamp;
+    dali2_mon_record_t record;
+} dali2_mon_slot_t;
+
+//! Internal handle type
+typedef struct {
+#ifdef DALI2_MON_EN
+    dali2_ring_t ring;
+    dali2_mon_slot_t slot[DALI2_MON_RING_SIZE];
+#endif
+
+    //! pcap time is extended from 32 bit microseconds
+    unsigned int pcap_last_us;
+    unsigned int pcap_sec;
+    unsigned int pcap_usec;
+    unsigned char is_pcap_time;
+} dali2_mon_handle_t;
+
+static dali2_mon_handle_t __mon_handle;
+
+#ifdef DALI2_MON_EN
+static inline unsigned char __dali2_mon_type(const dali2_l_phy_tap_t *tap)
+{
+    switch (tap->evt) {
+        case DALI2_L_PHY_EVT_FORWARD_DONE:
+            return DALI2_MON_FRAME_FORWARD_OWN;
+
+        case DALI2_L_PHY_EVT_START_ERROR:
+        case DALI2_L_PHY_EVT_STOP_ERROR:
+        case DALI2_L_PHY_EVT_FORWARD_ERROR:
+            return DALI2_MON_FRAME_COLLISION;
+
+        case DALI2_L_PHY_EVT_BACKWARD_DONE:
+            return DALI2_MON_FRAME_BACKWARD;
+
+        case DALI2_L_PHY_EVT_FORWARD_RECEIVED:
+            return DALI2_MON_FRAME_FORWARD;
+
+        default:
+            return DALI2_MON_FRAME_ERROR;
+    }
+}
+
+void dali2_mon_init(void)
+{
+    memset(&__mon_handle, 0x00, sizeof(__mon_handle));
+    dali2_l_phy_tap_set(dali2_mon_write);
+}
+
+void dali2_mon_write(const dali2_l_phy_tap_t *tap)
+{
+    unsigned int head;
+    dali2_mon_slot_t *slot;
+
+    //! Reserve slot
+    if (!dali2_ring_reserve(&__mon_handle.ring, DALI2_MON_RING_SIZE, &head)) {
+        return;
+    }
+
+    //! Fill record
+    slot = &__mon_handle.slot[DALI2_RING_IDX(head, DALI2_MON_RING_SIZE)];
+    slot->record.start_us = tap->start_us;
+    slot->record.stop_us = tap->stop_us;
+    slot->record.frame = tap->frame;
+    slot->record.type = __dali2_mon_type(tap);
+    slot->record.bits = tap->bits;
+    slot->record.evt = (unsigned char) tap->evt;
+    slot->record.seq = (unsigned char) head;
+
+    //! Publish record
+    dali2_ring_publish(&slot->stamp, head);
+}
+
+dali2_ret_t dali2_mon_read(dali2_mon_record_t *record)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+    unsigned int tail;
+    dali2_mon_slot_t *slot;
+
+    //! Verify pointer
+    if (!record) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    tail = dali2_ring_tail_get(&__mon_handle.ring);
+    slot = &__mon_handle.slot[DALI2_RING_IDX(tail, DALI2_MON_RING_SIZE)];
+
+    //! Verify record is published
+    if (!dali2_ring_is_published(&slot->stamp, tail)) {
+        dali2_ret = DALI2_RET_BUSY;
+        goto __ret;
+    }
+
+    memcpy(record, &slot->record, sizeof(dali2_mon_record_t));
+
+    //! Free slot for producers
+    dali2_ring_release(&__mon_handle.ring, tail);
+
+__ret:
+    return dali2_ret;
+}
+
+unsigned int dali2_mon_dropped_get(void)
+{
+    return dali2_ring_dropped_get(&__mon_handle.ring);
+}
+#else
+//! Ring buffer takes no RAM while journal is disabled, Physical layer tap is left free
+void dali2_mon_init(void)
+{
+    memset(&__mon_handle, 0x00, sizeof(__mon_handle));
+}
+
+void dali2_mon_write(const dali2_l_phy_tap_t *tap)
+{
+}
+
+dali2_ret_t dali2_mon_read(dali2_mon_record_t *record)
+{
+    return record ? DALI2_RET_NOT_SUPPORTED : DALI2_RET_INVALID_PARAMS;
+}
+
+unsigned int dali2_mon_dropped_get(void)
+{
+    return 0;
+}
+#endif
+
+static inline void __dali2_mon_put_le(unsigned char *buf, unsigned int value, unsigned int size)
+{
+    unsigned int i;
+
+    for (i = 0; i < size; i++) {
+        buf[i] = (unsigned char) (value >> (i * 8));
+    }
+}
+
+static inline void __dali2_mon_put_be(unsigned char *buf, unsigned int value, unsigned int size)
+{
+    unsigned int i;
+
+    for (i = 0; i < size; i++) {
+        buf[size - 1 - i] = (unsigned char) (value >> (i * 8));
+    }
+}
+
+unsigned int dali2_mon_export(dali2_mon_export_func_t write_func)
+{
+    unsigned int count = 0;
+    unsigned int duration;
+    dali2_mon_record_t record;
+    unsigned char buf[DALI2_MON_RECORD_EXPORT_SIZE];
+
+    if (!write_func) {
+        return 0;
+    }
+
+    while (dali2_mon_read(&record) == DALI2_RET_SUCCESS) {
+        duration = record.stop_us - record.start_us;
+        if (duration > 0xFFFF) {
+            duration = 0xFFFF;
+        }
+
+        __dali2_mon_put_le(&buf[0], record.start_us, 4);
+        __dali2_mon_put_le(&buf[4], record.frame, 4);
+        __dali2_mon_put_le(&buf[8], duration, 2);
+        buf[10] = record.type;
+        buf[11] = record.evt;
+        buf[12] = record.bits;
+        buf[13] = record.seq;
+
+        write_func(buf, sizeof(buf));
+        count++;
+    }
+
+    return count;
+}
+
+void dali2_mon_pcap_header_export(dali2_mon_export_func_t write_func)
+{
+    unsigned char buf[DALI2_MON_PCAP_HEADER_SIZE];
+
+    if (!write_func) {
+        return;
+    }
+
+    //! Native byte order of the writer is detected by reader from magic
+    __dali2_mon_put_le(&buf[0], DALI2_MON_PCAP_MAGIC, 4);
+    __dali2_mon_put_le(&buf[4], DALI2_MON_PCAP_VERSION_MAJOR, 2);
+    __dali2_mon_put_le(&buf[6], DALI2_MON_PCAP_VERSION_MINOR, 2);
+    __dali2_mon_put_le(&buf[8], 0, 4);          //! Time zone, UTC
+    __dali2_mon_put_le(&buf[12], 0, 4);         //! Timestamp accuracy
+    __dali2_mon_put_le(&buf[16], DALI2_MON_PCAP_SNAPLEN, 4);
+    __dali2_mon_put_le(&buf[20], DALI2_MON_PCAP_LINKTYPE, 4);
+
+    write_func(buf, sizeof(buf));
+
+    //! Capture time starts from zero
+    __mon_handle.pcap_sec = 0;
+    __mon_handle.pcap_usec = 0;
+    __mon_handle.is_pcap_time = 0;
+}
+
+unsigned int dali2_mon_pcap_export(dali2_mon_export_func_t write_func)
+{
+    unsigned int count = 0;
+    unsigned int delta;
+    dali2_mon_record_t record;
+    unsigned char buf[DALI2_MON_PCAP_RECORD_SIZE + DALI2_MON_PCAP_PAYLOAD_SIZE];
+
+    if (!write_func) {
+        return 0;
+    }
+
+    while (dali2_mon_read(&record) == DALI2_RET_SUCCESS) {
+        //! Time difference of records is added, so 32 bit time wraps are not seen
+        if (!__mon_handle.is_pcap_time) {
+            __mon_handle.pcap_last_us = record.start_us;
+            __mon_handle.is_pcap_time = 1;
+        }
+        delta = record.start_us - __mon_handle.pcap_last_us;
+        __mon_handle.pcap_last_us = record.start_us;
+
+        __mon_handle.pcap_sec += delta / 1000000;
+        __mon_handle.pcap_usec += delta % 1000000;
+        if (__mon_handle.pcap_usec >= 1000000) {
+            __mon_handle.pcap_usec -= 1000000;
+            __mon_handle.pcap_sec++;
+        }
+
+        //! Packet header
+        __dali2_mon_put_le(&buf[0], __mon_handle.pcap_sec, 4);
+        __dali2_mon_put_le(&buf[4], __mon_handle.pcap_usec, 4);
+        __dali2_mon_put_le(&buf[8], DALI2_MON_PCAP_PAYLOAD_SIZE, 4);
+        __dali2_mon_put_le(&buf[12], DALI2_MON_PCAP_PAYLOAD_SIZE, 4);
+
+        //! Payload, network byte order
+        buf[16] = record.type;
+        buf[17] = record.evt;
+        buf[18] = record.bits;
+        buf[19] = record.seq;
+        __dali2_mon_put_be(&buf[20], record.stop_us - record.start_us, 4);
+        __dali2_mon_put_be(&buf[24], record.frame, 4);
+
+        write_func(buf, sizeof(buf));
+        count++;
+    }
+
+    return count;
+}
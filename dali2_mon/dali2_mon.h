@@ -0,0 +1,129 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_mon.h
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Bus monitor frame journal header file
+ *
+ * @details Every frame seen by Physical layer, own forward frames, frames of other
+ *          masters and input devices, backward frames and broken frames, is stored
+ *          into lock-free ring buffer with microsecond timestamps and Physical layer
+ *          event as error classification.
+ *
+ *          Together with @ref dali2_l_ses_monitor_set() it is passive bus sniffer,
+ *          without it own traffic is journaled too.
+ *
+ *          Journal is exported as compact binary capture for dali2_mon_decode tool
+ *          or as pcap capture for Wireshark and tcpdump.
+ *          Time values are 32 bit microseconds of dali2_l_bsp_time_us_get()
+ *          and wrap after ~71 minutes.
+ *
+ * @note    DALI2_MON_EN (see dali2_l_bsp.h) enables journal at all.
+ */
+#ifndef DALI2_MON_H_
+#define DALI2_MON_H_
+
+#include "dali2_l_bsp.h"
+#include "dali2_error.h"
+#include "dali2_l_phy.h"
+
+//! Ring buffer size in records, must be power of 2
+#ifndef DALI2_MON_RING_SIZE
+#define DALI2_MON_RING_SIZE             64
+#endif
+
+//! Binary record size on export stream, @see dali2_mon_export()
+#define DALI2_MON_RECORD_EXPORT_SIZE    14
+
+//! pcap link type, DLT_USER0. Wireshark decodes payload by "DLT_USER" preferences
+#define DALI2_MON_PCAP_LINKTYPE         147
+
+//! pcap payload size, @see dali2_mon_pcap_export()
+#define DALI2_MON_PCAP_PAYLOAD_SIZE     12
+
+//! Frame classification
+typedef enum {
+    DALI2_MON_FRAME_FORWARD,                    //! Forward frame of another master or input device
+    DALI2_MON_FRAME_FORWARD_OWN,                //! Own forward frame
+    DALI2_MON_FRAME_BACKWARD,                   //! Backward frame
+    DALI2_MON_FRAME_COLLISION,                  //! Own forward frame stopped by collision
+    DALI2_MON_FRAME_ERROR,                      //! Broken received frame, event tells the reason
+
+    DALI2_MON_FRAME_COUNT
+} DALI2_MON_FRAME_T;
+
+//! Journal record
+typedef struct {
+    unsigned int start_us;                      //! The first edge of Start condition
+    unsigned int stop_us;                       //! The last edge of the frame
+    unsigned int frame;                         //! The last 32 bits, MSB is sent first
+    unsigned char type;                         //! @ref DALI2_MON_FRAME_T
+    unsigned char bits;                         //! Frame size in bits, received part of broken frame
+    unsigned char evt;                          //! Physical layer event, @see DALI2_L_PHY_EVT_T
+    unsigned char seq;                          //! Lower byte of record number, shows lost records
+} dali2_mon_record_t;
+
+/**@brief Journal initialization, all records are dropped
+ * @note  Journal is attached to Physical layer tap when DALI2_MON_EN is defined
+ */
+void dali2_mon_init(void);
+
+/**@brief Storing frame into journal. Physical layer tap, @see dali2_l_phy_tap_func_t
+ * @note  Lock-free, may be called from interrupt context.
+ *        Record is dropped when ring buffer is full.
+ *
+ * @param[IN] tap - frame seen by Physical layer
+ */
+void dali2_mon_write(const dali2_l_phy_tap_t *tap);
+
+/**@brief Reading single record from journal
+ * @note  Single consumer only
+ *
+ * @param[OUT] record - record output
+ * @return DALI2_RET_SUCCESS - record read
+ *         DALI2_RET_BUSY - journal is empty or next record is not published yet
+ *         DALI2_RET_NOT_SUPPORTED - journal is disabled
+ */
+dali2_ret_t dali2_mon_read(dali2_mon_record_t *record);
+
+/**@brief Getting count of dropped records since initialization
+ */
+unsigned int dali2_mon_dropped_get(void);
+
+/**@brief Binary export writer function type
+ *
+ * @param[IN] data - bytes to write
+ * @param[IN] size - bytes count
+ */
+typedef void (* dali2_mon_export_func_t) (const unsigned char *data, unsigned int size);
+
+/**@brief Exporting all pending records as compact binary capture for dali2_mon_decode tool
+ * @note  Record layout is DALI2_MON_RECORD_EXPORT_SIZE bytes, little endian:
+ *        [start_us:32] [frame:32] [duration_us:16] [type:8] [evt:8] [bits:8] [seq:8]
+ *        Duration saturates at 65535 us.
+ *
+ * @param[IN] write_func - stream writer
+ * @return Count of exported records
+ */
+unsigned int dali2_mon_export(dali2_mon_export_func_t write_func);
+
+/**@brief Writing pcap global header, capture time starts from the next exported record
+ *
+ * @param[IN] write_func - stream writer
+ */
+void dali2_mon_pcap_header_export(dali2_mon_export_func_t write_func);
+
+/**@brief Exporting all pending records as pcap packets
+ * @note  Packet time is Start condition. Payload is DALI2_MON_PCAP_PAYLOAD_SIZE bytes,
+ *        big endian: [type:8] [evt:8] [bits:8] [seq:8] [duration_us:32] [frame:32]
+ *        Idle line longer than ~71 minutes is shortened in capture time.
+ *
+ * @param[IN] write_func - stream writer
+ * @return Count of exported records
+ */
+unsigned int dali2_mon_pcap_export(dali2_mon_export_func_t write_func);
+
+#endif /* DALI2_MON_H_ */
@@ -11,6 +11,7 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "dali2_l_phy.h"
 
@@ -21,9 +22,11 @@ typedef enum {
     DALI2_L_PHY_STATE_FORWARD_START,
     DALI2_L_PHY_STATE_FORWARD_FRAME,
     DALI2_L_PHY_STATE_FORWARD_STOP,
-    DALI2_L_PHY_STATE_BACKWARD_START,
-    DALI2_L_PHY_STATE_BACKWARD_FRAME,
-    DALI2_L_PHY_STATE_BACKWARD_STOP
+    DALI2_L_PHY_STATE_RX_START,
+    DALI2_L_PHY_STATE_RX_FRAME,
+    DALI2_L_PHY_STATE_RX_STOP,
+    DALI2_L_PHY_STATE_COLLISION_BREAK,
+    DALI2_L_PHY_STATE_COLLISION_RECOVERY
 } DALI2_L_PHY_STATE_T;
 
 //! Internal handle type
@@ -33,34 +36,307 @@ typedef struct {
     unsigned char half_bits_left;
     DALI2_L_BSP_DPIN_STATE_T expected_dpin_state;
 
+    //! Forward frame edges are scheduled from frame start
+    unsigned int tx_start_us;
+    unsigned char tx_bits;
+    unsigned int tx_edge_us;
+    unsigned char tx_half_bit;
+    DALI2_L_BSP_DPIN_STATE_T tx_level;
+    unsigned int tx_echo_q2[2];                 //! TX echo delay per level, 1/4 microseconds
+    DALI2_L_PHY_EVT_T collision_evt;            //! Reported after collision recovery
+
+    //! The last edge on the line, own frames and other masters included
+    unsigned int line_edge_us;
+
+    //! Received frame of any length, data half-bits are counted up
+    unsigned int rx_frame;
+    unsigned int rx_start_us;
+    unsigned char rx_half_bits;
+
     dali2_l_phy_evt_func_t evt_func;
     dali2_l_phy_evt_param_t ev_param;
+    dali2_l_phy_tap_func_t tap_func;
+
+    dali2_l_phy_stats_t stats;
+
+#ifdef DALI2_L_PHY_TIMING_EN
+    dali2_l_phy_timing_t timing;
+    unsigned int timer_due_us;
+    unsigned int last_edge_us;
+    unsigned char timing_gear;
+#endif
 
     unsigned char is_init:1;
+    unsigned char is_tx_echo:1;
+    unsigned char is_monitor:1;
 } dali2_l_phy_handle_t;
 
 dali2_l_phy_handle_t __phy_handle;
 
+static void __dali2_l_phy_tap(DALI2_L_PHY_EVT_T evt)
+{
+    dali2_l_phy_tap_t tap;
+
+    tap.evt = evt;
+    tap.stop_us = __phy_handle.line_edge_us;
+
+    switch (evt) {
+        case DALI2_L_PHY_EVT_FORWARD_DONE:
+        case DALI2_L_PHY_EVT_START_ERROR:
+        case DALI2_L_PHY_EVT_STOP_ERROR:
+        case DALI2_L_PHY_EVT_FORWARD_ERROR:
+            tap.frame = __phy_handle.ev_param.forward.frame;
+            tap.bits = __phy_handle.tx_bits;
+            tap.is_own = 1;
+            tap.start_us = __phy_handle.tx_start_us;
+            break;
+
+        default:
+            //! Received frame up to the event, broken frames included
+            tap.frame = __phy_handle.rx_frame;
+            tap.bits = __phy_handle.rx_half_bits / 2;
+            tap.is_own = 0;
+            tap.start_us = __phy_handle.rx_start_us;
+            break;
+    }
+
+    __phy_handle.tap_func(&tap);
+}
+
+static inline void __dali2_l_phy_evt(DALI2_L_PHY_EVT_T evt)
+{
+    //! Count every event for classification statistics
+    __phy_handle.stats.evt[evt]++;
+
+    if (__phy_handle.tap_func) {
+        __dali2_l_phy_tap(evt);
+    }
+    __phy_handle.evt_func(evt, &__phy_handle.ev_param);
+}
+
+#ifdef DALI2_L_PHY_TIMING_EN
+static inline void __dali2_l_phy_hist_add(dali2_l_phy_hist_t *hist, unsigned int us, unsigned int base, unsigned int step)
+{
+    unsigned int i = (us > base) ? ((us - base) / step) : 0;
+
+    if (i >= DALI2_L_PHY_HIST_SIZE) {
+        i = DALI2_L_PHY_HIST_SIZE - 1;
+    }
+
+    //! Saturate instead of wrapping
+    if (hist->bucket[i] != 0xFFFF) {
+        hist->bucket[i]++;
+    }
+}
+
+static inline void __dali2_l_phy_timing_timer(void)
+{
+    unsigned int late = dali2_l_bsp_time_us_get() - __phy_handle.timer_due_us;
+
+    //! Early callback is counted as in time
+    if ((int) late < 0) {
+        late = 0;
+    }
+
+    if (late > __phy_handle.timing.timer_late_max_us) {
+        __phy_handle.timing.timer_late_max_us = late;
+    }
+
+    __dali2_l_phy_hist_add(&__phy_handle.timing.timer_late, late,
+                           DALI2_L_PHY_HIST_TIMER_LATE_BASE_US, DALI2_L_PHY_HIST_TIMER_LATE_STEP_US);
+}
+
+static inline void __dali2_l_phy_timing_edge(void)
+{
+    unsigned int now = dali2_l_bsp_time_us_get();
+    unsigned int width = now - __phy_handle.last_edge_us;
+    unsigned char gear = __phy_handle.timing_gear;
+
+    __phy_handle.last_edge_us = now;
+
+    switch (__phy_handle.phy_state) {
+        case DALI2_L_PHY_STATE_IDLE:
+            //! Start of the next frame
+            __dali2_l_phy_hist_add(&__phy_handle.timing.stop, width,
+                                   DALI2_L_PHY_HIST_STOP_BASE_US, DALI2_L_PHY_HIST_STOP_STEP_US);
+            break;
+
+        case DALI2_L_PHY_STATE_RX_START:
+        case DALI2_L_PHY_STATE_RX_FRAME:
+        case DALI2_L_PHY_STATE_RX_STOP:
+            //! Edges are one or two half-bits apart
+            if (width < (DALI2_L_PHY_HALF_BIT_TIME_US_TYP * 3 / 2)) {
+                __dali2_l_phy_hist_add(&__phy_handle.timing.half_bit[gear], width,
+                                       DALI2_L_PHY_HIST_HALF_BIT_BASE_US, DALI2_L_PHY_HIST_HALF_BIT_STEP_US);
+            } else {
+                __dali2_l_phy_hist_add(&__phy_handle.timing.double_half_bit[gear], width,
+                                       DALI2_L_PHY_HIST_DOUBLE_BASE_US, DALI2_L_PHY_HIST_DOUBLE_STEP_US);
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static inline void __dali2_l_phy_timing_gear_set(DALI2_L_PHY_FRAME_T frame_type, unsigned int frame_data)
+{
+    //! Short address byte is 0AAAAAAS
+    if (frame_type == DALI2_L_PHY_FRAME_16BIT_FW && !(frame_data & 0x8000) &&
+        ((frame_data >> 9) & 0x3F) < DALI2_L_PHY_TIMING_GEAR_COUNT) {
+        __phy_handle.timing_gear = (unsigned char) ((frame_data >> 9) & 0x3F);
+    } else {
+        __phy_handle.timing_gear = DALI2_L_PHY_TIMING_GEAR_OTHER;
+    }
+}
+#else
+static inline void __dali2_l_phy_timing_timer(void) { }
+static inline void __dali2_l_phy_timing_edge(void) { }
+static inline void __dali2_l_phy_timing_gear_set(DALI2_L_PHY_FRAME_T frame_type, unsigned int frame_data) { }
+#endif
+
+static inline void __dali2_l_phy_timer_start(unsigned int us)
+{
+#ifdef DALI2_L_PHY_TIMING_EN
+    __phy_handle.timer_due_us = dali2_l_bsp_time_us_get() + us;
+#endif
+    dali2_l_bsp_phy_timer_start_us(us);
+}
+
+static inline void __dali2_l_phy_timer_start_at(unsigned int at_us)
+{
+#ifdef DALI2_L_PHY_TIMING_EN
+    __phy_handle.timer_due_us = at_us;
+#endif
+    dali2_l_bsp_phy_timer_start_at_us(at_us);
+}
+
+static inline void __dali2_l_fw_pin_set(DALI2_L_BSP_DPIN_STATE_T level)
+{
+    __phy_handle.expected_dpin_state = level;
+
+    //! Echo of the edge is measured on RX PIN
+    if (level != __phy_handle.tx_level) {
+        __phy_handle.tx_level = level;
+        __phy_handle.tx_edge_us = dali2_l_bsp_time_us_get();
+        __phy_handle.is_tx_echo = 1;
+    }
+
+    dali2_l_bsp_tx_pin_set(level);
+}
+
+static inline void __dali2_l_fw_echo(DALI2_L_BSP_DPIN_STATE_T state)
+{
+    unsigned int delay_q2;
+
+    if (!__phy_handle.is_tx_echo || state != __phy_handle.tx_level) {
+        return;
+    }
+    __phy_handle.is_tx_echo = 0;
+
+    //! Echo later than half-bit is line fault, not slope
+    delay_q2 = dali2_l_bsp_time_us_get() - __phy_handle.tx_edge_us;
+    if (delay_q2 >= DALI2_L_PHY_HALF_BIT_TIME_US_MIN) {
+        return;
+    }
+    delay_q2 <<= 2;
+
+    //! Slow average, so edge jitter does not move the frame
+    __phy_handle.tx_echo_q2[state] = (__phy_handle.tx_echo_q2[state] * 15 + delay_q2) / 16;
+}
+
+static inline void __dali2_l_fw_timer_next(DALI2_L_BSP_DPIN_STATE_T level)
+{
+    unsigned int echo_min = __phy_handle.tx_echo_q2[DALI2_L_BSP_DPIN_STATE_0];
+    unsigned int correction;
+
+    if (__phy_handle.tx_echo_q2[DALI2_L_BSP_DPIN_STATE_1] < echo_min) {
+        echo_min = __phy_handle.tx_echo_q2[DALI2_L_BSP_DPIN_STATE_1];
+    }
+
+    //! Slower edge is started earlier, so both are seen on the line on time
+    correction = (__phy_handle.tx_echo_q2[level] - echo_min) >> 2;
+    if (correction > DALI2_L_PHY_TX_CORRECTION_US_MAX) {
+        correction = DALI2_L_PHY_TX_CORRECTION_US_MAX;
+    }
+
+    __phy_handle.tx_half_bit++;
+    __dali2_l_phy_timer_start_at(__phy_handle.tx_start_us +
+                                 __phy_handle.tx_half_bit * DALI2_L_PHY_HALF_BIT_TIME_US_TYP - correction);
+}
+
+//! Collision: stop transmission, send break condition and wait for recovery time
+static inline void __dali2_l_fw_collision(DALI2_L_PHY_EVT_T evt)
+{
+    __phy_handle.collision_evt = evt;
+    __phy_handle.phy_state = DALI2_L_PHY_STATE_COLLISION_BREAK;
+    __phy_handle.is_tx_echo = 0;
+    __phy_handle.tx_level = DALI2_L_BSP_DPIN_STATE_0;
+    __phy_handle.stats.collisions++;
+
+    dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_0);
+    __dali2_l_phy_timer_start(DALI2_L_PHY_BREAK_TIME_US);
+}
+
+static inline void __dali2_l_fw_break_end(void)
+{
+    //! Release the line
+    __phy_handle.phy_state = DALI2_L_PHY_STATE_COLLISION_RECOVERY;
+    __phy_handle.tx_level = DALI2_L_BSP_DPIN_STATE_1;
+    dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_1);
+    __dali2_l_phy_timer_start(DALI2_L_PHY_RECOVERY_TIME_US);
+}
+
+static inline void __dali2_l_fw_recovery_end(void)
+{
+    //! Line must be idle for the whole recovery time
+    if (dali2_l_bsp_rx_pin_get() != DALI2_L_BSP_DPIN_STATE_1) {
+        __dali2_l_phy_timer_start(DALI2_L_PHY_RECOVERY_TIME_US);
+        return;
+    }
+
+    __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
+    __dali2_l_phy_evt(__phy_handle.collision_evt);
+}
+
+//! Line level of half-bit, half-bits are counted down to 0 (stop condition)
+static inline DALI2_L_BSP_DPIN_STATE_T __dali2_l_fw_level(unsigned char half_bits_left)
+{
+    unsigned char is_one;
+
+    if (!half_bits_left) {
+        return DALI2_L_BSP_DPIN_STATE_1;
+    }
+
+    is_one = (__phy_handle.ev_param.forward.frame & (1 << ((half_bits_left - 1) / 2))) ? 1 : 0;
+
+    if (half_bits_left % 2) {
+        //! Last half-bit is the bit value
+        return is_one ? DALI2_L_BSP_DPIN_STATE_1 : DALI2_L_BSP_DPIN_STATE_0;
+    }
+
+    //! First half-bit is inverted bit value
+    return is_one ? DALI2_L_BSP_DPIN_STATE_0 : DALI2_L_BSP_DPIN_STATE_1;
+}
+
 static inline void __dali2_l_fw_start(void)
 {
     DALI2_L_BSP_DPIN_STATE_T dpin_state = dali2_l_bsp_rx_pin_get();
 
     //! Verify expected PIN state
     if (dpin_state != __phy_handle.expected_dpin_state) {
-        __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-        __phy_handle.evt_func(DALI2_L_PHY_EVT_START_ERROR, &__phy_handle.ev_param);
+        __dali2_l_fw_collision(DALI2_L_PHY_EVT_START_ERROR);
         return;
     }
 
     //! Last start half-bit
-    __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_1;
-    dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_1);
+    __dali2_l_fw_pin_set(DALI2_L_BSP_DPIN_STATE_1);
 
     //! Going to forward frame
     __phy_handle.phy_state = DALI2_L_PHY_STATE_FORWARD_FRAME;
 
-    //! Start timer for finishing STOP condition
-    dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_HALF_BIT_TIME_US_MIN);
+    //! Start timer for the first data half-bit
+    __dali2_l_fw_timer_next(__dali2_l_fw_level(__phy_handle.half_bits_left));
 }
 
 static inline void __dali2_l_fw_frame(void)
@@ -69,8 +345,7 @@ static inline void __dali2_l_fw_frame(void)
 
     //! Verify expected PIN state
     if (dpin_state != __phy_handle.expected_dpin_state) {
-        __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-        __phy_handle.evt_func(DALI2_L_PHY_EVT_FORWARD_ERROR, &__phy_handle.ev_param);
+        __dali2_l_fw_collision(DALI2_L_PHY_EVT_FORWARD_ERROR);
         return;
     }
 
@@ -79,41 +354,20 @@ static inline void __dali2_l_fw_frame(void)
         //! Going stop condition
         __phy_handle.phy_state = DALI2_L_PHY_STATE_FORWARD_STOP;
 
-        __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_1;
-        dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_1);
-        dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_STOP_CONDITION_TIME_US);
+        __dali2_l_fw_pin_set(DALI2_L_BSP_DPIN_STATE_1);
+        __dali2_l_phy_timer_start_at(__phy_handle.tx_start_us +
+                                     __phy_handle.tx_half_bit * DALI2_L_PHY_HALF_BIT_TIME_US_TYP +
+                                     DALI2_L_PHY_STOP_CONDITION_TIME_US);
         return;
-    } else if (__phy_handle.half_bits_left % 2) {  //! Last Half-bits processing
-
-        if (__phy_handle.ev_param.forward.frame & (1 << (__phy_handle.half_bits_left / 2))) {
-            //! Logic 1
-            __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_1;
-            dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_1);
-        } else {
-            //! Logic 0
-            __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_0;
-            dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_0);
-        }
-    } else {    //! First Half-bits processing
-
-        if (__phy_handle.ev_param.forward.frame & (1 << (__phy_handle.half_bits_left / 2 - 1))) {
-            //! Logic 1
-            __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_0;
-            dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_0);
-        } else {
-            //! Logic 0
-            __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_1;
-            dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_1);
-        }
     }
 
+    __dali2_l_fw_pin_set(__dali2_l_fw_level(__phy_handle.half_bits_left));
+
     //! Decrement half-bit left
-    if (__phy_handle.half_bits_left) {
-        __phy_handle.half_bits_left--;
-    }
+    __phy_handle.half_bits_left--;
 
-    //! Start timer again
-    dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_HALF_BIT_TIME_US_TYP);
+    //! Start timer for the next half-bit
+    __dali2_l_fw_timer_next(__dali2_l_fw_level(__phy_handle.half_bits_left));
 }
 
 static inline void __dali2_l_fw_stop(void)
@@ -122,61 +376,94 @@ static inline void __dali2_l_fw_stop(void)
 
     //! Verify expected PIN state
     if (dpin_state != __phy_handle.expected_dpin_state) {
-        __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-        __phy_handle.evt_func(DALI2_L_PHY_EVT_STOP_ERROR, &__phy_handle.ev_param);
+        __dali2_l_fw_collision(DALI2_L_PHY_EVT_STOP_ERROR);
         return;
     }
 
     //! Here is Forward frame DONE
     __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-    __phy_handle.evt_func(DALI2_L_PHY_EVT_FORWARD_DONE, &__phy_handle.ev_param);
+    __dali2_l_phy_evt(DALI2_L_PHY_EVT_FORWARD_DONE);
 }
 
-static inline void __dali2_l_bw_start(void)
+static inline void __dali2_l_rx_start(void)
 {
-    //! Timing violation on Backward Start condition
+    //! Timing violation on Start condition
     __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-    __phy_handle.evt_func(DALI2_L_PHY_EVT_TIMING_VIOLATION, &__phy_handle.ev_param);
+    __dali2_l_phy_evt(DALI2_L_PHY_EVT_TIMING_VIOLATION);
+}
+
+//! Received half-bit, by edge or by timer when there is no edge on bit boundary
+static inline void __dali2_l_rx_half_bit(DALI2_L_BSP_DPIN_STATE_T level)
+{
+    if (__phy_handle.rx_half_bits % 2) {    //! Last half-bit
+        //! Edge in the middle of bit, "1" is rising edge, MSB is received first
+        __phy_handle.rx_frame = (__phy_handle.rx_frame << 1) | ((level == DALI2_L_BSP_DPIN_STATE_1) ? 1 : 0);
+    } else {    //! First half-bit
+        __phy_handle.expected_dpin_state = (level == DALI2_L_BSP_DPIN_STATE_0) ?
+                                           DALI2_L_BSP_DPIN_STATE_1 : DALI2_L_BSP_DPIN_STATE_0;
+    }
+
+    //! Too long frame is size violation anyway, count saturates keeping half-bit parity
+    if (++__phy_handle.rx_half_bits > DALI2_L_PHY_RX_BITS_MAX * 2) {
+        __phy_handle.rx_half_bits -= 2;
+    }
+
+    __dali2_l_phy_timer_start(DALI2_L_PHY_HALF_BIT_TIME_US_MAX);
 }
 
-static inline void __dali2_l_bw_frame(void)
+static inline void __dali2_l_rx_frame(void)
 {
     DALI2_L_BSP_DPIN_STATE_T dpin_state = dali2_l_bsp_rx_pin_get();
 
-    //! If no bits left
-    if (!__phy_handle.half_bits_left) {
-        //! Waiting for STOP condition
-        __phy_handle.phy_state = DALI2_L_PHY_STATE_BACKWARD_STOP;
-        __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_1;
-        dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_STOP_CONDITION_TIME_US);
+    //! No edge on bit boundary, the first half-bit keeps line level
+    if (!(__phy_handle.rx_half_bits % 2)) {
+        __dali2_l_rx_half_bit(dpin_state);
         return;
     }
 
-    //! Decrement half-bit left
-    if (--__phy_handle.half_bits_left) {
-        dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_HALF_BIT_TIME_US_MAX);
-    }
-
-    if (__phy_handle.half_bits_left % 2) {  //! First half-bit
-        if (dpin_state == DALI2_L_BSP_DPIN_STATE_0) {    //! "1" begins
-            __phy_handle.ev_param.backward.frame |= (1 << (__phy_handle.half_bits_left / 2));
-            __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_1;
-        } else {    //! "0" begins
-            __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_0;
-        }
-    } else {    //! Last half-bit
-        //! Timing violation on Backward Frame condition
-        __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-        __phy_handle.evt_func(DALI2_L_PHY_EVT_TIMING_VIOLATION, &__phy_handle.ev_param);
+    //! No edge in the middle of bit
+    if (dpin_state == DALI2_L_BSP_DPIN_STATE_1) {
+        //! Line is high for two half-bits, so that was stop condition, not "0"
+        __phy_handle.rx_half_bits--;
+
+        //! Waiting for the whole stop condition
+        __phy_handle.phy_state = DALI2_L_PHY_STATE_RX_STOP;
+        __dali2_l_phy_timer_start_at(__phy_handle.line_edge_us + DALI2_L_PHY_STOP_CONDITION_TIME_US);
         return;
     }
+
+    //! Timing violation on Frame condition, line is low too long
+    __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
+    __dali2_l_phy_evt(DALI2_L_PHY_EVT_TIMING_VIOLATION);
 }
 
-static inline void __dali2_l_bw_stop(void)
+static inline void __dali2_l_rx_stop(void)
 {
-    //! Here is Backward frame DONE
+    unsigned char bits = __phy_handle.rx_half_bits / 2;
+
+    //! Here is received frame DONE, it is classified by size
     __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-    __phy_handle.evt_func(DALI2_L_PHY_EVT_BACKWARD_DONE, &__phy_handle.ev_param);
+    __phy_handle.ev_param.received.frame = __phy_handle.rx_frame;
+    __phy_handle.ev_param.received.bits = bits;
+    __phy_handle.ev_param.received.start_us = __phy_handle.rx_start_us;
+    __phy_handle.ev_param.received.stop_us = __phy_handle.line_edge_us;
+
+    switch (bits) {
+        case DALI2_L_PHY_BACKWARD_8BIT_SIZE:
+            __phy_handle.ev_param.backward.frame = (unsigned char) __phy_handle.rx_frame;
+            __dali2_l_phy_evt(DALI2_L_PHY_EVT_BACKWARD_DONE);
+            break;
+
+        case DALI2_L_PHY_FORWARD_16BIT_SIZE:
+        case DALI2_L_PHY_FORWARD_24BIT_SIZE:
+            //! Forward frame of another master or input device
+            __dali2_l_phy_evt(DALI2_L_PHY_EVT_FORWARD_RECEIVED);
+            break;
+
+        default:
+            __dali2_l_phy_evt(DALI2_L_PHY_EVT_SIZE_VIOLATION);
+            break;
+    }
 }
 
 dali2_ret_t dali2_l_phy_init(dali2_l_phy_evt_func_t evt_handler)
@@ -198,14 +485,21 @@ dali2_ret_t dali2_l_phy_init(dali2_l_phy_evt_func_t evt_handler)
     //! Initialize internal structure
     __phy_handle.evt_func = evt_handler;
     __phy_handle.phy_state = DALI2_L_PHY_STATE_STARTUP;
+    __phy_handle.is_monitor = 0;
+    memset(&__phy_handle.stats, 0x00, sizeof(dali2_l_phy_stats_t));
+    __phy_handle.tx_level = DALI2_L_BSP_DPIN_STATE_1;
+    __phy_handle.tx_echo_q2[DALI2_L_BSP_DPIN_STATE_0] = 0;
+    __phy_handle.tx_echo_q2[DALI2_L_BSP_DPIN_STATE_1] = 0;
 
     //! Call BSP layer Initialization
     dali2_l_bsp_init();
+    dali2_l_phy_timing_reset();
+    __phy_handle.line_edge_us = dali2_l_bsp_time_us_get();
 
     //! Idle Data PIN state
     dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_1);
 
-    dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_STARTUP_TIME_US);
+    __dali2_l_phy_timer_start(DALI2_L_PHY_STARTUP_TIME_US);
 
 __ret:
     return dali2_ret;
@@ -241,6 +535,11 @@ dali2_ret_t dali2_l_phy_exec_frame(DALI2_L_PHY_FRAME_T frame_type, unsigned int
         dali2_ret = DALI2_RET_BUSY; goto __ret;
     }
 
+    //! Monitor never transmits
+    if (__phy_handle.is_monitor) {
+        dali2_ret = DALI2_RET_NOT_SUPPORTED; goto __ret;
+    }
+
     //! Verify Bus for Free
     if (dali2_l_bsp_rx_pin_get() != DALI2_L_BSP_DPIN_STATE_1) {
         dali2_ret = DALI2_RET_INTERNAL_ERROR; goto __ret;
@@ -248,10 +547,12 @@ dali2_ret_t dali2_l_phy_exec_frame(DALI2_L_PHY_FRAME_T frame_type, unsigned int
 
     switch (frame_type) {
         case DALI2_L_PHY_FRAME_16BIT_FW:
+            __phy_handle.tx_bits = DALI2_L_PHY_FORWARD_16BIT_SIZE;
             __phy_handle.half_bits_left = DALI2_L_PHY_FORWARD_16BIT_SIZE * 2;
             break;
 
         case DALI2_L_PHY_FRAME_24BIT_FW:
+            __phy_handle.tx_bits = DALI2_L_PHY_FORWARD_24BIT_SIZE;
             __phy_handle.half_bits_left = DALI2_L_PHY_FORWARD_24BIT_SIZE * 2;
             break;
 
@@ -261,14 +562,17 @@ dali2_ret_t dali2_l_phy_exec_frame(DALI2_L_PHY_FRAME_T frame_type, unsigned int
     }
 
     __phy_handle.ev_param.forward.frame = frame_data;
+    __dali2_l_phy_timing_gear_set(frame_type, frame_data);
 
     //! Going to start bit
     __phy_handle.phy_state = DALI2_L_PHY_STATE_FORWARD_START;
 
-    //! First start half-bit
-    __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_0;
-    dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_0);
-    dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_HALF_BIT_TIME_US_MIN);
+    //! First start half-bit, every next edge is scheduled from here
+    __phy_handle.tx_level = DALI2_L_BSP_DPIN_STATE_1;
+    __dali2_l_fw_pin_set(DALI2_L_BSP_DPIN_STATE_0);
+    __phy_handle.tx_start_us = __phy_handle.tx_edge_us;
+    __phy_handle.tx_half_bit = 0;
+    __dali2_l_fw_timer_next(DALI2_L_BSP_DPIN_STATE_1);
 
 __ret:
     return dali2_ret;
@@ -276,6 +580,8 @@ __ret:
 
 void dali2_l_phy_timer_cb_handler(void)
 {
+    __dali2_l_phy_timing_timer();
+
     switch (__phy_handle.phy_state) {
         case DALI2_L_PHY_STATE_STARTUP:
             //! Initialization done now
@@ -298,16 +604,24 @@ void dali2_l_phy_timer_cb_handler(void)
             __dali2_l_fw_stop();
             break;
 
-        case DALI2_L_PHY_STATE_BACKWARD_START:
-            __dali2_l_bw_start();
+        case DALI2_L_PHY_STATE_RX_START:
+            __dali2_l_rx_start();
             break;
 
-        case DALI2_L_PHY_STATE_BACKWARD_FRAME:
-            __dali2_l_bw_frame();
+        case DALI2_L_PHY_STATE_RX_FRAME:
+            __dali2_l_rx_frame();
             break;
 
-        case DALI2_L_PHY_STATE_BACKWARD_STOP:
-            __dali2_l_bw_stop();
+        case DALI2_L_PHY_STATE_RX_STOP:
+            __dali2_l_rx_stop();
+            break;
+
+        case DALI2_L_PHY_STATE_COLLISION_BREAK:
+            __dali2_l_fw_break_end();
+            break;
+
+        case DALI2_L_PHY_STATE_COLLISION_RECOVERY:
+            __dali2_l_fw_recovery_end();
             break;
 
         default:
@@ -320,87 +634,183 @@ void dali2_l_dpin_int_cb_handler(DALI2_L_BSP_DPIN_STATE_T state)
     //! Initialization undone!
     if (!__phy_handle.is_init) return;
 
+    __phy_handle.line_edge_us = dali2_l_bsp_time_us_get();
+    __dali2_l_phy_timing_edge();
+
     switch (__phy_handle.phy_state) {
         case DALI2_L_PHY_STATE_IDLE:
             if (state == DALI2_L_BSP_DPIN_STATE_0) {
 
-                //! First half-bit of Backward frame detected
-                __phy_handle.phy_state = DALI2_L_PHY_STATE_BACKWARD_START;
+                //! First half-bit of Start condition detected, frame size is not known yet
+                __phy_handle.phy_state = DALI2_L_PHY_STATE_RX_START;
+                __phy_handle.rx_start_us = __phy_handle.line_edge_us;
+                __phy_handle.rx_half_bits = 0;
+                __phy_handle.rx_frame = 0x00;
 
                 __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_1;
-                dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_HALF_BIT_TIME_US_MAX);
+                __dali2_l_phy_timer_start(DALI2_L_PHY_HALF_BIT_TIME_US_MAX);
             } else {
-                //! Data violation on Backward Start condition
+                //! Data violation on Start condition
                 __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-                __phy_handle.evt_func(DALI2_L_PHY_EVT_SIZE_VIOLATION, &__phy_handle.ev_param);
+                __phy_handle.rx_start_us = __phy_handle.line_edge_us;
+                __phy_handle.rx_half_bits = 0;
+                __dali2_l_phy_evt(DALI2_L_PHY_EVT_SIZE_VIOLATION);
             }
             break;
 
-        case DALI2_L_PHY_STATE_BACKWARD_START:
+        case DALI2_L_PHY_STATE_RX_START:
             if (state == __phy_handle.expected_dpin_state) {
 
-                //! Initialize Backward frame reception
-                __phy_handle.phy_state = DALI2_L_PHY_STATE_BACKWARD_FRAME;
-                __phy_handle.half_bits_left = DALI2_L_PHY_BACKWARD_8BIT_SIZE * 2;
-                __phy_handle.ev_param.backward.frame = 0x00;
+                //! Going to frame reception
+                __phy_handle.phy_state = DALI2_L_PHY_STATE_RX_FRAME;
 
-                //! Waiting for last half-bit of START condition yet
-                dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_HALF_BIT_TIME_US_MAX);
+                //! Waiting for the first data half-bit
+                __dali2_l_phy_timer_start(DALI2_L_PHY_HALF_BIT_TIME_US_MAX);
             } else {
-                //! Data violation on Backward Start condition
+                //! Data violation on Start condition
                 __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-                __phy_handle.evt_func(DALI2_L_PHY_EVT_DATA_VIOLATION, &__phy_handle.ev_param);
+                __dali2_l_phy_evt(DALI2_L_PHY_EVT_DATA_VIOLATION);
             }
             break;
 
-        case DALI2_L_PHY_STATE_BACKWARD_FRAME:
-            //! STOP If no bits left
-            if (!__phy_handle.half_bits_left) {
-                //! Waiting for STOP condition
-                __phy_handle.phy_state = DALI2_L_PHY_STATE_BACKWARD_STOP;
-                __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_1;
-                dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_STOP_CONDITION_TIME_US);
-                return;
-            }
-
-            //! Decrement half-bit left
-            if (--__phy_handle.half_bits_left) {
-                //! Start timer again
-                dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_HALF_BIT_TIME_US_MAX);
+        case DALI2_L_PHY_STATE_RX_FRAME:
+            //! Verify the middle of bit
+            if ((__phy_handle.rx_half_bits % 2) && state != __phy_handle.expected_dpin_state) {
+                __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
+                __dali2_l_phy_evt(DALI2_L_PHY_EVT_DATA_VIOLATION);
+                break;
             }
 
-            if (__phy_handle.half_bits_left % 2) {    //! First half-bit
-                if (state == DALI2_L_BSP_DPIN_STATE_0) {    //! "1" begins
-                    __phy_handle.ev_param.backward.frame |= (1 << (__phy_handle.half_bits_left / 2));
-                    __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_1;
-                } else {
-                    //! "0" begins
-                    __phy_handle.expected_dpin_state = DALI2_L_BSP_DPIN_STATE_0;
-                }
-            } else {  //! Last half-bit
-                //! Verify last half-bit
-                if (state != __phy_handle.expected_dpin_state) {
-                    __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-                    __phy_handle.evt_func(DALI2_L_PHY_EVT_DATA_VIOLATION, &__phy_handle.ev_param);
-                }
-            }
+            __dali2_l_rx_half_bit(state);
             break;
 
-        case DALI2_L_PHY_STATE_BACKWARD_STOP:
-            //! Data size violation on backward STOP condition
+        case DALI2_L_PHY_STATE_RX_STOP:
+            //! Data size violation on STOP condition
             if (__phy_handle.expected_dpin_state != state) {
                 __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
-                __phy_handle.evt_func(DALI2_L_PHY_EVT_SIZE_VIOLATION, &__phy_handle.ev_param);
+                __dali2_l_phy_evt(DALI2_L_PHY_EVT_SIZE_VIOLATION);
             }
             break;
 
         case DALI2_L_PHY_STATE_FORWARD_START:
         case DALI2_L_PHY_STATE_FORWARD_FRAME:
         case DALI2_L_PHY_STATE_FORWARD_STOP:
+            //! Line is pulled low by another transmitter while own TX is high
+            if (state == DALI2_L_BSP_DPIN_STATE_0 && __phy_handle.tx_level == DALI2_L_BSP_DPIN_STATE_1) {
+                __dali2_l_fw_collision((__phy_handle.phy_state == DALI2_L_PHY_STATE_FORWARD_STOP) ?
+                                       DALI2_L_PHY_EVT_STOP_ERROR : DALI2_L_PHY_EVT_FORWARD_ERROR);
+                break;
+            }
+
+            //! Own forward frame edge
+            __dali2_l_fw_echo(state);
+            break;
+
+        case DALI2_L_PHY_STATE_COLLISION_RECOVERY:
+            //! Line is busy, recovery time starts again
+            __dali2_l_phy_timer_start(DALI2_L_PHY_RECOVERY_TIME_US);
+            break;
+
         default:
             break;
     }
 }
 
+void dali2_l_phy_tap_set(dali2_l_phy_tap_func_t tap_func)
+{
+    __phy_handle.tap_func = tap_func;
+}
 
+dali2_ret_t dali2_l_phy_monitor_set(unsigned char is_on)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+
+    //! Own frame, break or recovery in progress
+    switch (__phy_handle.phy_state) {
+        case DALI2_L_PHY_STATE_FORWARD_START:
+        case DALI2_L_PHY_STATE_FORWARD_FRAME:
+        case DALI2_L_PHY_STATE_FORWARD_STOP:
+        case DALI2_L_PHY_STATE_COLLISION_BREAK:
+        case DALI2_L_PHY_STATE_COLLISION_RECOVERY:
+            dali2_ret = DALI2_RET_BUSY;
+            goto __ret;
+
+        default:
+            break;
+    }
+
+    __phy_handle.is_monitor = is_on ? 1 : 0;
+
+__ret:
+    return dali2_ret;
+}
+
+unsigned char dali2_l_phy_is_idle(void)
+{
+    return (__phy_handle.phy_state == DALI2_L_PHY_STATE_IDLE) ? 1 : 0;
+}
+
+unsigned char dali2_l_phy_resync(void)
+{
+    //! Startup is ended by its own timer
+    if (__phy_handle.phy_state == DALI2_L_PHY_STATE_IDLE || __phy_handle.phy_state == DALI2_L_PHY_STATE_STARTUP) {
+        return 0;
+    }
+
+    //! Release the line, late timer finds Idle state
+    __phy_handle.tx_level = DALI2_L_BSP_DPIN_STATE_1;
+    dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_1);
+    __phy_handle.phy_state = DALI2_L_PHY_STATE_IDLE;
+
+    return 1;
+}
 
+unsigned int dali2_l_phy_idle_us_get(void)
+{
+    //! Line is not idle during frame, break or recovery and while it is low
+    if (__phy_handle.phy_state != DALI2_L_PHY_STATE_IDLE ||
+        dali2_l_bsp_rx_pin_get() != DALI2_L_BSP_DPIN_STATE_1) {
+        return 0;
+    }
+
+    return dali2_l_bsp_time_us_get() - __phy_handle.line_edge_us;
+}
+
+void dali2_l_phy_stats_get(dali2_l_phy_stats_t *stats)
+{
+    memcpy(stats, &__phy_handle.stats, sizeof(dali2_l_phy_stats_t));
+}
+
+void dali2_l_phy_stats_reset(void)
+{
+    memset(&__phy_handle.stats, 0x00, sizeof(dali2_l_phy_stats_t));
+}
+
+dali2_ret_t dali2_l_phy_timing_get(dali2_l_phy_timing_t *timing)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+
+    //! Verify pointer
+    if (!timing) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+#ifdef DALI2_L_PHY_TIMING_EN
+    memcpy(timing, &__phy_handle.timing, sizeof(dali2_l_phy_timing_t));
+#else
+    dali2_ret = DALI2_RET_NOT_SUPPORTED;
+#endif
+
+__ret:
+    return dali2_ret;
+}
+
+void dali2_l_phy_timing_reset(void)
+{
+#ifdef DALI2_L_PHY_TIMING_EN
+    memset(&__phy_handle.timing, 0x00, sizeof(dali2_l_phy_timing_t));
+    __phy_handle.timing_gear = DALI2_L_PHY_TIMING_GEAR_OTHER;
+    __phy_handle.last_edge_us = dali2_l_bsp_time_us_get();
+#endif
+}
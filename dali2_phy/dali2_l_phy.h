@@ -22,6 +22,9 @@
 #define DALI2_L_PHY_FORWARD_24BIT_SIZE      24
 #define DALI2_L_PHY_BACKWARD_8BIT_SIZE      8
 
+//! Received frame is counted up to this size, longer frames are reported as this size
+#define DALI2_L_PHY_RX_BITS_MAX             64
+
 #define DALI2_L_PHY_ALLOWER_OVERHEAD_US             100     //! This overhead extended for practice case,
                                                             //! "DALI IEC 62386-101-2014" doesn't allowed this
 #define DALI2_L_PHY_HALF_BIT_TIME_US_MIN            366
@@ -32,6 +35,14 @@
 #define DALI2_L_PHY_DOUBLE_HALF_BIT_TIME_US_TYP     (DALI2_L_PHY_HALF_BIT_TIME_US_TYP * 2)
 #define DALI2_L_PHY_DOUBLE_HALF_BIT_TIME_US_MAX     (DALI2_L_PHY_HALF_BIT_TIME_US_MAX * 2)
 
+//! Forward frame edges are shifted earlier by difference of TX echo delays of rising and
+//! falling edges (slow rise or fall of the line), up to this limit
+#define DALI2_L_PHY_TX_CORRECTION_US_MAX        200
+
+//! Collision recovery, IEC 62386-101 break 1.2 - 1.4 ms and recovery time at least 4 ms
+#define DALI2_L_PHY_BREAK_TIME_US               1300
+#define DALI2_L_PHY_RECOVERY_TIME_US            4000
+
 #define DALI2_L_PHY_STARTUP_TIME_US             13000
 #define DALI2_L_PHY_STOP_CONDITION_TIME_US      2450
 
@@ -47,13 +58,16 @@ typedef enum {
 typedef enum {
     DALI2_L_PHY_EVT_FORWARD_DONE,
     DALI2_L_PHY_EVT_BACKWARD_DONE,
-    DALI2_L_PHY_EVT_START_ERROR,
-    DALI2_L_PHY_EVT_STOP_ERROR,
+    DALI2_L_PHY_EVT_START_ERROR,                //! Start, stop and forward errors are collisions,
+    DALI2_L_PHY_EVT_STOP_ERROR,                 //! they are reported after break and recovery time
     DALI2_L_PHY_EVT_FORWARD_ERROR,
     DALI2_L_PHY_EVT_BACKWARD_ERROR,
     DALI2_L_PHY_EVT_DATA_VIOLATION,
     DALI2_L_PHY_EVT_TIMING_VIOLATION,
-    DALI2_L_PHY_EVT_SIZE_VIOLATION
+    DALI2_L_PHY_EVT_SIZE_VIOLATION,
+    DALI2_L_PHY_EVT_FORWARD_RECEIVED,           //! 16 or 24 bit frame of another master or input device
+
+    DALI2_L_PHY_EVT_COUNT
 } DALI2_L_PHY_EVT_T;
 
 //! Event parameter for DALI2_L_PHY_EVT_FORWARD_DONE
@@ -66,12 +80,79 @@ typedef struct {
     unsigned char frame;
 } dali2_l_phy_evt_param_backward_t;
 
+//! Event parameter for DALI2_L_PHY_EVT_FORWARD_RECEIVED and DALI2_L_PHY_EVT_SIZE_VIOLATION
+//! of completely received frame
+typedef struct {
+    unsigned int frame;                         //! The last 32 bits, MSB is received first
+    unsigned char bits;                         //! Frame size, up to DALI2_L_PHY_RX_BITS_MAX
+    unsigned int start_us;                      //! The first edge of Start condition
+    unsigned int stop_us;                       //! The last edge of the frame
+} dali2_l_phy_evt_param_received_t;
+
 //! Event parameter union
 typedef union {
     dali2_l_phy_evt_param_forward_t forward;
     dali2_l_phy_evt_param_backward_t backward;
+    dali2_l_phy_evt_param_received_t received;
 } dali2_l_phy_evt_param_t;
 
+//! Physical layer statistics
+typedef struct {
+    unsigned int evt[DALI2_L_PHY_EVT_COUNT];    //! Events count, @see DALI2_L_PHY_EVT_T
+    unsigned int collisions;                    //! Forward frames stopped by break condition
+} dali2_l_phy_stats_t;
+
+//! Frame seen on the line, passed to tap of every event, @see dali2_l_phy_tap_set()
+typedef struct {
+    DALI2_L_PHY_EVT_T evt;
+    unsigned int frame;                         //! The last 32 bits, MSB is sent first
+    unsigned char bits;                         //! Received data bits or size of own forward frame
+    unsigned char is_own;                       //! Own forward frame, otherwise received frame
+    unsigned int start_us;                      //! The first edge of Start condition
+    unsigned int stop_us;                       //! The last edge seen before the event
+} dali2_l_phy_tap_t;
+
+/**@brief Physical layer tap function type
+ * @note  Called in interrupt context before event handler
+ *
+ * @param[IN] tap - frame of the event
+ */
+typedef void (* dali2_l_phy_tap_func_t) (const dali2_l_phy_tap_t *tap);
+
+//! Timing histograms, @see dali2_l_phy_timing_get()
+//! Bucket i counts values within [BASE + i * STEP, BASE + (i + 1) * STEP),
+//! the first and the last buckets count outliers too. Counters saturate.
+#define DALI2_L_PHY_HIST_SIZE                   16
+
+#define DALI2_L_PHY_HIST_TIMER_LATE_BASE_US     0       //! Timer callback later than scheduled
+#define DALI2_L_PHY_HIST_TIMER_LATE_STEP_US     8
+#define DALI2_L_PHY_HIST_HALF_BIT_BASE_US       300     //! Received half-bit width
+#define DALI2_L_PHY_HIST_HALF_BIT_STEP_US       16
+#define DALI2_L_PHY_HIST_DOUBLE_BASE_US         600     //! Received double half-bit width
+#define DALI2_L_PHY_HIST_DOUBLE_STEP_US         32
+#define DALI2_L_PHY_HIST_STOP_BASE_US           0       //! Idle line from the last edge up to the next frame
+#define DALI2_L_PHY_HIST_STOP_STEP_US           1000
+
+//! Gear with own backward frame histograms, gear is short address of the last forward frame.
+//! Broadcast, group, special commands and gear above the count go to the last entry.
+#ifndef DALI2_L_PHY_TIMING_GEAR_COUNT
+#define DALI2_L_PHY_TIMING_GEAR_COUNT           64
+#endif
+#define DALI2_L_PHY_TIMING_GEAR_OTHER           DALI2_L_PHY_TIMING_GEAR_COUNT
+
+typedef struct {
+    unsigned short bucket[DALI2_L_PHY_HIST_SIZE];
+} dali2_l_phy_hist_t;
+
+//! Physical layer timing
+typedef struct {
+    dali2_l_phy_hist_t timer_late;
+    unsigned int timer_late_max_us;
+    dali2_l_phy_hist_t stop;
+    dali2_l_phy_hist_t half_bit[DALI2_L_PHY_TIMING_GEAR_COUNT + 1];
+    dali2_l_phy_hist_t double_half_bit[DALI2_L_PHY_TIMING_GEAR_COUNT + 1];
+} dali2_l_phy_timing_t;
+
 //! @brief One-short Timer callback Handler
 //! @note Produced by dali2_l_bsp_phy_timer_start_us(()
 //! @attention Must have to be used!
@@ -103,4 +184,61 @@ dali2_ret_t dali2_l_phy_deinit(void);
  */
 dali2_ret_t dali2_l_phy_exec_frame(DALI2_L_PHY_FRAME_T frame_type, unsigned int frame_data);
 
+/**@brief Setting tap of every Physical layer event, bus monitor for example
+ * @note  Tap is kept over @ref dali2_l_phy_init()
+ *
+ * @param[IN] tap_func - tap function or NULL to remove it
+ */
+void dali2_l_phy_tap_set(dali2_l_phy_tap_func_t tap_func);
+
+/**@brief Monitor mode, Physical layer only receives and never transmits
+ *
+ * @param[IN] is_on - 1 to switch monitor mode on, 0 to switch it off
+ * @return DALI2_RET_SUCCESS or DALI2_RET_BUSY when own frame is in progress
+ */
+dali2_ret_t dali2_l_phy_monitor_set(unsigned char is_on);
+
+/**@brief Physical layer idle state
+ *
+ * @return 1 when no frame is transmitted or received, 0 otherwise
+ */
+unsigned char dali2_l_phy_is_idle(void);
+
+/**@brief Physical layer resynchronization after lost timer or edge interrupt
+ * @note  Frame in progress is dropped without event and the line is released
+ *
+ * @return 1 when frame was in progress, 0 otherwise
+ */
+unsigned char dali2_l_phy_resync(void);
+
+/**@brief Line idle time
+ * @note  Measured from the last edge seen by dali2_l_dpin_int_cb_handler(), so frames
+ *        of other masters are taken into account. Wraps after ~71 minutes of idle line,
+ *        which may only delay the next frame once.
+ *
+ * @return Microseconds since the last edge, 0 when line is low or frame is in progress
+ */
+unsigned int dali2_l_phy_idle_us_get(void);
+
+/**@brief Physical layer statistics
+ *
+ * @param[OUT] stats - events count since initialization or @ref dali2_l_phy_stats_reset()
+ */
+void dali2_l_phy_stats_get(dali2_l_phy_stats_t *stats);
+
+//! @brief Physical layer statistics reset
+void dali2_l_phy_stats_reset(void);
+
+/**@brief Physical layer timing histograms
+ * @note  Needs DALI2_L_PHY_TIMING_EN, see dali2_l_bsp.h.
+ *        Histograms are updated in interrupt context, copy is not atomic.
+ *
+ * @param[OUT] timing - histograms since initialization or @ref dali2_l_phy_timing_reset()
+ * @return DALI2_RET_SUCCESS or DALI2_RET_NOT_SUPPORTED when timing is disabled
+ */
+dali2_ret_t dali2_l_phy_timing_get(dali2_l_phy_timing_t *timing);
+
+//! @brief Physical layer timing histograms reset
+void dali2_l_phy_timing_reset(void);
+
 #endif /* DALI2_L_PHY_H_ */
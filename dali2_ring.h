@@ -0,0 +1,95 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_ring.h
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Lock-free ring positions header file
+ *
+ * @details Several producers, interrupts included, and single consumer share ring of
+ *          power of 2 slots. Producer reserves position by compare and swap of the head,
+ *          fills the slot and publishes it by slot stamp (position + 1). Consumer reads
+ *          published slot at the tail and releases it. Slot storage belongs to the ring
+ *          user, every slot begins with its volatile unsigned int stamp.
+ */
+
+#ifndef DALI2_RING_H_
+#define DALI2_RING_H_
+
+//! Slot index of ring position
+#define DALI2_RING_IDX(POS, SIZE)       ((POS) & ((SIZE) - 1))
+
+//! Ring positions
+typedef struct {
+    volatile unsigned int head;         //! Next position to reserve
+    volatile unsigned int tail;         //! Next position to consume
+    volatile unsigned int dropped;      //! Reservations failed on full ring
+} dali2_ring_t;
+
+/**@brief Reserving position
+ * @note  Lock-free, may be called from interrupt context and from several producers
+ *
+ * @param[IN] ring - ring positions
+ * @param[IN] size - slots count, power of 2
+ * @param[OUT] head - reserved position
+ * @return 1 if reserved, 0 if ring is full and the drop is counted
+ */
+static inline unsigned char dali2_ring_reserve(dali2_ring_t *ring, unsigned int size, unsigned int *head)
+{
+    *head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    do {
+        if ((*head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE)) >= size) {
+            __atomic_fetch_add(&ring->dropped, 1, __ATOMIC_RELAXED);
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&ring->head, head, *head + 1, 1,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    return 1;
+}
+
+/**@brief Publishing filled slot, reserved slot is always published
+ *
+ * @param[IN] stamp - stamp of the slot
+ * @param[IN] head - reserved position
+ */
+static inline void dali2_ring_publish(volatile unsigned int *stamp, unsigned int head)
+{
+    __atomic_store_n(stamp, head + 1, __ATOMIC_RELEASE);
+}
+
+/**@brief Getting position to consume, consumer only
+ */
+static inline unsigned int dali2_ring_tail_get(dali2_ring_t *ring)
+{
+    return __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+}
+
+/**@brief Checking the slot of tail position is published
+ *
+ * @param[IN] stamp - stamp of the slot
+ * @param[IN] tail - position to consume
+ * @return 1 if slot may be read
+ */
+static inline unsigned char dali2_ring_is_published(volatile unsigned int *stamp, unsigned int tail)
+{
+    return (__atomic_load_n(stamp, __ATOMIC_ACQUIRE) == tail + 1) ? 1 : 0;
+}
+
+/**@brief Freeing read slot for producers, consumer only
+ */
+static inline void dali2_ring_release(dali2_ring_t *ring, unsigned int tail)
+{
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/**@brief Getting count of dropped reservations
+ */
+static inline unsigned int dali2_ring_dropped_get(dali2_ring_t *ring)
+{
+    return __atomic_load_n(&ring->dropped, __ATOMIC_RELAXED);
+}
+
+#endif /* DALI2_RING_H_ */
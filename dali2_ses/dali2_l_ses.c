@@ -9,32 +9,212 @@
  *          Session layer source file
  */
 
+#include <string.h>
+
 #include "dali2_l_ses.h"
+#include "dali2_metrics.h"
 
 typedef enum {
     DALI2_L_SES_STATE_RDY,
     DALI2_L_SES_STATE_PROGRESS,
-    DALI2_L_SES_STATE_SETTLING_TIME
+    DALI2_L_SES_STATE_SETTLING_TIME,
+    DALI2_L_SES_STATE_BACKOFF,
+    DALI2_L_SES_STATE_PRIORITY_WAIT
 } DALI2_L_SES_STATE_T;
 
+//! Priority settling window
+typedef struct {
+    unsigned short min_us;
+    unsigned short max_us;
+} dali2_l_ses_settling_t;
+
+static const dali2_l_ses_settling_t __ses_settling[] = {
+    [DALI2_L_SES_PRIORITY_1] = { DALI2_L_SES_PRIORITY_1_US_MIN, DALI2_L_SES_PRIORITY_1_US_MAX },
+    [DALI2_L_SES_PRIORITY_2] = { DALI2_L_SES_PRIORITY_2_US_MIN, DALI2_L_SES_PRIORITY_2_US_MAX },
+    [DALI2_L_SES_PRIORITY_3] = { DALI2_L_SES_PRIORITY_3_US_MIN, DALI2_L_SES_PRIORITY_3_US_MAX },
+    [DALI2_L_SES_PRIORITY_4] = { DALI2_L_SES_PRIORITY_4_US_MIN, DALI2_L_SES_PRIORITY_4_US_MAX },
+    [DALI2_L_SES_PRIORITY_5] = { DALI2_L_SES_PRIORITY_5_US_MIN, DALI2_L_SES_PRIORITY_5_US_MAX },
+};
+
 //! Internal handle type
 typedef struct {
     DALI2_L_SES_STATE_T ses_state;
 
     DALI2_L_PHY_FRAME_T phy_frame_type;
+    unsigned int phy_frame_data;
     dali2_l_ses_evt_func_t evt_func;
     dali2_l_ses_evt_param_t ev_param;
+    dali2_l_ses_tap_func_t tap_func;
+
+    //! Multi-master line access
+    DALI2_L_SES_PRIORITY_T priority;
+    unsigned int settling_us;
+
+    //! Collision retransmission
+    unsigned char retries;
+    unsigned int rand_state;
+    dali2_l_ses_stats_t stats;
 
     unsigned char is_init:1;
     unsigned char send_twice:1;
+    unsigned char is_monitor:1;
 } dali2_l_ses_handle_t;
 
 static dali2_l_ses_handle_t __ses_handle;
 
+static unsigned int __dali2_l_ses_rand(void)
+{
+    //! Collision time differs between masters, it is mixed into generator
+    __ses_handle.rand_state ^= dali2_l_bsp_time_us_get();
+    __ses_handle.rand_state ^= __ses_handle.rand_state << 13;
+    __ses_handle.rand_state ^= __ses_handle.rand_state >> 17;
+    __ses_handle.rand_state ^= __ses_handle.rand_state << 5;
+    return __ses_handle.rand_state;
+}
+
+static inline unsigned int __dali2_l_ses_backoff_ms(void)
+{
+    //! Random window doubles on every retry, lower priority waits longer
+    return DALI2_L_SES_BACKOFF_MS_MIN + (__ses_handle.priority - 1) * DALI2_L_SES_BACKOFF_PRIORITY_MS +
+           __dali2_l_ses_rand() % (DALI2_L_SES_BACKOFF_WINDOW_MS << (__ses_handle.retries - 1));
+}
+
+static dali2_ret_t __dali2_l_ses_transmit(void)
+{
+    unsigned int idle_us = dali2_l_phy_idle_us_get();
+
+    //! Wait for the rest of settling time, line is checked again after it
+    if (idle_us < __ses_handle.settling_us) {
+        __ses_handle.stats.deferred++;
+        __ses_handle.ses_state = DALI2_L_SES_STATE_PRIORITY_WAIT;
+        dali2_l_bsp_ses_timer_start_us(__ses_handle.settling_us - idle_us);
+        return DALI2_RET_SUCCESS;
+    }
+
+    __ses_handle.ses_state = DALI2_L_SES_STATE_PROGRESS;
+    return dali2_l_phy_exec_frame(__ses_handle.phy_frame_type, __ses_handle.phy_frame_data);
+}
+
+static inline void __dali2_l_ses_ready(void)
+{
+    if (__ses_handle.ses_state != DALI2_L_SES_STATE_RDY) {
+        DALI2_METRICS_BUS_READY();
+    }
+    __ses_handle.ses_state = DALI2_L_SES_STATE_RDY;
+}
+
+static void __dali2_l_ses_collision(void)
+{
+    __ses_handle.stats.collisions++;
+
+    //! Retransmit after backoff
+    if (__ses_handle.retries < DALI2_L_SES_COLLISION_RETRY_MAX) {
+        __ses_handle.retries++;
+        __ses_handle.stats.retransmits++;
+        __ses_handle.ses_state = DALI2_L_SES_STATE_BACKOFF;
+
+        //! Send twice starts from the first frame again
+        if (__ses_handle.ev_param.msg == DALI2_L_SES_SEND_TWICE) {
+            __ses_handle.send_twice = 1;
+        }
+
+        dali2_l_bsp_ses_timer_start_ms(__dali2_l_ses_backoff_ms());
+        return;
+    }
+
+    //! Give up
+    __ses_handle.stats.dropped++;
+    DALI2_METRICS_CMD_INC(collision);
+    DALI2_METRICS_BUS_DONE();
+    __ses_handle.evt_func(DALI2_L_SES_EVT_COLLISION, &__ses_handle.ev_param);
+    __dali2_l_ses_ready();
+}
+
+static inline void __dali2_l_ses_forward_done(void)
+{
+    __ses_handle.stats.sent++;
+    if (__ses_handle.retries) {
+        __ses_handle.stats.recovered++;
+    }
+}
+
+static void __dali2_l_ses_tap_own(unsigned char is_answer, unsigned char backward)
+{
+    dali2_l_ses_tap_t tap;
+
+    if (!__ses_handle.tap_func) {
+        return;
+    }
+
+    tap.forward = __ses_handle.phy_frame_data;
+    tap.bits = (__ses_handle.phy_frame_type == DALI2_L_PHY_FRAME_24BIT_FW) ?
+               DALI2_L_PHY_FORWARD_24BIT_SIZE : DALI2_L_PHY_FORWARD_16BIT_SIZE;
+    tap.is_own = 1;
+    tap.is_query = (__ses_handle.ev_param.msg == DALI2_L_SES_QUERY) ? 1 : 0;
+    tap.is_answer = is_answer;
+    tap.backward = backward;
+    __ses_handle.tap_func(&tap);
+}
+
+static void __dali2_l_ses_tap_foreign(dali2_l_phy_evt_param_received_t *received)
+{
+    dali2_l_ses_tap_t tap;
+
+    if (!__ses_handle.tap_func) {
+        return;
+    }
+
+    tap.forward = received->frame;
+    tap.bits = received->bits;
+    tap.is_own = 0;
+    tap.is_query = 0;
+    tap.is_answer = 0;
+    tap.backward = 0;
+    __ses_handle.tap_func(&tap);
+}
+
+//! Backward frame ends own transaction: query waiting for answer, own frame on the line or query settling
+static inline unsigned char __dali2_l_ses_is_backward_own(void)
+{
+    return (__ses_handle.ses_state == DALI2_L_SES_STATE_PROGRESS ||
+            (__ses_handle.ses_state == DALI2_L_SES_STATE_SETTLING_TIME &&
+             __ses_handle.ev_param.msg == DALI2_L_SES_QUERY)) ? 1 : 0;
+}
+
+static void __dali2_l_ses_backward_foreign(void)
+{
+    unsigned int idle_us;
+
+    DALI2_METRICS_CMD_INC(unexpected);
+
+    //! Pending transmission keeps its transaction, settling time starts again from the last edge.
+    //! Backoff is checked by settling time when it expires.
+    if (__ses_handle.ses_state == DALI2_L_SES_STATE_PRIORITY_WAIT) {
+        idle_us = dali2_l_phy_idle_us_get();
+        if (idle_us < __ses_handle.settling_us) {
+            dali2_l_bsp_ses_timer_start_us(__ses_handle.settling_us - idle_us);
+        }
+    }
+}
+
 static void __dali2_l_ses_phy_evt_handler(DALI2_L_PHY_EVT_T evt, dali2_l_phy_evt_param_t *param)
 {
+    //! Frame of another master is not an answer, own transaction goes on.
+    //! It is delivered in monitor mode too.
+    if (evt == DALI2_L_PHY_EVT_FORWARD_RECEIVED) {
+        __ses_handle.stats.foreign++;
+        __dali2_l_ses_tap_foreign(&param->received);
+        return;
+    }
+
+    //! Monitor has no transaction, frames are seen by Physical layer tap only
+    if (__ses_handle.is_monitor) {
+        return;
+    }
+
     switch (evt) {
         case DALI2_L_PHY_EVT_FORWARD_DONE:
+            DALI2_METRICS_CMD_INC(fw_frames);
             switch (__ses_handle.ev_param.msg) {
                 case DALI2_L_SES_SEND_TWICE:
                     if (__ses_handle.send_twice) {
@@ -46,13 +226,17 @@ static void __dali2_l_ses_phy_evt_handler(DALI2_L_PHY_EVT_T evt, dali2_l_phy_evt
                 case DALI2_L_SES_SEND:
                     //! Here is DONE forward frame sending
                     //! Waiting Settling time for session ready state again
+                    __dali2_l_ses_forward_done();
                     __ses_handle.ses_state = DALI2_L_SES_STATE_SETTLING_TIME;
+                    DALI2_METRICS_BUS_DONE();
                     dali2_l_bsp_ses_timer_start_ms(DALI2_L_SES_SETTLING_TIME_FW_FW_MS_MAX);
+                    __dali2_l_ses_tap_own(0, 0);
                     __ses_handle.evt_func(DALI2_L_SES_EVT_DONE, &__ses_handle.ev_param);
                     break;
 
                 case DALI2_L_SES_QUERY:
                     //! Start timeout for response
+                    __dali2_l_ses_forward_done();
                     dali2_l_bsp_ses_timer_start_ms(DALI2_L_SES_SETTLING_TIME_FW_BW_MS_MAX);
                     break;
 
@@ -62,16 +246,31 @@ static void __dali2_l_ses_phy_evt_handler(DALI2_L_PHY_EVT_T evt, dali2_l_phy_evt
             break;
 
         case DALI2_L_PHY_EVT_BACKWARD_DONE:
+            //! Answer to another master or frame of another device on idle line
+            if (!__dali2_l_ses_is_backward_own()) {
+                __dali2_l_ses_backward_foreign();
+                break;
+            }
+
+            //! Answer of own query, not of query of another master
+            if (__ses_handle.ses_state == DALI2_L_SES_STATE_PROGRESS &&
+                __ses_handle.ev_param.msg == DALI2_L_SES_QUERY) {
+                __dali2_l_ses_tap_own(1, param->backward.frame);
+            }
+
             //! Waiting Settling time for session ready state again
             __ses_handle.ses_state = DALI2_L_SES_STATE_SETTLING_TIME;
+            DALI2_METRICS_BUS_DONE();
             dali2_l_bsp_ses_timer_start_ms(DALI2_L_SES_SETTLING_TIME_FW_FW_MS_MAX);
 
             if (__ses_handle.ev_param.msg == DALI2_L_SES_QUERY) {
                 //! Here is backward Done
+                DALI2_METRICS_CMD_INC(bw_frames);
                 __ses_handle.ev_param.msg_data = param->backward.frame;
                 __ses_handle.evt_func(DALI2_L_SES_EVT_DONE, &__ses_handle.ev_param);
             } else {
                 //! Received unexpected frame
+                DALI2_METRICS_CMD_INC(unexpected);
                 __ses_handle.ev_param.msg_data = param->backward.frame;
                 __ses_handle.evt_func(DALI2_L_SES_EVT_DONE, &__ses_handle.ev_param);
             }
@@ -80,20 +279,27 @@ static void __dali2_l_ses_phy_evt_handler(DALI2_L_PHY_EVT_T evt, dali2_l_phy_evt
         case DALI2_L_PHY_EVT_START_ERROR:
         case DALI2_L_PHY_EVT_STOP_ERROR:
         case DALI2_L_PHY_EVT_FORWARD_ERROR:
-            //! Data collision detected
-            //! TODO: Here may be Collision Recovery timeout
-            __ses_handle.evt_func(DALI2_L_SES_EVT_COLLISION, &__ses_handle.ev_param);
-            __ses_handle.ses_state = DALI2_L_SES_STATE_RDY;
+            //! Data collision detected, Physical layer has done break and recovery time
+            if (__ses_handle.ses_state == DALI2_L_SES_STATE_PROGRESS) {
+                __dali2_l_ses_collision();
+            }
             break;
 
         case DALI2_L_PHY_EVT_BACKWARD_ERROR:
         case DALI2_L_PHY_EVT_DATA_VIOLATION:
         case DALI2_L_PHY_EVT_TIMING_VIOLATION:
         case DALI2_L_PHY_EVT_SIZE_VIOLATION:
+            if (!__dali2_l_ses_is_backward_own()) {
+                __dali2_l_ses_backward_foreign();
+                break;
+            }
+
             //! Here is undone backward frame or some collision during
+            DALI2_METRICS_CMD_INC(unexpected);
+            DALI2_METRICS_BUS_DONE();
             __ses_handle.ev_param.msg_data = param->backward.frame;
             __ses_handle.evt_func(DALI2_L_SES_EVT_UNEXPECTED_FRAME, &__ses_handle.ev_param);
-            __ses_handle.ses_state = DALI2_L_SES_STATE_RDY;
+            __dali2_l_ses_ready();
             break;
 
         default:
@@ -116,31 +322,44 @@ void dali2_l_ses_timer_cb_handler(void)
         return;
     }
 
+    //! Transmission after settling time or retransmission after collision
+    if (__ses_handle.ses_state == DALI2_L_SES_STATE_PRIORITY_WAIT ||
+        __ses_handle.ses_state == DALI2_L_SES_STATE_BACKOFF) {
+        dali2_ret = __dali2_l_ses_transmit();
+        if (dali2_ret != DALI2_RET_SUCCESS) {
+            //! Line is busy by another master
+            __dali2_l_ses_collision();
+        }
+        return;
+    }
+
     switch (__ses_handle.ev_param.msg) {
         case DALI2_L_SES_SEND_TWICE:
             if (__ses_handle.send_twice) {
                 //! Send Forward frame second time
-                dali2_ret = dali2_l_phy_exec_frame(__ses_handle.phy_frame_type, __ses_handle.ev_param.msg_data);
+                __ses_handle.send_twice = 0;
+                dali2_ret = dali2_l_phy_exec_frame(__ses_handle.phy_frame_type, __ses_handle.phy_frame_data);
                 if (dali2_ret != DALI2_RET_SUCCESS) {
-                    __ses_handle.evt_func(DALI2_L_SES_EVT_COLLISION, &__ses_handle.ev_param);
-                    __ses_handle.ses_state = DALI2_L_SES_STATE_RDY;
+                    __dali2_l_ses_collision();
                 }
-                __ses_handle.send_twice = 0;
                 break;
             } //! Else Continue to the next case
 
         case DALI2_L_SES_SEND:
             //! This must be settling time, well just go to Ready state
-            __ses_handle.ses_state = DALI2_L_SES_STATE_RDY;
+            __dali2_l_ses_ready();
             break;
 
         case DALI2_L_SES_QUERY:
             if (__ses_handle.ses_state == DALI2_L_SES_STATE_PROGRESS) {
                 //! Timeout occur on waiting for Backward frame
                 //! Going Ready state immediately
+                DALI2_METRICS_CMD_INC(timeout);
+                DALI2_METRICS_BUS_DONE();
+                __dali2_l_ses_tap_own(0, 0);
                 __ses_handle.evt_func(DALI2_L_SES_EVT_TIMEOUT, &__ses_handle.ev_param);
             }
-            __ses_handle.ses_state = DALI2_L_SES_STATE_RDY;
+            __dali2_l_ses_ready();
             break;
 
         default:
@@ -166,6 +385,9 @@ dali2_ret_t dali2_l_ses_init(dali2_l_ses_evt_func_t evt_handler)
 
     //! Secure session handler
     __ses_handle.evt_func = evt_handler;
+    __ses_handle.is_monitor = 0;
+    memset(&__ses_handle.stats, 0x00, sizeof(dali2_l_ses_stats_t));
+    __ses_handle.rand_state = dali2_l_bsp_time_us_get() | 1;
 
     //! Physical layer initialization
     dali2_ret = dali2_l_phy_init(__dali2_l_ses_phy_evt_handler);
@@ -199,7 +421,8 @@ __ret:
     return dali2_ret;
 }
 
-dali2_ret_t dali2_l_ses_exec(DALI2_L_SES_MSG_T msg, DALI2_L_PHY_FRAME_T frame_type, unsigned int frame_data)
+dali2_ret_t dali2_l_ses_exec(DALI2_L_SES_MSG_T msg, DALI2_L_SES_PRIORITY_T priority,
+                             DALI2_L_PHY_FRAME_T frame_type, unsigned int frame_data)
 {
     dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
 
@@ -215,6 +438,12 @@ dali2_ret_t dali2_l_ses_exec(DALI2_L_SES_MSG_T msg, DALI2_L_PHY_FRAME_T frame_ty
         goto __ret;
     }
 
+    //! Monitor never transmits
+    if (__ses_handle.is_monitor) {
+        dali2_ret = DALI2_RET_NOT_SUPPORTED;
+        goto __ret;
+    }
+
     switch (msg) {
         case DALI2_L_SES_SEND:
             __ses_handle.send_twice = 0;
@@ -232,13 +461,98 @@ dali2_ret_t dali2_l_ses_exec(DALI2_L_SES_MSG_T msg, DALI2_L_PHY_FRAME_T frame_ty
             goto __ret;
     }
 
-    //! Execute backward frame on physical layer
-    dali2_ret = dali2_l_phy_exec_frame(frame_type, frame_data);
+    //! Verify priority
+    if (!DALI2_L_SES_PRIORITY_IS_VALID(priority)) {
+        dali2_ret = DALI2_RET_INVALID_PARAMS;
+        goto __ret;
+    }
+
+    __ses_handle.phy_frame_type = frame_type;
+    __ses_handle.phy_frame_data = frame_data;
+    __ses_handle.retries = 0;
+
+    //! Random point of settling window separates masters of the same priority
+    __ses_handle.priority = priority;
+    __ses_handle.settling_us = __ses_settling[priority].min_us +
+        __dali2_l_ses_rand() % (__ses_settling[priority].max_us - __ses_settling[priority].min_us + 1);
+
+    __ses_handle.ev_param.msg = msg;
+    __ses_handle.ev_param.msg_data = frame_data;
+
+    //! Execute forward frame on physical layer, now or after settling time
+    dali2_ret = __dali2_l_ses_transmit();
+    if (dali2_ret == DALI2_RET_SUCCESS) {
+        DALI2_METRICS_BUS_START();
+    } else {
+        __ses_handle.ses_state = DALI2_L_SES_STATE_RDY;
+    }
+
+__ret:
+    return dali2_ret;
+}
+
+unsigned char dali2_l_ses_resync(void)
+{
+    unsigned char busy = 0;
+
+    //! Verify initialization
+    if (!__ses_handle.is_init) {
+        return busy;
+    }
+
+    if (dali2_l_phy_resync()) {
+        busy |= DALI2_L_SES_RESYNC_PHY;
+    }
+
+    if (__ses_handle.ses_state != DALI2_L_SES_STATE_RDY) {
+        busy |= DALI2_L_SES_RESYNC_SES;
+        __ses_handle.stats.resyncs++;
+        __ses_handle.send_twice = 0;
+        if (__ses_handle.ses_state != DALI2_L_SES_STATE_SETTLING_TIME) {
+            DALI2_METRICS_BUS_DONE();
+        }
+
+        //! Late timer finds Ready state
+        __dali2_l_ses_ready();
+    }
+
+    return busy;
+}
+
+void dali2_l_ses_stats_get(dali2_l_ses_stats_t *stats)
+{
+    memcpy(stats, &__ses_handle.stats, sizeof(dali2_l_ses_stats_t));
+}
+
+void dali2_l_ses_stats_reset(void)
+{
+    memset(&__ses_handle.stats, 0x00, sizeof(dali2_l_ses_stats_t));
+}
+
+void dali2_l_ses_tap_set(dali2_l_ses_tap_func_t tap_func)
+{
+    __ses_handle.tap_func = tap_func;
+}
+
+dali2_ret_t dali2_l_ses_monitor_set(unsigned char is_on)
+{
+    dali2_ret_t dali2_ret = DALI2_RET_SUCCESS;
+
+    //! Verify initialization
+    if (!__ses_handle.is_init) {
+        dali2_ret = DALI2_RET_INTERNAL_ERROR;
+        goto __ret;
+    }
+
+    //! Own transaction is completed first
+    if (__ses_handle.ses_state != DALI2_L_SES_STATE_RDY) {
+        dali2_ret = DALI2_RET_BUSY;
+        goto __ret;
+    }
+
+    dali2_ret = dali2_l_phy_monitor_set(is_on);
     if (dali2_ret == DALI2_RET_SUCCESS) {
-        __ses_handle.phy_frame_type = frame_type;
-        __ses_handle.ev_param.msg = msg;
-        __ses_handle.ev_param.msg_data = frame_data;
-        __ses_handle.ses_state = DALI2_L_SES_STATE_PROGRESS;
+        __ses_handle.is_monitor = is_on ? 1 : 0;
     }
 
 __ret:
@@ -28,6 +28,38 @@
 #define DALI2_L_SES_SETTLING_TIME_FW_FW_MS_MAX          3
 #define DALI2_L_SES_SETTLING_TIME_FW_FW_TWICE_MS_MAX    94
 
+//! Collision retransmission, backoff is
+//! MIN + (priority - 1) * PRIORITY + random(WINDOW * 2^(retry - 1)) milliseconds
+#define DALI2_L_SES_COLLISION_RETRY_MAX         3
+#define DALI2_L_SES_BACKOFF_MS_MIN              2
+#define DALI2_L_SES_BACKOFF_PRIORITY_MS         2
+#define DALI2_L_SES_BACKOFF_WINDOW_MS           8
+
+//! Multi-master settling time before a new transaction per priority,
+//! "DALI IEC 62386-101-2014" Table 22. Line must be idle this long before transmission
+#define DALI2_L_SES_PRIORITY_1_US_MIN           13500
+#define DALI2_L_SES_PRIORITY_1_US_MAX           14700
+#define DALI2_L_SES_PRIORITY_2_US_MIN           14900
+#define DALI2_L_SES_PRIORITY_2_US_MAX           16100
+#define DALI2_L_SES_PRIORITY_3_US_MIN           16300
+#define DALI2_L_SES_PRIORITY_3_US_MAX           17700
+#define DALI2_L_SES_PRIORITY_4_US_MIN           17900
+#define DALI2_L_SES_PRIORITY_4_US_MAX           19300
+#define DALI2_L_SES_PRIORITY_5_US_MIN           19500
+#define DALI2_L_SES_PRIORITY_5_US_MAX           21100
+
+//! Transaction priority, the lower value wins the line
+typedef enum {
+    DALI2_L_SES_PRIORITY_1 = 1,         //! Highest, reserved for urgent instructions
+    DALI2_L_SES_PRIORITY_2,             //! User instructions, e.g. push button
+    DALI2_L_SES_PRIORITY_3,             //! Configuration
+    DALI2_L_SES_PRIORITY_4,             //! Automatic instructions, e.g. sensors
+    DALI2_L_SES_PRIORITY_5              //! Lowest, periodic queries
+} DALI2_L_SES_PRIORITY_T;
+
+#define DALI2_L_SES_PRIORITY_DEFAULT            DALI2_L_SES_PRIORITY_2
+#define DALI2_L_SES_PRIORITY_IS_VALID(P)        ((P) >= DALI2_L_SES_PRIORITY_1 && (P) <= DALI2_L_SES_PRIORITY_5)
+
 typedef enum {
     DALI2_L_SES_SEND,
     DALI2_L_SES_SEND_TWICE,
@@ -46,8 +78,37 @@ typedef struct {
     unsigned int msg_data;
 } dali2_l_ses_evt_param_t;
 
+//! Session layer statistics
+typedef struct {
+    unsigned int sent;                  //! Forward frames done, the last one of send twice
+    unsigned int collisions;            //! Collisions of own forward frames
+    unsigned int retransmits;           //! Retransmissions after backoff
+    unsigned int recovered;             //! Frames done after retransmission
+    unsigned int dropped;               //! Frames given up after DALI2_L_SES_COLLISION_RETRY_MAX
+    unsigned int deferred;              //! Transmissions delayed by priority settling time
+    unsigned int foreign;               //! Forward frames of other masters and input devices
+    unsigned int resyncs;               //! Transactions dropped by dali2_l_ses_resync()
+} dali2_l_ses_stats_t;
+
 typedef void (* dali2_l_ses_evt_func_t) (DALI2_L_SES_EVT_T evt, dali2_l_ses_evt_param_t *params);
 
+//! Forward frame delivered on the line, passed to tap, @see dali2_l_ses_tap_set()
+typedef struct {
+    unsigned int forward;               //! Forward frame
+    unsigned char bits;                 //! Forward frame size
+    unsigned char is_own;               //! Own frame, otherwise frame of another master or input device
+    unsigned char is_query;             //! Own query, backward frame is valid when is_answer is set
+    unsigned char is_answer;            //! Backward frame received, otherwise NO answer
+    unsigned char backward;
+} dali2_l_ses_tap_t;
+
+/**@brief Session layer tap function type
+ * @note  Called in interrupt context
+ *
+ * @param[IN] tap - delivered frame
+ */
+typedef void (* dali2_l_ses_tap_func_t) (const dali2_l_ses_tap_t *tap);
+
 //! @brief One-short Timer callback Handler
 //! @note Produced by dali2_l_bsp_ses_timer_start_ms(()
 //! @attention Must have to be used!
@@ -67,12 +128,54 @@ dali2_ret_t dali2_l_ses_init(dali2_l_ses_evt_func_t evt_handler);
 dali2_ret_t dali2_l_ses_deinit(void);
 
 /**@brief DALI2 Session execution
+ * @note  Transmission starts after line is idle for random time of priority settling window,
+ *        the first frame may be delayed up to DALI2_L_SES_PRIORITY_5_US_MAX
  *
  * @param[IN] msg - session message type, @see DALI2_L_SES_MSG_T
+ * @param[IN] priority - transaction priority, @see DALI2_L_SES_PRIORITY_T
  * @param[IN] frame_type - Physical layer data frame type, @see DALI2_L_PHY_FRAME_T
  * @param[IN] frame_data - Physical layer data frame
  * @return @see dali2_ret_t
  */
-dali2_ret_t dali2_l_ses_exec(DALI2_L_SES_MSG_T msg, DALI2_L_PHY_FRAME_T frame_type, unsigned int frame_data);
+dali2_ret_t dali2_l_ses_exec(DALI2_L_SES_MSG_T msg, DALI2_L_SES_PRIORITY_T priority,
+                             DALI2_L_PHY_FRAME_T frame_type, unsigned int frame_data);
+
+//! Layers found busy by resynchronization
+#define DALI2_L_SES_RESYNC_PHY                  0x01
+#define DALI2_L_SES_RESYNC_SES                  0x02
+
+/**@brief DALI2 Session layer resynchronization after lost completion
+ * @note  Transaction in progress is dropped without event, Physical layer is resynchronized too
+ *
+ * @return DALI2_L_SES_RESYNC_* flags of layers which were busy
+ */
+unsigned char dali2_l_ses_resync(void);
+
+/**@brief Setting tap of delivered forward frames: own frames when they are done (the second
+ *        one of send twice), own queries with answer or after timeout and forward frames
+ *        of other masters. Frames stopped by collision are not delivered.
+ * @note  Tap is kept over @ref dali2_l_ses_init()
+ *
+ * @param[IN] tap_func - tap function or NULL to remove it
+ */
+void dali2_l_ses_tap_set(dali2_l_ses_tap_func_t tap_func);
+
+/**@brief Bus monitor mode, nothing is transmitted and @ref dali2_l_ses_exec() returns
+ *        DALI2_RET_NOT_SUPPORTED. Frames on the line are seen by Physical layer tap,
+ *        @see dali2_l_phy_tap_set() and dali2_mon.h
+ *
+ * @param[IN] is_on - 1 to switch monitor mode on, 0 to switch it off
+ * @return DALI2_RET_SUCCESS or DALI2_RET_BUSY when transaction is in progress
+ */
+dali2_ret_t dali2_l_ses_monitor_set(unsigned char is_on);
+
+/**@brief Session layer statistics
+ *
+ * @param[OUT] stats - counters since initialization or @ref dali2_l_ses_stats_reset()
+ */
+void dali2_l_ses_stats_get(dali2_l_ses_stats_t *stats);
+
+//! @brief Session layer statistics reset
+void dali2_l_ses_stats_reset(void);
 
 #endif /* DALI2_L_SES_H_ */
@@ -0,0 +1,374 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_sim_bus.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host simulation bus wire source file
+ */
+
+#include <string.h>
+
+#include "dali2_sim_bus.h"
+
+#define DALI2_SIM_BUS_HALF_BITS_MAX     ((DALI2_SIM_BUS_FRAME_BITS_MAX + 1) * 2)
+
+static void __dali2_sim_bus_level_update(dali2_sim_bus_t *bus);
+
+static void __dali2_sim_bus_frame_end(void *ctx)
+{
+    dali2_sim_bus_t *bus = (dali2_sim_bus_t *) ctx;
+    unsigned int frame;
+    unsigned char bits;
+    unsigned int i;
+
+    bus->frame_end_evt = DALI2_SIM_SCHED_EVT_INVALID;
+
+    //! Line is still low, frame is not finished
+    if (bus->level != DALI2_L_BSP_DPIN_STATE_1 || !bus->edge_count) {
+        return;
+    }
+
+    bus->stats.busy_us += bus->edge_at[bus->edge_count - 1] - bus->edge_at[0];
+
+    if (dali2_sim_bus_decode(bus->edge_at, bus->edge_level, bus->edge_count, &frame, &bits) != DALI2_RET_SUCCESS) {
+        bus->stats.error_frames++;
+    } else if (bits == DALI2_SIM_BUS_BACKWARD_BITS) {
+        bus->stats.backward_frames++;
+    } else {
+        bus->stats.forward_frames++;
+
+        for (i = 0; i < bus->responder_count; i++) {
+            bus->responder[i].func(bus->responder[i].ctx, bus, frame, bits);
+        }
+    }
+
+    bus->edge_count = 0;
+}
+
+static unsigned int __dali2_sim_bus_rand(dali2_sim_bus_t *bus)
+{
+    //! xorshift32
+    bus->rand_state ^= bus->rand_state << 13;
+    bus->rand_state ^= bus->rand_state >> 17;
+    bus->rand_state ^= bus->rand_state << 5;
+
+    return bus->rand_state;
+}
+
+static void __dali2_sim_bus_glitch_start(void *ctx)
+{
+    dali2_sim_bus_t *bus = (dali2_sim_bus_t *) ctx;
+
+    bus->glitch_depth++;
+    bus->stats.glitches++;
+    __dali2_sim_bus_level_update(bus);
+}
+
+static void __dali2_sim_bus_glitch_end(void *ctx)
+{
+    dali2_sim_bus_t *bus = (dali2_sim_bus_t *) ctx;
+
+    if (bus->glitch_depth) {
+        bus->glitch_depth--;
+    }
+    __dali2_sim_bus_level_update(bus);
+}
+
+static void __dali2_sim_bus_level_update(dali2_sim_bus_t *bus)
+{
+    DALI2_L_BSP_DPIN_STATE_T new_level = bus->line_level;
+
+    //! Glitch inverts level seen by receivers
+    if (bus->glitch_depth) {
+        new_level = (new_level == DALI2_L_BSP_DPIN_STATE_0) ? DALI2_L_BSP_DPIN_STATE_1 : DALI2_L_BSP_DPIN_STATE_0;
+    }
+
+    if (new_level == bus->level) {
+        return;
+    }
+    bus->level = new_level;
+    bus->stats.edges++;
+
+    //! Record edge of the frame
+    if (bus->edge_count < DALI2_SIM_BUS_EDGE_MAX) {
+        bus->edge_at[bus->edge_count] = dali2_sim_sched_now();
+        bus->edge_level[bus->edge_count] = (unsigned char) new_level;
+        bus->edge_count++;
+    }
+
+    //! Restart frame end detection
+    dali2_sim_sched_cancel(bus->frame_end_evt);
+    bus->frame_end_evt = dali2_sim_sched_add_in(DALI2_SIM_BUS_FRAME_END_US, __dali2_sim_bus_frame_end, bus);
+
+    if (bus->edge_func) {
+        bus->edge_func(bus->edge_ctx, new_level);
+    }
+}
+
+static void __dali2_sim_bus_line_set(dali2_sim_bus_t *bus, DALI2_L_BSP_DPIN_STATE_T level)
+{
+    bus->line_level = level;
+    __dali2_sim_bus_level_update(bus);
+
+    //! Glitch somewhere within the next half-bit
+    if (bus->is_noise && bus->noise.glitch_pct && (__dali2_sim_bus_rand(bus) % 100) < bus->noise.glitch_pct) {
+        dali2_sim_bus_glitch_inject(bus, __dali2_sim_bus_rand(bus) % DALI2_SIM_BUS_HALF_BIT_US, bus->noise.glitch_us);
+    }
+}
+
+static void __dali2_sim_bus_pending_edge(void *ctx)
+{
+    dali2_sim_bus_t *bus = (dali2_sim_bus_t *) ctx;
+    DALI2_L_BSP_DPIN_STATE_T level;
+
+    if (!bus->pending_count) {
+        return;
+    }
+
+    level = bus->pending_level[bus->pending_head];
+    bus->pending_head = (bus->pending_head + 1) % DALI2_SIM_BUS_PENDING_EDGE_MAX;
+    bus->pending_count--;
+
+    __dali2_sim_bus_line_set(bus, level);
+}
+
+static void __dali2_sim_bus_tx_half_bit(void *ctx)
+{
+    dali2_sim_bus_tx_t *tx = (dali2_sim_bus_tx_t *) ctx;
+
+    if (tx->idx < sizeof(tx->half_bits)) {
+        dali2_sim_bus_drive(tx->bus, tx->driver, (DALI2_L_BSP_DPIN_STATE_T) tx->half_bits[tx->idx++]);
+        dali2_sim_sched_add_in(DALI2_SIM_BUS_HALF_BIT_US, __dali2_sim_bus_tx_half_bit, tx);
+    } else {
+        //! Release line
+        dali2_sim_bus_drive(tx->bus, tx->driver, DALI2_L_BSP_DPIN_STATE_1);
+        tx->is_active = 0;
+    }
+}
+
+void dali2_sim_bus_init(dali2_sim_bus_t *bus)
+{
+    unsigned int i;
+
+    memset(bus, 0x00, sizeof(dali2_sim_bus_t));
+
+    bus->level = DALI2_L_BSP_DPIN_STATE_1;
+    bus->driven_level = DALI2_L_BSP_DPIN_STATE_1;
+    bus->line_level = DALI2_L_BSP_DPIN_STATE_1;
+    bus->frame_end_evt = DALI2_SIM_SCHED_EVT_INVALID;
+
+    for (i = 0; i < DALI2_SIM_BUS_TX_MAX; i++) {
+        bus->tx[i].bus = bus;
+        bus->tx[i].driver = (unsigned char) (i + 1);
+    }
+}
+
+void dali2_sim_bus_drive(dali2_sim_bus_t *bus, unsigned char driver, DALI2_L_BSP_DPIN_STATE_T level)
+{
+    DALI2_L_BSP_DPIN_STATE_T new_level;
+    unsigned char is_low = (level == DALI2_L_BSP_DPIN_STATE_0);
+    dali2_sim_time_t at;
+    unsigned int delay_us;
+
+    if (driver >= DALI2_SIM_BUS_DRIVER_MAX || bus->driver_low[driver] == is_low) {
+        return;
+    }
+
+    bus->driver_low[driver] = is_low;
+    if (is_low) {
+        bus->low_count++;
+    } else {
+        bus->low_count--;
+    }
+
+    //! Wired-AND of all drivers
+    new_level = (bus->low_count) ? DALI2_L_BSP_DPIN_STATE_0 : DALI2_L_BSP_DPIN_STATE_1;
+    if (new_level == bus->driven_level) {
+        return;
+    }
+    bus->driven_level = new_level;
+
+    if (!bus->is_noise || bus->pending_count >= DALI2_SIM_BUS_PENDING_EDGE_MAX) {
+        __dali2_sim_bus_line_set(bus, new_level);
+        return;
+    }
+
+    //! Edge reaches receivers later, edges never overtake each other
+    delay_us = (new_level == DALI2_L_BSP_DPIN_STATE_0) ? bus->noise.fall_us : bus->noise.rise_us;
+    if (bus->noise.jitter_us) {
+        delay_us += __dali2_sim_bus_rand(bus) % (bus->noise.jitter_us + 1);
+    }
+    at = dali2_sim_sched_now() + delay_us;
+    if (at < bus->pending_at) {
+        at = bus->pending_at;
+    }
+    bus->pending_at = at;
+
+    bus->pending_level[(bus->pending_head + bus->pending_count) % DALI2_SIM_BUS_PENDING_EDGE_MAX] = new_level;
+    bus->pending_count++;
+    dali2_sim_sched_add(at, __dali2_sim_bus_pending_edge, bus);
+}
+
+DALI2_L_BSP_DPIN_STATE_T dali2_sim_bus_level(dali2_sim_bus_t *bus)
+{
+    return bus->level;
+}
+
+void dali2_sim_bus_noise_set(dali2_sim_bus_t *bus, const dali2_sim_bus_noise_t *noise)
+{
+    if (!noise) {
+        memset(&bus->noise, 0x00, sizeof(dali2_sim_bus_noise_t));
+        bus->is_noise = 0;
+        return;
+    }
+
+    memcpy(&bus->noise, noise, sizeof(dali2_sim_bus_noise_t));
+    bus->rand_state = (noise->seed) ? noise->seed : 1;
+    bus->is_noise = 1;
+}
+
+void dali2_sim_bus_glitch_inject(dali2_sim_bus_t *bus, unsigned int delay_us, unsigned int width_us)
+{
+    dali2_sim_time_t at = dali2_sim_sched_now() + delay_us;
+
+    if (!width_us) {
+        return;
+    }
+
+    dali2_sim_sched_add(at, __dali2_sim_bus_glitch_start, bus);
+    dali2_sim_sched_add(at + width_us, __dali2_sim_bus_glitch_end, bus);
+}
+
+dali2_ret_t dali2_sim_bus_responder_add(dali2_sim_bus_t *bus, dali2_sim_bus_fw_func_t func, void *ctx)
+{
+    if (!func) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    if (bus->responder_count >= DALI2_SIM_BUS_RESPONDER_MAX) {
+        return DALI2_RET_BUSY;
+    }
+
+    bus->responder[bus->responder_count].func = func;
+    bus->responder[bus->responder_count].ctx = ctx;
+    bus->responder_count++;
+
+    return DALI2_RET_SUCCESS;
+}
+
+void dali2_sim_bus_edge_listener_set(dali2_sim_bus_t *bus, dali2_sim_bus_edge_func_t func, void *ctx)
+{
+    bus->edge_func = func;
+    bus->edge_ctx = ctx;
+}
+
+static dali2_ret_t __dali2_sim_bus_backward_start(dali2_sim_bus_t *bus, unsigned char data, unsigned int delay_us)
+{
+    dali2_sim_bus_tx_t *tx = NULL;
+    unsigned int i;
+
+    //! Find free transmitter
+    for (i = 0; i < DALI2_SIM_BUS_TX_MAX; i++) {
+        if (!bus->tx[i].is_active) {
+            tx = &bus->tx[i];
+            break;
+        }
+    }
+
+    if (!tx) {
+        bus->stats.replies_dropped++;
+        return DALI2_RET_BUSY;
+    }
+
+    //! Start bit
+    tx->half_bits[0] = DALI2_L_BSP_DPIN_STATE_0;
+    tx->half_bits[1] = DALI2_L_BSP_DPIN_STATE_1;
+
+    //! Data bits, MSB first. "1" is low to high, "0" is high to low
+    for (i = 0; i < DALI2_SIM_BUS_BACKWARD_BITS; i++) {
+        if (data & (0x80 >> i)) {
+            tx->half_bits[2 + i * 2] = DALI2_L_BSP_DPIN_STATE_0;
+            tx->half_bits[3 + i * 2] = DALI2_L_BSP_DPIN_STATE_1;
+        } else {
+            tx->half_bits[2 + i * 2] = DALI2_L_BSP_DPIN_STATE_1;
+            tx->half_bits[3 + i * 2] = DALI2_L_BSP_DPIN_STATE_0;
+        }
+    }
+
+    tx->idx = 0;
+    tx->is_active = 1;
+
+    if (dali2_sim_sched_add_in(delay_us, __dali2_sim_bus_tx_half_bit, tx) == DALI2_SIM_SCHED_EVT_INVALID) {
+        tx->is_active = 0;
+        bus->stats.replies_dropped++;
+        return DALI2_RET_BUSY;
+    }
+
+    return DALI2_RET_SUCCESS;
+}
+
+dali2_ret_t dali2_sim_bus_backward_send(dali2_sim_bus_t *bus, unsigned char data, unsigned int delay_us)
+{
+    unsigned int skew_us = 0;
+
+    //! Foreign backward frame at about the same time
+    if (bus->is_noise && bus->noise.collision_pct && (__dali2_sim_bus_rand(bus) % 100) < bus->noise.collision_pct) {
+        if (bus->noise.collision_skew_us) {
+            skew_us = __dali2_sim_bus_rand(bus) % (bus->noise.collision_skew_us + 1);
+        }
+        if (__dali2_sim_bus_backward_start(bus, (unsigned char) __dali2_sim_bus_rand(bus), delay_us + skew_us) == DALI2_RET_SUCCESS) {
+            bus->stats.collisions++;
+        }
+    }
+
+    return __dali2_sim_bus_backward_start(bus, data, delay_us);
+}
+
+dali2_ret_t dali2_sim_bus_decode(const dali2_sim_time_t *edge_at, const unsigned char *edge_level,
+                                 unsigned int edge_count, unsigned int *frame, unsigned char *bits)
+{
+    unsigned char half_bits[DALI2_SIM_BUS_HALF_BITS_MAX];
+    unsigned int count = 0;
+    unsigned int i, n;
+    dali2_sim_time_t dt;
+
+    if (!edge_count || edge_level[0] != DALI2_L_BSP_DPIN_STATE_0) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    //! Expand edge intervals into half-bits levels
+    for (i = 0; i + 1 < edge_count; i++) {
+        dt = edge_at[i + 1] - edge_at[i];
+        n = (unsigned int) ((dt + DALI2_SIM_BUS_HALF_BIT_US / 2) / DALI2_SIM_BUS_HALF_BIT_US);
+        if (n < 1 || n > 2 || (count + n) > DALI2_SIM_BUS_HALF_BITS_MAX) {
+            return DALI2_RET_INVALID_PARAMS;
+        }
+        while (n--) {
+            half_bits[count++] = edge_level[i];
+        }
+    }
+
+    //! Line is high after the last edge, it completes the last bit only
+    if (count % 2) {
+        half_bits[count++] = DALI2_L_BSP_DPIN_STATE_1;
+    }
+
+    //! Start bit
+    if (count < 4 || half_bits[0] != DALI2_L_BSP_DPIN_STATE_0 || half_bits[1] != DALI2_L_BSP_DPIN_STATE_1) {
+        return DALI2_RET_INVALID_PARAMS;
+    }
+
+    *frame = 0;
+    for (i = 2; i < count; i += 2) {
+        if (half_bits[i] == half_bits[i + 1]) {
+            return DALI2_RET_INVALID_PARAMS;
+        }
+        *frame = (*frame << 1) | (half_bits[i] == DALI2_L_BSP_DPIN_STATE_0);
+    }
+    *bits = (unsigned char) (count / 2 - 1);
+
+    return DALI2_RET_SUCCESS;
+}
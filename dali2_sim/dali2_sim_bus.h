@@ -0,0 +1,198 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_sim_bus.h
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host simulation bus wire header file
+ *
+ * @details Simulated DALI line in virtual time, @see dali2_sim_sched.h.
+ *          Line is idle high, every driver may pull it low (wired-AND).
+ *          Driver 0 is dedicated for application controller (host BSP),
+ *          other drivers are used by backward frames of responders.
+ *          Every completed frame is decoded from edges and forward frames
+ *          are delivered to pluggable responders.
+ *
+ *          Optional noise model, @see dali2_sim_bus_noise_set(): wired-AND level
+ *          of drivers reaches receivers with rise/fall delay and random jitter,
+ *          glitches may follow edges and foreign backward frames may overlap
+ *          with backward frames. Without noise line level changes immediately.
+ */
+#ifndef DALI2_SIM_BUS_H_
+#define DALI2_SIM_BUS_H_
+
+#include "dali2_l_bsp.h"
+#include "dali2_error.h"
+#include "dali2_sim_sched.h"
+
+#define DALI2_SIM_BUS_CTRL_DRIVER           0
+#define DALI2_SIM_BUS_TX_MAX                64      //! Every gear of the line may answer at once
+#define DALI2_SIM_BUS_DRIVER_MAX            (DALI2_SIM_BUS_TX_MAX + 1)
+#define DALI2_SIM_BUS_RESPONDER_MAX         8
+#define DALI2_SIM_BUS_EDGE_MAX              128
+
+#define DALI2_SIM_BUS_HALF_BIT_US           416
+#define DALI2_SIM_BUS_FRAME_END_US          1250    //! Idle time which terminates the frame
+#define DALI2_SIM_BUS_BACKWARD_BITS         8
+#define DALI2_SIM_BUS_FRAME_BITS_MAX        32
+#define DALI2_SIM_BUS_PENDING_EDGE_MAX      16
+
+typedef struct dali2_sim_bus_s dali2_sim_bus_t;
+
+/**@brief Forward frame responder function type
+ * @note  Use @ref dali2_sim_bus_backward_send() inside for answering
+ *
+ * @param[IN] ctx - responder context
+ * @param[IN] bus - bus of the frame
+ * @param[IN] frame - forward frame data
+ * @param[IN] bits - forward frame size in bits
+ */
+typedef void (* dali2_sim_bus_fw_func_t) (void *ctx, dali2_sim_bus_t *bus, unsigned int frame, unsigned char bits);
+
+/**@brief Line level change listener function type
+ *
+ * @param[IN] ctx - listener context
+ * @param[IN] level - new line level
+ */
+typedef void (* dali2_sim_bus_edge_func_t) (void *ctx, DALI2_L_BSP_DPIN_STATE_T level);
+
+//! Bus statistics
+typedef struct {
+    unsigned long long edges;
+    unsigned long long forward_frames;
+    unsigned long long backward_frames;
+    unsigned long long error_frames;
+    unsigned long long replies_dropped;
+    unsigned long long glitches;            //! Injected glitches
+    unsigned long long collisions;          //! Injected foreign backward frames
+    dali2_sim_time_t busy_us;               //! Time from first edge up to the end of frames
+} dali2_sim_bus_stats_t;
+
+//! Noise model, all zeroes is noiseless line
+typedef struct {
+    unsigned int fall_us;                   //! Falling edge delay
+    unsigned int rise_us;                   //! Rising edge delay, slow rise of weak bus power supply
+    unsigned int jitter_us;                 //! Random extension of every edge delay 0..jitter_us
+    unsigned char glitch_pct;               //! Probability of glitch after an edge, percent
+    unsigned int glitch_us;                 //! Glitch width
+    unsigned char collision_pct;            //! Probability of foreign backward frame, percent
+    unsigned int collision_skew_us;         //! Start of foreign backward frame spread 0..collision_skew_us
+    unsigned int seed;                      //! Random generator seed, must not be 0
+} dali2_sim_bus_noise_t;
+
+//! Backward frame transmitter
+typedef struct {
+    dali2_sim_bus_t *bus;
+    unsigned char driver;
+    unsigned char half_bits[(DALI2_SIM_BUS_BACKWARD_BITS + 1) * 2];
+    unsigned char idx;
+    unsigned char is_active;
+} dali2_sim_bus_tx_t;
+
+//! Responder entry
+typedef struct {
+    dali2_sim_bus_fw_func_t func;
+    void *ctx;
+} dali2_sim_bus_responder_t;
+
+//! Bus handle
+struct dali2_sim_bus_s {
+    DALI2_L_BSP_DPIN_STATE_T level;         //! Level seen by receivers
+    DALI2_L_BSP_DPIN_STATE_T driven_level;  //! Wired-AND of drivers
+    DALI2_L_BSP_DPIN_STATE_T line_level;    //! Driven level after rise/fall delay
+    unsigned char driver_low[DALI2_SIM_BUS_DRIVER_MAX];
+    unsigned int low_count;
+
+    //! Noise model
+    dali2_sim_bus_noise_t noise;
+    unsigned int rand_state;
+    unsigned char is_noise:1;
+    unsigned int glitch_depth;              //! Active glitches count
+    DALI2_L_BSP_DPIN_STATE_T pending_level[DALI2_SIM_BUS_PENDING_EDGE_MAX];
+    unsigned int pending_head;
+    unsigned int pending_count;
+    dali2_sim_time_t pending_at;
+
+    //! Edges of the current frame
+    dali2_sim_time_t edge_at[DALI2_SIM_BUS_EDGE_MAX];
+    unsigned char edge_level[DALI2_SIM_BUS_EDGE_MAX];
+    unsigned int edge_count;
+    int frame_end_evt;
+
+    dali2_sim_bus_responder_t responder[DALI2_SIM_BUS_RESPONDER_MAX];
+    unsigned int responder_count;
+
+    dali2_sim_bus_edge_func_t edge_func;
+    void *edge_ctx;
+
+    dali2_sim_bus_tx_t tx[DALI2_SIM_BUS_TX_MAX];
+
+    dali2_sim_bus_stats_t stats;
+};
+
+/**@brief Bus initialization. Line is idle high.
+ *
+ * @param[IN] bus - bus handle
+ */
+void dali2_sim_bus_init(dali2_sim_bus_t *bus);
+
+/**@brief Driving line by driver
+ *
+ * @param[IN] bus - bus handle
+ * @param[IN] driver - driver index, DALI2_SIM_BUS_CTRL_DRIVER for controller
+ * @param[IN] level - DALI2_L_BSP_DPIN_STATE_0 pulls line low
+ */
+void dali2_sim_bus_drive(dali2_sim_bus_t *bus, unsigned char driver, DALI2_L_BSP_DPIN_STATE_T level);
+
+//! @brief Current line level seen by receivers
+DALI2_L_BSP_DPIN_STATE_T dali2_sim_bus_level(dali2_sim_bus_t *bus);
+
+/**@brief Setting noise model
+ *
+ * @param[IN] bus - bus handle
+ * @param[IN] noise - noise model, NULL for noiseless line
+ */
+void dali2_sim_bus_noise_set(dali2_sim_bus_t *bus, const dali2_sim_bus_noise_t *noise);
+
+/**@brief Injecting single glitch: line level seen by receivers is inverted
+ *
+ * @param[IN] bus - bus handle
+ * @param[IN] delay_us - delay from now up to the glitch
+ * @param[IN] width_us - glitch width
+ */
+void dali2_sim_bus_glitch_inject(dali2_sim_bus_t *bus, unsigned int delay_us, unsigned int width_us);
+
+/**@brief Adding forward frame responder
+ *
+ * @return DALI2_RET_SUCCESS or DALI2_RET_BUSY if no free responder entries
+ */
+dali2_ret_t dali2_sim_bus_responder_add(dali2_sim_bus_t *bus, dali2_sim_bus_fw_func_t func, void *ctx);
+
+//! @brief Setting line level change listener. Single listener only.
+void dali2_sim_bus_edge_listener_set(dali2_sim_bus_t *bus, dali2_sim_bus_edge_func_t func, void *ctx);
+
+/**@brief Sending 8-bit backward frame
+ *
+ * @param[IN] bus - bus handle
+ * @param[IN] data - backward frame data
+ * @param[IN] delay_us - delay from now up to the start bit
+ * @return DALI2_RET_SUCCESS or DALI2_RET_BUSY if all transmitters are busy
+ */
+dali2_ret_t dali2_sim_bus_backward_send(dali2_sim_bus_t *bus, unsigned char data, unsigned int delay_us);
+
+/**@brief Decoding Manchester frame from edges
+ * @note  First edge must be falling edge of start bit, line is idle high after the last edge
+ *
+ * @param[IN] edge_at - edge times
+ * @param[IN] edge_level - line level after edge
+ * @param[IN] edge_count - edges count
+ * @param[OUT] frame - decoded frame, MSB first
+ * @param[OUT] bits - decoded bits count
+ * @return DALI2_RET_SUCCESS or DALI2_RET_INVALID_PARAMS on timing or coding error
+ */
+dali2_ret_t dali2_sim_bus_decode(const dali2_sim_time_t *edge_at, const unsigned char *edge_level,
+                                 unsigned int edge_count, unsigned int *frame, unsigned char *bits);
+
+#endif /* DALI2_SIM_BUS_H_ */
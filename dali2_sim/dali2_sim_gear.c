@@ -0,0 +1,996 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_sim_gear.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host simulation control gear source file
+ */
+
+#include <string.h>
+
+#include "dali2_sim_gear.h"
+
+#include "dali2_std_cmd_list.h"
+#include "dali2_spec_cmd_list.h"
+#include "dali2_led_cmd_list.h"
+
+#define DALI2_SIM_GEAR_FRAME_BITS           16
+#define DALI2_SIM_GEAR_LEVEL_MAX            254
+#define DALI2_SIM_GEAR_VERSION_NUMBER       0x08    //! Version 2.0
+#define DALI2_SIM_GEAR_DT6_VERSION_NUMBER   0x02
+#define DALI2_SIM_GEAR_FAST_FADE_TIME_MAX   27
+#define DALI2_SIM_GEAR_UP_DOWN_FADE_MS      200
+
+//! Address byte ranges
+#define DALI2_SIM_GEAR_ADDR_IS_SHORT(A)     (((A) & 0x80) == 0x00)
+#define DALI2_SIM_GEAR_ADDR_IS_GROUP(A)     (((A) & 0xE0) == 0x80)
+#define DALI2_SIM_GEAR_ADDR_IS_SPECIAL(A)   ((A) >= 0xA0 && (A) <= 0xCB)
+#define DALI2_SIM_GEAR_ADDR_IS_UNADDR(A)    (((A) & 0xFE) == 0xFC)
+#define DALI2_SIM_GEAR_ADDR_IS_BCAST(A)     (((A) & 0xFE) == 0xFE)
+
+//! Fade time 0.5 * sqrt(2 ^ X) seconds, in milliseconds
+static const unsigned int __fade_time_ms[16] = {
+    0, 707, 1000, 1414, 2000, 2828, 4000, 5657,
+    8000, 11314, 16000, 22627, 32000, 45255, 64000, 90510
+};
+
+//! Fade rate 506 / sqrt(2 ^ X) steps per second, in 0.1 steps per second
+static const unsigned int __fade_rate_x10[16] = {
+    0, 3578, 2530, 1789, 1265, 894, 633, 447,
+    316, 224, 158, 112, 79, 56, 40, 28
+};
+
+//! Extended fade time multipliers, in milliseconds
+static const unsigned int __ext_fade_mul_ms[8] = {
+    0, 100, 1000, 10000, 60000, 0, 0, 0
+};
+
+static unsigned int __dali2_sim_gear_rand(dali2_sim_gear_t *gear)
+{
+    //! xorshift32
+    gear->rand_state ^= gear->rand_state << 13;
+    gear->rand_state ^= gear->rand_state >> 17;
+    gear->rand_state ^= gear->rand_state << 5;
+
+    return gear->rand_state;
+}
+
+static void __dali2_sim_gear_reply(dali2_sim_gear_t *gear, unsigned char data)
+{
+    unsigned int delay_us = gear->cfg.reply_delay_us;
+
+    if (gear->cfg.reply_jitter_us) {
+        delay_us += __dali2_sim_gear_rand(gear) % (gear->cfg.reply_jitter_us + 1);
+    }
+
+    if (gear->cfg.reply_loss_pct && (__dali2_sim_gear_rand(gear) % 100) < gear->cfg.reply_loss_pct) {
+        gear->stats.replies_lost++;
+        return;
+    }
+
+    if (dali2_sim_bus_backward_send(gear->line->bus, data, delay_us) != DALI2_RET_SUCCESS) {
+        gear->stats.replies_lost++;
+        return;
+    }
+
+    gear->stats.replies++;
+}
+
+static inline void __dali2_sim_gear_reply_yes(dali2_sim_gear_t *gear, int is_yes)
+{
+    //! NO is no answer
+    if (is_yes) {
+        __dali2_sim_gear_reply(gear, DALI2_SIM_GEAR_YES);
+    }
+}
+
+static inline int __dali2_sim_gear_is_fading(dali2_sim_gear_t *gear, dali2_sim_time_t now)
+{
+    return gear->fade_us && now < (gear->fade_at + gear->fade_us);
+}
+
+static unsigned int __dali2_sim_gear_fade_time_ms(dali2_sim_gear_t *gear)
+{
+    if (gear->fade_time) {
+        return __fade_time_ms[gear->fade_time];
+    }
+
+    //! Fade time 0 selects extended fade time
+    return (gear->ext_fade_base + 1) * __ext_fade_mul_ms[gear->ext_fade_mul];
+}
+
+static void __dali2_sim_gear_level_start(dali2_sim_gear_t *gear, unsigned char target, unsigned int fade_ms)
+{
+    unsigned char actual = dali2_sim_gear_level_get(gear);
+
+    gear->limit_error = 0;
+
+    if (target) {
+        //! Arc power level is limited by min and max levels
+        if (target > gear->max_level) {
+            target = gear->max_level;
+            gear->limit_error = 1;
+        } else if (target < gear->min_level) {
+            target = gear->min_level;
+            gear->limit_error = 1;
+        }
+        gear->last_active_level = target;
+
+        if ((gear->cfg.quirks & DALI2_SIM_GEAR_QUIRK_LEVEL_ROUNDING) && target > gear->min_level) {
+            target--;
+        }
+    }
+
+    gear->level_from = actual;
+    gear->level_to = target;
+    gear->fade_at = dali2_sim_sched_now();
+    gear->fade_us = (dali2_sim_time_t) fade_ms * 1000;
+
+    gear->reset_state = 0;
+    gear->power_failure = 0;
+}
+
+static void __dali2_sim_gear_level_stop(dali2_sim_gear_t *gear)
+{
+    unsigned char actual = dali2_sim_gear_level_get(gear);
+
+    gear->level_from = actual;
+    gear->level_to = actual;
+    gear->fade_us = 0;
+}
+
+static void __dali2_sim_gear_vars_reset(dali2_sim_gear_t *gear)
+{
+    gear->max_level = DALI2_SIM_GEAR_LEVEL_MAX;
+    gear->min_level = gear->cfg.phys_min_level;
+    gear->power_on_level = DALI2_SIM_GEAR_LEVEL_MAX;
+    gear->system_failure_level = DALI2_SIM_GEAR_LEVEL_MAX;
+    gear->last_active_level = DALI2_SIM_GEAR_LEVEL_MAX;
+    gear->fade_time = 0;
+    gear->fade_rate = 7;
+    gear->ext_fade_base = 0;
+    gear->ext_fade_mul = 0;
+    gear->operating_mode = 0;
+    gear->groups = 0;
+    gear->random_addr = DALI2_SIM_GEAR_RANDOM_ADDR_MASK;
+    gear->search_addr = DALI2_SIM_GEAR_RANDOM_ADDR_MASK;
+    memset(gear->scene, DALI2_SIM_GEAR_MASK, sizeof(gear->scene));
+
+    gear->dimming_curve = 0;
+    gear->fast_fade_time = 0;
+    gear->current_protector_en = 1;
+
+    gear->limit_error = 0;
+    gear->power_cycle_seen = 0;
+    gear->reset_state = 1;
+}
+
+static void __dali2_sim_gear_bank0_init(dali2_sim_gear_t *gear)
+{
+    unsigned int i;
+
+    memset(gear->bank0, 0x00, sizeof(gear->bank0));
+
+    gear->bank0[0x00] = DALI2_SIM_GEAR_BANK0_SIZE - 1;  //! Last accessible location
+    gear->bank0[0x02] = 0;                              //! Last accessible memory bank
+
+    for (i = 0; i < 6; i++) {                           //! GTIN, MSB first
+        gear->bank0[0x03 + i] = (unsigned char) (gear->cfg.gtin >> (8 * (5 - i)));
+    }
+    gear->bank0[0x09] = 1;                              //! Firmware version
+    for (i = 0; i < 8; i++) {                           //! Identification number, MSB first
+        gear->bank0[0x0B + i] = (unsigned char) (gear->cfg.serial >> (8 * (7 - i)));
+    }
+    gear->bank0[0x13] = 1;                              //! Hardware version
+    gear->bank0[0x15] = DALI2_SIM_GEAR_VERSION_NUMBER;  //! IEC 62386-101 version
+    gear->bank0[0x16] = DALI2_SIM_GEAR_VERSION_NUMBER;  //! IEC 62386-102 version
+    gear->bank0[0x17] = DALI2_SIM_GEAR_MASK;            //! IEC 62386-103 is not implemented
+    gear->bank0[0x19] = 1;                              //! Logical control gear units
+}
+
+static inline int __dali2_sim_gear_is_addressed(dali2_sim_gear_t *gear, unsigned char addr_byte)
+{
+    if (DALI2_SIM_GEAR_ADDR_IS_SHORT(addr_byte)) {
+        return (addr_byte >> 1) == gear->short_addr;
+    }
+
+    if (DALI2_SIM_GEAR_ADDR_IS_GROUP(addr_byte)) {
+        return (gear->groups >> ((addr_byte >> 1) & 0x0F)) & 0x01;
+    }
+
+    if (DALI2_SIM_GEAR_ADDR_IS_BCAST(addr_byte)) {
+        return 1;
+    }
+
+    if (DALI2_SIM_GEAR_ADDR_IS_UNADDR(addr_byte)) {
+        return gear->short_addr == DALI2_SIM_GEAR_MASK;
+    }
+
+    return 0;
+}
+
+static inline int __dali2_sim_gear_is_config(unsigned char addr_byte, unsigned char data, int is_dt6)
+{
+    if (DALI2_SIM_GEAR_ADDR_IS_SPECIAL(addr_byte)) {
+        return addr_byte == DALI2_L_APP_SPEC_CMD_INITIALISE || addr_byte == DALI2_L_APP_SPEC_CMD_RANDOMISE;
+    }
+
+    //! Direct arc power control
+    if (!(addr_byte & 0x01)) {
+        return 0;
+    }
+
+    if (data >= DALI2_L_APP_STD_CMD_RESET && data <= DALI2_L_APP_STD_CMD_ENABLE_WRITE_MEMORY) {
+        return 1;
+    }
+
+    return is_dt6 && data >= DALI2_L_APP_LED_CMD_REFERENCE_SYSTEM_POWER &&
+           data <= DALI2_L_APP_LED_CMD_STORE_DTR_AS_FAST_FADE_TIME;
+}
+
+static unsigned char __dali2_sim_gear_status(dali2_sim_gear_t *gear, dali2_sim_time_t now)
+{
+    unsigned char status = 0;
+
+    if (gear->cfg.fail_flags & DALI2_SIM_GEAR_FAIL_GEAR)        status |= 0x01;
+    if (gear->cfg.fail_flags & DALI2_SIM_GEAR_FAIL_LAMP)        status |= 0x02;
+    if (dali2_sim_gear_level_get(gear))                         status |= 0x04;
+    if (gear->limit_error)                                      status |= 0x08;
+    if (__dali2_sim_gear_is_fading(gear, now))                  status |= 0x10;
+    if (gear->reset_state)                                      status |= 0x20;
+    if (gear->short_addr == DALI2_SIM_GEAR_MASK)                status |= 0x40;
+    if (gear->power_cycle_seen)                                 status |= 0x80;
+
+    return status;
+}
+
+static void __dali2_sim_gear_special_exec(dali2_sim_gear_t *gear, unsigned char addr_byte, unsigned char data)
+{
+    int is_init = (gear->init_state != DALI2_SIM_GEAR_INIT_DISABLED);
+    int is_selected = is_init && (gear->random_addr == gear->search_addr);
+
+    switch (addr_byte) {
+        case DALI2_L_APP_SPEC_CMD_TERMINATE:
+            gear->init_state = DALI2_SIM_GEAR_INIT_DISABLED;
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_DTR0:
+            gear->dtr0 = data;
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_DTR1:
+            gear->dtr1 = data;
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_DTR2:
+            gear->dtr2 = data;
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_INITIALISE:
+            //! 0x00 - all gear, 0xFF - gear without short address, 0AAAAAA1 - gear with short address
+            if (data == 0x00 ||
+                (data == DALI2_SIM_GEAR_MASK && gear->short_addr == DALI2_SIM_GEAR_MASK) ||
+                ((data & 0x81) == 0x01 && (data >> 1) == gear->short_addr)) {
+                gear->init_state = DALI2_SIM_GEAR_INIT_ENABLED;
+                gear->init_until = dali2_sim_sched_now() + DALI2_SIM_GEAR_INITIALISE_US;
+            }
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_RANDOMISE:
+            if (is_init) {
+                gear->random_addr = __dali2_sim_gear_rand(gear) & DALI2_SIM_GEAR_RANDOM_ADDR_MASK;
+                gear->reset_state = 0;
+            }
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_COMPARE:
+            __dali2_sim_gear_reply_yes(gear, gear->init_state == DALI2_SIM_GEAR_INIT_ENABLED &&
+                                             gear->random_addr <= gear->search_addr);
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_WITHDRAW:
+            if (gear->init_state == DALI2_SIM_GEAR_INIT_ENABLED && is_selected) {
+                gear->init_state = DALI2_SIM_GEAR_INIT_WITHDRAWN;
+            }
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_SEARCHADDRH:
+            if (is_init) {
+                gear->search_addr = (gear->search_addr & 0x00FFFF) | ((unsigned int) data << 16);
+            }
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_SEARCHADDRM:
+            if (is_init) {
+                gear->search_addr = (gear->search_addr & 0xFF00FF) | ((unsigned int) data << 8);
+            }
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_SEARCHADDRL:
+            if (is_init) {
+                gear->search_addr = (gear->search_addr & 0xFFFF00) | data;
+            }
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_PROGRAM_SHORT_ADDRESS:
+            if (is_selected) {
+                if (data == DALI2_SIM_GEAR_MASK) {
+                    gear->short_addr = DALI2_SIM_GEAR_MASK;
+                } else if ((data & 0x81) == 0x01) {
+                    gear->short_addr = data >> 1;
+                }
+            }
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_VERIFY_SHORT_ADDRESS:
+            __dali2_sim_gear_reply_yes(gear, is_init && (data & 0x81) == 0x01 &&
+                                             (data >> 1) == gear->short_addr);
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_QUERY_SHORT_ADDRESS:
+            if (is_selected) {
+                __dali2_sim_gear_reply(gear, (gear->short_addr == DALI2_SIM_GEAR_MASK) ?
+                                             DALI2_SIM_GEAR_MASK : (unsigned char) ((gear->short_addr << 1) | 0x01));
+            }
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_WRITE_MEMORY_LOCATION_DTR1_DTR0:
+        case DALI2_L_APP_SPEC_CMD_WRITE_MEMORY_LOCATION_NO_REPLY_DTR1_DTR0:
+            //! Memory bank 0 is read-only, only the location pointer moves
+            if (gear->write_enable && gear->dtr0 < DALI2_SIM_GEAR_MASK) {
+                gear->dtr0++;
+            }
+            break;
+
+        case DALI2_L_APP_SPEC_CMD_PING:
+        default:
+            break;
+    }
+}
+
+static void __dali2_sim_gear_dt6_exec(dali2_sim_gear_t *gear, unsigned char data)
+{
+    unsigned char failure = 0;
+
+    if (gear->cfg.fail_flags & DALI2_SIM_GEAR_FAIL_LAMP)    failure |= 0x02;
+    if (gear->cfg.fail_flags & DALI2_SIM_GEAR_FAIL_THERMAL) failure |= 0x40;
+
+    switch (data) {
+        case DALI2_L_APP_LED_CMD_REFERENCE_SYSTEM_POWER:
+            break;
+
+        case DALI2_L_APP_LED_CMD_ENABLE_CURRENT_PROTECTOR:
+            gear->current_protector_en = 1;
+            break;
+
+        case DALI2_L_APP_LED_CMD_DISABLE_CURRENT_PROTECTOR:
+            gear->current_protector_en = 0;
+            break;
+
+        case DALI2_L_APP_LED_CMD_SELECT_DIMMING_CURVE:
+            if (gear->dtr0 <= 1) {
+                gear->dimming_curve = gear->dtr0;
+            }
+            break;
+
+        case DALI2_L_APP_LED_CMD_STORE_DTR_AS_FAST_FADE_TIME:
+            if (!gear->cfg.min_fast_fade_time) {
+                break;
+            }
+            if (gear->dtr0 == 0 || gear->dtr0 > DALI2_SIM_GEAR_FAST_FADE_TIME_MAX) {
+                gear->fast_fade_time = (gear->dtr0) ? DALI2_SIM_GEAR_FAST_FADE_TIME_MAX : 0;
+            } else {
+                gear->fast_fade_time = (gear->dtr0 < gear->cfg.min_fast_fade_time) ?
+                                       gear->cfg.min_fast_fade_time : gear->dtr0;
+            }
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_GEAR_TYPE:
+            __dali2_sim_gear_reply(gear, gear->cfg.led_gear_type);
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_DIMMING_CURVE:
+            __dali2_sim_gear_reply(gear, gear->dimming_curve);
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_POSSIBLE_OPERATING_MODES:
+            __dali2_sim_gear_reply(gear, 0x01);     //! PWM only
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_FEATURES:
+            __dali2_sim_gear_reply(gear, gear->cfg.led_features);
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_FAILURE_STATUS:
+            __dali2_sim_gear_reply(gear, failure);
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_OPEN_CIRCUIT:
+            __dali2_sim_gear_reply_yes(gear, failure & 0x02);
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_THERMAL_OVERLOAD:
+            __dali2_sim_gear_reply_yes(gear, failure & 0x40);
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_CURRENT_PROTECTOR_ENABLED:
+            __dali2_sim_gear_reply_yes(gear, gear->current_protector_en);
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_OPERATING_MODE:
+            __dali2_sim_gear_reply(gear, (unsigned char) (0x01 | (gear->dimming_curve ? 0x10 : 0x00)));
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_FAST_FADE_TIME:
+            __dali2_sim_gear_reply(gear, gear->fast_fade_time);
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_MIN_FAST_FADE_TIME:
+            __dali2_sim_gear_reply(gear, gear->cfg.min_fast_fade_time);
+            break;
+
+        case DALI2_L_APP_LED_CMD_QUERY_EXTENDED_VERSION_NUMBER:
+            __dali2_sim_gear_reply(gear, DALI2_SIM_GEAR_DT6_VERSION_NUMBER);
+            break;
+
+        //! Short circuit, load changes, current protector active, thermal shut down
+        //! and reference queries are always NO
+        default:
+            break;
+    }
+}
+
+static void __dali2_sim_gear_std_exec(dali2_sim_gear_t *gear, unsigned char data, int is_dt6)
+{
+    dali2_sim_time_t now = dali2_sim_sched_now();
+    unsigned char actual = dali2_sim_gear_level_get(gear);
+    unsigned int steps;
+
+    //! Application extended commands
+    if (data >= DALI2_L_APP_STD_CMD_APPLICATION_EXTENDED_COMMANDS) {
+        if (is_dt6) {
+            __dali2_sim_gear_dt6_exec(gear, data);
+        }
+        return;
+    }
+
+    if (data >= DALI2_L_APP_STD_CMD_GO_TO_SCENE && data < DALI2_L_APP_STD_CMD_GO_TO_SCENE + DALI2_SIM_GEAR_SCENE_COUNT) {
+        if (gear->scene[data & 0x0F] != DALI2_SIM_GEAR_MASK) {
+            __dali2_sim_gear_level_start(gear, gear->scene[data & 0x0F], __dali2_sim_gear_fade_time_ms(gear));
+        }
+        return;
+    }
+
+    if (data >= DALI2_L_APP_STD_CMD_SET_SCENE_DTR0 && data < DALI2_L_APP_STD_CMD_SET_SCENE_DTR0 + DALI2_SIM_GEAR_SCENE_COUNT) {
+        gear->scene[data & 0x0F] = gear->dtr0;
+        gear->reset_state = 0;
+        return;
+    }
+
+    if (data >= DALI2_L_APP_STD_CMD_REMOVE_FROM_SCENE && data < DALI2_L_APP_STD_CMD_REMOVE_FROM_SCENE + DALI2_SIM_GEAR_SCENE_COUNT) {
+        gear->scene[data & 0x0F] = DALI2_SIM_GEAR_MASK;
+        return;
+    }
+
+    if (data >= DALI2_L_APP_STD_CMD_ADD_TO_GROUP && data < DALI2_L_APP_STD_CMD_ADD_TO_GROUP + 16) {
+        gear->groups |= (unsigned short) (1 << (data & 0x0F));
+        gear->reset_state = 0;
+        return;
+    }
+
+    if (data >= DALI2_L_APP_STD_CMD_REMOVE_FROM_GROUP && data < DALI2_L_APP_STD_CMD_REMOVE_FROM_GROUP + 16) {
+        gear->groups &= (unsigned short) ~(1 << (data & 0x0F));
+        return;
+    }
+
+    if (data >= DALI2_L_APP_STD_CMD_QUERY_SCENE_LEVEL && data < DALI2_L_APP_STD_CMD_QUERY_SCENE_LEVEL + DALI2_SIM_GEAR_SCENE_COUNT) {
+        __dali2_sim_gear_reply(gear, gear->scene[data & 0x0F]);
+        return;
+    }
+
+    switch (data) {
+        case DALI2_L_APP_STD_CMD_OFF:
+            __dali2_sim_gear_level_start(gear, 0, 0);
+            break;
+
+        case DALI2_L_APP_STD_CMD_UP:
+        case DALI2_L_APP_STD_CMD_DOWN:
+            //! Fade during 200 ms with fade rate, doesn't switch lamp on or off
+            if (!actual) {
+                break;
+            }
+            steps = __fade_rate_x10[gear->fade_rate] * DALI2_SIM_GEAR_UP_DOWN_FADE_MS / 10000;
+            if (data == DALI2_L_APP_STD_CMD_UP) {
+                steps = (actual + steps > gear->max_level) ? gear->max_level : actual + steps;
+            } else {
+                steps = (actual < gear->min_level + steps) ? gear->min_level : actual - steps;
+            }
+            __dali2_sim_gear_level_start(gear, (unsigned char) steps, DALI2_SIM_GEAR_UP_DOWN_FADE_MS);
+            break;
+
+        case DALI2_L_APP_STD_CMD_STEP_UP:
+            if (actual && actual < gear->max_level) {
+                __dali2_sim_gear_level_start(gear, actual + 1, 0);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_STEP_DOWN:
+            if (actual && actual > gear->min_level) {
+                __dali2_sim_gear_level_start(gear, actual - 1, 0);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_RECALL_MAX_LEVEL:
+            __dali2_sim_gear_level_start(gear, gear->max_level, 0);
+            break;
+
+        case DALI2_L_APP_STD_CMD_RECALL_MIN_LEVEL:
+            __dali2_sim_gear_level_start(gear, gear->min_level, 0);
+            break;
+
+        case DALI2_L_APP_STD_CMD_STEP_DOWN_AND_OFF:
+            if (actual) {
+                __dali2_sim_gear_level_start(gear, (actual <= gear->min_level) ? 0 : actual - 1, 0);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_ON_AND_STEP_UP:
+            if (!actual) {
+                __dali2_sim_gear_level_start(gear, gear->min_level, 0);
+            } else if (actual < gear->max_level) {
+                __dali2_sim_gear_level_start(gear, actual + 1, 0);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_ENABLE_DAPC_SEQUENCE:
+            break;
+
+        case DALI2_L_APP_STD_CMD_GO_TO_LAST_ACTIVE_LEVEL:
+            __dali2_sim_gear_level_start(gear, gear->last_active_level, __dali2_sim_gear_fade_time_ms(gear));
+            break;
+
+        //! ***** Configuration commands, received twice *****
+        case DALI2_L_APP_STD_CMD_RESET:
+            __dali2_sim_gear_vars_reset(gear);
+            gear->level_from = gear->level_to = DALI2_SIM_GEAR_LEVEL_MAX;
+            gear->fade_us = 0;
+            if (gear->cfg.quirks & DALI2_SIM_GEAR_QUIRK_RESET_BUSY) {
+                gear->busy_until = now + DALI2_SIM_GEAR_RESET_BUSY_US;
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_STORE_ACTUAL_LEVEL_IN_DTR0:
+            gear->dtr0 = actual;
+            break;
+
+        case DALI2_L_APP_STD_CMD_SAVE_PERSISTENT_VARIABLES:
+        case DALI2_L_APP_STD_CMD_RESET_MEMORY_BANK:
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_OPERATING_MODE:
+            if (gear->dtr0 == 0 || gear->dtr0 >= 0x80) {
+                gear->operating_mode = gear->dtr0;
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_IDENTIFY_DEVICE:
+            gear->identify_until = now + DALI2_SIM_GEAR_IDENTIFY_US;
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_MAX_LEVEL_DTR0:
+            gear->max_level = (gear->dtr0 < gear->min_level) ? gear->min_level :
+                              (gear->dtr0 > DALI2_SIM_GEAR_LEVEL_MAX) ? DALI2_SIM_GEAR_LEVEL_MAX : gear->dtr0;
+            gear->reset_state = 0;
+            if (actual > gear->max_level) {
+                __dali2_sim_gear_level_start(gear, gear->max_level, 0);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_MIN_LEVEL_DTR0:
+            gear->min_level = (gear->dtr0 < gear->cfg.phys_min_level) ? gear->cfg.phys_min_level :
+                              (gear->dtr0 > gear->max_level) ? gear->max_level : gear->dtr0;
+            gear->reset_state = 0;
+            if (actual && actual < gear->min_level) {
+                __dali2_sim_gear_level_start(gear, gear->min_level, 0);
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_SYSTEM_FAILURE_LEVEL_DTR0:
+            gear->system_failure_level = gear->dtr0;
+            gear->reset_state = 0;
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_POWER_ON_LEVEL_DTR0:
+            gear->power_on_level = gear->dtr0;
+            gear->reset_state = 0;
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_FADE_TIME_DTR0:
+            gear->fade_time = (gear->dtr0 > 15) ? 15 : gear->dtr0;
+            gear->reset_state = 0;
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_FADE_RATE_DTR0:
+            gear->fade_rate = (gear->dtr0 > 15) ? 15 : (gear->dtr0 ? gear->dtr0 : 1);
+            gear->reset_state = 0;
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_EXTENDED_FADE_TIME_DTR0:
+            if (gear->dtr0 > 0x4F) {
+                gear->ext_fade_base = 0;
+                gear->ext_fade_mul = 0;
+            } else {
+                gear->ext_fade_base = gear->dtr0 & 0x0F;
+                gear->ext_fade_mul = (gear->dtr0 >> 4) & 0x07;
+            }
+            gear->reset_state = 0;
+            break;
+
+        case DALI2_L_APP_STD_CMD_SET_SHORT_ADDRESS_DTR0:
+            if (gear->dtr0 == DALI2_SIM_GEAR_MASK) {
+                gear->short_addr = DALI2_SIM_GEAR_MASK;
+            } else if ((gear->dtr0 & 0x81) == 0x01) {
+                gear->short_addr = gear->dtr0 >> 1;
+            }
+            break;
+
+        case DALI2_L_APP_STD_CMD_ENABLE_WRITE_MEMORY:
+            gear->write_enable = 1;
+            break;
+
+        //! ***** Queries *****
+        case DALI2_L_APP_STD_CMD_QUERY_STATUS:
+            __dali2_sim_gear_reply(gear, __dali2_sim_gear_status(gear, now));
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_CONTROL_GEAR_PRESENT:
+            __dali2_sim_gear_reply_yes(gear, 1);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_LAMP_FAILURE:
+            __dali2_sim_gear_reply_yes(gear, gear->cfg.fail_flags & DALI2_SIM_GEAR_FAIL_LAMP);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_LAMP_POWER_ON:
+            __dali2_sim_gear_reply_yes(gear, actual && !(gear->cfg.fail_flags & DALI2_SIM_GEAR_FAIL_LAMP));
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_LIMIT_ERROR:
+            __dali2_sim_gear_reply_yes(gear, gear->limit_error);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_RESET_STATE:
+            __dali2_sim_gear_reply_yes(gear, gear->reset_state);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_MISSING_SHORT_ADDRESS:
+            __dali2_sim_gear_reply_yes(gear, gear->short_addr == DALI2_SIM_GEAR_MASK);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_VERSION_NUMBER:
+            __dali2_sim_gear_reply(gear, DALI2_SIM_GEAR_VERSION_NUMBER);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_CONTENT_DTR0:
+            __dali2_sim_gear_reply(gear, gear->dtr0);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_DEVICE_TYPE:
+            __dali2_sim_gear_reply(gear, gear->cfg.device_type);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_PHYSICAL_MINIMUM:
+            __dali2_sim_gear_reply(gear, gear->cfg.phys_min_level);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_POWER_FAILURE:
+            __dali2_sim_gear_reply_yes(gear, gear->power_failure);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_CONTENT_DTR1:
+            __dali2_sim_gear_reply(gear, gear->dtr1);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_CONTENT_DTR2:
+            __dali2_sim_gear_reply(gear, gear->dtr2);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_OPERATING_MODE:
+            __dali2_sim_gear_reply(gear, gear->operating_mode);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_LIGHT_SOURCE_TYPE:
+            __dali2_sim_gear_reply(gear, (gear->cfg.device_type == DALI2_SIM_GEAR_DEVICE_TYPE_LED) ? 0x06 : 0xFC);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_ACTUAL_LEVEL:
+            __dali2_sim_gear_reply(gear, actual);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_MAX_LEVEL:
+            __dali2_sim_gear_reply(gear, gear->max_level);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_MIN_LEVEL:
+            __dali2_sim_gear_reply(gear, gear->min_level);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_POWER_ON_LEVEL:
+            __dali2_sim_gear_reply(gear, gear->power_on_level);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_SYSTEM_FAILURE_LEVEL:
+            __dali2_sim_gear_reply(gear, gear->system_failure_level);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_FADE_TIME_FADE_RATE:
+            __dali2_sim_gear_reply(gear, (unsigned char) ((gear->fade_time << 4) | gear->fade_rate));
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_MANUFACTURER_SPECIFIC_MODE:
+            __dali2_sim_gear_reply_yes(gear, gear->operating_mode >= 0x80);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_NEXT_DEVICE_TYPE:
+            //! Single device type only
+            __dali2_sim_gear_reply(gear, DALI2_SIM_GEAR_DEVICE_TYPE_NONE);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_EXTENDED_FADE_TIME:
+            __dali2_sim_gear_reply(gear, (unsigned char) ((gear->ext_fade_mul << 4) | gear->ext_fade_base));
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_CONTROL_GEAR_FAILURE:
+            __dali2_sim_gear_reply_yes(gear, gear->cfg.fail_flags & DALI2_SIM_GEAR_FAIL_GEAR);
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_GROUPS_0_7:
+            __dali2_sim_gear_reply(gear, (unsigned char) (gear->groups & 0xFF));
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_GROUPS_8_15:
+            __dali2_sim_gear_reply(gear, (unsigned char) (gear->groups >> 8));
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_RANDOM_ADDRESS_H:
+            __dali2_sim_gear_reply(gear, (unsigned char) (gear->random_addr >> 16));
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_RANDOM_ADDRESS_M:
+            __dali2_sim_gear_reply(gear, (unsigned char) (gear->random_addr >> 8));
+            break;
+
+        case DALI2_L_APP_STD_CMD_QUERY_RANDOM_ADDRESS_L:
+            __dali2_sim_gear_reply(gear, (unsigned char) gear->random_addr);
+            break;
+
+        case DALI2_L_APP_STD_CMD_READ_MEMORY_LOCATION_DTR1_DTR0:
+            //! Memory bank 0 only, location pointer moves after every read
+            if (gear->dtr1 == 0 && gear->dtr0 < DALI2_SIM_GEAR_BANK0_SIZE) {
+                __dali2_sim_gear_reply(gear, gear->bank0[gear->dtr0]);
+            }
+            if (gear->dtr1 == 0 && gear->dtr0 < DALI2_SIM_GEAR_MASK) {
+                gear->dtr0++;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void __dali2_sim_gear_frame(dali2_sim_gear_t *gear, unsigned int frame)
+{
+    dali2_sim_time_t now = dali2_sim_sched_now();
+    unsigned char addr_byte = (unsigned char) (frame >> 8);
+    unsigned char data = (unsigned char) frame;
+    int is_repeat, is_dt, is_dt6;
+    unsigned char dt;
+
+    if (gear->cfg.fail_flags & DALI2_SIM_GEAR_FAIL_DEAD) {
+        return;
+    }
+
+    gear->stats.rx_frames++;
+
+    if (now < gear->busy_until) {
+        return;
+    }
+
+    if (gear->init_state != DALI2_SIM_GEAR_INIT_DISABLED && now >= gear->init_until) {
+        gear->init_state = DALI2_SIM_GEAR_INIT_DISABLED;
+    }
+
+    //! Second frame of the pair has to be the same and within 100 ms
+    is_repeat = gear->is_twice_pending && gear->twice_frame == frame &&
+                (now - gear->twice_at) <= DALI2_SIM_GEAR_SEND_TWICE_US;
+    if (gear->is_twice_pending && !is_repeat) {
+        gear->stats.twice_missed++;
+    }
+
+    //! ENABLE DEVICE TYPE is applied to the next command only, repetition keeps it
+    is_dt = (is_repeat) ? gear->is_twice_dt : gear->is_dt_enabled;
+    dt = (is_repeat) ? gear->twice_dt : gear->enabled_dt;
+    is_dt6 = (gear->cfg.device_type == DALI2_SIM_GEAR_DEVICE_TYPE_LED) &&
+             ((is_dt && dt == DALI2_SIM_GEAR_DEVICE_TYPE_LED) || (gear->cfg.quirks & DALI2_SIM_GEAR_QUIRK_DT6_NO_ENABLE));
+    gear->is_dt_enabled = 0;
+
+    if (addr_byte == (DALI2_L_APP_LED_CMD_ENABLE_DEVICE_TYPE_6 >> 8)) {
+        gear->enabled_dt = data;
+        gear->is_dt_enabled = 1;
+        gear->is_twice_pending = 0;
+        return;
+    }
+
+    if (__dali2_sim_gear_is_config(addr_byte, data, is_dt6)) {
+        if (!is_repeat) {
+            gear->twice_frame = frame;
+            gear->twice_at = now;
+            gear->twice_dt = dt;
+            gear->is_twice_dt = is_dt;
+            gear->is_twice_pending = 1;
+
+            if (!(gear->cfg.quirks & DALI2_SIM_GEAR_QUIRK_NO_SEND_TWICE)) {
+                return;
+            }
+        } else {
+            gear->is_twice_pending = 0;
+        }
+    } else {
+        gear->is_twice_pending = 0;
+    }
+
+    if (DALI2_SIM_GEAR_ADDR_IS_SPECIAL(addr_byte)) {
+        __dali2_sim_gear_special_exec(gear, addr_byte, data);
+        return;
+    }
+
+    if (!__dali2_sim_gear_is_addressed(gear, addr_byte)) {
+        return;
+    }
+    gear->stats.executed++;
+
+    if (!(addr_byte & 0x01)) {
+        //! Direct arc power control, MASK stops fading
+        if (data == DALI2_SIM_GEAR_MASK) {
+            __dali2_sim_gear_level_stop(gear);
+        } else {
+            __dali2_sim_gear_level_start(gear, data, __dali2_sim_gear_fade_time_ms(gear));
+        }
+        return;
+    }
+
+    __dali2_sim_gear_std_exec(gear, data, is_dt6);
+}
+
+static void __dali2_sim_gear_line_fw_handler(void *ctx, dali2_sim_bus_t *bus, unsigned int frame, unsigned char bits)
+{
+    dali2_sim_gear_line_t *line = (dali2_sim_gear_line_t *) ctx;
+    unsigned int i;
+
+    //! Control gear accepts 16-bit forward frames only
+    if (bits != DALI2_SIM_GEAR_FRAME_BITS) {
+        return;
+    }
+
+    for (i = 0; i < line->gear_count; i++) {
+        __dali2_sim_gear_frame(&line->gear[i], frame);
+    }
+}
+
+void dali2_sim_gear_cfg_default(dali2_sim_gear_cfg_t *cfg)
+{
+    memset(cfg, 0x00, sizeof(dali2_sim_gear_cfg_t));
+
+    cfg->device_type = DALI2_SIM_GEAR_DEVICE_TYPE_LED;
+    cfg->short_addr = DALI2_SIM_GEAR_MASK;
+    cfg->random_addr = DALI2_SIM_GEAR_RANDOM_ADDR_MASK;
+    cfg->seed = 0x2F6E2B1;
+    cfg->phys_min_level = 1;
+    cfg->led_features = 0x12;       //! Open circuit detection, current protector
+    cfg->reply_delay_us = DALI2_SIM_GEAR_REPLY_DELAY_US;
+}
+
+dali2_ret_t dali2_sim_gear_line_init(dali2_sim_gear_line_t *line, dali2_sim_bus_t *bus)
+{
+    memset(line, 0x00, sizeof(dali2_sim_gear_line_t));
+    line->bus = bus;
+
+    return dali2_sim_bus_responder_add(bus, __dali2_sim_gear_line_fw_handler, line);
+}
+
+dali2_sim_gear_t *dali2_sim_gear_add(dali2_sim_gear_line_t *line, const dali2_sim_gear_cfg_t *cfg)
+{
+    dali2_sim_gear_t *gear;
+
+    if (!cfg || line->gear_count >= DALI2_SIM_GEAR_LINE_MAX) {
+        return NULL;
+    }
+
+    gear = &line->gear[line->gear_count];
+    memset(gear, 0x00, sizeof(dali2_sim_gear_t));
+
+    gear->line = line;
+    memcpy(&gear->cfg, cfg, sizeof(dali2_sim_gear_cfg_t));
+
+    //! Distinct generator per gear even for the same seed
+    gear->rand_state = cfg->seed ? cfg->seed : 1;
+    gear->rand_state ^= (line->gear_count + 1) * 0x9E3779B9;
+    if (!gear->rand_state) {
+        gear->rand_state = 1;
+    }
+
+    __dali2_sim_gear_vars_reset(gear);
+    __dali2_sim_gear_bank0_init(gear);
+
+    gear->short_addr = cfg->short_addr;
+    gear->random_addr = cfg->random_addr & DALI2_SIM_GEAR_RANDOM_ADDR_MASK;
+
+    dali2_sim_gear_power_cycle(gear);
+
+    line->gear_count++;
+    return gear;
+}
+
+dali2_sim_gear_t *dali2_sim_gear_find(dali2_sim_gear_line_t *line, unsigned char short_addr)
+{
+    unsigned int i;
+
+    for (i = 0; i < line->gear_count; i++) {
+        if (line->gear[i].short_addr == short_addr) {
+            return &line->gear[i];
+        }
+    }
+
+    return NULL;
+}
+
+void dali2_sim_gear_power_cycle(dali2_sim_gear_t *gear)
+{
+    unsigned char level;
+
+    gear->dtr0 = 0;
+    gear->dtr1 = 0;
+    gear->dtr2 = 0;
+    gear->search_addr = DALI2_SIM_GEAR_RANDOM_ADDR_MASK;
+    gear->init_state = DALI2_SIM_GEAR_INIT_DISABLED;
+    gear->identify_until = 0;
+    gear->busy_until = 0;
+    gear->write_enable = 0;
+    gear->is_twice_pending = 0;
+    gear->is_dt_enabled = 0;
+    gear->limit_error = 0;
+
+    //! Power on level, MASK restores last active level
+    level = (gear->power_on_level == DALI2_SIM_GEAR_MASK) ? gear->last_active_level : gear->power_on_level;
+    if (level) {
+        level = (level > gear->max_level) ? gear->max_level : (level < gear->min_level) ? gear->min_level : level;
+    }
+    gear->level_from = level;
+    gear->level_to = level;
+    gear->fade_us = 0;
+
+    gear->power_cycle_seen = 1;
+    gear->power_failure = 1;
+}
+
+unsigned char dali2_sim_gear_level_get(dali2_sim_gear_t *gear)
+{
+    dali2_sim_time_t now = dali2_sim_sched_now();
+    dali2_sim_time_t elapsed;
+    int from, to;
+
+    if (!__dali2_sim_gear_is_fading(gear, now)) {
+        return gear->level_to;
+    }
+
+    //! Fading from or to off passes through min level
+    from = (gear->level_from) ? gear->level_from : gear->min_level;
+    to = (gear->level_to) ? gear->level_to : gear->min_level;
+    elapsed = now - gear->fade_at;
+
+    return (unsigned char) (from + (to - from) * (long long) elapsed / (long long) gear->fade_us);
+}
@@ -0,0 +1,219 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_sim_gear.h
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host simulation control gear header file
+ *
+ * @details IEC 62386-102 control gear with IEC 62386-207 (LED, device type 6)
+ *          extension. Gear are grouped into lines, every line is a responder
+ *          of single simulated bus, @see dali2_sim_bus.h. Every line holds up to
+ *          DALI2_SIM_GEAR_LINE_MAX gear, lines are independent, so there may be
+ *          many lines per process. All gear are statically allocated inside of line.
+ *
+ *          Supported: short/random addressing and initialisation, DTR0-DTR2,
+ *          levels and fades, scenes, groups, memory bank 0, DT6 queries and
+ *          configuration, send twice verification.
+ */
+#ifndef DALI2_SIM_GEAR_H_
+#define DALI2_SIM_GEAR_H_
+
+#include "dali2_error.h"
+#include "dali2_sim_sched.h"
+#include "dali2_sim_bus.h"
+
+#define DALI2_SIM_GEAR_LINE_MAX             64
+
+#define DALI2_SIM_GEAR_MASK                 0xFF
+#define DALI2_SIM_GEAR_YES                  0xFF
+#define DALI2_SIM_GEAR_RANDOM_ADDR_MASK     0xFFFFFF
+#define DALI2_SIM_GEAR_SCENE_COUNT          16
+
+#define DALI2_SIM_GEAR_DEVICE_TYPE_NONE     254
+#define DALI2_SIM_GEAR_DEVICE_TYPE_LED      6
+
+//! Backward frame starts within 5.5 - 10.5 ms after forward frame
+//! Responder is called DALI2_SIM_BUS_FRAME_END_US after the last edge
+#define DALI2_SIM_GEAR_REPLY_DELAY_US       5500
+#define DALI2_SIM_GEAR_SEND_TWICE_US        100000
+#define DALI2_SIM_GEAR_INITIALISE_US        (15ULL * 60 * 1000000)
+#define DALI2_SIM_GEAR_IDENTIFY_US          10000000
+#define DALI2_SIM_GEAR_RESET_BUSY_US        300000
+
+#define DALI2_SIM_GEAR_BANK0_SIZE           0x1B
+
+//! Failure flags
+typedef enum {
+    DALI2_SIM_GEAR_FAIL_DEAD = 0x01,            //! Gear ignores every frame
+    DALI2_SIM_GEAR_FAIL_LAMP = 0x02,            //! Lamp failure, DT6 open circuit
+    DALI2_SIM_GEAR_FAIL_GEAR = 0x04,            //! Control gear failure
+    DALI2_SIM_GEAR_FAIL_THERMAL = 0x08          //! DT6 thermal overload
+} DALI2_SIM_GEAR_FAIL_T;
+
+//! Firmware quirks seen on real gear
+typedef enum {
+    DALI2_SIM_GEAR_QUIRK_NO_SEND_TWICE = 0x01,  //! Configuration commands are executed on first frame
+    DALI2_SIM_GEAR_QUIRK_DT6_NO_ENABLE = 0x02,  //! DT6 commands are accepted without ENABLE DEVICE TYPE 6
+    DALI2_SIM_GEAR_QUIRK_RESET_BUSY = 0x04,     //! Gear is deaf for DALI2_SIM_GEAR_RESET_BUSY_US after RESET
+    DALI2_SIM_GEAR_QUIRK_LEVEL_ROUNDING = 0x08  //! Fade ends one step below target level
+} DALI2_SIM_GEAR_QUIRK_T;
+
+//! Initialisation state
+typedef enum {
+    DALI2_SIM_GEAR_INIT_DISABLED,
+    DALI2_SIM_GEAR_INIT_ENABLED,
+    DALI2_SIM_GEAR_INIT_WITHDRAWN
+} DALI2_SIM_GEAR_INIT_T;
+
+//! Gear configuration, @see dali2_sim_gear_cfg_default()
+typedef struct {
+    unsigned char device_type;          //! DALI2_SIM_GEAR_DEVICE_TYPE_LED or DALI2_SIM_GEAR_DEVICE_TYPE_NONE
+    unsigned char short_addr;           //! Power-on short address, DALI2_SIM_GEAR_MASK for none
+    unsigned int random_addr;           //! Power-on random address
+    unsigned int seed;                  //! RANDOMISE generator seed, must not be 0
+
+    unsigned char phys_min_level;
+    unsigned char min_fast_fade_time;   //! DT6, 0 for fast fade is not supported
+    unsigned char led_features;         //! DT6, @see DALI2_L_APP_LED_FEATURE_T
+    unsigned char led_gear_type;        //! DT6 QUERY GEAR TYPE answer
+
+    unsigned int reply_delay_us;        //! From forward frame end detection up to backward frame
+    unsigned int reply_jitter_us;       //! Random extension of reply delay
+    unsigned char reply_loss_pct;       //! Percent of dropped replies
+
+    unsigned char fail_flags;           //! @see DALI2_SIM_GEAR_FAIL_T
+    unsigned char quirks;               //! @see DALI2_SIM_GEAR_QUIRK_T
+
+    unsigned long long gtin;            //! Memory bank 0
+    unsigned long long serial;          //! Memory bank 0 identification number
+} dali2_sim_gear_cfg_t;
+
+//! Gear statistics
+typedef struct {
+    unsigned long long rx_frames;       //! Forward frames seen on the line
+    unsigned long long executed;        //! Addressed and executed commands
+    unsigned long long replies;         //! Sent backward frames
+    unsigned long long replies_lost;    //! Dropped by reply_loss_pct or busy bus transmitters
+    unsigned long long twice_missed;    //! Configuration commands without repetition
+} dali2_sim_gear_stats_t;
+
+typedef struct dali2_sim_gear_line_s dali2_sim_gear_line_t;
+
+//! Gear handle. Read-only for users, changed by simulated traffic
+typedef struct {
+    dali2_sim_gear_line_t *line;
+    dali2_sim_gear_cfg_t cfg;
+
+    //! Addressing
+    unsigned char short_addr;
+    unsigned int random_addr;
+    unsigned int search_addr;
+    unsigned short groups;
+    DALI2_SIM_GEAR_INIT_T init_state;
+    dali2_sim_time_t init_until;
+
+    //! Data transfer registers
+    unsigned char dtr0;
+    unsigned char dtr1;
+    unsigned char dtr2;
+
+    //! Persistent variables
+    unsigned char max_level;
+    unsigned char min_level;
+    unsigned char power_on_level;
+    unsigned char system_failure_level;
+    unsigned char fade_time;
+    unsigned char fade_rate;
+    unsigned char ext_fade_base;
+    unsigned char ext_fade_mul;
+    unsigned char last_active_level;
+    unsigned char operating_mode;
+    unsigned char scene[DALI2_SIM_GEAR_SCENE_COUNT];
+
+    //! Level fading from level_from up to level_to
+    unsigned char level_from;
+    unsigned char level_to;
+    dali2_sim_time_t fade_at;
+    dali2_sim_time_t fade_us;
+
+    //! DT6 variables
+    unsigned char dimming_curve;
+    unsigned char fast_fade_time;
+    unsigned char current_protector_en;
+
+    unsigned char bank0[DALI2_SIM_GEAR_BANK0_SIZE];
+
+    //! Send twice and ENABLE DEVICE TYPE tracking
+    unsigned int twice_frame;
+    dali2_sim_time_t twice_at;
+    unsigned char twice_dt;
+    unsigned char enabled_dt;
+
+    dali2_sim_time_t identify_until;
+    dali2_sim_time_t busy_until;
+    unsigned int rand_state;
+
+    unsigned char limit_error:1;
+    unsigned char reset_state:1;
+    unsigned char power_cycle_seen:1;
+    unsigned char power_failure:1;
+    unsigned char write_enable:1;
+    unsigned char is_twice_pending:1;
+    unsigned char is_dt_enabled:1;
+    unsigned char is_twice_dt:1;
+
+    dali2_sim_gear_stats_t stats;
+} dali2_sim_gear_t;
+
+//! Line of gear connected to single bus
+struct dali2_sim_gear_line_s {
+    dali2_sim_bus_t *bus;
+    dali2_sim_gear_t gear[DALI2_SIM_GEAR_LINE_MAX];
+    unsigned int gear_count;
+};
+
+/**@brief Default configuration: LED gear without address, reply in 5.5 ms
+ *
+ * @param[OUT] cfg - gear configuration
+ */
+void dali2_sim_gear_cfg_default(dali2_sim_gear_cfg_t *cfg);
+
+/**@brief Line initialization. Line becomes responder of the bus.
+ *
+ * @param[IN] line - line handle
+ * @param[IN] bus - initialized bus
+ * @return DALI2_RET_SUCCESS or @see dali2_sim_bus_responder_add()
+ */
+dali2_ret_t dali2_sim_gear_line_init(dali2_sim_gear_line_t *line, dali2_sim_bus_t *bus);
+
+/**@brief Adding powered-on gear into the line
+ *
+ * @param[IN] line - line handle
+ * @param[IN] cfg - gear configuration
+ * @return gear handle or NULL if line is full
+ */
+dali2_sim_gear_t *dali2_sim_gear_add(dali2_sim_gear_line_t *line, const dali2_sim_gear_cfg_t *cfg);
+
+/**@brief Finding gear by short address
+ *
+ * @return gear handle or NULL if not found
+ */
+dali2_sim_gear_t *dali2_sim_gear_find(dali2_sim_gear_line_t *line, unsigned char short_addr);
+
+/**@brief Power cycle of gear. Volatile state is lost, persistent variables are kept.
+ *
+ * @param[IN] gear - gear handle
+ */
+void dali2_sim_gear_power_cycle(dali2_sim_gear_t *gear);
+
+/**@brief Actual arc power level at current virtual time
+ *
+ * @param[IN] gear - gear handle
+ * @return actual level
+ */
+unsigned char dali2_sim_gear_level_get(dali2_sim_gear_t *gear);
+
+#endif /* DALI2_SIM_GEAR_H_ */
@@ -0,0 +1,241 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_sim_sched.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host simulation discrete-event scheduler source file
+ *
+ * @details Events are kept in binary min-heap ordered by time and insertion
+ *          order, so events of the same time are executed in FIFO order.
+ *          Cancel is lazy: cancelled event is dropped when it reaches the top.
+ */
+
+#include <string.h>
+
+#include "dali2_sim_sched.h"
+
+//! Event identifier: [generation:16] [slot:16]
+#define DALI2_SIM_SCHED_ID(SLOT, GEN)   ((int) ((((GEN) & 0x7FFF) << 16) | (SLOT)))
+#define DALI2_SIM_SCHED_ID_SLOT(ID)     ((ID) & 0xFFFF)
+#define DALI2_SIM_SCHED_ID_GEN(ID)      (((ID) >> 16) & 0x7FFF)
+
+typedef struct {
+    dali2_sim_time_t at;
+    unsigned long long seq;
+    dali2_sim_sched_func_t func;
+    void *ctx;
+    unsigned short gen;
+    unsigned char is_active:1;
+    unsigned char is_used:1;
+} dali2_sim_sched_evt_t;
+
+typedef struct {
+    dali2_sim_time_t now;
+    unsigned long long seq;
+    unsigned long long evt_count;
+
+    dali2_sim_sched_evt_t evt[DALI2_SIM_SCHED_EVT_MAX];
+    unsigned short free_list[DALI2_SIM_SCHED_EVT_MAX];
+    unsigned int free_count;
+
+    unsigned short heap[DALI2_SIM_SCHED_EVT_MAX];
+    unsigned int heap_count;
+} dali2_sim_sched_handle_t;
+
+static dali2_sim_sched_handle_t __sched_handle;
+
+static inline int __dali2_sim_sched_less(unsigned short a, unsigned short b)
+{
+    dali2_sim_sched_evt_t *evt_a = &__sched_handle.evt[a];
+    dali2_sim_sched_evt_t *evt_b = &__sched_handle.evt[b];
+
+    if (evt_a->at != evt_b->at) {
+        return evt_a->at < evt_b->at;
+    }
+
+    return evt_a->seq < evt_b->seq;
+}
+
+static void __dali2_sim_sched_heap_push(unsigned short slot)
+{
+    unsigned int pos = __sched_handle.heap_count++;
+    unsigned int parent;
+
+    while (pos) {
+        parent = (pos - 1) / 2;
+        if (!__dali2_sim_sched_less(slot, __sched_handle.heap[parent])) {
+            break;
+        }
+        __sched_handle.heap[pos] = __sched_handle.heap[parent];
+        pos = parent;
+    }
+
+    __sched_handle.heap[pos] = slot;
+}
+
+static unsigned short __dali2_sim_sched_heap_pop(void)
+{
+    unsigned short top = __sched_handle.heap[0];
+    unsigned short last = __sched_handle.heap[--__sched_handle.heap_count];
+    unsigned int pos = 0;
+    unsigned int child;
+
+    while ((child = pos * 2 + 1) < __sched_handle.heap_count) {
+        if ((child + 1) < __sched_handle.heap_count &&
+            __dali2_sim_sched_less(__sched_handle.heap[child + 1], __sched_handle.heap[child])) {
+            child++;
+        }
+        if (!__dali2_sim_sched_less(__sched_handle.heap[child], last)) {
+            break;
+        }
+        __sched_handle.heap[pos] = __sched_handle.heap[child];
+        pos = child;
+    }
+
+    if (__sched_handle.heap_count) {
+        __sched_handle.heap[pos] = last;
+    }
+
+    return top;
+}
+
+static inline void __dali2_sim_sched_free(unsigned short slot)
+{
+    __sched_handle.evt[slot].is_used = 0;
+    __sched_handle.evt[slot].gen++;
+    __sched_handle.free_list[__sched_handle.free_count++] = slot;
+}
+
+//! Drop cancelled events from the heap top
+static void __dali2_sim_sched_purge(void)
+{
+    unsigned short slot;
+
+    while (__sched_handle.heap_count &&
+           !__sched_handle.evt[__sched_handle.heap[0]].is_active) {
+        slot = __dali2_sim_sched_heap_pop();
+        __dali2_sim_sched_free(slot);
+    }
+}
+
+void dali2_sim_sched_init(void)
+{
+    unsigned int i;
+
+    memset(&__sched_handle, 0x00, sizeof(__sched_handle));
+
+    for (i = 0; i < DALI2_SIM_SCHED_EVT_MAX; i++) {
+        __sched_handle.free_list[i] = (unsigned short) (DALI2_SIM_SCHED_EVT_MAX - 1 - i);
+    }
+    __sched_handle.free_count = DALI2_SIM_SCHED_EVT_MAX;
+}
+
+dali2_sim_time_t dali2_sim_sched_now(void)
+{
+    return __sched_handle.now;
+}
+
+int dali2_sim_sched_add(dali2_sim_time_t at, dali2_sim_sched_func_t func, void *ctx)
+{
+    unsigned short slot;
+    dali2_sim_sched_evt_t *evt;
+
+    if (!func || !__sched_handle.free_count) {
+        return DALI2_SIM_SCHED_EVT_INVALID;
+    }
+
+    slot = __sched_handle.free_list[--__sched_handle.free_count];
+    evt = &__sched_handle.evt[slot];
+
+    evt->at = (at < __sched_handle.now) ? __sched_handle.now : at;
+    evt->seq = __sched_handle.seq++;
+    evt->func = func;
+    evt->ctx = ctx;
+    evt->is_active = 1;
+    evt->is_used = 1;
+
+    __dali2_sim_sched_heap_push(slot);
+
+    return DALI2_SIM_SCHED_ID(slot, evt->gen);
+}
+
+int dali2_sim_sched_add_in(dali2_sim_time_t delay_us, dali2_sim_sched_func_t func, void *ctx)
+{
+    return dali2_sim_sched_add(__sched_handle.now + delay_us, func, ctx);
+}
+
+void dali2_sim_sched_cancel(int evt_id)
+{
+    dali2_sim_sched_evt_t *evt;
+
+    if (evt_id < 0 || DALI2_SIM_SCHED_ID_SLOT(evt_id) >= DALI2_SIM_SCHED_EVT_MAX) {
+        return;
+    }
+
+    evt = &__sched_handle.evt[DALI2_SIM_SCHED_ID_SLOT(evt_id)];
+    if (evt->is_used && (evt->gen & 0x7FFF) == DALI2_SIM_SCHED_ID_GEN(evt_id)) {
+        evt->is_active = 0;
+    }
+}
+
+dali2_ret_t dali2_sim_sched_next(dali2_sim_time_t *at)
+{
+    __dali2_sim_sched_purge();
+
+    if (!__sched_handle.heap_count) {
+        return DALI2_RET_BUSY;
+    }
+
+    *at = __sched_handle.evt[__sched_handle.heap[0]].at;
+    return DALI2_RET_SUCCESS;
+}
+
+int dali2_sim_sched_step(void)
+{
+    unsigned short slot;
+    dali2_sim_sched_func_t func;
+    void *ctx;
+
+    __dali2_sim_sched_purge();
+
+    if (!__sched_handle.heap_count) {
+        return 0;
+    }
+
+    slot = __dali2_sim_sched_heap_pop();
+    __sched_handle.now = __sched_handle.evt[slot].at;
+    func = __sched_handle.evt[slot].func;
+    ctx = __sched_handle.evt[slot].ctx;
+
+    //! Free slot before execution, event function may schedule again
+    __dali2_sim_sched_free(slot);
+
+    __sched_handle.evt_count++;
+    func(ctx);
+
+    return 1;
+}
+
+unsigned int dali2_sim_sched_run_until(dali2_sim_time_t at)
+{
+    unsigned int count = 0;
+    dali2_sim_time_t next;
+
+    while (dali2_sim_sched_next(&next) == DALI2_RET_SUCCESS && next <= at) {
+        count += dali2_sim_sched_step();
+    }
+
+    if (__sched_handle.now < at) {
+        __sched_handle.now = at;
+    }
+
+    return count;
+}
+
+unsigned long long dali2_sim_sched_evt_count(void)
+{
+    return __sched_handle.evt_count;
+}
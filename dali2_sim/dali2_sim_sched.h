@@ -0,0 +1,92 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_sim_sched.h
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host simulation discrete-event scheduler header file
+ *
+ * @details Virtual time scheduler for host builds. Nothing sleeps:
+ *          time jumps from one event to the next one, so bus traffic
+ *          runs as fast as CPU handles events.
+ */
+#ifndef DALI2_SIM_SCHED_H_
+#define DALI2_SIM_SCHED_H_
+
+#include "dali2_error.h"
+
+//! Maximum pending events
+#ifndef DALI2_SIM_SCHED_EVT_MAX
+#define DALI2_SIM_SCHED_EVT_MAX         1024
+#endif
+
+#define DALI2_SIM_SCHED_EVT_INVALID     (-1)
+
+//! Virtual time in microseconds
+typedef unsigned long long dali2_sim_time_t;
+
+/**@brief Scheduled event function type
+ *
+ * @param[IN] ctx - context given on @ref dali2_sim_sched_add()
+ */
+typedef void (* dali2_sim_sched_func_t) (void *ctx);
+
+//! @brief Scheduler initialization. Virtual time starts from 0
+void dali2_sim_sched_init(void);
+
+//! @brief Current virtual time
+dali2_sim_time_t dali2_sim_sched_now(void);
+
+/**@brief Adding event
+ *
+ * @param[IN] at - virtual time of execution. Past time is executed as soon as possible
+ * @param[IN] func - event function
+ * @param[IN] ctx - event function context
+ * @return Event identifier for @ref dali2_sim_sched_cancel()
+ *         or DALI2_SIM_SCHED_EVT_INVALID if no free events
+ */
+int dali2_sim_sched_add(dali2_sim_time_t at, dali2_sim_sched_func_t func, void *ctx);
+
+/**@brief Adding event relatively current virtual time
+ *
+ * @param[IN] delay_us - delay from now
+ * @param[IN] func - event function
+ * @param[IN] ctx - event function context
+ * @return @see dali2_sim_sched_add()
+ */
+int dali2_sim_sched_add_in(dali2_sim_time_t delay_us, dali2_sim_sched_func_t func, void *ctx);
+
+/**@brief Canceling event
+ * @note  Already executed or cancelled event is ignored
+ *
+ * @param[IN] evt_id - event identifier
+ */
+void dali2_sim_sched_cancel(int evt_id);
+
+/**@brief Time of the next pending event
+ *
+ * @param[OUT] at - next event time
+ * @return DALI2_RET_SUCCESS - there is pending event
+ *         DALI2_RET_BUSY - no pending events
+ */
+dali2_ret_t dali2_sim_sched_next(dali2_sim_time_t *at);
+
+/**@brief Executing the next pending event, virtual time jumps to it
+ *
+ * @return 1 - event executed, 0 - no pending events
+ */
+int dali2_sim_sched_step(void);
+
+/**@brief Executing all events up to the time, then virtual time is set to it
+ *
+ * @param[IN] at - virtual time
+ * @return Count of executed events
+ */
+unsigned int dali2_sim_sched_run_until(dali2_sim_time_t at);
+
+//! @brief Count of executed events since initialization
+unsigned long long dali2_sim_sched_evt_count(void);
+
+#endif /* DALI2_SIM_SCHED_H_ */
@@ -0,0 +1,266 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_bus_noise_bench.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host side bus fault matrix
+ *
+ * @details Runs the same traffic over simulated line with every noise model
+ *          and prints how Physical layer classified received frames together
+ *          with retry overhead of Application layer commands. Then checks that
+ *          backward frame of another device during priority settling time does
+ *          not end own query.
+ *
+ *          Build together with driver sources, dali2_bsp/dali2_l_bsp_host.c
+ *          and dali2_sim/ sources, @see README.md "Host simulation".
+ *          Usage: dali2_bus_noise_bench [operations per fault]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dali2_l_app.h"
+#include "dali2_l_bsp_host.h"
+#include "dali2_sim_gear.h"
+
+#define BENCH_GEAR_COUNT            4
+#define BENCH_OPS_DEFAULT           200
+#define BENCH_ATTEMPTS_MAX          4
+#define BENCH_CMD_TIMEOUT_US        500000
+#define BENCH_SETTLING_US           30000
+
+//! Foreign backward frames: the first one makes the line recently busy, the second one
+//! comes during priority settling time of own query
+#define BENCH_FOREIGN_BACKWARD      0x55
+#define BENCH_FOREIGN_IDLE_US       14000
+#define BENCH_FOREIGN_DELAY_US      3000
+
+typedef struct {
+    const char *name;
+    dali2_sim_bus_noise_t noise;
+} bench_fault_t;
+
+typedef struct {
+    unsigned int ok;
+    unsigned int failed;
+    unsigned int attempts;
+    unsigned int fault;
+    unsigned int timeout;
+    unsigned int unexpected;
+    unsigned int exec_busy;
+} bench_result_t;
+
+static const bench_fault_t __faults[] = {
+    //!                               fall  rise  jitter glitch% width coll% skew  seed
+    { "clean",                      {   0,    0,     0,    0,     0,    0,    0,    1 } },
+    { "jitter 50us",                {   0,    0,    50,    0,     0,    0,    0,    1 } },
+    { "jitter 150us",               {   0,    0,   150,    0,     0,    0,    0,    1 } },
+    { "jitter 300us",               {   0,    0,   300,    0,     0,    0,    0,    1 } },
+    { "slow rise 100us",            {   0,  100,     0,    0,     0,    0,    0,    1 } },
+    { "slow rise 400us",            {   0,  400,     0,    0,     0,    0,    0,    1 } },
+    { "slow fall 100us",            { 100,    0,     0,    0,     0,    0,    0,    1 } },
+    { "glitch 2% 30us",             {   0,    0,     0,    2,    30,    0,    0,    1 } },
+    { "glitch 10% 100us",           {   0,    0,     0,   10,   100,    0,    0,    1 } },
+    { "backward collision 20%",     {   0,    0,     0,    0,     0,   20,    0,    1 } },
+    { "backward collision 20% skew",{   0,    0,     0,    0,     0,   20,  800,    1 } },
+    { "site mix",                   {  20,   80,    60,    1,    40,    5,  400,    1 } },
+};
+
+static const char *__phy_evt_name[DALI2_L_PHY_EVT_COUNT] = {
+    "fw_done", "bw_done", "start_err", "stop_err", "fw_err", "bw_err", "data_vio", "time_vio", "size_vio",
+    "fw_rx"
+};
+
+static dali2_sim_bus_t __bus;
+static dali2_sim_gear_line_t __line;
+
+static unsigned char __is_done;
+static DALI2_L_APP_EVT_T __last_evt;
+static DALI2_L_APP_CMD_T __last_cmd;
+static unsigned char __last_data;
+
+static void __bench_app_evt_handler(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data)
+{
+    __last_evt = evt;
+    __last_cmd = evt_data->cmd;
+    __last_data = evt_data->cmd_data.std_rsp.data;
+    __is_done = 1;
+}
+
+static int __bench_cmd(DALI2_L_APP_CMD_T cmd, dali2_l_app_cmd_data_t *cmd_data, bench_result_t *res)
+{
+    dali2_sim_time_t deadline;
+    unsigned int attempt;
+
+    for (attempt = 0; attempt < BENCH_ATTEMPTS_MAX; attempt++) {
+        res->attempts++;
+
+        __is_done = 0;
+        if (dali2_l_app_cmd_execute(cmd, cmd_data) != DALI2_RET_SUCCESS) {
+            res->exec_busy++;
+            dali2_sim_sched_run_until(dali2_sim_sched_now() + BENCH_SETTLING_US);
+            continue;
+        }
+
+        deadline = dali2_sim_sched_now() + BENCH_CMD_TIMEOUT_US;
+        while (!__is_done && dali2_sim_sched_now() < deadline && dali2_sim_sched_step());
+
+        //! Let the line settle before the next frame
+        dali2_sim_sched_run_until(dali2_sim_sched_now() + BENCH_SETTLING_US);
+
+        if (!__is_done) {
+            res->timeout++;
+            continue;
+        }
+
+        if (__last_evt == DALI2_L_APP_EVT_SUCCESS && __last_cmd == cmd) {
+            return 1;
+        }
+
+        if (__last_evt == DALI2_L_APP_EVT_FAULT) {
+            res->fault++;
+        } else if (__last_evt == DALI2_L_APP_EVT_TIMEOUT) {
+            res->timeout++;
+        } else {
+            res->unexpected++;
+        }
+    }
+
+    return 0;
+}
+
+static void __bench_fault_run(const bench_fault_t *fault, unsigned int ops)
+{
+    dali2_sim_gear_cfg_t cfg;
+    dali2_l_app_cmd_data_t cmd_data;
+    dali2_l_phy_stats_t phy_stats;
+    bench_result_t res;
+    unsigned int i;
+
+    memset(&res, 0x00, sizeof(res));
+
+    dali2_sim_sched_init();
+    dali2_sim_bus_init(&__bus);
+    dali2_sim_gear_line_init(&__line, &__bus);
+
+    dali2_sim_gear_cfg_default(&cfg);
+    for (i = 0; i < BENCH_GEAR_COUNT; i++) {
+        cfg.short_addr = (unsigned char) i;
+        dali2_sim_gear_add(&__line, &cfg);
+    }
+
+    dali2_l_bsp_host_attach(&__bus);
+    dali2_l_app_init(__bench_app_evt_handler);
+
+    //! Startup is done on clean line
+    dali2_sim_sched_run_until(DALI2_L_PHY_STARTUP_TIME_US * 2);
+    dali2_sim_bus_noise_set(&__bus, &fault->noise);
+
+    for (i = 0; i < ops; i++) {
+        memset(&cmd_data, 0x00, sizeof(cmd_data));
+        cmd_data.std_cmd.net.method = DALI2_L_NET_METHOD_SHORT_ADDRESSING;
+        cmd_data.std_cmd.net.addr_byte = (unsigned char) (i % BENCH_GEAR_COUNT);
+
+        if (__bench_cmd((i % 2) ? DALI2_L_APP_CMD_RECALL_MAX_LEVEL : DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL,
+                        &cmd_data, &res)) {
+            res.ok++;
+        } else {
+            res.failed++;
+        }
+    }
+
+    dali2_l_phy_stats_get(&phy_stats);
+
+    printf("%-28s %5u %5u %6.2f %5u %5u %5u %5u",
+           fault->name, res.ok, res.failed, (double) res.attempts / ops,
+           res.fault, res.timeout, res.unexpected, res.exec_busy);
+    for (i = 0; i < DALI2_L_PHY_EVT_COUNT; i++) {
+        printf(" %9u", phy_stats.evt[i]);
+    }
+    printf(" %7llu %7llu %8.2f\n", __bus.stats.error_frames, __bus.stats.glitches,
+           (res.ok) ? (double) __bus.stats.busy_us / 1000.0 / res.ok : 0.0);
+
+    dali2_l_app_deinit();
+    dali2_l_bsp_host_attach(NULL);
+}
+
+static void __bench_foreign_backward_run(void)
+{
+    dali2_sim_gear_cfg_t cfg;
+    dali2_l_app_cmd_data_t cmd_data;
+    dali2_l_ses_stats_t ses_stats;
+    dali2_sim_gear_t *gear;
+    dali2_sim_time_t deadline;
+    dali2_ret_t dali2_ret;
+    unsigned char is_ok;
+
+    dali2_sim_sched_init();
+    dali2_sim_bus_init(&__bus);
+    dali2_sim_gear_line_init(&__line, &__bus);
+
+    dali2_sim_gear_cfg_default(&cfg);
+    cfg.short_addr = 0;
+    gear = dali2_sim_gear_add(&__line, &cfg);
+
+    dali2_l_bsp_host_attach(&__bus);
+    dali2_l_app_init(__bench_app_evt_handler);
+    dali2_sim_sched_run_until(DALI2_L_PHY_STARTUP_TIME_US * 2);
+
+    dali2_sim_bus_backward_send(&__bus, BENCH_FOREIGN_BACKWARD, 0);
+    dali2_sim_sched_run_until(dali2_sim_sched_now() + BENCH_FOREIGN_IDLE_US);
+    dali2_sim_bus_backward_send(&__bus, BENCH_FOREIGN_BACKWARD, BENCH_FOREIGN_DELAY_US);
+
+    //! Query is deferred by the lowest priority window and has to wait again after foreign frame
+    dali2_l_ses_stats_reset();
+    dali2_l_app_priority_set(DALI2_L_SES_PRIORITY_5);
+    memset(&cmd_data, 0x00, sizeof(cmd_data));
+    cmd_data.std_cmd.net.method = DALI2_L_NET_METHOD_SHORT_ADDRESSING;
+    cmd_data.std_cmd.net.addr_byte = 0;
+
+    __is_done = 0;
+    dali2_ret = dali2_l_app_cmd_execute(DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL, &cmd_data);
+    deadline = dali2_sim_sched_now() + BENCH_CMD_TIMEOUT_US;
+    while (!__is_done && dali2_sim_sched_now() < deadline && dali2_sim_sched_step());
+
+    dali2_l_ses_stats_get(&ses_stats);
+    is_ok = (dali2_ret == DALI2_RET_SUCCESS && __is_done && __last_evt == DALI2_L_APP_EVT_SUCCESS &&
+             __last_cmd == DALI2_L_APP_CMD_QUERY_ACTUAL_LEVEL && ses_stats.sent == 1 &&
+             __last_data == dali2_sim_gear_level_get(gear)) ? 1 : 0;
+
+    printf("\n%-28s deferred %u sent %u evt %d answer 0x%02X gear 0x%02X %s\n",
+           "foreign backward in wait", ses_stats.deferred, ses_stats.sent, (__is_done) ? (int) __last_evt : -1,
+           __last_data, dali2_sim_gear_level_get(gear), (is_ok) ? "ok" : "FAILED");
+
+    dali2_l_app_deinit();
+    dali2_l_bsp_host_attach(NULL);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int ops = BENCH_OPS_DEFAULT;
+    unsigned int i;
+
+    if (argc > 1) {
+        ops = (unsigned int) strtoul(argv[1], NULL, 0);
+    }
+
+    dali2_l_bsp_host_print_enable(0);
+
+    printf("%-28s %5s %5s %6s %5s %5s %5s %5s", "fault", "ok", "fail", "tries", "fault", "tmo", "unexp", "busy");
+    for (i = 0; i < DALI2_L_PHY_EVT_COUNT; i++) {
+        printf(" %9s", __phy_evt_name[i]);
+    }
+    printf(" %7s %7s %8s\n", "bus_err", "glitch", "ms/op");
+
+    for (i = 0; i < sizeof(__faults) / sizeof(__faults[0]); i++) {
+        __bench_fault_run(&__faults[i], ops);
+    }
+
+    __bench_foreign_backward_run();
+
+    return 0;
+}
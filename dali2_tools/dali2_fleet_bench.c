@@ -0,0 +1,949 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_fleet_bench.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host side end-to-end fleet benchmark
+ *
+ * @details Runs HAL API over simulated line of control gear, @see dali2_sim_gear.h:
+ *          - addr_alloc:   random address allocation of unaddressed gear
+ *          - dim_cfg:      dali2_hal_dim_cfg() of every gear
+ *          - status_sweep: dali2_hal_dim_get_status() of every gear
+ *          - set_level:    interactive dali2_hal_dim_set_level() of random gear
+ *          - mixed:        random mix of the above without address allocation
+ *          - preempt:      dali2_hal_dim_cfg() of every gear preempted by dali2_hal_dim_set_level()
+ *                          of the next gear at random point, both jobs are checked on the gear
+ *          - edf:          rounds of requests submitted at once to dali2_hal_edf_submit() with
+ *                          deadlines of 1-6 own predicted bus times, set level and state update
+ *                          rounds or dimmer configuration rounds, so jobs do not preempt each other
+ *          - clients:      clients keeping own queue of dali2_hal_client_submit() full for
+ *                          BENCH_CLIENT_TIME_MS: two set level clients of weights 3 and 1 and
+ *                          dimmer configuration client of weight 4 limited to 10% of bus time
+ *
+ *          Operation is done when dali2_hal_process() reports freed HAL,
+ *          latency is virtual time from accepted API call up to that point.
+ *          Address allocation is done when every gear has short address as well.
+ *          Every scenario runs in own process, because HAL state is static.
+ *          Output is one JSON object per line:
+ *          {"scenario", "gear", "ops", "ok", "timeouts" (operations not done), "bus_ms" (line busy time),
+ *          "wall_ms" (virtual time), "frames": {"dapc", "cmd", "special", "fw24",
+ *          "backward", "error"}, "cpu_ms", "lat_ms": {"p50", "p99", "max"},
+ *          "metrics": {"busy_pct", "timeout", "collision", "unexpected", "wait_ms",
+ *          "bus_ms", "settle_ms"} (driver side @see dali2_metrics.h, times are summed
+ *          over HAL jobs, printed when DALI2_METRICS_EN is defined),
+ *          "assigned" (gear with short address after addr_alloc),
+ *          "preempt": {"preemptions", "resumes", "restarts", "verified"} (preempt only,
+ *          @see dali2_hal_preempt_stats_get(), "verified" is count of configured gear with
+ *          written levels whose preempting set level has reached its gear as well),
+ *          "edf": {"admitted", "rejected", "expired", "met", "missed" (@see dali2_hal_edf_stats_get()),
+ *          "late" (admitted jobs done after deadline or failed, measured by the bench), "pred_ms",
+ *          "actual_ms" (predicted and measured time of successful jobs, job time is counted from
+ *          its submission or the end of the previous job), "err_ms": {"min", "p50", "max"} (actual minus
+ *          predicted time of a job)} (edf only),
+ *          "clients": [{"name", "weight", "rate_ms", "jobs", "failed", "throttled",
+ *          "expected_pct" (share by weights and rates), "share_pct" (measured share of time
+ *          of holding HAL, @see dali2_hal_client_stats_get())}] (clients only)}
+ *
+ *          Build together with driver sources, dali2_bsp/dali2_l_bsp_host.c
+ *          and dali2_sim/ sources with -DDALI2_METRICS_EN, @see README.md "Host simulation".
+ *          Usage: dali2_fleet_bench [gear count [scenario]]
+ *          Without arguments every scenario runs with 1, 8, 32 and 64 gear.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "dali2_hal.h"
+#include "dali2_metrics.h"
+#include "dali2_l_bsp_host.h"
+#include "dali2_sim_gear.h"
+
+#define BENCH_OPS_MAX               256
+#define BENCH_SET_LEVEL_OPS         64
+#define BENCH_MIXED_OPS             128
+#define BENCH_OP_TIMEOUT_US         10000000ULL
+#define BENCH_ADDR_ALLOC_TIMEOUT_US (30ULL * 60 * 1000000)
+#define BENCH_IDLE_STEP_US          1000
+#define BENCH_SEED                  0x1F2E3D4C
+
+#define BENCH_FADE_TIME_S           0
+#define BENCH_PREEMPT_LEVEL_MIN     0xA0
+#define BENCH_PREEMPT_LEVEL_MAX     0xFA
+#define BENCH_PREEMPT_DELAY_MAX_US  1500000
+#define BENCH_EDF_ROUNDS            16
+#define BENCH_EDF_SLACK_MAX         6
+#define BENCH_CLIENT_COUNT          3
+#define BENCH_CLIENT_TIME_MS        120000
+#define BENCH_SPECIAL_FIRST         0xA1
+#define BENCH_SPECIAL_LAST          0xCB
+
+typedef enum {
+    BENCH_SCENARIO_ADDR_ALLOC,
+    BENCH_SCENARIO_DIM_CFG,
+    BENCH_SCENARIO_STATUS_SWEEP,
+    BENCH_SCENARIO_SET_LEVEL,
+    BENCH_SCENARIO_MIXED,
+    BENCH_SCENARIO_PREEMPT,
+    BENCH_SCENARIO_EDF,
+    BENCH_SCENARIO_CLIENTS,
+
+    BENCH_SCENARIO_COUNT
+} BENCH_SCENARIO_T;
+
+typedef struct {
+    unsigned long long dapc;
+    unsigned long long cmd;
+    unsigned long long special;
+    unsigned long long fw24;
+} bench_frames_t;
+
+//! Deadline request of the bench
+typedef struct {
+    dali2_sim_time_t submit_us;
+    dali2_sim_time_t deadline_us;
+    dali2_sim_time_t done_us;
+    unsigned int pred_us;
+    unsigned int actual_us;
+    dali2_ret_t ret;
+    unsigned char is_done;
+} bench_edf_job_t;
+
+typedef struct {
+    unsigned int late;
+    unsigned long long pred_us;
+    unsigned long long actual_us;
+    unsigned int err_count;
+    int err_us[BENCH_OPS_MAX];
+} bench_edf_result_t;
+
+//! Competing client of the bench
+typedef struct {
+    dali2_hal_client_cfg_t cfg;
+    DALI2_HAL_JOB_T job;
+    unsigned char id;
+    unsigned int jobs;
+    unsigned int failed;
+    double expected_pct;
+} bench_client_t;
+
+typedef struct {
+    unsigned int ops;
+    unsigned int ok;
+    unsigned int timeouts;
+    unsigned int lat_count;
+    dali2_sim_time_t lat_us[BENCH_OPS_MAX];
+} bench_result_t;
+
+static const char *__scenario_name[BENCH_SCENARIO_COUNT] = {
+    "addr_alloc", "dim_cfg", "status_sweep", "set_level", "mixed", "preempt", "edf", "clients"
+};
+
+static const unsigned int __default_gear_count[] = { 1, 8, 32, 64 };
+
+static dali2_sim_bus_t __bus;
+static dali2_sim_gear_line_t __line;
+static bench_frames_t __frames;
+static dali2_sim_time_t __edf_last_done_us;
+static unsigned int __rand_state = BENCH_SEED;
+
+static bench_client_t __client[BENCH_CLIENT_COUNT] = {
+    { { "ui", 3, 0, 0 }, DALI2_HAL_JOB_SET_LEVEL },
+    { { "scene", 1, 0, 0 }, DALI2_HAL_JOB_SET_LEVEL },
+    { { "commission", 4, 100, 500 }, DALI2_HAL_JOB_DIM_CFG },
+};
+
+static unsigned int __bench_rand(void)
+{
+    //! xorshift32
+    __rand_state ^= __rand_state << 13;
+    __rand_state ^= __rand_state >> 17;
+    __rand_state ^= __rand_state << 5;
+    return __rand_state;
+}
+
+static void __bench_app_evt_handler(DALI2_L_APP_EVT_T evt, dali2_l_app_evt_data_t *evt_data)
+{
+    dali2_hal_app_evt_dispatch(evt, evt_data);
+}
+
+static void __bench_frame_counter(void *ctx, dali2_sim_bus_t *bus, unsigned int frame, unsigned char bits)
+{
+    unsigned char addr = (unsigned char) (frame >> 8);
+
+    if (bits == 24) {
+        __frames.fw24++;
+    } else if (addr >= BENCH_SPECIAL_FIRST && addr <= BENCH_SPECIAL_LAST) {
+        __frames.special++;
+    } else if (addr & 0x01) {
+        __frames.cmd++;
+    } else {
+        __frames.dapc++;
+    }
+}
+
+static void __bench_line_create(unsigned int gear_count, unsigned char is_addressed)
+{
+    dali2_sim_gear_cfg_t cfg;
+    unsigned int i;
+
+    dali2_sim_sched_init();
+    dali2_sim_bus_init(&__bus);
+    dali2_sim_gear_line_init(&__line, &__bus);
+    dali2_sim_bus_responder_add(&__bus, __bench_frame_counter, NULL);
+
+    dali2_sim_gear_cfg_default(&cfg);
+    for (i = 0; i < gear_count; i++) {
+        cfg.short_addr = is_addressed ? (unsigned char) i : DALI2_SIM_GEAR_MASK;
+        cfg.random_addr = __bench_rand() & DALI2_SIM_GEAR_RANDOM_ADDR_MASK;
+        cfg.seed = __bench_rand() | 1;
+        dali2_sim_gear_add(&__line, &cfg);
+    }
+
+    dali2_l_bsp_host_attach(&__bus);
+    dali2_l_app_init(__bench_app_evt_handler);
+    dali2_hal_init();
+    dali2_sim_sched_run_until(DALI2_L_PHY_STARTUP_TIME_US * 2);
+
+    memset(&__frames, 0x00, sizeof(__frames));
+    memset(&__bus.stats, 0x00, sizeof(__bus.stats));
+}
+
+static void __bench_advance(void)
+{
+    if (!dali2_sim_sched_step()) {
+        dali2_sim_sched_run_until(dali2_sim_sched_now() + BENCH_IDLE_STEP_US);
+    }
+}
+
+/**@brief Waiting for HAL operation
+ *
+ * @return 1 if HAL has been freed by expected operation before deadline
+ */
+static int __bench_hal_wait(DALI2_HAL_EVT_T expected, dali2_sim_time_t deadline)
+{
+    DALI2_HAL_EVT_T evt;
+    dali2_ret_t ret;
+
+    while (dali2_sim_sched_now() < deadline) {
+        ret = dali2_hal_process(&evt);
+        if (ret == DALI2_RET_SUCCESS) {
+            return (evt == expected) ? 1 : 0;
+        }
+
+        __bench_advance();
+    }
+
+    return 0;
+}
+
+static void __bench_op_done(bench_result_t *res, dali2_sim_time_t start, int is_ok)
+{
+    res->ops++;
+
+    if (!is_ok) {
+        res->timeouts++;
+        return;
+    }
+
+    res->ok++;
+    if (res->lat_count < BENCH_OPS_MAX) {
+        res->lat_us[res->lat_count++] = dali2_sim_sched_now() - start;
+    }
+}
+
+static void __bench_node(dali2_l_app_network_t *node, unsigned char short_addr)
+{
+    node->method = DALI2_L_NET_METHOD_SHORT_ADDRESSING;
+    node->addr_byte = short_addr;
+}
+
+static void __bench_dim_cfg(dali2_hal_dim_cfg_t *cfg)
+{
+    memset(cfg, 0x00, sizeof(dali2_hal_dim_cfg_t));
+    cfg->mode = DALI2_HAL_DIM_MODE_NORMAL;
+    cfg->fade_time_s = BENCH_FADE_TIME_S;
+    cfg->level_min = DALI2_DIM_CFG_MIN_LEVEL;
+    cfg->level_max = DALI2_DIM_CFG_MAX_LEVEL;
+    cfg->dim_curve = DALI2_L_APP_DIMMING_CURVE_LOGARITHMIC;
+}
+
+//! API call is repeated while HAL is busy, it counts into latency
+static void __bench_op_dim_cfg(unsigned char short_addr, bench_result_t *res)
+{
+    dali2_sim_time_t start = dali2_sim_sched_now();
+    dali2_sim_time_t deadline = start + BENCH_OP_TIMEOUT_US;
+    dali2_l_app_network_t node;
+    dali2_hal_dim_cfg_t cfg;
+
+    __bench_node(&node, short_addr);
+    __bench_dim_cfg(&cfg);
+
+    while (dali2_hal_dim_cfg(&cfg, &node) != DALI2_RET_SUCCESS && dali2_sim_sched_now() < deadline) {
+        __bench_advance();
+    }
+
+    __bench_op_done(res, start, __bench_hal_wait(DALI2_HAL_EVT_DIM_CFG, deadline));
+}
+
+static void __bench_op_status(unsigned char short_addr, bench_result_t *res)
+{
+    dali2_sim_time_t start = dali2_sim_sched_now();
+    dali2_sim_time_t deadline = start + BENCH_OP_TIMEOUT_US;
+    dali2_l_app_network_t node;
+    dali2_hal_cache_stats_t cache_stats;
+    unsigned int cache_hit;
+    unsigned char status;
+
+    __bench_node(&node, short_addr);
+
+    dali2_hal_cache_stats_get(&cache_stats);
+    cache_hit = cache_stats.hit;
+
+    //! Status sweep starts only on free HAL, otherwise the operation times out
+    dali2_hal_dim_get_status(&status, &node);
+
+    //! Cached status is done without HAL job
+    dali2_hal_cache_stats_get(&cache_stats);
+    if (cache_stats.hit != cache_hit) {
+        __bench_op_done(res, start, 1);
+        return;
+    }
+
+    __bench_op_done(res, start, __bench_hal_wait(DALI2_HAL_EVT_DIM_CTRL, deadline));
+}
+
+static void __bench_op_set_level(unsigned char short_addr, unsigned char level, bench_result_t *res)
+{
+    dali2_sim_time_t start = dali2_sim_sched_now();
+    dali2_sim_time_t deadline = start + BENCH_OP_TIMEOUT_US;
+    dali2_l_app_network_t node;
+
+    __bench_node(&node, short_addr);
+
+    while (dali2_hal_dim_set_level(level, &node) != DALI2_RET_SUCCESS && dali2_sim_sched_now() < deadline) {
+        __bench_advance();
+    }
+
+    __bench_op_done(res, start, __bench_hal_wait(DALI2_HAL_EVT_DIM_CTRL, deadline));
+}
+
+static unsigned int __bench_addr_alloc(bench_result_t *res)
+{
+    dali2_sim_time_t start = dali2_sim_sched_now();
+    dali2_hal_addr_alloc_data_t data;
+    unsigned int assigned = 0;
+    unsigned int i;
+    int is_done;
+
+    data.random_step = DALI2_HAL_ADDR_ALLOC_RANDOM_STEP_FIRST;
+    if (dali2_hal_addr_alloc(DALI2_HAL_ADDR_ALLOC_METHOD_RANDOM, &data) != DALI2_RET_SUCCESS) {
+        __bench_op_done(res, start, 0);
+        return 0;
+    }
+
+    is_done = __bench_hal_wait(DALI2_HAL_EVT_ADDR_ALLOC, start + BENCH_ADDR_ALLOC_TIMEOUT_US);
+
+    for (i = 0; i < __line.gear_count; i++) {
+        if (__line.gear[i].short_addr != DALI2_SIM_GEAR_MASK) {
+            assigned++;
+        }
+    }
+
+    //! Freed HAL is not success while any gear is left without short address
+    __bench_op_done(res, start, is_done && assigned == __line.gear_count);
+
+    return assigned;
+}
+
+/**@brief Running background job until random point
+ *
+ * @return 1 if the job is still running at that point
+ */
+static int __bench_run_until_preempt(DALI2_HAL_EVT_T expected, bench_result_t *res, dali2_sim_time_t start)
+{
+    dali2_sim_time_t until = dali2_sim_sched_now() + __bench_rand() % BENCH_PREEMPT_DELAY_MAX_US;
+    DALI2_HAL_EVT_T evt;
+
+    while (dali2_sim_sched_now() < until) {
+        if (dali2_hal_process(&evt) == DALI2_RET_SUCCESS) {
+            //! Job has ended before it is preempted
+            __bench_op_done(res, start, evt == expected);
+            return 0;
+        }
+
+        __bench_advance();
+    }
+
+    return 1;
+}
+
+/**@brief Preempting dimmer configuration of every gear by set level of the next gear
+ *
+ * @return count of gear with both jobs verified
+ */
+static unsigned int __bench_preempt(unsigned int gear_count, bench_result_t *res)
+{
+    dali2_sim_time_t cfg_start, ctrl_start;
+    dali2_l_app_network_t node, ctrl_node;
+    dali2_hal_job_result_t job_result;
+    dali2_hal_dim_cfg_t cfg;
+    dali2_sim_gear_t *gear, *ctrl_gear;
+    unsigned int verified = 0;
+    unsigned int i, ctrl;
+    unsigned char level;
+    int is_ok;
+
+    __bench_dim_cfg(&cfg);
+    cfg.level_min = BENCH_PREEMPT_LEVEL_MIN;
+    cfg.level_max = BENCH_PREEMPT_LEVEL_MAX;
+
+    for (i = 0; i < gear_count; i++) {
+        ctrl = (i + 1) % gear_count;
+        level = (unsigned char) (BENCH_PREEMPT_LEVEL_MIN - DALI2_DIM_CFG_MIN_LEVEL +
+                                 __bench_rand() % (BENCH_PREEMPT_LEVEL_MAX - BENCH_PREEMPT_LEVEL_MIN + 1));
+        gear = &__line.gear[i];
+        ctrl_gear = &__line.gear[ctrl];
+        __bench_node(&node, (unsigned char) i);
+        __bench_node(&ctrl_node, (unsigned char) ctrl);
+
+        cfg_start = dali2_sim_sched_now();
+        while (dali2_hal_dim_cfg(&cfg, &node) != DALI2_RET_SUCCESS &&
+               dali2_sim_sched_now() < cfg_start + BENCH_OP_TIMEOUT_US) {
+            __bench_advance();
+        }
+
+        if (__bench_run_until_preempt(DALI2_HAL_EVT_DIM_CFG, res, cfg_start)) {
+            //! Interactive job takes the bus at once, then the configuration resumes
+            ctrl_start = dali2_sim_sched_now();
+            if (dali2_hal_dim_set_level(level, &ctrl_node) != DALI2_RET_SUCCESS) {
+                __bench_op_done(res, ctrl_start, 0);
+                __bench_op_done(res, cfg_start, __bench_hal_wait(DALI2_HAL_EVT_DIM_CFG,
+                                                                 cfg_start + BENCH_OP_TIMEOUT_US));
+                continue;
+            }
+
+            __bench_op_done(res, ctrl_start, __bench_hal_wait(DALI2_HAL_EVT_DIM_CTRL,
+                                                              ctrl_start + BENCH_OP_TIMEOUT_US));
+            is_ok = (dali2_sim_gear_level_get(ctrl_gear) == level + DALI2_DIM_CFG_MIN_LEVEL);
+
+            is_ok &= __bench_hal_wait(DALI2_HAL_EVT_DIM_CFG, cfg_start + BENCH_OP_TIMEOUT_US);
+            dali2_hal_job_result_get(&job_result);
+            is_ok &= (job_result.ret == DALI2_RET_SUCCESS);
+            __bench_op_done(res, cfg_start, is_ok);
+        } else {
+            dali2_hal_job_result_get(&job_result);
+            is_ok = (job_result.ret == DALI2_RET_SUCCESS);
+        }
+
+        //! Levels written by resumed job are on the gear
+        if (is_ok && gear->min_level == cfg.level_min && gear->max_level == cfg.level_max) {
+            verified++;
+        }
+    }
+
+    return verified;
+}
+
+//! Jobs of the round run one after another, job time is counted from the end of the previous one
+static void __bench_edf_done(DALI2_HAL_EVT_T evt, dali2_ret_t ret, void *ctx)
+{
+    bench_edf_job_t *job = (bench_edf_job_t *) ctx;
+    dali2_sim_time_t now = dali2_sim_sched_now();
+
+    job->done_us = now;
+    job->actual_us = (unsigned int) (now - ((job->submit_us > __edf_last_done_us) ? job->submit_us :
+                                                                                   __edf_last_done_us));
+    job->ret = ret;
+    job->is_done = 1;
+    __edf_last_done_us = now;
+}
+
+static int __bench_int_cmp(const void *a, const void *b)
+{
+    return (*(const int *) a > *(const int *) b) - (*(const int *) a < *(const int *) b);
+}
+
+/**@brief Submitting rounds of deadline requests
+ *
+ * @param[OUT] edf - measured deadlines and predictions
+ */
+static void __bench_edf(unsigned int gear_count, bench_result_t *res, bench_edf_result_t *edf)
+{
+    static bench_edf_job_t job[DALI2_HAL_EDF_COUNT];
+    dali2_hal_edf_req_t req;
+    dali2_sim_time_t now, round_end;
+    unsigned int round, i, count, admitted, done;
+    unsigned char is_cfg;
+
+    for (round = 0; round < BENCH_EDF_ROUNDS; round++) {
+        memset(job, 0x00, sizeof(job));
+        is_cfg = (__bench_rand() % 4 == 0);
+        count = is_cfg ? DALI2_HAL_EDF_COUNT / 2 : DALI2_HAL_EDF_COUNT;
+        now = dali2_sim_sched_now();
+        __edf_last_done_us = now;
+        round_end = now;
+        admitted = 0;
+
+        for (i = 0; i < count; i++) {
+            memset(&req, 0x00, sizeof(req));
+            __bench_node(&req.node, (unsigned char) (__bench_rand() % gear_count));
+            if (is_cfg) {
+                req.job = DALI2_HAL_JOB_DIM_CFG;
+                __bench_dim_cfg(&req.data.dim_cfg);
+            } else if (__bench_rand() % 3) {
+                req.job = DALI2_HAL_JOB_SET_LEVEL;
+                req.data.level = 1 + __bench_rand() % DALI2_DIM_LEVEL_MAX;
+            } else {
+                req.job = DALI2_HAL_JOB_UPDATE_STATE;
+            }
+
+            job[i].submit_us = now;
+            job[i].pred_us = dali2_hal_cost_job_us(req.job, &req.node);
+            req.deadline_ms = (job[i].pred_us / 1000 + 1) * (1 + __bench_rand() % BENCH_EDF_SLACK_MAX);
+            job[i].deadline_us = now + (dali2_sim_time_t) req.deadline_ms * 1000;
+            req.done.func = __bench_edf_done;
+            req.done.ctx = &job[i];
+
+            if (dali2_hal_edf_submit(&req) != DALI2_RET_SUCCESS) {
+                //! Rejected request is not called, it is not waited for
+                job[i].is_done = 2;
+                continue;
+            }
+
+            admitted++;
+            if (job[i].deadline_us > round_end) {
+                round_end = job[i].deadline_us;
+            }
+        }
+
+        //! Failed jobs are reported by deadline at most, late ones finish after it
+        round_end += BENCH_OP_TIMEOUT_US;
+        do {
+            DALI2_HAL_EVT_T evt;
+
+            dali2_hal_process(&evt);
+            for (i = 0, done = 0; i < count; i++) {
+                done += (job[i].is_done == 1) ? 1 : 0;
+            }
+            if (done == admitted) {
+                break;
+            }
+
+            __bench_advance();
+        } while (dali2_sim_sched_now() < round_end);
+
+        for (i = 0; i < count; i++) {
+            if (job[i].is_done == 2) {
+                continue;
+            }
+
+            if (job[i].is_done && job[i].ret == DALI2_RET_SUCCESS) {
+                edf->pred_us += job[i].pred_us;
+                edf->actual_us += job[i].actual_us;
+                if (edf->err_count < BENCH_OPS_MAX) {
+                    edf->err_us[edf->err_count++] = (int) job[i].actual_us - (int) job[i].pred_us;
+                }
+            }
+
+            res->ops++;
+            if (!job[i].is_done || job[i].ret != DALI2_RET_SUCCESS || job[i].done_us > job[i].deadline_us) {
+                edf->late++;
+                res->timeouts++;
+            } else {
+                res->ok++;
+                if (res->lat_count < BENCH_OPS_MAX) {
+                    res->lat_us[res->lat_count++] = job[i].done_us - job[i].submit_us;
+                }
+            }
+        }
+    }
+}
+
+static void __bench_client_done(DALI2_HAL_EVT_T evt, dali2_ret_t ret, void *ctx)
+{
+    bench_client_t *client = (bench_client_t *) ctx;
+
+    client->jobs++;
+    if (ret != DALI2_RET_SUCCESS) {
+        client->failed++;
+    }
+}
+
+//! Busy clients share the bus by weights, client over its rate gets the rate only
+static void __bench_client_expected(void)
+{
+    unsigned char is_fixed[BENCH_CLIENT_COUNT] = { 0 };
+    double left_pct = 100.0;
+    unsigned int weight, i;
+    int is_changed;
+
+    do {
+        is_changed = 0;
+        weight = 0;
+        for (i = 0; i < BENCH_CLIENT_COUNT; i++) {
+            weight += is_fixed[i] ? 0 : __client[i].cfg.weight;
+        }
+
+        for (i = 0; i < BENCH_CLIENT_COUNT && weight; i++) {
+            if (is_fixed[i]) {
+                continue;
+            }
+
+            __client[i].expected_pct = left_pct * __client[i].cfg.weight / weight;
+            if (__client[i].cfg.rate_ms && __client[i].expected_pct > __client[i].cfg.rate_ms / 10.0) {
+                __client[i].expected_pct = __client[i].cfg.rate_ms / 10.0;
+                left_pct -= __client[i].expected_pct;
+                is_fixed[i] = 1;
+                is_changed = 1;
+                break;
+            }
+        }
+    } while (is_changed);
+}
+
+static void __bench_client_fill(bench_client_t *client, unsigned int gear_count)
+{
+    dali2_hal_client_req_t req;
+
+    do {
+        memset(&req, 0x00, sizeof(req));
+        req.job = client->job;
+        __bench_node(&req.node, (unsigned char) (__bench_rand() % gear_count));
+        if (req.job == DALI2_HAL_JOB_DIM_CFG) {
+            __bench_dim_cfg(&req.data.dim_cfg);
+        } else {
+            req.data.level = 1 + __bench_rand() % DALI2_DIM_LEVEL_MAX;
+        }
+        req.done.func = __bench_client_done;
+        req.done.ctx = client;
+    } while (dali2_hal_client_submit(client->id, &req) == DALI2_RET_SUCCESS);
+}
+
+//! Every client is busy all the time, so its share is set by weights and rates only
+static void __bench_clients(unsigned int gear_count, bench_result_t *res)
+{
+    dali2_sim_time_t end = dali2_sim_sched_now() + BENCH_CLIENT_TIME_MS * 1000ULL;
+    DALI2_HAL_EVT_T evt;
+    unsigned int i;
+
+    for (i = 0; i < BENCH_CLIENT_COUNT; i++) {
+        dali2_hal_client_register(&__client[i].id, &__client[i].cfg);
+    }
+    __bench_client_expected();
+
+    while (dali2_sim_sched_now() < end) {
+        for (i = 0; i < BENCH_CLIENT_COUNT; i++) {
+            __bench_client_fill(&__client[i], gear_count);
+        }
+
+        dali2_hal_process(&evt);
+        __bench_advance();
+    }
+
+    for (i = 0; i < BENCH_CLIENT_COUNT; i++) {
+        res->ops += __client[i].jobs;
+        res->ok += __client[i].jobs - __client[i].failed;
+        res->timeouts += __client[i].failed;
+    }
+}
+
+static void __bench_clients_print(void)
+{
+    dali2_hal_client_stats_t stats[BENCH_CLIENT_COUNT];
+    unsigned long long bus_ms = 0;
+    unsigned int i;
+
+    for (i = 0; i < BENCH_CLIENT_COUNT; i++) {
+        dali2_hal_client_stats_get(&stats[i], __client[i].id);
+        bus_ms += stats[i].bus_ms;
+    }
+
+    printf(",\"clients\":[");
+    for (i = 0; i < BENCH_CLIENT_COUNT; i++) {
+        printf("%s{\"name\":\"%s\",\"weight\":%u,\"rate_ms\":%u,\"jobs\":%u,\"failed\":%u,\"throttled\":%u,"
+               "\"expected_pct\":%.1f,\"share_pct\":%.1f}", i ? "," : "",
+               __client[i].cfg.name, __client[i].cfg.weight, __client[i].cfg.rate_ms, __client[i].jobs,
+               __client[i].failed, stats[i].throttled, __client[i].expected_pct,
+               bus_ms ? 100.0 * stats[i].bus_ms / bus_ms : 0.0);
+    }
+    printf("]");
+}
+
+//! Level of every gear is dropped to 0, it is expected level of status sweep
+static void __bench_all_off(void)
+{
+    dali2_l_app_cmd_data_t cmd_data;
+
+    memset(&cmd_data, 0x00, sizeof(cmd_data));
+    cmd_data.std_cmd.net.method = DALI2_L_NET_METHOD_BROADCAST;
+
+    while (dali2_l_app_cmd_execute(DALI2_L_APP_CMD_OFF, &cmd_data) != DALI2_RET_SUCCESS) {
+        __bench_advance();
+    }
+    dali2_sim_sched_run_until(dali2_sim_sched_now() + DALI2_L_APP_CMD_RESET_SETTLING_TIME_MS * 1000);
+}
+
+static int __bench_cmp(const void *a, const void *b)
+{
+    dali2_sim_time_t x = *(const dali2_sim_time_t *) a;
+    dali2_sim_time_t y = *(const dali2_sim_time_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+static double __bench_percentile_ms(bench_result_t *res, unsigned int pct)
+{
+    unsigned int idx;
+
+    if (!res->lat_count) {
+        return 0.0;
+    }
+
+    idx = (res->lat_count * pct + 99) / 100;
+    idx = idx ? idx - 1 : 0;
+
+    return (double) res->lat_us[idx] / 1000.0;
+}
+
+static void __bench_metrics_print(void)
+{
+    static dali2_metrics_snapshot_t snap;
+    unsigned long long timeout = 0, collision = 0, unexpected = 0;
+    unsigned long long wait_us = 0, bus_us = 0, settle_us = 0;
+    unsigned int i;
+
+    //! Driver side metrics are printed when they are enabled
+    if (dali2_metrics_get(&snap) != DALI2_RET_SUCCESS) {
+        return;
+    }
+
+    for (i = 0; i < DALI2_METRICS_CMD_COUNT; i++) {
+        timeout += snap.cmd[i].timeout;
+        collision += snap.cmd[i].collision;
+        unexpected += snap.cmd[i].unexpected;
+    }
+
+    for (i = 0; i < DALI2_METRICS_JOB_COUNT; i++) {
+        wait_us += snap.job[i].queue_wait.sum_us;
+        bus_us += snap.job[i].bus.sum_us;
+        settle_us += snap.job[i].settling.sum_us;
+    }
+
+    printf(",\"metrics\":{\"busy_pct\":%.1f,\"timeout\":%llu,\"collision\":%llu,\"unexpected\":%llu,"
+           "\"wait_ms\":%.1f,\"bus_ms\":%.1f,\"settle_ms\":%.1f}",
+           snap.time_us ? 100.0 * snap.busy_us / snap.time_us : 0.0, timeout, collision, unexpected,
+           (double) wait_us / 1000.0, (double) bus_us / 1000.0, (double) settle_us / 1000.0);
+}
+
+static void __bench_run(BENCH_SCENARIO_T scenario, unsigned int gear_count)
+{
+    static bench_result_t res;
+    struct timespec cpu_start, cpu_end;
+    dali2_sim_time_t bus_start;
+    dali2_hal_preempt_stats_t preempt_stats;
+    static bench_edf_result_t edf;
+    dali2_hal_edf_stats_t edf_stats;
+    unsigned int assigned = 0, verified = 0;
+    unsigned int i, gear;
+
+    memset(&res, 0x00, sizeof(res));
+    memset(&edf, 0x00, sizeof(edf));
+
+    __bench_line_create(gear_count, (scenario == BENCH_SCENARIO_ADDR_ALLOC) ? 0 : 1);
+
+    //! Set level needs metadata of dimmer configuration
+    if (scenario == BENCH_SCENARIO_SET_LEVEL || scenario == BENCH_SCENARIO_MIXED ||
+        scenario == BENCH_SCENARIO_PREEMPT || scenario == BENCH_SCENARIO_EDF ||
+        scenario == BENCH_SCENARIO_CLIENTS) {
+        bench_result_t setup;
+
+        memset(&setup, 0x00, sizeof(setup));
+        __bench_op_dim_cfg(0, &setup);
+    }
+
+    if (scenario == BENCH_SCENARIO_STATUS_SWEEP || scenario == BENCH_SCENARIO_MIXED) {
+        __bench_all_off();
+    }
+
+    memset(&__frames, 0x00, sizeof(__frames));
+    memset(&__bus.stats, 0x00, sizeof(__bus.stats));
+    bus_start = dali2_sim_sched_now();
+    dali2_metrics_reset();
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_start);
+
+    switch (scenario) {
+        case BENCH_SCENARIO_ADDR_ALLOC:
+            assigned = __bench_addr_alloc(&res);
+            break;
+
+        case BENCH_SCENARIO_DIM_CFG:
+            for (i = 0; i < gear_count; i++) {
+                __bench_op_dim_cfg((unsigned char) i, &res);
+            }
+            break;
+
+        case BENCH_SCENARIO_STATUS_SWEEP:
+            for (i = 0; i < gear_count; i++) {
+                __bench_op_status((unsigned char) i, &res);
+            }
+            break;
+
+        case BENCH_SCENARIO_SET_LEVEL:
+            for (i = 0; i < BENCH_SET_LEVEL_OPS; i++) {
+                gear = __bench_rand() % gear_count;
+                __bench_op_set_level((unsigned char) gear, 1 + __bench_rand() % DALI2_DIM_LEVEL_MAX, &res);
+            }
+            break;
+
+        case BENCH_SCENARIO_PREEMPT:
+            verified = __bench_preempt(gear_count, &res);
+            break;
+
+        case BENCH_SCENARIO_EDF:
+            __bench_edf(gear_count, &res, &edf);
+            break;
+
+        case BENCH_SCENARIO_CLIENTS:
+            __bench_clients(gear_count, &res);
+            break;
+
+        case BENCH_SCENARIO_MIXED:
+        default:
+            for (i = 0; i < BENCH_MIXED_OPS; i++) {
+                gear = __bench_rand() % gear_count;
+                switch (__bench_rand() % 8) {
+                    case 0:
+                        __bench_op_dim_cfg((unsigned char) gear, &res);
+                        break;
+
+                    case 1:
+                    case 2:
+                    case 3:
+                        __bench_op_status((unsigned char) gear, &res);
+                        break;
+
+                    default:
+                        __bench_op_set_level((unsigned char) gear, 1 + __bench_rand() % DALI2_DIM_LEVEL_MAX, &res);
+                        break;
+                }
+            }
+            break;
+    }
+
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_end);
+
+    qsort(res.lat_us, res.lat_count, sizeof(res.lat_us[0]), __bench_cmp);
+
+    printf("{\"scenario\":\"%s\",\"gear\":%u,\"ops\":%u,\"ok\":%u,\"timeouts\":%u,"
+           "\"bus_ms\":%.1f,\"wall_ms\":%.1f,"
+           "\"frames\":{\"dapc\":%llu,\"cmd\":%llu,\"special\":%llu,\"fw24\":%llu,\"backward\":%llu,\"error\":%llu},"
+           "\"cpu_ms\":%.3f,\"lat_ms\":{\"p50\":%.1f,\"p99\":%.1f,\"max\":%.1f}",
+           __scenario_name[scenario], gear_count, res.ops, res.ok, res.timeouts,
+           (double) __bus.stats.busy_us / 1000.0, (double) (dali2_sim_sched_now() - bus_start) / 1000.0,
+           __frames.dapc, __frames.cmd, __frames.special, __frames.fw24,
+           __bus.stats.backward_frames, __bus.stats.error_frames,
+           (double) (cpu_end.tv_sec - cpu_start.tv_sec) * 1000.0 +
+           (double) (cpu_end.tv_nsec - cpu_start.tv_nsec) / 1000000.0,
+           __bench_percentile_ms(&res, 50), __bench_percentile_ms(&res, 99),
+           res.lat_count ? (double) res.lat_us[res.lat_count - 1] / 1000.0 : 0.0);
+    __bench_metrics_print();
+    if (scenario == BENCH_SCENARIO_ADDR_ALLOC) {
+        printf(",\"assigned\":%u", assigned);
+    }
+    if (scenario == BENCH_SCENARIO_PREEMPT) {
+        dali2_hal_preempt_stats_get(&preempt_stats);
+        printf(",\"preempt\":{\"preemptions\":%u,\"resumes\":%u,\"restarts\":%u,\"verified\":%u}",
+               preempt_stats.preemptions, preempt_stats.resumes, preempt_stats.restarts, verified);
+    }
+    if (scenario == BENCH_SCENARIO_EDF) {
+        dali2_hal_edf_stats_get(&edf_stats);
+        qsort(edf.err_us, edf.err_count, sizeof(edf.err_us[0]), __bench_int_cmp);
+        printf(",\"edf\":{\"admitted\":%u,\"rejected\":%u,\"expired\":%u,\"met\":%u,\"missed\":%u,"
+               "\"late\":%u,\"pred_ms\":%.1f,\"actual_ms\":%.1f,\"err_ms\":{\"min\":%.1f,\"p50\":%.1f,\"max\":%.1f}}",
+               edf_stats.admitted, edf_stats.rejected, edf_stats.expired, edf_stats.met, edf_stats.missed,
+               edf.late, (double) edf.pred_us / 1000.0, (double) edf.actual_us / 1000.0,
+               edf.err_count ? (double) edf.err_us[0] / 1000.0 : 0.0,
+               edf.err_count ? (double) edf.err_us[(edf.err_count - 1) / 2] / 1000.0 : 0.0,
+               edf.err_count ? (double) edf.err_us[edf.err_count - 1] / 1000.0 : 0.0);
+    }
+    if (scenario == BENCH_SCENARIO_CLIENTS) {
+        __bench_clients_print();
+    }
+    printf("}\n");
+    fflush(stdout);
+}
+
+//! HAL keeps its state in statics, so every run has own process
+static void __bench_run_isolated(BENCH_SCENARIO_T scenario, unsigned int gear_count)
+{
+    pid_t pid;
+
+    fflush(stdout);
+
+    pid = fork();
+    if (pid < 0) {
+        perror("fork");
+        exit(1);
+    }
+
+    if (!pid) {
+        __rand_state ^= (scenario + 1) * 0x9E3779B9 ^ gear_count;
+        __bench_run(scenario, gear_count);
+        _exit(0);
+    }
+
+    waitpid(pid, NULL, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int gear_count = 0;
+    int scenario = -1;
+    unsigned int s, i;
+
+    if (argc > 1) {
+        gear_count = (unsigned int) strtoul(argv[1], NULL, 0);
+        if (!gear_count || gear_count > DALI2_SIM_GEAR_LINE_MAX) {
+            fprintf(stderr, "gear count 1..%u\n", DALI2_SIM_GEAR_LINE_MAX);
+            return 1;
+        }
+    }
+
+    if (argc > 2) {
+        for (s = 0; s < BENCH_SCENARIO_COUNT; s++) {
+            if (!strcmp(argv[2], __scenario_name[s])) {
+                scenario = (int) s;
+            }
+        }
+        if (scenario < 0) {
+            fprintf(stderr, "unknown scenario %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    dali2_l_bsp_host_print_enable(0);
+
+    for (s = 0; s < BENCH_SCENARIO_COUNT; s++) {
+        if (scenario >= 0 && (int) s != scenario) {
+            continue;
+        }
+
+        if (gear_count) {
+            __bench_run_isolated((BENCH_SCENARIO_T) s, gear_count);
+            continue;
+        }
+
+        for (i = 0; i < sizeof(__default_gear_count) / sizeof(__default_gear_count[0]); i++) {
+            __bench_run_isolated((BENCH_SCENARIO_T) s, __default_gear_count[i]);
+        }
+    }
+
+    return 0;
+}
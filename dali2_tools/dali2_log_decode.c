@@ -0,0 +1,94 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_log_decode.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host side binary log decoder
+ *
+ * @details Rebuilds text of records exported by dali2_log_export()
+ *          from the dali2_log_msg_list.h table.
+ *
+ *          Build: cc -I.. -I../dali2_bsp -I../dali2_log dali2_log_decode.c -o dali2_log_decode
+ *          Usage: dali2_log_decode [capture.bin]   (stdin is used without file)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "dali2_log.h"
+
+typedef struct {
+    const char *module;
+    const char *level;
+    const char *text;
+} dali2_log_decode_msg_t;
+
+#define DALI2_LOG_MSG(ID, MODULE, LEVEL, TEXT)  { #MODULE, #LEVEL, TEXT },
+static const dali2_log_decode_msg_t __msg_table[DALI2_LOG_ID_COUNT] = {
+#include "dali2_log_msg_list.h"
+};
+#undef DALI2_LOG_MSG
+
+static unsigned int __get_le(const unsigned char *buf, unsigned int size)
+{
+    unsigned int value = 0;
+    unsigned int i;
+
+    for (i = 0; i < size; i++) {
+        value |= (unsigned int) buf[i] << (i * 8);
+    }
+
+    return value;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *in = stdin;
+    unsigned char buf[DALI2_LOG_RECORD_EXPORT_SIZE];
+    unsigned int id, seq, arg0, arg1;
+    unsigned int expected_seq = 0, lost = 0, count = 0;
+    int has_seq = 0;
+
+    if (argc > 1) {
+        in = fopen(argv[1], "rb");
+        if (!in) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    while (fread(buf, 1, sizeof(buf), in) == sizeof(buf)) {
+        id = __get_le(&buf[0], 2);
+        seq = buf[3];
+        arg0 = __get_le(&buf[4], 4);
+        arg1 = __get_le(&buf[8], 4);
+
+        //! Sequence gap means records were dropped or not exported
+        if (has_seq && seq != expected_seq) {
+            lost += (seq - expected_seq) & 0xFF;
+            printf("---- %u record(s) lost ----\n", (seq - expected_seq) & 0xFF);
+        }
+        expected_seq = (seq + 1) & 0xFF;
+        has_seq = 1;
+
+        if (id >= DALI2_LOG_ID_COUNT) {
+            printf("[%03u] UNKNOWN ID %u 0x%X 0x%X\n", seq, id, arg0, arg1);
+        } else {
+            printf("[%03u] %-8s %-7s ", seq, __msg_table[id].level, __msg_table[id].module);
+            printf(__msg_table[id].text, arg0, arg1);
+            printf("\n");
+        }
+        count++;
+    }
+
+    fprintf(stderr, "%u record(s) decoded, %u lost\n", count, lost);
+
+    if (in != stdin) {
+        fclose(in);
+    }
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_mon_decode.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host side bus monitor capture decoder
+ *
+ * @details Prints frames of compact binary capture exported by dali2_mon_export()
+ *          one per line: start time, gap since the previous frame, duration,
+ *          classification, size, data and Physical layer event.
+ *
+ *          Build: cc -I.. -I../dali2_bsp -I../dali2_phy -I../dali2_mon dali2_mon_decode.c -o dali2_mon_decode
+ *          Usage: dali2_mon_decode [capture.bin]   (stdin is used without file)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "dali2_mon.h"
+
+static const char *__type_name[DALI2_MON_FRAME_COUNT] = {
+    "FW", "FW_OWN", "BW", "COLLISION", "ERROR"
+};
+
+static const char *__evt_name[DALI2_L_PHY_EVT_COUNT] = {
+    "fw_done", "bw_done", "start_err", "stop_err", "fw_err", "bw_err", "data_vio", "time_vio", "size_vio",
+    "fw_rx"
+};
+
+static unsigned int __get_le(const unsigned char *buf, unsigned int size)
+{
+    unsigned int value = 0;
+    unsigned int i;
+
+    for (i = 0; i < size; i++) {
+        value |= (unsigned int) buf[i] << (i * 8);
+    }
+
+    return value;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *in = stdin;
+    unsigned char buf[DALI2_MON_RECORD_EXPORT_SIZE];
+    unsigned int start_us, frame, duration, type, evt, bits, seq;
+    unsigned int last_stop_us = 0, expected_seq = 0, lost = 0, count = 0;
+    unsigned int type_count[DALI2_MON_FRAME_COUNT];
+    int has_seq = 0;
+    unsigned int i;
+
+    if (argc > 1) {
+        in = fopen(argv[1], "rb");
+        if (!in) {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    memset(type_count, 0x00, sizeof(type_count));
+
+    printf("%12s %10s %8s %-10s %4s %-10s %s\n", "start_us", "gap_us", "dur_us", "type", "bits", "data", "event");
+
+    while (fread(buf, 1, sizeof(buf), in) == sizeof(buf)) {
+        start_us = __get_le(&buf[0], 4);
+        frame = __get_le(&buf[4], 4);
+        duration = __get_le(&buf[8], 2);
+        type = buf[10];
+        evt = buf[11];
+        bits = buf[12];
+        seq = buf[13];
+
+        //! Sequence gap means records were dropped or not exported
+        if (has_seq && seq != expected_seq) {
+            lost += (seq - expected_seq) & 0xFF;
+            printf("---- %u frame(s) lost ----\n", (seq - expected_seq) & 0xFF);
+        }
+        expected_seq = (seq + 1) & 0xFF;
+
+        printf("%12u %10d %8u %-10s %4u ", start_us, has_seq ? (int) (start_us - last_stop_us) : 0, duration,
+               (type < DALI2_MON_FRAME_COUNT) ? __type_name[type] : "?", bits);
+
+        //! Only the last 32 bits are kept
+        if (bits >= 32) {
+            printf("0x%08X ", frame);
+        } else {
+            printf("0x%0*X%*s ", (int) ((bits + 3) / 4), frame & ((1u << bits) - 1), (int) (8 - (bits + 3) / 4), "");
+        }
+        printf("%s\n", (evt < DALI2_L_PHY_EVT_COUNT) ? __evt_name[evt] : "?");
+
+        if (type < DALI2_MON_FRAME_COUNT) {
+            type_count[type]++;
+        }
+        last_stop_us = start_us + duration;
+        has_seq = 1;
+        count++;
+    }
+
+    fprintf(stderr, "%u frame(s) decoded, %u lost:", count, lost);
+    for (i = 0; i < DALI2_MON_FRAME_COUNT; i++) {
+        fprintf(stderr, " %s %u", __type_name[i], type_count[i]);
+    }
+    fprintf(stderr, "\n");
+
+    if (in != stdin) {
+        fclose(in);
+    }
+
+    return 0;
+}
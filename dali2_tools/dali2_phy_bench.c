@@ -0,0 +1,809 @@
+/**
+ * @copyright
+ *
+ * @file    dali2_phy_bench.c
+ * @author  Anton K.
+ * @date    19 Oct 2026
+ *
+ * @brief   DALI-2 Application Controller.
+ *          Host side Physical layer microbenchmark and fuzzer
+ *
+ * @details Harness provides its own BSP: virtual time, RX PIN level and one-shot
+ *          timer. Edge sequences are replayed into dali2_l_dpin_int_cb_handler()
+ *          and dali2_l_phy_timer_cb_handler() exactly as interrupts do. Every
+ *          sequence is also replayed into alternative decoders, so decoder
+ *          implementations are compared side by side on the same stimulus:
+ *          - clean:   random backward frames with nominal timing
+ *          - jitter:  random backward frames with edge jitter
+ *          - mutated: frames with shifted, dropped, inserted edges, truncation
+ *                     and stretched bit time
+ *          - capture: logic analyzer export, split into bursts by idle gaps
+ *
+ *          Expected result of every sequence is given by strict offline
+ *          validation of edge intervals against DALI2_L_PHY_HALF_BIT_TIME_US_*.
+ *          Wrong accept is backward frame with value which was not sent, or
+ *          more than one frame per sequence. Lenient accept is the sent value
+ *          reported from out of window timing. Hang is decoder which is not
+ *          idle after the line has been quiet for BENCH_QUIET_US.
+ *          Cost is measured in CPU cycles (nanoseconds on non-x86 hosts)
+ *          spent inside callbacks: average per edge and per replayed frame,
+ *          and 99.9 percentile of single callback as interrupt latency budget.
+ *          Wrong accepts and hangs are dumped into stderr in capture format.
+ *
+ *          Capture format: "time,level" lines, other lines are skipped.
+ *          Time with decimal point is in seconds (logic analyzer export),
+ *          integer time is in microseconds.
+ *
+ *          Build: cc -O2 -I.. -I../dali2_bsp -I../dali2_phy dali2_phy_bench.c
+ *                 ../dali2_phy/dali2_l_phy.c -o dali2_phy_bench
+ *          Usage: dali2_phy_bench [sequences [jitter_us [capture.csv]]]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_COST_UNIT             "cyc"
+#else
+#define BENCH_COST_UNIT             "ns"
+#endif
+
+#include "dali2_l_phy.h"
+
+#define BENCH_SEQS_DEFAULT          100000
+#define BENCH_JITTER_US_DEFAULT     60
+#define BENCH_SEED                  0x2545F491
+
+#define BENCH_EDGE_MAX              256
+#define BENCH_RX_MAX                BENCH_EDGE_MAX
+#define BENCH_BW_HALF_BITS          ((1 + DALI2_L_PHY_BACKWARD_8BIT_SIZE) * 2)
+#define BENCH_SEQ_GAP_US            20000
+#define BENCH_QUIET_US              (DALI2_L_PHY_STOP_CONDITION_TIME_US * 4)
+#define BENCH_TIMER_LOOP_MAX        64
+#define BENCH_DUMP_MAX              4
+#define BENCH_COST_HIST_SIZE        4096
+#define BENCH_COST_PERMILLE         999
+#define BENCH_SENT_UNKNOWN          -1
+
+//! Edge sequence, times are relative to the first edge
+typedef struct {
+    unsigned int at[BENCH_EDGE_MAX];
+    unsigned char level[BENCH_EDGE_MAX];
+    unsigned int count;
+} bench_seq_t;
+
+//! Frame or error reported by decoder
+typedef struct {
+    DALI2_L_PHY_EVT_T evt;
+    unsigned char frame;
+} bench_rx_t;
+
+//! Decoder under test, same entries as interrupts of the driver
+typedef struct {
+    const char *name;
+    void (*reset)(void);
+    void (*edge)(DALI2_L_BSP_DPIN_STATE_T state);
+    void (*timer)(void);
+    unsigned char (*is_idle)(void);
+} bench_decoder_t;
+
+typedef struct {
+    unsigned long long seqs;
+    unsigned long long accepted;
+    unsigned long long rejected;
+    unsigned long long wrong_accept;
+    unsigned long long lenient;
+    unsigned long long false_reject;
+    unsigned long long hangs;
+    unsigned long long edges;
+    unsigned long long calls;
+    unsigned long long cost;
+    unsigned int cost_hist[BENCH_COST_HIST_SIZE];
+    unsigned int dumped;
+} bench_stats_t;
+
+//! Stub BSP state
+static unsigned long long __now;
+static unsigned long long __timer_at;
+static unsigned char __is_timer;
+static DALI2_L_BSP_DPIN_STATE_T __rx_level = DALI2_L_BSP_DPIN_STATE_1;
+
+static bench_rx_t __rx[BENCH_RX_MAX];
+static unsigned int __rx_count;
+
+static unsigned int __rand_state = BENCH_SEED;
+static unsigned long long __cost_overhead;
+
+static unsigned int __bench_rand(void)
+{
+    //! xorshift32
+    __rand_state ^= __rand_state << 13;
+    __rand_state ^= __rand_state >> 17;
+    __rand_state ^= __rand_state << 5;
+    return __rand_state;
+}
+
+static int __bench_rand_range(int min, int max)
+{
+    return min + (int) (__bench_rand() % (unsigned int) (max - min + 1));
+}
+
+static inline unsigned long long __bench_cost(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+static void __bench_rx(DALI2_L_PHY_EVT_T evt, unsigned char frame)
+{
+    if (__rx_count < BENCH_RX_MAX) {
+        __rx[__rx_count].evt = evt;
+        __rx[__rx_count].frame = frame;
+        __rx_count++;
+    }
+}
+
+/*
+ * Stub BSP
+ */
+
+void dali2_l_bsp_init(void)
+{
+    __is_timer = 0;
+}
+
+void dali2_l_bsp_deinit(void)
+{
+    __is_timer = 0;
+}
+
+void dali2_l_bsp_tx_pin_set(DALI2_L_BSP_DPIN_STATE_T data)
+{
+    //! Receive path only, controller never drives the line here
+}
+
+DALI2_L_BSP_DPIN_STATE_T dali2_l_bsp_rx_pin_get(void)
+{
+    return __rx_level;
+}
+
+void dali2_l_bsp_phy_timer_start_us(unsigned int us)
+{
+    __timer_at = __now + us;
+    __is_timer = 1;
+}
+
+void dali2_l_bsp_phy_timer_start_at_us(unsigned int at_us)
+{
+    int delay_us = (int) (at_us - (unsigned int) __now);
+
+    __timer_at = __now + ((delay_us > 0) ? (unsigned int) delay_us : 0);
+    __is_timer = 1;
+}
+
+unsigned int dali2_l_bsp_time_us_get(void)
+{
+    return (unsigned int) __now;
+}
+
+/*
+ * Half-bit helpers shared by offline validation and edge decoder
+ */
+
+static unsigned int __bench_interval_halves(unsigned int us)
+{
+    if (us >= DALI2_L_PHY_HALF_BIT_TIME_US_MIN && us <= DALI2_L_PHY_HALF_BIT_TIME_US_MAX) {
+        return 1;
+    }
+
+    if (us >= DALI2_L_PHY_DOUBLE_HALF_BIT_TIME_US_MIN && us <= DALI2_L_PHY_DOUBLE_HALF_BIT_TIME_US_MAX) {
+        return 2;
+    }
+
+    return 0;
+}
+
+//! Half-bit levels are shifted in from LSB, the first half-bit is the highest one
+static DALI2_L_PHY_EVT_T __bench_halves_decode(unsigned int halves, unsigned int count, unsigned char *frame)
+{
+    unsigned int first, last;
+    unsigned int i;
+
+    if (count != BENCH_BW_HALF_BITS) {
+        return DALI2_L_PHY_EVT_SIZE_VIOLATION;
+    }
+
+    //! Start bit is logic 1: low, then high
+    if (((halves >> (BENCH_BW_HALF_BITS - 2)) & 0x03) != 0x01) {
+        return DALI2_L_PHY_EVT_DATA_VIOLATION;
+    }
+
+    *frame = 0;
+    for (i = 0; i < DALI2_L_PHY_BACKWARD_8BIT_SIZE; i++) {
+        first = (halves >> (BENCH_BW_HALF_BITS - 3 - i * 2)) & 0x01;
+        last = (halves >> (BENCH_BW_HALF_BITS - 4 - i * 2)) & 0x01;
+
+        if (first == last) {
+            return DALI2_L_PHY_EVT_DATA_VIOLATION;
+        }
+
+        *frame = (unsigned char) ((*frame << 1) | (first ? 0 : 1));
+    }
+
+    return DALI2_L_PHY_EVT_BACKWARD_DONE;
+}
+
+static unsigned char __bench_seq_validate(const bench_seq_t *seq, unsigned char *frame)
+{
+    unsigned int halves = 0, count = 0, n;
+    unsigned int i;
+
+    if (!seq->count || seq->level[0] != DALI2_L_BSP_DPIN_STATE_0 ||
+        seq->level[seq->count - 1] != DALI2_L_BSP_DPIN_STATE_1) {
+        return 0;
+    }
+
+    for (i = 1; i < seq->count; i++) {
+        n = __bench_interval_halves(seq->at[i] - seq->at[i - 1]);
+        if (!n || count + n > BENCH_BW_HALF_BITS) {
+            return 0;
+        }
+
+        halves = (halves << n) | (seq->level[i - 1] ? ((1u << n) - 1) : 0);
+        count += n;
+    }
+
+    //! Last half-bit of logic 1 merges with stop condition
+    if (count == BENCH_BW_HALF_BITS - 1) {
+        halves = (halves << 1) | 1;
+        count++;
+    }
+
+    return (__bench_halves_decode(halves, count, frame) == DALI2_L_PHY_EVT_BACKWARD_DONE) ? 1 : 0;
+}
+
+/*
+ * Decoder "phy": Physical layer of the driver
+ */
+
+static void __bench_phy_evt_handler(DALI2_L_PHY_EVT_T evt, dali2_l_phy_evt_param_t *param)
+{
+    __bench_rx(evt, (evt == DALI2_L_PHY_EVT_BACKWARD_DONE) ? param->backward.frame : 0);
+}
+
+static void __bench_phy_reset(void)
+{
+    dali2_l_phy_deinit();
+    dali2_l_phy_init(__bench_phy_evt_handler);
+
+    //! Startup timer
+    __is_timer = 0;
+    dali2_l_phy_timer_cb_handler();
+}
+
+static const bench_decoder_t __bench_phy_decoder = {
+    .name = "phy",
+    .reset = __bench_phy_reset,
+    .edge = dali2_l_dpin_int_cb_handler,
+    .timer = dali2_l_phy_timer_cb_handler,
+    .is_idle = dali2_l_phy_is_idle
+};
+
+/*
+ * Decoder "edge": edge timestamp decoder, candidate implementation
+ */
+
+static struct {
+    unsigned int last_at;
+    unsigned int halves;
+    unsigned char count;
+    DALI2_L_BSP_DPIN_STATE_T level;
+    unsigned char is_active:1;
+    unsigned char is_error:1;       //! Rest of broken frame is ignored up to idle line
+} __edge_dec;
+
+static void __bench_edge_reset(void)
+{
+    memset(&__edge_dec, 0x00, sizeof(__edge_dec));
+    __edge_dec.level = DALI2_L_BSP_DPIN_STATE_1;
+    __is_timer = 0;
+}
+
+static void __bench_edge_edge(DALI2_L_BSP_DPIN_STATE_T state)
+{
+    unsigned int now = dali2_l_bsp_time_us_get();
+    unsigned int n;
+
+    if (__edge_dec.is_error) {
+        __edge_dec.level = state;
+        dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_STOP_CONDITION_TIME_US);
+        return;
+    }
+
+    if (!__edge_dec.is_active) {
+        __edge_dec.level = state;
+
+        if (state != DALI2_L_BSP_DPIN_STATE_0) {
+            __bench_rx(DALI2_L_PHY_EVT_SIZE_VIOLATION, 0);
+            return;
+        }
+
+        __edge_dec.is_active = 1;
+        __edge_dec.halves = 0;
+        __edge_dec.count = 0;
+        __edge_dec.last_at = now;
+        dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_STOP_CONDITION_TIME_US);
+        return;
+    }
+
+    n = __bench_interval_halves(now - __edge_dec.last_at);
+    if (!n || __edge_dec.count + n > BENCH_BW_HALF_BITS) {
+        __edge_dec.is_active = 0;
+        __edge_dec.is_error = 1;
+        __edge_dec.level = state;
+        dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_STOP_CONDITION_TIME_US);
+        __bench_rx(n ? DALI2_L_PHY_EVT_SIZE_VIOLATION : DALI2_L_PHY_EVT_TIMING_VIOLATION, 0);
+        return;
+    }
+
+    //! Half-bits before this edge have previous line level
+    __edge_dec.halves = (__edge_dec.halves << n) | (__edge_dec.level ? ((1u << n) - 1) : 0);
+    __edge_dec.count += n;
+    __edge_dec.level = state;
+    __edge_dec.last_at = now;
+
+    dali2_l_bsp_phy_timer_start_us(DALI2_L_PHY_STOP_CONDITION_TIME_US);
+}
+
+static void __bench_edge_timer(void)
+{
+    DALI2_L_PHY_EVT_T evt;
+    unsigned char frame = 0;
+
+    if (__edge_dec.is_error) {
+        __edge_dec.is_error = (__edge_dec.level != DALI2_L_BSP_DPIN_STATE_1) ? 1 : 0;
+        return;
+    }
+
+    if (!__edge_dec.is_active) {
+        return;
+    }
+
+    __edge_dec.is_active = 0;
+
+    if (__edge_dec.level != DALI2_L_BSP_DPIN_STATE_1) {
+        __bench_rx(DALI2_L_PHY_EVT_BACKWARD_ERROR, 0);
+        return;
+    }
+
+    if (__edge_dec.count == BENCH_BW_HALF_BITS - 1) {
+        __edge_dec.halves = (__edge_dec.halves << 1) | 1;
+        __edge_dec.count++;
+    }
+
+    evt = __bench_halves_decode(__edge_dec.halves, __edge_dec.count, &frame);
+    __bench_rx(evt, frame);
+}
+
+static unsigned char __bench_edge_is_idle(void)
+{
+    return (__edge_dec.is_active || __edge_dec.is_error) ? 0 : 1;
+}
+
+static const bench_decoder_t __bench_edge_decoder = {
+    .name = "edge",
+    .reset = __bench_edge_reset,
+    .edge = __bench_edge_edge,
+    .timer = __bench_edge_timer,
+    .is_idle = __bench_edge_is_idle
+};
+
+static const bench_decoder_t *__decoders[] = {
+    &__bench_phy_decoder,
+    &__bench_edge_decoder
+};
+
+#define BENCH_DECODER_COUNT         (sizeof(__decoders) / sizeof(__decoders[0]))
+
+/*
+ * Sequence generation
+ */
+
+static void __bench_seq_add(bench_seq_t *seq, unsigned int at, unsigned char level)
+{
+    if (seq->count < BENCH_EDGE_MAX) {
+        seq->at[seq->count] = at;
+        seq->level[seq->count] = level;
+        seq->count++;
+    }
+}
+
+static void __bench_seq_encode(bench_seq_t *seq, unsigned char frame, unsigned int jitter_us)
+{
+    unsigned char half[BENCH_BW_HALF_BITS];
+    unsigned char prev = DALI2_L_BSP_DPIN_STATE_1;
+    unsigned int i, at;
+
+    half[0] = DALI2_L_BSP_DPIN_STATE_0;
+    half[1] = DALI2_L_BSP_DPIN_STATE_1;
+    for (i = 0; i < DALI2_L_PHY_BACKWARD_8BIT_SIZE; i++) {
+        half[2 + i * 2] = (frame & (0x80 >> i)) ? DALI2_L_BSP_DPIN_STATE_0 : DALI2_L_BSP_DPIN_STATE_1;
+        half[3 + i * 2] = !half[2 + i * 2];
+    }
+
+    seq->count = 0;
+    for (i = 0; i <= BENCH_BW_HALF_BITS; i++) {
+        unsigned char level = (i < BENCH_BW_HALF_BITS) ? half[i] : DALI2_L_BSP_DPIN_STATE_1;
+
+        if (level == prev) {
+            continue;
+        }
+
+        //! Jitter moves every edge around its nominal position
+        at = i * DALI2_L_PHY_HALF_BIT_TIME_US_TYP + jitter_us;
+        if (jitter_us) {
+            at += __bench_rand_range(-(int) jitter_us, (int) jitter_us);
+        }
+
+        __bench_seq_add(seq, at, level);
+        prev = level;
+    }
+}
+
+static void __bench_seq_mutate(bench_seq_t *seq)
+{
+    unsigned int i, k, at, width;
+    int shift;
+
+    switch (__bench_rand() % 5) {
+        case 0:     //! Shift single edge keeping the order
+            i = __bench_rand() % seq->count;
+            shift = __bench_rand_range(-300, 300);
+            at = (unsigned int) ((int) seq->at[i] + shift);
+            if ((!i || at > seq->at[i - 1]) && (i + 1 == seq->count || at < seq->at[i + 1]) &&
+                (int) seq->at[i] + shift >= 0) {
+                seq->at[i] = at;
+            }
+            break;
+
+        case 1:     //! Drop pair of edges, line levels stay consistent
+            if (seq->count > 2) {
+                i = __bench_rand() % (seq->count - 1);
+                memmove(&seq->at[i], &seq->at[i + 2], (seq->count - i - 2) * sizeof(seq->at[0]));
+                memmove(&seq->level[i], &seq->level[i + 2], seq->count - i - 2);
+                seq->count -= 2;
+            }
+            break;
+
+        case 2:     //! Glitch: pair of edges inside of the frame
+            at = __bench_rand() % (seq->at[seq->count - 1] + 1);
+            width = __bench_rand_range(5, 200);
+            for (i = 0; i < seq->count && seq->at[i] <= at; i++);
+            if (seq->count + 2 > BENCH_EDGE_MAX || (i < seq->count && at + width >= seq->at[i]) ||
+                (i && seq->at[i - 1] == at)) {
+                break;
+            }
+            memmove(&seq->at[i + 2], &seq->at[i], (seq->count - i) * sizeof(seq->at[0]));
+            memmove(&seq->level[i + 2], &seq->level[i], seq->count - i);
+            seq->level[i] = i ? !seq->level[i - 1] : DALI2_L_BSP_DPIN_STATE_0;
+            seq->level[i + 1] = !seq->level[i];
+            seq->at[i] = at;
+            seq->at[i + 1] = at + width;
+            seq->count += 2;
+            break;
+
+        case 3:     //! Truncation, line is released at the end
+            k = __bench_rand() % seq->count;
+            seq->count = (k & ~1u) ? (k & ~1u) : 2;
+            break;
+
+        default:    //! Bit time stretched or squeezed as a whole
+            k = (unsigned int) __bench_rand_range(75, 135);
+            for (i = 0; i < seq->count; i++) {
+                seq->at[i] = seq->at[i] * k / 100;
+            }
+            break;
+    }
+}
+
+/*
+ * Replay
+ */
+
+static void __bench_cost_add(bench_stats_t *stats, unsigned long long t0)
+{
+    unsigned long long cost = __bench_cost() - t0;
+
+    cost = (cost > __cost_overhead) ? cost - __cost_overhead : 0;
+
+    stats->cost += cost;
+    stats->cost_hist[(cost < BENCH_COST_HIST_SIZE) ? cost : BENCH_COST_HIST_SIZE - 1]++;
+    stats->calls++;
+}
+
+static void __bench_timers_until(const bench_decoder_t *dec, unsigned long long at, bench_stats_t *stats)
+{
+    unsigned long long t0;
+    unsigned int loop;
+
+    for (loop = 0; loop < BENCH_TIMER_LOOP_MAX && __is_timer && __timer_at <= at; loop++) {
+        __now = __timer_at;
+        __is_timer = 0;
+
+        t0 = __bench_cost();
+        dec->timer();
+        __bench_cost_add(stats, t0);
+    }
+
+    __now = at;
+}
+
+static void __bench_seq_dump(const char *mode, const bench_decoder_t *dec, const char *what, const bench_seq_t *seq)
+{
+    unsigned int i;
+
+    fprintf(stderr, "# %s %s %s\n", mode, dec->name, what);
+    for (i = 0; i < seq->count; i++) {
+        fprintf(stderr, "%u,%u\n", seq->at[i], seq->level[i]);
+    }
+}
+
+/**@brief Replaying single sequence into decoder
+ *
+ * @param[IN] sent - frame value used for generation or BENCH_SENT_UNKNOWN
+ */
+static void __bench_replay(const char *mode, const bench_decoder_t *dec, const bench_seq_t *seq, int sent,
+                           bench_stats_t *stats)
+{
+    unsigned long long base, t0;
+    unsigned char truth_frame = 0;
+    unsigned char is_truth;
+    unsigned int accepts = 0;
+    unsigned char frame = 0;
+    unsigned int i;
+
+    is_truth = __bench_seq_validate(seq, &truth_frame);
+
+    __rx_count = 0;
+    base = __now + BENCH_SEQ_GAP_US;
+    __bench_timers_until(dec, base, stats);
+
+    for (i = 0; i < seq->count; i++) {
+        __bench_timers_until(dec, base + seq->at[i], stats);
+
+        if (seq->level[i] == __rx_level) {
+            continue;
+        }
+        __rx_level = seq->level[i];
+
+        t0 = __bench_cost();
+        dec->edge(__rx_level);
+        __bench_cost_add(stats, t0);
+        stats->edges++;
+    }
+
+    //! Quiet line up to the end of stop condition and further
+    __bench_timers_until(dec, __now + BENCH_QUIET_US, stats);
+
+    stats->seqs++;
+
+    for (i = 0; i < __rx_count; i++) {
+        if (__rx[i].evt == DALI2_L_PHY_EVT_BACKWARD_DONE) {
+            frame = __rx[i].frame;
+            accepts++;
+        }
+    }
+
+    if (accepts) {
+        stats->accepted++;
+    } else {
+        stats->rejected++;
+    }
+
+    if (accepts > 1 || (accepts && is_truth && frame != truth_frame) ||
+        (accepts && !is_truth && sent != BENCH_SENT_UNKNOWN && frame != sent)) {
+        stats->wrong_accept++;
+        if (stats->dumped < BENCH_DUMP_MAX) {
+            stats->dumped++;
+            __bench_seq_dump(mode, dec, "wrong accept", seq);
+        }
+    } else if (accepts && !is_truth) {
+        stats->lenient++;
+    } else if (!accepts && is_truth) {
+        stats->false_reject++;
+    }
+
+    if (!dec->is_idle()) {
+        stats->hangs++;
+        if (stats->dumped < BENCH_DUMP_MAX) {
+            stats->dumped++;
+            __bench_seq_dump(mode, dec, "hang", seq);
+        }
+        dec->reset();
+    }
+
+    //! Line stuck low at the end of sequence is released for the next one
+    if (__rx_level != DALI2_L_BSP_DPIN_STATE_1) {
+        __rx_level = DALI2_L_BSP_DPIN_STATE_1;
+        dec->edge(__rx_level);
+        __bench_timers_until(dec, __now + BENCH_QUIET_US, stats);
+        if (!dec->is_idle()) {
+            dec->reset();
+        }
+    }
+}
+
+static void __bench_stats_print(const char *mode, const bench_decoder_t *dec, const bench_stats_t *stats)
+{
+    unsigned long long sum = 0;
+    unsigned int p;
+
+    for (p = 0; p < BENCH_COST_HIST_SIZE - 1; p++) {
+        sum += stats->cost_hist[p];
+        if (sum * 1000 >= stats->calls * BENCH_COST_PERMILLE) {
+            break;
+        }
+    }
+
+    printf("%-8s %-5s %8llu %8llu %8llu %9llu %8llu %9llu %6llu %9.1f %10.1f %8u\n",
+           mode, dec->name, stats->seqs, stats->accepted, stats->rejected,
+           stats->wrong_accept, stats->lenient, stats->false_reject, stats->hangs,
+           stats->edges ? (double) stats->cost / stats->edges : 0.0,
+           stats->seqs ? (double) stats->cost / stats->seqs : 0.0, p);
+}
+
+static void __bench_generated_run(const char *mode, unsigned int seqs, unsigned int jitter_us, unsigned char is_mutated)
+{
+    static bench_seq_t seq;
+    bench_stats_t stats[BENCH_DECODER_COUNT];
+    unsigned char frame;
+    unsigned int i, d;
+
+    memset(stats, 0x00, sizeof(stats));
+
+    for (i = 0; i < seqs; i++) {
+        frame = (unsigned char) __bench_rand();
+        __bench_seq_encode(&seq, frame, jitter_us);
+        if (is_mutated) {
+            __bench_seq_mutate(&seq);
+        }
+
+        for (d = 0; d < BENCH_DECODER_COUNT; d++) {
+            __bench_replay(mode, __decoders[d], &seq, frame, &stats[d]);
+        }
+    }
+
+    for (d = 0; d < BENCH_DECODER_COUNT; d++) {
+        __bench_stats_print(mode, __decoders[d], &stats[d]);
+    }
+}
+
+static int __bench_capture_run(const char *path)
+{
+    static bench_seq_t seq;
+    bench_stats_t stats[BENCH_DECODER_COUNT];
+    unsigned long long at, first_at = 0, last_at = 0;
+    unsigned char level, prev = DALI2_L_BSP_DPIN_STATE_1;
+    char line[128];
+    char *end;
+    double time;
+    long value;
+    unsigned int d;
+    FILE *in;
+
+    in = fopen(path, "r");
+    if (!in) {
+        perror(path);
+        return 1;
+    }
+
+    memset(stats, 0x00, sizeof(stats));
+    seq.count = 0;
+
+    while (1) {
+        int is_eof = !fgets(line, sizeof(line), in);
+
+        if (!is_eof) {
+            time = strtod(line, &end);
+            if (end == line) {
+                continue;
+            }
+            at = strchr(line, '.') && strchr(line, '.') < end ? (unsigned long long) (time * 1e6 + 0.5)
+                                                             : (unsigned long long) time;
+
+            while (*end == ',' || *end == ';' || *end == ' ' || *end == '\t') {
+                end++;
+            }
+            value = strtol(end, NULL, 0);
+            level = value ? DALI2_L_BSP_DPIN_STATE_1 : DALI2_L_BSP_DPIN_STATE_0;
+
+            if (level == prev) {
+                continue;
+            }
+            prev = level;
+        }
+
+        //! Idle gap or end of capture closes the burst
+        if (seq.count && (is_eof || at - last_at > DALI2_L_PHY_STOP_CONDITION_TIME_US)) {
+            for (d = 0; d < BENCH_DECODER_COUNT; d++) {
+                __bench_replay("capture", __decoders[d], &seq, BENCH_SENT_UNKNOWN, &stats[d]);
+            }
+            seq.count = 0;
+        }
+
+        if (is_eof) {
+            break;
+        }
+
+        if (!seq.count) {
+            first_at = at;
+        }
+        __bench_seq_add(&seq, (unsigned int) (at - first_at), level);
+        last_at = at;
+    }
+
+    fclose(in);
+
+    for (d = 0; d < BENCH_DECODER_COUNT; d++) {
+        __bench_stats_print("capture", __decoders[d], &stats[d]);
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int seqs = BENCH_SEQS_DEFAULT;
+    unsigned int jitter_us = BENCH_JITTER_US_DEFAULT;
+    unsigned long long t0, cost;
+    unsigned int i, d;
+
+    if (argc > 1) {
+        seqs = (unsigned int) strtoul(argv[1], NULL, 0);
+    }
+    if (argc > 2) {
+        jitter_us = (unsigned int) strtoul(argv[2], NULL, 0);
+    }
+
+    //! Cost of measurement itself
+    __cost_overhead = ~0ULL;
+    for (i = 0; i < 1000; i++) {
+        t0 = __bench_cost();
+        cost = __bench_cost() - t0;
+        if (cost < __cost_overhead) {
+            __cost_overhead = cost;
+        }
+    }
+
+    //! Physical layer startup
+    dali2_l_phy_init(__bench_phy_evt_handler);
+    __is_timer = 0;
+    dali2_l_phy_timer_cb_handler();
+
+    for (d = 0; d < BENCH_DECODER_COUNT; d++) {
+        __decoders[d]->reset();
+    }
+
+    printf("%-8s %-5s %8s %8s %8s %9s %8s %9s %6s %9s %10s %8s\n",
+           "mode", "dec", "seqs", "accept", "reject", "wrong_acc", "lenient", "false_rej", "hangs",
+           BENCH_COST_UNIT "/edge", BENCH_COST_UNIT "/frame", BENCH_COST_UNIT "_p999");
+
+    __bench_generated_run("clean", seqs, 0, 0);
+    __bench_generated_run("jitter", seqs, jitter_us, 0);
+    __bench_generated_run("mutated", seqs, jitter_us, 1);
+
+    if (argc > 3) {
+        return __bench_capture_run(argv[3]);
+    }
+
+    return 0;
+}